@@ -0,0 +1,249 @@
+#include "catalogue.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace tuttle {
+namespace bench {
+
+namespace {
+
+host::Graph::Node& createGenerator( host::Graph& graph, const std::string& pluginId, const BenchConfig& config )
+{
+	host::Graph::Node& node = graph.createNode( pluginId );
+	node.getParam( "mode" ).setValueFromExpression( "size" );
+	node.getParam( "size" ).setValue( static_cast<int>( config._width ), static_cast<int>( config._height ) );
+	node.getParam( "explicitConversion" ).setValueFromExpression( config._bitDepth );
+	return node;
+}
+
+/**
+ * @brief Write a 3D lut in the Autodesk 3dl format read by the Lut plugin: a gamma curve on each channel.
+ */
+boost::filesystem::path createLutFile( const boost::filesystem::path& workDir )
+{
+	const boost::filesystem::path filename = workDir / "bench.3dl";
+	if( boost::filesystem::exists( filename ) )
+		return filename;
+
+	static const int nbSteps = 17;
+	boost::filesystem::ofstream file( filename );
+	file << "# tuttle-bench gamma lut\n";
+	for( int i = 0; i < nbSteps; ++i )
+		file << ( i * 1023 ) / ( nbSteps - 1 ) << ( i + 1 < nbSteps ? " " : "\n" );
+	for( int r = 0; r < nbSteps; ++r )
+		for( int g = 0; g < nbSteps; ++g )
+			for( int b = 0; b < nbSteps; ++b )
+			{
+				file << static_cast<int>( 4095.0 * std::pow( r / double( nbSteps - 1 ), 1.0 / 2.2 ) ) << " "
+				     << static_cast<int>( 4095.0 * std::pow( g / double( nbSteps - 1 ), 1.0 / 2.2 ) ) << " "
+				     << static_cast<int>( 4095.0 * std::pow( b / double( nbSteps - 1 ), 1.0 / 2.2 ) ) << "\n";
+			}
+	return filename;
+}
+
+host::Graph::Node& buildCheckerboardBlur( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generator = createGenerator( graph, "tuttle.checkerboard", config );
+	host::Graph::Node& blur = graph.createNode( "tuttle.blur" );
+	blur.getParam( "size" ).setValue( 8.0, 8.0 );
+	graph.connect( generator, blur );
+	return blur;
+}
+
+host::Graph::Node& buildColorBarsResize( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generator = createGenerator( graph, "tuttle.colorbars", config );
+	host::Graph::Node& resize = graph.createNode( "tuttle.resize" );
+	resize.getParam( "mode" ).setValueFromExpression( "scale" );
+	resize.getParam( "scale" ).setValue( 0.5, 0.5 );
+	graph.connect( generator, resize );
+	return resize;
+}
+
+host::Graph::Node& buildRampLut( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generator = createGenerator( graph, "tuttle.ramp", config );
+	host::Graph::Node& lut = graph.createNode( "tuttle.lut" );
+	lut.getParam( "filename" ).setValue( createLutFile( config._workDir ).string() );
+	graph.connect( generator, lut );
+	return lut;
+}
+
+host::Graph::Node& buildMerge( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generatorA = createGenerator( graph, "tuttle.checkerboard", config );
+	host::Graph::Node& generatorB = createGenerator( graph, "tuttle.colorbars", config );
+	host::Graph::Node& merge = graph.createNode( "tuttle.merge" );
+	graph.connect( generatorA, merge.getAttribute( "A" ) );
+	graph.connect( generatorB, merge.getAttribute( "B" ) );
+	return merge;
+}
+
+host::Graph::Node& buildRampColorSpace( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generator = createGenerator( graph, "tuttle.ramp", config );
+	host::Graph::Node& colorspace = graph.createNode( "tuttle.colorspace" );
+	colorspace.getParam( "outputReferenceSpace" ).setValue( 1 );
+	graph.connect( generator, colorspace );
+	return colorspace;
+}
+
+host::Graph::Node& buildColorBarsInvert( host::Graph& graph, const BenchConfig& config )
+{
+	host::Graph::Node& generator = createGenerator( graph, "tuttle.colorbars", config );
+	host::Graph::Node& invert = graph.createNode( "tuttle.invert" );
+	graph.connect( generator, invert );
+	return invert;
+}
+
+std::size_t getBytesPerChannel( const std::string& bitDepth )
+{
+	if( bitDepth == "8i" )
+		return 1;
+	if( bitDepth == "16i" )
+		return 2;
+	if( bitDepth == "32f" )
+		return 4;
+	BOOST_THROW_EXCEPTION( std::invalid_argument( "Unrecognized bit depth \"" + bitDepth + "\" (8i, 16i or 32f)." ) );
+}
+
+}
+
+std::string mapOutputEnumToString( const EOutput e )
+{
+	switch( e )
+	{
+		case eOutputMemory:
+			return "memory";
+		case eOutputDisk:
+			return "disk";
+	}
+	BOOST_THROW_EXCEPTION( std::invalid_argument( "Unrecognized output." ) );
+}
+
+EOutput mapOutputStringToEnum( const std::string& s )
+{
+	if( s == "memory" )
+		return eOutputMemory;
+	if( s == "disk" )
+		return eOutputDisk;
+	BOOST_THROW_EXCEPTION( std::invalid_argument( "Unrecognized output \"" + s + "\" (memory or disk)." ) );
+}
+
+BenchResult::BenchResult()
+	: _nbThreads( 0 )
+	, _seconds( 0.0 )
+	, _fps( 0.0 )
+	, _megaBytesPerSecond( 0.0 )
+	, _peakPoolMemory( 0 )
+	, _hasBaseline( false )
+	, _baselineFps( 0.0 )
+	, _baselinePeakPoolMemory( 0 )
+{}
+
+std::string BenchResult::getKey() const
+{
+	return _graphName + "/" + mapOutputEnumToString( _config._output ) + "/" +
+		boost::lexical_cast<std::string>( _config._width ) + "x" + boost::lexical_cast<std::string>( _config._height ) + "/" +
+		_config._bitDepth + "/" + boost::lexical_cast<std::string>( _nbThreads ) + "threads";
+}
+
+const std::vector<BenchGraph>& getCatalogue()
+{
+	static const BenchGraph graphs[] = {
+		{ "checkerboard-blur", "Checkerboard, Blur", &buildCheckerboardBlur },
+		{ "colorbars-resize", "ColorBars, Resize to half size", &buildColorBarsResize },
+		{ "ramp-lut", "Ramp, Lut 3D", &buildRampLut },
+		{ "merge", "Merge of a Checkerboard over ColorBars", &buildMerge },
+		{ "ramp-colorspace", "Ramp, ColorSpace", &buildRampColorSpace },
+		{ "colorbars-invert", "ColorBars, Invert", &buildColorBarsInvert },
+	};
+	static const std::vector<BenchGraph> catalogue( graphs, graphs + sizeof( graphs ) / sizeof( BenchGraph ) );
+	return catalogue;
+}
+
+BenchResult runBenchmark( const BenchGraph& benchGraph, const BenchConfig& config )
+{
+	using namespace tuttle::host;
+	typedef boost::chrono::steady_clock Clock;
+
+	BenchResult result;
+	result._graphName = benchGraph._name;
+	result._config = config;
+
+	core().getPreferences().setNbThreads( config._nbThreads );
+	result._nbThreads = core().getThreadPool().getNbThreads();
+
+	try
+	{
+		Graph graph;
+		Graph::Node* output = &benchGraph._build( graph, config );
+		if( config._output == eOutputDisk )
+		{
+			// png doesn't support floating point images
+			const std::string extension = config._bitDepth == "32f" ? "exr" : "png";
+			Graph::Node& writer = graph.createNode( "tuttle." + extension + "writer" );
+			const boost::filesystem::path filename = config._workDir / ( std::string( benchGraph._name ) + ".####." + extension );
+			writer.getParam( "filename" ).setValue( filename.string() );
+			graph.connect( *output, writer );
+			output = &writer;
+		}
+
+		ComputeOptions options;
+		options.setUseRenderCache( false );
+		memory::MemoryCache outputCache;
+
+		// each frame is computed separately, so the output cache only keeps one image
+		const std::size_t nbFrames = config._nbWarmupFrames + config._nbFrames;
+		Clock::time_point start = Clock::now();
+		for( std::size_t frame = 0; frame < nbFrames; ++frame )
+		{
+			if( frame == config._nbWarmupFrames )
+			{
+				core().getMemoryPool().resetPeakUsedMemorySize();
+				start = Clock::now();
+			}
+			options.setTimeRange( static_cast<int>( frame ), static_cast<int>( frame ) );
+			options.setReturnBuffers( config._output == eOutputMemory );
+			if( ! graph.compute( outputCache, NodeListArg( output->getName() ), options ) )
+				BOOST_THROW_EXCEPTION( std::runtime_error( "The computation failed." ) );
+			outputCache.clearAll();
+		}
+		result._seconds = boost::chrono::duration<double>( Clock::now() - start ).count();
+		result._peakPoolMemory = core().getMemoryPool().getPeakUsedMemorySize();
+
+		if( result._seconds > 0.0 )
+		{
+			// size of the rendered images, not of the generator (the graph may resize)
+			graph.setup();
+			graph.setupAtTime( 0, NodeListArg( output->getName() ) );
+			const OfxRectD outputRod = output->asImageEffectNode().getRegionOfDefinition( 0 );
+			const double frameSize = ( outputRod.x2 - outputRod.x1 ) * ( outputRod.y2 - outputRod.y1 ) * 4 * getBytesPerChannel( config._bitDepth );
+			result._fps = config._nbFrames / result._seconds;
+			result._megaBytesPerSecond = result._fps * frameSize / ( 1024.0 * 1024.0 );
+		}
+	}
+	catch( ... )
+	{
+		result._error = boost::current_exception_diagnostic_information();
+	}
+
+	// give the unused buffers back, so a benchmark doesn't reuse the buffers of the previous one
+	core().getMemoryPool().clear();
+	return result;
+}
+
+}
+}
@@ -0,0 +1,90 @@
+#ifndef _TUTTLE_BENCH_CATALOGUE_HPP_
+#define _TUTTLE_BENCH_CATALOGUE_HPP_
+
+#include <tuttle/host/Graph.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace tuttle {
+namespace bench {
+
+enum EOutput
+{
+	eOutputMemory = 0, ///< the images are returned in a memory cache
+	eOutputDisk        ///< the images are written by a writer node
+};
+
+std::string mapOutputEnumToString( const EOutput e );
+EOutput mapOutputStringToEnum( const std::string& s );
+
+/**
+ * @brief One point of the benchmarks sweep.
+ */
+struct BenchConfig
+{
+	std::size_t _width;
+	std::size_t _height;
+	std::string _bitDepth; ///< "8i", "16i" or "32f"
+	std::size_t _nbThreads; ///< 0 for one thread per hardware thread
+	EOutput _output;
+	std::size_t _nbFrames; ///< measured frames
+	std::size_t _nbWarmupFrames; ///< frames rendered before the measure
+	boost::filesystem::path _workDir; ///< written images and generated files
+};
+
+/**
+ * @brief Measures of one benchmark on one configuration.
+ */
+struct BenchResult
+{
+	BenchResult();
+
+	/// @brief Unique identifier, to compare with the same benchmark of a baseline.
+	std::string getKey() const;
+
+	std::string _graphName;
+	BenchConfig _config;
+	std::size_t _nbThreads; ///< threads really used
+	double _seconds;
+	double _fps;
+	double _megaBytesPerSecond; ///< size of the output images rendered per second
+	std::size_t _peakPoolMemory; ///< in bytes
+	std::string _error; ///< empty if the benchmark succeeded
+
+	/// @name Comparison with a baseline
+	/// @{
+	bool _hasBaseline;
+	double _baselineFps;
+	std::size_t _baselinePeakPoolMemory;
+	std::vector<std::string> _regressions; ///< names of the regressed measures
+	/// @}
+};
+
+/**
+ * @brief A graph of the catalogue.
+ * The builder creates the nodes in @p graph and returns the node to render,
+ * without the output: the writer is added by the benchmark.
+ */
+struct BenchGraph
+{
+	typedef host::Graph::Node& ( *Builder )( host::Graph& graph, const BenchConfig& config );
+
+	const char* _name;
+	const char* _description;
+	Builder _build;
+};
+
+/// @brief The fixed list of graphs, with generators as inputs.
+const std::vector<BenchGraph>& getCatalogue();
+
+/// @brief Render @p graph with @p config and measure it.
+BenchResult runBenchmark( const BenchGraph& graph, const BenchConfig& config );
+
+}
+}
+
+#endif
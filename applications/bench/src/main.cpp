@@ -0,0 +1,185 @@
+#include "catalogue.hpp"
+#include "report.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/common/utils/Formatter.hpp>
+#include <tuttle/host/Core.hpp>
+
+#include <boost/program_options.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/foreach.hpp>
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+namespace bpo = boost::program_options;
+
+namespace {
+
+std::vector<std::string> splitList( const std::string& s )
+{
+	std::vector<std::string> list;
+	boost::algorithm::split( list, s, boost::algorithm::is_any_of( ", " ), boost::algorithm::token_compress_on );
+	return list;
+}
+
+/// @brief "1920x1080" to width and height
+void parseResolution( const std::string& s, std::size_t& width, std::size_t& height )
+{
+	const std::size_t x = s.find( 'x' );
+	if( x == std::string::npos )
+		BOOST_THROW_EXCEPTION( std::invalid_argument( "Bad resolution \"" + s + "\", expected WIDTHxHEIGHT." ) );
+	width = boost::lexical_cast<std::size_t>( s.substr( 0, x ) );
+	height = boost::lexical_cast<std::size_t>( s.substr( x + 1 ) );
+}
+
+}
+
+int main( int argc, char** argv )
+{
+	using namespace tuttle::bench;
+
+	tuttle::common::Formatter::get();
+
+	bpo::options_description options( "tuttle-bench: render throughput of a fixed catalogue of graphs.\n"
+	                                  "Each graph is rendered for each resolution, bit depth, thread count and output.\n"
+	                                  "Returns 1 if a benchmark regressed against the baseline, 2 on errors.\n\nOptions" );
+	options.add_options()
+		( "help,h", "show this help" )
+		( "list,l", "list the graphs of the catalogue" )
+		( "graphs,g", bpo::value<std::string>(), "graphs to run (default: all)" )
+		( "resolutions,r", bpo::value<std::string>()->default_value( "1920x1080" ), "list of WIDTHxHEIGHT" )
+		( "bit-depths,b", bpo::value<std::string>()->default_value( "8i,32f" ), "list of bit depths (8i, 16i, 32f)" )
+		( "threads,t", bpo::value<std::string>()->default_value( "1,0" ), "list of thread counts, 0 for all the hardware threads" )
+		( "outputs,o", bpo::value<std::string>()->default_value( "memory,disk" ), "list of outputs: memory (images returned in a memory cache) or disk (writer node)" )
+		( "frames,f", bpo::value<std::size_t>()->default_value( 5 ), "number of measured frames" )
+		( "warmup,w", bpo::value<std::size_t>()->default_value( 1 ), "number of frames rendered before the measure" )
+		( "work-dir", bpo::value<std::string>(), "directory of the written images (default: tuttle temporary directory)" )
+		( "report", bpo::value<std::string>()->default_value( "tuttle-bench.json" ), "JSON report file, '-' for the standard output" )
+		( "baseline", bpo::value<std::string>(), "JSON report of a previous run, to detect regressions" )
+		( "tolerance", bpo::value<double>()->default_value( 0.1 ), "relative difference with the baseline considered as a regression" )
+	;
+
+	bpo::variables_map vm;
+	try
+	{
+		bpo::store( bpo::parse_command_line( argc, argv, options ), vm );
+		bpo::notify( vm );
+	}
+	catch( const bpo::error& e )
+	{
+		TUTTLE_LOG_ERROR( "tuttle-bench: command line error: " << e.what() );
+		return 2;
+	}
+
+	if( vm.count( "help" ) )
+	{
+		std::cout << options << std::endl;
+		return 0;
+	}
+
+	const std::vector<BenchGraph>& catalogue = getCatalogue();
+	if( vm.count( "list" ) )
+	{
+		BOOST_FOREACH( const BenchGraph& graph, catalogue )
+		{
+			TUTTLE_COUT( graph._name << "\t" << graph._description );
+		}
+		return 0;
+	}
+
+	try
+	{
+		tuttle::host::core().preload();
+
+		std::vector<BenchGraph> graphs;
+		if( vm.count( "graphs" ) )
+		{
+			BOOST_FOREACH( const std::string& name, splitList( vm["graphs"].as<std::string>() ) )
+			{
+				std::vector<BenchGraph>::const_iterator it = catalogue.begin();
+				while( it != catalogue.end() && name != it->_name )
+					++it;
+				if( it == catalogue.end() )
+					BOOST_THROW_EXCEPTION( std::invalid_argument( "No graph \"" + name + "\" in the catalogue." ) );
+				graphs.push_back( *it );
+			}
+		}
+		else
+		{
+			graphs = catalogue;
+		}
+
+		const boost::filesystem::path workDir = vm.count( "work-dir" ) ?
+			boost::filesystem::path( vm["work-dir"].as<std::string>() ) :
+			tuttle::host::core().getPreferences().getTuttleTempPath() / "bench";
+		boost::filesystem::create_directories( workDir );
+
+		BenchConfig config;
+		config._nbFrames = vm["frames"].as<std::size_t>();
+		config._nbWarmupFrames = vm["warmup"].as<std::size_t>();
+		config._workDir = workDir;
+
+		std::vector<BenchResult> results;
+		std::size_t nbErrors = 0;
+		BOOST_FOREACH( const BenchGraph& graph, graphs )
+		BOOST_FOREACH( const std::string& output, splitList( vm["outputs"].as<std::string>() ) )
+		BOOST_FOREACH( const std::string& resolution, splitList( vm["resolutions"].as<std::string>() ) )
+		BOOST_FOREACH( const std::string& bitDepth, splitList( vm["bit-depths"].as<std::string>() ) )
+		BOOST_FOREACH( const std::string& nbThreads, splitList( vm["threads"].as<std::string>() ) )
+		{
+			config._output = mapOutputStringToEnum( output );
+			parseResolution( resolution, config._width, config._height );
+			config._bitDepth = bitDepth;
+			config._nbThreads = boost::lexical_cast<std::size_t>( nbThreads );
+
+			results.push_back( runBenchmark( graph, config ) );
+			const BenchResult& result = results.back();
+			if( result._error.empty() )
+			{
+				TUTTLE_LOG_INFO( "[tuttle-bench] " << result.getKey() << ": " << result._fps << " fps, "
+					<< result._megaBytesPerSecond << " MB/s, " << result._peakPoolMemory << " bytes peak memory" );
+			}
+			else
+			{
+				TUTTLE_LOG_ERROR( "[tuttle-bench] " << result.getKey() << ": " << result._error );
+				++nbErrors;
+			}
+		}
+
+		std::size_t nbRegressions = 0;
+		if( vm.count( "baseline" ) )
+			nbRegressions = compareWithBaseline( results, vm["baseline"].as<std::string>(), vm["tolerance"].as<double>() );
+
+		const std::string reportFilename = vm["report"].as<std::string>();
+		if( reportFilename == "-" )
+		{
+			writeJsonReport( std::cout, results );
+		}
+		else
+		{
+			boost::filesystem::ofstream report( reportFilename );
+			writeJsonReport( report, results );
+		}
+
+		if( nbErrors )
+			return 2;
+		if( nbRegressions )
+		{
+			TUTTLE_LOG_ERROR( "[tuttle-bench] " << nbRegressions << " regression(s)." );
+			return 1;
+		}
+	}
+	catch( ... )
+	{
+		TUTTLE_LOG_ERROR( "[tuttle-bench] " << boost::current_exception_diagnostic_information() );
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include "report.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/common/utils/json.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/foreach.hpp>
+
+#include <map>
+#include <stdexcept>
+
+namespace tuttle {
+namespace bench {
+
+namespace {
+
+struct BaselineMeasure
+{
+	double _fps;
+	std::size_t _peakPoolMemory;
+};
+
+}
+
+void writeJsonReport( std::ostream& os, const std::vector<BenchResult>& results )
+{
+	os << "{\n";
+	os << "\"results\": [\n";
+	for( std::size_t i = 0; i < results.size(); ++i )
+	{
+		const BenchResult& r = results[i];
+		os << "  {";
+		os << "\"name\": "; common::writeJsonString( os, r.getKey() );
+		os << ", \"graph\": "; common::writeJsonString( os, r._graphName );
+		os << ", \"output\": "; common::writeJsonString( os, mapOutputEnumToString( r._config._output ) );
+		os << ", \"width\": " << r._config._width;
+		os << ", \"height\": " << r._config._height;
+		os << ", \"bitDepth\": "; common::writeJsonString( os, r._config._bitDepth );
+		os << ", \"threads\": " << r._nbThreads;
+		os << ", \"frames\": " << r._config._nbFrames;
+		os << ", \"seconds\": " << r._seconds;
+		os << ", \"fps\": " << r._fps;
+		os << ", \"MBps\": " << r._megaBytesPerSecond;
+		os << ", \"peakPoolMemory\": " << r._peakPoolMemory;
+		if( ! r._error.empty() )
+		{
+			os << ", \"error\": "; common::writeJsonString( os, r._error );
+		}
+		if( r._hasBaseline )
+		{
+			os << ", \"baselineFps\": " << r._baselineFps;
+			os << ", \"baselinePeakPoolMemory\": " << r._baselinePeakPoolMemory;
+			os << ", \"regressions\": [";
+			for( std::size_t j = 0; j < r._regressions.size(); ++j )
+			{
+				if( j )
+					os << ", ";
+				common::writeJsonString( os, r._regressions[j] );
+			}
+			os << "]";
+		}
+		os << "}" << ( i + 1 < results.size() ? "," : "" ) << "\n";
+	}
+	os << "]\n";
+	os << "}\n";
+}
+
+std::size_t compareWithBaseline( std::vector<BenchResult>& results, const boost::filesystem::path& baseline, const double tolerance )
+{
+	using boost::property_tree::ptree;
+
+	ptree root;
+	boost::property_tree::read_json( baseline.string(), root );
+
+	std::map<std::string, BaselineMeasure> measures;
+	BOOST_FOREACH( const ptree::value_type& v, root.get_child( "results" ) )
+	{
+		if( v.second.count( "error" ) )
+			continue;
+		BaselineMeasure m;
+		m._fps = v.second.get<double>( "fps" );
+		m._peakPoolMemory = v.second.get<std::size_t>( "peakPoolMemory" );
+		measures[v.second.get<std::string>( "name" )] = m;
+	}
+
+	std::size_t nbRegressions = 0;
+	BOOST_FOREACH( BenchResult& r, results )
+	{
+		std::map<std::string, BaselineMeasure>::const_iterator it = measures.find( r.getKey() );
+		if( it == measures.end() || ! r._error.empty() )
+			continue;
+		r._hasBaseline = true;
+		r._baselineFps = it->second._fps;
+		r._baselinePeakPoolMemory = it->second._peakPoolMemory;
+
+		if( r._fps < r._baselineFps * ( 1.0 - tolerance ) )
+			r._regressions.push_back( "fps" );
+		if( r._peakPoolMemory > r._baselinePeakPoolMemory * ( 1.0 + tolerance ) )
+			r._regressions.push_back( "peakPoolMemory" );
+
+		if( ! r._regressions.empty() )
+		{
+			TUTTLE_LOG_WARNING( "[tuttle-bench] Regression on " << r.getKey() << ": "
+				<< r._fps << " fps (baseline " << r._baselineFps << "), "
+				<< r._peakPoolMemory << " bytes (baseline " << r._baselinePeakPoolMemory << ")." );
+			++nbRegressions;
+		}
+	}
+	return nbRegressions;
+}
+
+}
+}
@@ -0,0 +1,30 @@
+#ifndef _TUTTLE_BENCH_REPORT_HPP_
+#define _TUTTLE_BENCH_REPORT_HPP_
+
+#include "catalogue.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <ostream>
+#include <vector>
+
+namespace tuttle {
+namespace bench {
+
+/**
+ * @brief Write the results in JSON, the same file can be used as a baseline.
+ */
+void writeJsonReport( std::ostream& os, const std::vector<BenchResult>& results );
+
+/**
+ * @brief Compare the results with the same benchmarks of a previous report.
+ * A benchmark regresses if its fps is lower than the baseline by more than @p tolerance
+ * (relative), or if its peak memory is higher by more than @p tolerance.
+ * @return number of regressed benchmarks
+ */
+std::size_t compareWithBaseline( std::vector<BenchResult>& results, const boost::filesystem::path& baseline, const double tolerance );
+
+}
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef _TERRY_ALGORITHM_FOR_EACH_BAND_HPP_
+#define _TERRY_ALGORITHM_FOR_EACH_BAND_HPP_
+
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace terry {
+namespace algorithm {
+
+/// @brief Maximum number of bands of rows processed independently.
+static const std::ptrdiff_t kBandsMaxNb = 64;
+/// @brief Under this number of pixels per thread, the bands use less threads.
+static const std::ptrdiff_t kBandsMinPixelsPerThread = 65536;
+
+/**
+ * @brief Execute the workers of the parallel algorithms on the threads of a boost::thread_group.
+ * The current thread is one of the workers.
+ *
+ * Executor models:
+ * @code
+ * std::size_t nbThreads() const; // maximum number of workers running at the same time
+ * template<typename Worker>
+ * void operator()( Worker& worker, const std::size_t nbWorkers ) const; // call worker.run() on nbWorkers threads, and wait for them
+ * @endcode
+ * The plugins use the host threads (see tuttle::plugin::OfxThreadExecutor).
+ */
+class thread_group_executor
+{
+public:
+	/// @param nbThreads 0 to use all the cores
+	explicit thread_group_executor( const std::size_t nbThreads = 0 )
+	: _nbThreads( nbThreads ? nbThreads : std::max( boost::thread::hardware_concurrency(), 1u ) )
+	{}
+
+	std::size_t nbThreads() const { return _nbThreads; }
+
+	template<typename Worker>
+	void operator()( Worker& worker, const std::size_t nbWorkers ) const
+	{
+		boost::thread_group threads;
+		for( std::size_t i = 1; i < nbWorkers; ++i )
+			threads.create_thread( boost::bind( &Worker::run, &worker ) );
+		worker.run();
+		threads.join_all();
+	}
+
+private:
+	std::size_t _nbThreads;
+};
+
+/// @brief Height of the bands of rows: the bands only depend on the height of the image.
+inline std::ptrdiff_t band_height( const std::ptrdiff_t height )
+{
+	return std::max( ( height + kBandsMaxNb - 1 ) / kBandsMaxNb, std::ptrdiff_t( 1 ) );
+}
+
+/// @brief Number of bands of rows of an image.
+inline std::ptrdiff_t nb_bands( const std::ptrdiff_t height )
+{
+	if( height <= 0 )
+		return 0;
+	const std::ptrdiff_t bandHeight = band_height( height );
+	return ( height + bandHeight - 1 ) / bandHeight;
+}
+
+namespace details {
+
+/**
+ * @brief Shared state of the threads processing the bands of rows.
+ * @see for_each_band
+ */
+template<typename BandFunction>
+class bands_runner
+{
+public:
+	bands_runner( BandFunction& function, const std::ptrdiff_t height )
+	: _function( function )
+	, _height( height )
+	, _bandHeight( band_height( height ) )
+	, _nbBands( nb_bands( height ) )
+	, _nextBand( 0 )
+	, _stopped( false )
+	{}
+
+	/// @brief Process the next bands until there is no more band.
+	void run()
+	{
+		try
+		{
+			std::size_t band;
+			while( nextBand( band ) )
+			{
+				const std::ptrdiff_t y1 = band * _bandHeight;
+				const std::ptrdiff_t y2 = std::min( y1 + _bandHeight, _height );
+				if( _function( band, y1, y2 ) )
+				{
+					stop();
+					return;
+				}
+			}
+		}
+		catch( ... )
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			if( ! _error )
+				_error = boost::current_exception();
+			_stopped = true;
+		}
+	}
+
+	/// @return false if the processing was stopped
+	bool finish() const
+	{
+		if( _error )
+			boost::rethrow_exception( _error );
+		return ! _stopped;
+	}
+
+private:
+	bool nextBand( std::size_t& band )
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		if( _stopped || _nextBand == _nbBands )
+			return false;
+		band = _nextBand++;
+		return true;
+	}
+
+	void stop()
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stopped = true;
+	}
+
+private:
+	BandFunction& _function;
+	const std::ptrdiff_t _height;
+	const std::ptrdiff_t _bandHeight;
+	const std::size_t _nbBands;
+
+	boost::mutex _mutex;
+	std::size_t _nextBand; ///< protected by _mutex
+	bool _stopped; ///< protected by _mutex
+	boost::exception_ptr _error; ///< protected by _mutex
+};
+
+}
+
+/**
+ * @brief Call @p function on each band of rows of an image, on the threads of @p executor.
+ * @ingroup ImageAlgorithms
+ *
+ * The rows are split in at most kBandsMaxNb bands (see band_height). The bands
+ * only depend on the height, so an algorithm can give a result independent of
+ * the number of threads.
+ *
+ * BandFunction models:
+ * @code
+ * // process the rows [y1, y2) of the band, return true to stop the processing of the next bands
+ * bool operator()( const std::size_t band, const std::ptrdiff_t y1, const std::ptrdiff_t y2 );
+ * @endcode
+ * The first exception thrown by @p function is rethrown, once all the threads are done.
+ *
+ * @param width number of pixels per row, to limit the number of threads on small images (0: unknown)
+ * @return false if the processing was stopped by @p function
+ */
+template<typename BandFunction, typename Executor>
+bool for_each_band( const std::ptrdiff_t height, const std::ptrdiff_t width, BandFunction& function, const Executor& executor )
+{
+	if( height <= 0 )
+		return true;
+
+	std::ptrdiff_t nbWorkers = std::min( std::ptrdiff_t( executor.nbThreads() ), nb_bands( height ) );
+	if( width > 0 )
+		nbWorkers = std::min( nbWorkers, std::max( height * width / kBandsMinPixelsPerThread, std::ptrdiff_t( 1 ) ) );
+
+	details::bands_runner<BandFunction> runner( function, height );
+	executor( runner, std::max( nbWorkers, std::ptrdiff_t( 1 ) ) );
+	return runner.finish();
+}
+
+template<typename BandFunction>
+bool for_each_band( const std::ptrdiff_t height, const std::ptrdiff_t width, BandFunction& function )
+{
+	return for_each_band( height, width, function, thread_group_executor() );
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef _TERRY_ALGORITHM_REDUCE_HPP_
+#define _TERRY_ALGORITHM_REDUCE_HPP_
+
+#include "for_each_band.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace algorithm {
+
+namespace details {
+
+struct reduce_no_progress
+{
+	bool progressForward( const int ) { return false; }
+};
+
+/**
+ * @brief Reduce the rows of each band in its own reducer.
+ */
+template<typename RowReducer, typename Progress>
+struct reduce_bands
+{
+	std::vector<RowReducer>& _bands;
+	const std::ptrdiff_t _width;
+	Progress& _progress;
+
+	reduce_bands( std::vector<RowReducer>& bands, const std::ptrdiff_t width, Progress& p )
+	: _bands( bands )
+	, _width( width )
+	, _progress( p )
+	{}
+
+	bool operator()( const std::size_t band, const std::ptrdiff_t y1, const std::ptrdiff_t y2 )
+	{
+		RowReducer& reducer = _bands[band];
+		for( std::ptrdiff_t y = y1; y < y2; ++y )
+		{
+			reducer( y );
+			if( _progress.progressForward( _width ) )
+				return true;
+		}
+		return false;
+	}
+};
+
+/**
+ * @brief Reduce each row of a view with a per pixel reducer.
+ */
+template<typename View, typename Reducer>
+struct pixel_rows_reducer_t
+{
+	View _view;
+	Reducer _reducer;
+
+	pixel_rows_reducer_t( const View& view, const Reducer& reducer )
+	: _view( view )
+	, _reducer( reducer )
+	{}
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		typename View::x_iterator it = _view.row_begin( y );
+		for( std::ptrdiff_t x = 0; x < _view.width(); ++x )
+			_reducer( it[x] );
+	}
+
+	void merge( const pixel_rows_reducer_t& other )
+	{
+		_reducer.merge( other._reducer );
+	}
+};
+
+}
+
+/**
+ * @brief Parallel reduction of the rows of an image.
+ * @ingroup ImageAlgorithms
+ *
+ * The rows are split in bands (see for_each_band), each band is reduced by a
+ * copy of @p reducer on one of the threads of @p executor, then the partial
+ * results are merged in the order of the bands. The bands only depend on the
+ * height, so the result doesn't depend on the number of threads.
+ *
+ * RowReducer models:
+ * @code
+ * RowReducer( const RowReducer& ); // the initial value of each band
+ * void operator()( const std::ptrdiff_t y ); // accumulate the row y
+ * void merge( const RowReducer& next ); // accumulate the result of the next rows
+ * @endcode
+ * The initial value must be neutral: empty, or idempotent like a min or a max.
+ *
+ * @param width number of pixels per row, for the progress and to limit
+ *              the number of threads on small images (0: unknown)
+ * @param executor threads of the reduction, see thread_group_executor
+ * @return @p reducer, containing the result. Partial if the progress was aborted.
+ */
+template<typename RowReducer, typename Progress, typename Executor>
+RowReducer& reduce_rows_parallel_progress( const std::ptrdiff_t height, const std::ptrdiff_t width, RowReducer& reducer, Progress& p, const Executor& executor )
+{
+	if( height <= 0 )
+		return reducer;
+
+	std::vector<RowReducer> bands( nb_bands( height ), reducer );
+	details::reduce_bands<RowReducer, Progress> reduction( bands, width, p );
+	for_each_band( height, width, reduction, executor );
+
+	reducer = bands.front();
+	for( std::size_t i = 1; i < bands.size(); ++i )
+		reducer.merge( bands[i] );
+	return reducer;
+}
+
+template<typename RowReducer, typename Progress>
+RowReducer& reduce_rows_parallel_progress( const std::ptrdiff_t height, const std::ptrdiff_t width, RowReducer& reducer, Progress& p )
+{
+	return reduce_rows_parallel_progress( height, width, reducer, p, thread_group_executor() );
+}
+
+template<typename RowReducer, typename Executor>
+RowReducer& reduce_rows_parallel( const std::ptrdiff_t height, const std::ptrdiff_t width, RowReducer& reducer, const Executor& executor )
+{
+	details::reduce_no_progress p;
+	return reduce_rows_parallel_progress( height, width, reducer, p, executor );
+}
+
+template<typename RowReducer>
+RowReducer& reduce_rows_parallel( const std::ptrdiff_t height, const std::ptrdiff_t width, RowReducer& reducer )
+{
+	return reduce_rows_parallel( height, width, reducer, thread_group_executor() );
+}
+
+/**
+ * @brief Parallel reduction of all the pixels of a view.
+ * @ingroup ImageAlgorithms
+ *
+ * Reducer models:
+ * @code
+ * Reducer( const Reducer& ); // the initial value of each band
+ * void operator()( const Pixel& p ); // accumulate a pixel
+ * void merge( const Reducer& next ); // accumulate the result of the next pixels
+ * @endcode
+ *
+ * @see reduce_rows_parallel_progress
+ */
+template<typename View, typename Reducer, typename Progress, typename Executor>
+Reducer& reduce_pixels_parallel_progress( const View& view, Reducer& reducer, Progress& p, const Executor& executor )
+{
+	details::pixel_rows_reducer_t<View, Reducer> rowsReducer( view, reducer );
+	reduce_rows_parallel_progress( view.height(), view.width(), rowsReducer, p, executor );
+	reducer = rowsReducer._reducer;
+	return reducer;
+}
+
+template<typename View, typename Reducer, typename Progress>
+Reducer& reduce_pixels_parallel_progress( const View& view, Reducer& reducer, Progress& p )
+{
+	return reduce_pixels_parallel_progress( view, reducer, p, thread_group_executor() );
+}
+
+template<typename View, typename Reducer, typename Executor>
+Reducer& reduce_pixels_parallel( const View& view, Reducer& reducer, const Executor& executor )
+{
+	details::reduce_no_progress p;
+	return reduce_pixels_parallel_progress( view, reducer, p, executor );
+}
+
+template<typename View, typename Reducer>
+Reducer& reduce_pixels_parallel( const View& view, Reducer& reducer )
+{
+	return reduce_pixels_parallel( view, reducer, thread_group_executor() );
+}
+
+}
+}
+
+#endif
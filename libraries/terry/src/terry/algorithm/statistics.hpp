@@ -0,0 +1,163 @@
+#ifndef _TERRY_ALGORITHM_STATISTICS_HPP_
+#define _TERRY_ALGORITHM_STATISTICS_HPP_
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/pixel.hpp>
+#include <boost/config.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+namespace terry {
+namespace algorithm {
+
+/**
+ * @brief Mean and central moments of a value, up to the 4th order.
+ *
+ * Single pass and numerically stable: the values are accumulated around the
+ * current mean (Welford, Terriberry), and two partial results are merged with
+ * the pairwise formulas of Chan and Pebay, so it can be used as a reducer of
+ * reduce_rows_parallel_progress.
+ */
+struct channel_moments_t
+{
+	std::size_t _n;
+	double _mean;
+	double _m2; ///< sum of ( x - mean )^2
+	double _m3; ///< sum of ( x - mean )^3
+	double _m4; ///< sum of ( x - mean )^4
+
+	channel_moments_t()
+	: _n( 0 )
+	, _mean( 0 )
+	, _m2( 0 )
+	, _m3( 0 )
+	, _m4( 0 )
+	{}
+
+	void operator()( const double x )
+	{
+		const double n1 = static_cast<double>( _n );
+		++_n;
+		const double n = static_cast<double>( _n );
+		const double delta = x - _mean;
+		const double delta_n = delta / n;
+		const double delta_n2 = delta_n * delta_n;
+		const double term1 = delta * delta_n * n1;
+		_mean += delta_n;
+		_m4 += term1 * delta_n2 * ( n * n - 3.0 * n + 3.0 ) + 6.0 * delta_n2 * _m2 - 4.0 * delta_n * _m3;
+		_m3 += term1 * delta_n * ( n - 2.0 ) - 3.0 * delta_n * _m2;
+		_m2 += term1;
+	}
+
+	void merge( const channel_moments_t& other )
+	{
+		if( other._n == 0 )
+			return;
+		if( _n == 0 )
+		{
+			*this = other;
+			return;
+		}
+		const double na = static_cast<double>( _n );
+		const double nb = static_cast<double>( other._n );
+		const double n = na + nb;
+		const double delta = other._mean - _mean;
+		const double delta2 = delta * delta;
+		const double delta3 = delta2 * delta;
+		const double delta4 = delta2 * delta2;
+
+		const double m2 = _m2 + other._m2 + delta2 * na * nb / n;
+		const double m3 = _m3 + other._m3
+			+ delta3 * na * nb * ( na - nb ) / ( n * n )
+			+ 3.0 * delta * ( na * other._m2 - nb * _m2 ) / n;
+		const double m4 = _m4 + other._m4
+			+ delta4 * na * nb * ( na * na - na * nb + nb * nb ) / ( n * n * n )
+			+ 6.0 * delta2 * ( na * na * other._m2 + nb * nb * _m2 ) / ( n * n )
+			+ 4.0 * delta * ( na * other._m3 - nb * _m3 ) / n;
+
+		_n += other._n;
+		_mean += delta * nb / n;
+		_m2 = m2;
+		_m3 = m3;
+		_m4 = m4;
+	}
+
+	std::size_t count() const { return _n; }
+	double mean() const { return _mean; }
+
+	/// @brief Population variance
+	double variance() const
+	{
+		return _n ? _m2 / _n : 0.0;
+	}
+
+	double standard_deviation() const
+	{
+		return std::sqrt( variance() );
+	}
+
+	/**
+	 * @brief Asymmetry of the distribution.
+	 * 0 if the values are constant.
+	 */
+	double skewness() const
+	{
+		if( _m2 <= 0 )
+			return 0.0;
+		return std::sqrt( static_cast<double>( _n ) ) * _m3 / std::pow( _m2, 1.5 );
+	}
+
+	/**
+	 * @brief Excess kurtosis, "peakedness" of the distribution (0 for a normal distribution).
+	 * 0 if the values are constant.
+	 */
+	double kurtosis() const
+	{
+		if( _m2 <= 0 )
+			return 0.0;
+		return static_cast<double>( _n ) * _m4 / ( _m2 * _m2 ) - 3.0;
+	}
+};
+
+/**
+ * @brief channel_moments_t of each channel of the pixels.
+ */
+template<typename Pixel>
+struct pixel_moments_t
+{
+	BOOST_STATIC_CONSTANT( int, nbChannels = boost::gil::num_channels<Pixel>::value );
+
+	channel_moments_t _channels[nbChannels];
+
+	template<typename SPixel>
+	GIL_FORCEINLINE
+	void operator()( const SPixel& p )
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			_channels[c]( static_cast<double>( p[c] ) );
+	}
+
+	void merge( const pixel_moments_t& other )
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			_channels[c].merge( other._channels[c] );
+	}
+
+	const channel_moments_t& operator[]( const int c ) const { return _channels[c]; }
+
+	std::size_t count() const { return _channels[0].count(); }
+
+	/// @brief Fill a pixel with one statistic of each channel, like &channel_moments_t::mean
+	template<typename DPixel>
+	void get( double ( channel_moments_t::*statistic )() const, DPixel& dst ) const
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			dst[c] = ( _channels[c].*statistic )();
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef _TERRY_FILTER_CONNECTEDCOMPONENTS_HPP_
+#define _TERRY_FILTER_CONNECTEDCOMPONENTS_HPP_
+
+#include <terry/algorithm/for_each_band.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace terry {
+namespace filter {
+namespace connectedComponents {
+
+/**
+ * @brief Labelling of the connected components of an image, with a union-find.
+ *
+ * The image is cut in bands of rows (see terry::algorithm::for_each_band).
+ * Each band is labelled independently on one thread, then the components are
+ * merged across the borders of the bands, and each pixel is finally linked to
+ * the root of its component, in parallel.
+ *
+ * The label of a component is the index (y * width + x) of its first pixel in
+ * the scan order, so the labels don't depend on the number of threads.
+ * A component is "seeded" if it contains at least one seed pixel, this is the
+ * hysteresis used by the flood fill and the canny filter.
+ *
+ * @tparam Allocator allocator of the labels (one label per pixel)
+ */
+template<template<class> class Allocator = std::allocator>
+class component_labelling
+{
+public:
+	typedef boost::uint32_t Label;
+	/// @brief Label of the background pixels.
+	static const Label kNoLabel = 0xffffffffu;
+
+	component_labelling()
+	: _width( 0 )
+	, _height( 0 )
+	{}
+
+	std::ptrdiff_t width() const { return _width; }
+	std::ptrdiff_t height() const { return _height; }
+
+	/**
+	 * @brief Label the connected components of @p view.
+	 *
+	 * @tparam Connexity neighbourhood of the pixels: Connexity::x is 0 for 4 neighbours, 1 for 8 neighbours
+	 * @param[in] foreground test of the pixels to label, applied on the first channel
+	 * @param[in] seed test of the seed pixels, applied on the first channel of the foreground pixels
+	 * @param[in] executor threads of the labelling, see terry::algorithm::thread_group_executor
+	 */
+	template<class Connexity, class View, class ForegroundTest, class SeedTest, class Executor>
+	void compute( const View& view, const ForegroundTest& foreground, const SeedTest& seed, const Executor& executor )
+	{
+		_width = view.width();
+		_height = view.height();
+		_parent.assign( _width * _height, kNoLabel );
+		_seeded.assign( _width * _height, 0 );
+
+		// label each band independently
+		label_bands<Connexity, View, ForegroundTest, SeedTest> labelBands( *this, view, foreground, seed );
+		algorithm::for_each_band( _height, _width, labelBands, executor );
+
+		mergeBands<Connexity>();
+
+		// link each pixel to the root of its component
+		link_roots linkRoots( *this );
+		algorithm::for_each_band( _height, _width, linkRoots, executor );
+	}
+
+	template<class Connexity, class View, class ForegroundTest, class SeedTest>
+	void compute( const View& view, const ForegroundTest& foreground, const SeedTest& seed )
+	{
+		compute<Connexity>( view, foreground, seed, algorithm::thread_group_executor() );
+	}
+
+	/// @return true if the pixel is in a component
+	bool isForeground( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		return _parent[y * _width + x] != kNoLabel;
+	}
+
+	/// @return the label of the component of the pixel, kNoLabel for the background
+	Label getLabel( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		return _parent[y * _width + x];
+	}
+
+	/// @return true if the pixel is in a component containing a seed
+	bool isSeeded( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		const Label label = _parent[y * _width + x];
+		return label != kNoLabel && _seeded[label];
+	}
+
+private:
+	template<class Connexity, class View, class ForegroundTest, class SeedTest>
+	struct label_bands;
+	struct link_roots;
+	template<class Connexity, class View, class ForegroundTest, class SeedTest>
+	friend struct label_bands;
+	friend struct link_roots;
+
+	/**
+	 * @brief Root of the component of @p i, with path halving.
+	 * The parent of a pixel is always before it in the scan order.
+	 */
+	Label findRoot( Label i )
+	{
+		while( _parent[i] != i )
+		{
+			_parent[i] = _parent[_parent[i]];
+			i = _parent[i];
+		}
+		return i;
+	}
+
+	/**
+	 * @brief Merge the components of @p a and @p b.
+	 * The root of the merged component is the smallest of the roots, so the
+	 * root of a component labelled in a band stays in this band.
+	 * @return the root linked to the other root, kNoLabel if @p a and @p b are in the same component
+	 */
+	Label merge( const Label a, const Label b )
+	{
+		Label rootA = findRoot( a );
+		Label rootB = findRoot( b );
+		if( rootA == rootB )
+			return kNoLabel;
+		if( rootB < rootA )
+			std::swap( rootA, rootB );
+		_parent[rootB] = rootA;
+		_seeded[rootA] |= _seeded[rootB];
+		return rootB;
+	}
+
+	/// @brief First pass: label the rows [y1, y2) without looking at the other bands.
+	template<class Connexity, class View, class ForegroundTest, class SeedTest>
+	struct label_bands
+	{
+		component_labelling& _labelling;
+		const View& _view;
+		const ForegroundTest& _foreground;
+		const SeedTest& _seed;
+
+		label_bands( component_labelling& labelling, const View& view, const ForegroundTest& foreground, const SeedTest& seed )
+		: _labelling( labelling )
+		, _view( view )
+		, _foreground( foreground )
+		, _seed( seed )
+		{}
+
+		bool operator()( const std::size_t, const std::ptrdiff_t y1, const std::ptrdiff_t y2 )
+		{
+			const std::ptrdiff_t width = _labelling._width;
+			for( std::ptrdiff_t y = y1; y < y2; ++y )
+			{
+				typename View::x_iterator it = _view.row_begin( y );
+				for( std::ptrdiff_t x = 0; x < width; ++x, ++it )
+				{
+					if( ! _foreground( (*it)[0] ) )
+						continue;
+					const Label i = y * width + x;
+					_labelling._parent[i] = i;
+					_labelling._seeded[i] = _seed( (*it)[0] );
+					if( x > 0 && _labelling._parent[i - 1] != kNoLabel )
+						_labelling.merge( i, i - 1 );
+					if( y == y1 )
+						continue;
+					for( std::ptrdiff_t dx = -Connexity::x; dx <= Connexity::x; ++dx )
+					{
+						if( x + dx < 0 || x + dx >= width )
+							continue;
+						const Label j = i - width + dx;
+						if( _labelling._parent[j] != kNoLabel )
+							_labelling.merge( i, j );
+					}
+				}
+			}
+			// link each pixel to the root of its component in the band
+			for( Label i = y1 * width; i < Label( y2 * width ); ++i )
+			{
+				if( _labelling._parent[i] != kNoLabel )
+					_labelling._parent[i] = _labelling._parent[_labelling._parent[i]];
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief Second pass: merge the components across the borders of the bands.
+	 *
+	 * Only the roots of the bands are modified, the pixels still point to the
+	 * root of their band. The merged roots are then linked to the root of their
+	 * component, so each pixel is at most at two links from its root.
+	 */
+	template<class Connexity>
+	void mergeBands()
+	{
+		const std::ptrdiff_t bandHeight = algorithm::band_height( _height );
+		std::vector<Label> mergedRoots;
+		for( std::ptrdiff_t y = bandHeight; y < _height; y += bandHeight )
+		{
+			for( std::ptrdiff_t x = 0; x < _width; ++x )
+			{
+				const Label i = y * _width + x;
+				if( _parent[i] == kNoLabel )
+					continue;
+				for( std::ptrdiff_t dx = -Connexity::x; dx <= Connexity::x; ++dx )
+				{
+					if( x + dx < 0 || x + dx >= _width )
+						continue;
+					const Label j = i - _width + dx;
+					if( _parent[j] == kNoLabel )
+						continue;
+					const Label merged = merge( _parent[i], _parent[j] );
+					if( merged != kNoLabel )
+						mergedRoots.push_back( merged );
+				}
+			}
+		}
+		// in the scan order, the parent of a merged root is already linked to its root
+		std::sort( mergedRoots.begin(), mergedRoots.end() );
+		BOOST_FOREACH( const Label root, mergedRoots )
+		{
+			_parent[root] = _parent[_parent[root]];
+		}
+	}
+
+	/**
+	 * @brief Third pass: link each pixel to the root of its component.
+	 * A pixel of a band only reads the parent of the root of its band, which
+	 * is in the same band, or is a root of an other band, never modified.
+	 */
+	struct link_roots
+	{
+		component_labelling& _labelling;
+
+		explicit link_roots( component_labelling& labelling )
+		: _labelling( labelling )
+		{}
+
+		bool operator()( const std::size_t, const std::ptrdiff_t y1, const std::ptrdiff_t y2 )
+		{
+			const std::ptrdiff_t width = _labelling._width;
+			for( Label i = y1 * width; i < Label( y2 * width ); ++i )
+			{
+				const Label parent = _labelling._parent[i];
+				if( parent == kNoLabel )
+					continue;
+				const Label root = _labelling._parent[parent];
+				if( root != parent )
+					_labelling._parent[i] = root;
+			}
+			return false;
+		}
+	};
+
+private:
+	std::ptrdiff_t _width;
+	std::ptrdiff_t _height;
+	std::vector<Label, Allocator<Label> > _parent; ///< parent of each pixel in its component, the roots are their own parent
+	std::vector<unsigned char, Allocator<unsigned char> > _seeded; ///< valid on the roots
+};
+
+template<template<class> class Allocator>
+const typename component_labelling<Allocator>::Label component_labelling<Allocator>::kNoLabel;
+
+}
+}
+}
+
+#endif
@@ -20,6 +20,8 @@
 #include <algorithm>
 #include <vector>
 #include <functional>
+#include <cmath>
+#include <limits>
 
 
 namespace terry {
@@ -40,6 +42,51 @@ enum convolve_boundary_option  {
 
 namespace detail {
 
+/**
+ * @brief Index of the source value used outside of the source, depending on the boundary option.
+ * output_ignore and output_zero are considered as extend_zero.
+ * @return -1 for a zero
+ */
+inline std::ptrdiff_t boundary_index( const std::ptrdiff_t i, const std::ptrdiff_t size, const convolve_boundary_option option )
+{
+	if( i >= 0 && i < size )
+		return i;
+	switch( option )
+	{
+		case convolve_option_extend_mirror:
+		{
+			// same as correlate: the border value is repeated ( cba|abc|cba )
+			const std::ptrdiff_t period = 2 * size;
+			std::ptrdiff_t m = i % period;
+			if( m < 0 )
+				m += period;
+			return m < size ? m : period - 1 - m;
+		}
+		case convolve_option_extend_padded: // the source should already contain the margin
+		case convolve_option_extend_constant:
+			return std::min( std::max( i, std::ptrdiff_t( 0 ) ), size - 1 );
+		case convolve_option_extend_zero:
+		case convolve_option_output_ignore:
+		case convolve_option_output_zero:
+			break;
+	}
+	return -1;
+}
+
+/**
+ * @brief Convert an accumulated value to a channel, rounded and clamped for the integral channels.
+ */
+template<typename Channel>
+GIL_FORCEINLINE
+Channel channel_from_double( const double v )
+{
+	if( ! std::numeric_limits<Channel>::is_integer )
+		return static_cast<Channel>( v );
+	const double minValue = channel_traits<Channel>::min_value();
+	const double maxValue = channel_traits<Channel>::max_value();
+	return static_cast<Channel>( std::floor( std::min( std::max( v, minValue ), maxValue ) + 0.5 ) );
+}
+
 /// @ingroup PointModel
 template <typename T> GIL_FORCEINLINE
 bool operator>=(const point2<T>& p1, const point2<T>& p2) { return (p1.x>=p2.x && p1.y>=p2.y); }
@@ -0,0 +1,484 @@
+#ifndef _TERRY_FILTER_CORRELATE2D_HPP_
+#define _TERRY_FILTER_CORRELATE2D_HPP_
+
+#include "convolve.hpp"
+
+#include <terry/math/fft.hpp>
+#include <terry/algorithm/for_each_band.hpp>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/metafunctions.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace filter {
+
+/**
+ * @brief Cost of a butterfly of the FFT, relative to a multiply-add of the direct correlation.
+ * Measured on rgba32f images, it includes the copies of the blocks (the crossover is around 9x9 kernels).
+ */
+static const double kFftButterflyCost = 8.0;
+/// @brief Maximum size of the FFT along an axis, it bounds the memory used by each thread.
+static const std::size_t kFftMaxSize = 512;
+
+/**
+ * @brief 2D correlation kernel, not separable.
+ * kernel( x, y ) is applied on the source pixel ( x - center.x, y - center.y ).
+ */
+template<typename T>
+class kernel_2d
+{
+public:
+	typedef T value_type;
+
+public:
+	kernel_2d()
+	: _width( 0 )
+	, _height( 0 )
+	, _center( 0, 0 )
+	{}
+
+	/// @brief Null kernel, centered
+	kernel_2d( const std::size_t width, const std::size_t height )
+	: _width( width )
+	, _height( height )
+	, _center( width / 2, height / 2 )
+	, _values( width * height, T( 0 ) )
+	{}
+
+	std::size_t width() const { return _width; }
+	std::size_t height() const { return _height; }
+	bool empty() const { return _values.empty(); }
+
+	const point2<std::ptrdiff_t>& center() const { return _center; }
+	void set_center( const point2<std::ptrdiff_t>& center ) { _center = center; }
+
+	std::size_t left_size() const { return _center.x; }
+	std::size_t right_size() const { return _width - 1 - _center.x; }
+	std::size_t top_size() const { return _center.y; }
+	std::size_t bottom_size() const { return _height - 1 - _center.y; }
+
+	T& operator()( const std::size_t x, const std::size_t y ) { return _values[y * _width + x]; }
+	const T& operator()( const std::size_t x, const std::size_t y ) const { return _values[y * _width + x]; }
+
+	T sum() const
+	{
+		T s = 0;
+		for( std::size_t i = 0; i < _values.size(); ++i )
+			s += _values[i];
+		return s;
+	}
+
+	/// @brief Divide by the sum of the values, if not null
+	void normalize()
+	{
+		const T s = sum();
+		if( s == 0 )
+			return;
+		for( std::size_t i = 0; i < _values.size(); ++i )
+			_values[i] /= s;
+	}
+
+private:
+	std::size_t _width;
+	std::size_t _height;
+	point2<std::ptrdiff_t> _center;
+	std::vector<T> _values; ///< row major
+};
+
+/**
+ * @brief Number of multiply-adds per pixel and per channel of the direct correlation.
+ */
+inline double correlate_2d_direct_cost( const std::size_t kernelWidth, const std::size_t kernelHeight )
+{
+	return static_cast<double>( kernelWidth ) * kernelHeight;
+}
+
+/**
+ * @brief Size of the FFT giving the lowest cost per pixel for a kernel size.
+ *
+ * Each block of fftWidth * fftHeight values gives ( fftWidth - kernelWidth + 1 ) * ( fftHeight - kernelHeight + 1 )
+ * pixels. Each transform costs size * log2( size ) / 2 butterflies, there is a
+ * forward and an inverse transform for 2 channels.
+ *
+ * @return cost per pixel and per channel, in multiply-adds
+ */
+inline double correlate_2d_fft_size( const std::size_t kernelWidth, const std::size_t kernelHeight,
+                                     std::size_t& fftWidth, std::size_t& fftHeight )
+{
+	const std::size_t maxWidth = std::max( kFftMaxSize, math::next_power_of_2( 2 * kernelWidth ) );
+	const std::size_t maxHeight = std::max( kFftMaxSize, math::next_power_of_2( 2 * kernelHeight ) );
+	double bestCost = -1.0;
+	fftWidth = fftHeight = 0;
+	for( std::size_t w = math::next_power_of_2( kernelWidth ); w <= maxWidth; w *= 2 )
+	{
+		for( std::size_t h = math::next_power_of_2( kernelHeight ); h <= maxHeight; h *= 2 )
+		{
+			const double size = static_cast<double>( w ) * h;
+			const double pixels = static_cast<double>( w - kernelWidth + 1 ) * ( h - kernelHeight + 1 );
+			const double butterflies = size * math::log2_of_power_of_2( w * h ) / 2.0;
+			// 2 transforms and the product with the kernel, for 2 channels
+			const double cost = ( 2.0 * butterflies * kFftButterflyCost + size ) / ( 2.0 * pixels );
+			if( bestCost < 0 || cost < bestCost )
+			{
+				bestCost = cost;
+				fftWidth = w;
+				fftHeight = h;
+			}
+		}
+	}
+	return bestCost;
+}
+
+/**
+ * @brief The FFT is faster than the direct correlation for this kernel size.
+ */
+inline bool is_correlate_2d_fft_faster( const std::size_t kernelWidth, const std::size_t kernelHeight )
+{
+	std::size_t fftWidth, fftHeight;
+	return correlate_2d_fft_size( kernelWidth, kernelHeight, fftWidth, fftHeight ) < correlate_2d_direct_cost( kernelWidth, kernelHeight );
+}
+
+/**
+ * @brief Spectrum of a kernel_2d, for correlate_2d_fft.
+ *
+ * It only depends on the kernel, so it is computed once and shared by all
+ * the tiles and threads.
+ */
+template<typename T>
+class fft_correlation_kernel
+{
+public:
+	typedef std::complex<T> Complex;
+
+public:
+	fft_correlation_kernel()
+	: _kernelWidth( 0 )
+	, _kernelHeight( 0 )
+	, _center( 0, 0 )
+	{}
+
+	template<typename K>
+	explicit fft_correlation_kernel( const kernel_2d<K>& kernel )
+	{
+		reset( kernel );
+	}
+
+	template<typename K>
+	void reset( const kernel_2d<K>& kernel )
+	{
+		_kernelWidth = kernel.width();
+		_kernelHeight = kernel.height();
+		_center = kernel.center();
+		std::size_t fftWidth, fftHeight;
+		correlate_2d_fft_size( _kernelWidth, _kernelHeight, fftWidth, fftHeight );
+		_planX.reset( fftWidth );
+		_planY.reset( fftHeight );
+
+		// a convolution by the flipped kernel is a correlation by the kernel
+		_spectrum.assign( fftWidth * fftHeight, Complex( 0 ) );
+		for( std::size_t y = 0; y < _kernelHeight; ++y )
+			for( std::size_t x = 0; x < _kernelWidth; ++x )
+				_spectrum[y * fftWidth + x] = Complex( static_cast<T>( kernel( _kernelWidth - 1 - x, _kernelHeight - 1 - y ) ) );
+		std::vector<Complex> column;
+		math::fft_2d( &_spectrum[0], _planX, _planY, false, column );
+	}
+
+	std::size_t kernel_width() const { return _kernelWidth; }
+	std::size_t kernel_height() const { return _kernelHeight; }
+	const point2<std::ptrdiff_t>& center() const { return _center; }
+
+	const math::fft_plan<T>& plan_x() const { return _planX; }
+	const math::fft_plan<T>& plan_y() const { return _planY; }
+	const std::vector<Complex>& spectrum() const { return _spectrum; }
+
+	/// @brief Number of pixels computed by each block along each axis.
+	std::size_t block_width() const { return _planX.size() - _kernelWidth + 1; }
+	std::size_t block_height() const { return _planY.size() - _kernelHeight + 1; }
+
+private:
+	std::size_t _kernelWidth;
+	std::size_t _kernelHeight;
+	point2<std::ptrdiff_t> _center;
+	math::fft_plan<T> _planX;
+	math::fft_plan<T> _planY;
+	std::vector<Complex> _spectrum;
+};
+
+/**
+ * @brief Direct 2D correlation.
+ * @ingroup ImageAlgorithms
+ *
+ * @param dst_tl topleft point of dst in src coordinates
+ * @param option values outside of the source (output_ignore and output_zero are considered as extend_zero)
+ */
+template <typename SrcView, typename Kernel, typename DstView>
+void correlate_2d_direct( const SrcView& src, const kernel_2d<Kernel>& kernel, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                          const convolve_boundary_option option = convolve_option_extend_zero )
+{
+	typedef typename channel_type<DstView>::type DstChannel;
+	const std::ptrdiff_t nbChannels = num_channels<DstView>::value;
+	const std::ptrdiff_t width = dst.width();
+	const std::ptrdiff_t kw = kernel.width();
+	const std::ptrdiff_t kh = kernel.height();
+	if( width == 0 || kw == 0 || kh == 0 )
+		return;
+
+	std::vector<std::ptrdiff_t> xIndices( width + kw - 1 );
+	for( std::ptrdiff_t i = 0; i < width + kw - 1; ++i )
+		xIndices[i] = detail::boundary_index( dst_tl.x - kernel.center().x + i, src.width(), option );
+
+	std::vector<double> line( ( width + kw - 1 ) * nbChannels );
+	std::vector<double> acc( width * nbChannels );
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+	{
+		std::fill( acc.begin(), acc.end(), 0.0 );
+		for( std::ptrdiff_t j = 0; j < kh; ++j )
+		{
+			const std::ptrdiff_t sy = detail::boundary_index( dst_tl.y + y - kernel.center().y + j, src.height(), option );
+			if( sy < 0 )
+				continue;
+			const typename SrcView::x_iterator srcIt = src.row_begin( sy );
+			for( std::ptrdiff_t i = 0; i < width + kw - 1; ++i )
+				for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+					line[i * nbChannels + c] = xIndices[i] < 0 ? 0.0 : static_cast<double>( srcIt[xIndices[i]][c] );
+
+			for( std::ptrdiff_t i = 0; i < kw; ++i )
+			{
+				const double k = kernel( i, j );
+				if( k == 0 )
+					continue;
+				const double* l = &line[i * nbChannels];
+				for( std::ptrdiff_t n = 0; n < width * nbChannels; ++n )
+					acc[n] += k * l[n];
+			}
+		}
+		const typename DstView::x_iterator dstIt = dst.row_begin( y );
+		for( std::ptrdiff_t x = 0; x < width; ++x )
+			for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+				dstIt[x][c] = detail::channel_from_double<DstChannel>( acc[x * nbChannels + c] );
+	}
+}
+
+namespace detail {
+
+/**
+ * @brief Blocks of the destination computed by the FFT, shared by the threads.
+ *
+ * Overlap-save: each block of the source, with the margins of the kernel, is
+ * transformed, multiplied by the spectrum of the kernel and transformed
+ * back. The values wrapped around by the circular convolution are dropped.
+ * The channels are computed by pairs, as the real and imaginary parts.
+ */
+template<typename T, typename SrcView, typename DstView>
+class fft_correlation_blocks
+{
+public:
+	typedef std::complex<T> Complex;
+	typedef typename channel_type<DstView>::type DstChannel;
+
+public:
+	fft_correlation_blocks( const SrcView& src, const fft_correlation_kernel<T>& kernel, const DstView& dst,
+	                        const typename SrcView::point_t& dst_tl, const convolve_boundary_option option )
+	: _src( src )
+	, _kernel( kernel )
+	, _dst( dst )
+	, _dst_tl( dst_tl )
+	, _option( option )
+	, _nbBlocksX( ( dst.width() + kernel.block_width() - 1 ) / kernel.block_width() )
+	, _nbBlocks( _nbBlocksX * ( ( dst.height() + kernel.block_height() - 1 ) / kernel.block_height() ) )
+	, _nextBlock( 0 )
+	{}
+
+	std::size_t nbBlocks() const { return _nbBlocks; }
+
+	/// @brief Compute the next blocks until there is no more block.
+	void run()
+	{
+		try
+		{
+			const std::ptrdiff_t fftWidth = _kernel.plan_x().size();
+			const std::ptrdiff_t fftHeight = _kernel.plan_y().size();
+			std::vector<Complex> buffer( fftWidth * fftHeight );
+			std::vector<Complex> column;
+			std::vector<std::ptrdiff_t> xIndices( fftWidth );
+			std::size_t block;
+			while( nextBlock( block ) )
+				processBlock( block, buffer, column, xIndices );
+		}
+		catch( ... )
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			if( ! _error )
+				_error = boost::current_exception();
+			_nextBlock = _nbBlocks;
+		}
+	}
+
+	/// @brief Rethrow the first error of the threads.
+	void rethrow() const
+	{
+		if( _error )
+			boost::rethrow_exception( _error );
+	}
+
+private:
+	bool nextBlock( std::size_t& block )
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		if( _nextBlock == _nbBlocks )
+			return false;
+		block = _nextBlock++;
+		return true;
+	}
+
+	void processBlock( const std::size_t block, std::vector<Complex>& buffer, std::vector<Complex>& column, std::vector<std::ptrdiff_t>& xIndices )
+	{
+		const std::ptrdiff_t nbChannels = num_channels<DstView>::value;
+		const std::ptrdiff_t fftWidth = _kernel.plan_x().size();
+		const std::ptrdiff_t kw = _kernel.kernel_width();
+		const std::ptrdiff_t kh = _kernel.kernel_height();
+		const std::ptrdiff_t bx = ( block % _nbBlocksX ) * _kernel.block_width();
+		const std::ptrdiff_t by = ( block / _nbBlocksX ) * _kernel.block_height();
+		const std::ptrdiff_t bw = std::min( std::ptrdiff_t( _kernel.block_width() ), _dst.width() - bx );
+		const std::ptrdiff_t bh = std::min( std::ptrdiff_t( _kernel.block_height() ), _dst.height() - by );
+		// source values used by the block
+		const std::ptrdiff_t inWidth = bw + kw - 1;
+		const std::ptrdiff_t inHeight = bh + kh - 1;
+
+		for( std::ptrdiff_t p = 0; p < inWidth; ++p )
+			xIndices[p] = boundary_index( _dst_tl.x + bx - _kernel.center().x + p, _src.width(), _option );
+
+		for( std::ptrdiff_t c0 = 0; c0 < nbChannels; c0 += 2 )
+		{
+			const std::ptrdiff_t c1 = c0 + 1;
+			std::fill( buffer.begin(), buffer.end(), Complex( 0 ) );
+			for( std::ptrdiff_t q = 0; q < inHeight; ++q )
+			{
+				const std::ptrdiff_t sy = boundary_index( _dst_tl.y + by - _kernel.center().y + q, _src.height(), _option );
+				if( sy < 0 )
+					continue;
+				const typename SrcView::x_iterator srcIt = _src.row_begin( sy );
+				Complex* const row = &buffer[q * fftWidth];
+				for( std::ptrdiff_t p = 0; p < inWidth; ++p )
+				{
+					if( xIndices[p] < 0 )
+						continue;
+					const T re = static_cast<T>( srcIt[xIndices[p]][c0] );
+					const T im = c1 < nbChannels ? static_cast<T>( srcIt[xIndices[p]][c1] ) : T( 0 );
+					row[p] = Complex( re, im );
+				}
+			}
+
+			math::fft_2d( &buffer[0], _kernel.plan_x(), _kernel.plan_y(), false, column );
+			const std::vector<Complex>& spectrum = _kernel.spectrum();
+			for( std::size_t i = 0; i < buffer.size(); ++i )
+			{
+				const Complex& a = buffer[i];
+				const Complex& b = spectrum[i];
+				buffer[i] = Complex( a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() );
+			}
+			math::fft_2d( &buffer[0], _kernel.plan_x(), _kernel.plan_y(), true, column );
+
+			for( std::ptrdiff_t t = 0; t < bh; ++t )
+			{
+				const typename DstView::x_iterator dstIt = _dst.row_begin( by + t ) + bx;
+				const Complex* const row = &buffer[( t + kh - 1 ) * fftWidth + kw - 1];
+				for( std::ptrdiff_t s = 0; s < bw; ++s )
+				{
+					dstIt[s][c0] = detail::channel_from_double<DstChannel>( row[s].real() );
+					if( c1 < nbChannels )
+						dstIt[s][c1] = detail::channel_from_double<DstChannel>( row[s].imag() );
+				}
+			}
+		}
+	}
+
+private:
+	const SrcView& _src;
+	const fft_correlation_kernel<T>& _kernel;
+	const DstView& _dst;
+	const typename SrcView::point_t _dst_tl;
+	const convolve_boundary_option _option;
+	const std::size_t _nbBlocksX;
+	const std::size_t _nbBlocks;
+
+	boost::mutex _mutex;
+	std::size_t _nextBlock; ///< protected by _mutex
+	boost::exception_ptr _error; ///< protected by _mutex
+};
+
+}
+
+/**
+ * @brief 2D correlation in the frequency domain.
+ * @ingroup ImageAlgorithms
+ *
+ * The same result as correlate_2d_direct (within the float precision), with a
+ * cost per pixel growing with the log of the kernel size. The destination is
+ * computed by blocks (overlap-save), the memory used only depends on the
+ * size of the FFT (see kFftMaxSize).
+ *
+ * @param dst_tl topleft point of dst in src coordinates
+ * @param executor threads computing the blocks, see terry::algorithm::thread_group_executor
+ */
+template <typename T, typename SrcView, typename DstView, typename Executor>
+void correlate_2d_fft( const SrcView& src, const fft_correlation_kernel<T>& kernel, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                       const convolve_boundary_option option, const Executor& executor )
+{
+	if( dst.width() == 0 || dst.height() == 0 || kernel.kernel_width() == 0 || kernel.kernel_height() == 0 )
+		return;
+
+	typedef detail::fft_correlation_blocks<T, SrcView, DstView> Blocks;
+	Blocks blocks( src, kernel, dst, dst_tl, option );
+	executor( blocks, std::max( std::min( executor.nbThreads(), blocks.nbBlocks() ), std::size_t( 1 ) ) );
+	blocks.rethrow();
+}
+
+/// @brief 2D correlation in the frequency domain, on the current thread.
+template <typename T, typename SrcView, typename DstView>
+void correlate_2d_fft( const SrcView& src, const fft_correlation_kernel<T>& kernel, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                       const convolve_boundary_option option = convolve_option_extend_zero )
+{
+	correlate_2d_fft( src, kernel, dst, dst_tl, option, algorithm::thread_group_executor( 1 ) );
+}
+
+/**
+ * @brief 2D correlation, in the frequency domain for the big kernels.
+ * @ingroup ImageAlgorithms
+ * @see is_correlate_2d_fft_faster
+ */
+template <typename SrcView, typename Kernel, typename DstView, typename Executor>
+void correlate_2d_auto( const SrcView& src, const kernel_2d<Kernel>& kernel, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                        const convolve_boundary_option option, const Executor& executor )
+{
+	if( is_correlate_2d_fft_faster( kernel.width(), kernel.height() ) )
+	{
+		const fft_correlation_kernel<float> fftKernel( kernel );
+		correlate_2d_fft( src, fftKernel, dst, dst_tl, option, executor );
+	}
+	else
+	{
+		correlate_2d_direct( src, kernel, dst, dst_tl, option );
+	}
+}
+
+/// @brief 2D correlation, in the frequency domain for the big kernels, on the current thread.
+template <typename SrcView, typename Kernel, typename DstView>
+void correlate_2d_auto( const SrcView& src, const kernel_2d<Kernel>& kernel, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                        const convolve_boundary_option option = convolve_option_extend_zero )
+{
+	correlate_2d_auto( src, kernel, dst, dst_tl, option, algorithm::thread_group_executor( 1 ) );
+}
+
+}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef _TERRY_FILTER_FLOODFILL_HPP_
 #define _TERRY_FILTER_FLOODFILL_HPP_
 
+#include "connectedComponents.hpp"
+
 #include <terry/globals.hpp>
 #include <terry/draw/fill.hpp>
 #include <terry/basic_colors.hpp>
@@ -577,14 +579,94 @@ void flood_fill_bruteForce( const SView& srcView, const Rect<std::ssize_t>& srcR
 //	}
 }
 
+/**
+ * @brief Write the pixels of the @p labelling components containing a seed.
+ */
+template<class DView, template<class> class Allocator>
+struct fill_seeded_components
+{
+	typedef typename DView::value_type DPixel;
+
+	const connectedComponents::component_labelling<Allocator>& _labelling;
+	DView _dstView; ///< same size as the labelling
+	const DPixel _value;
+
+	fill_seeded_components( const connectedComponents::component_labelling<Allocator>& labelling, const DView& dstView, const DPixel& value )
+	: _labelling( labelling )
+	, _dstView( dstView )
+	, _value( value )
+	{}
+
+	bool operator()( const std::size_t, const std::ptrdiff_t y1, const std::ptrdiff_t y2 )
+	{
+		for( std::ptrdiff_t y = y1; y < y2; ++y )
+		{
+			typename DView::x_iterator it = _dstView.row_begin( y );
+			for( std::ptrdiff_t x = 0; x < _dstView.width(); ++x, ++it )
+			{
+				if( _labelling.isSeeded( x, y ) )
+					*it = _value;
+			}
+		}
+		return false;
+	}
+};
+
+/**
+ * @brief Flood fill an image, with 2 conditions, on multiple threads.
+ * The same result as flood_fill: fill all pixels respecting the soft condition
+ * if connected with a pixel respecting the strong condition.
+ * The pixels outside of the components are not modified.
+ *
+ * @param[in] executor threads of the flood fill, see terry::algorithm::thread_group_executor
+ *
+ * @see connectedComponents::component_labelling
+ */
+template<class Connexity, class StrongTest, class SoftTest, class SView, class DView, template<class> class Allocator, class Executor>
+void flood_fill_parallel( const SView& srcView, const Rect<std::ssize_t>& srcRod,
+                          DView& dstView, const Rect<std::ssize_t>& dstRod,
+                          const Rect<std::ssize_t>& procWindow,
+                          const StrongTest& strongTest, const SoftTest& softTest,
+                          const Executor& executor )
+{
+	typedef typename DView::value_type DPixel;
+
+	const std::ptrdiff_t width = procWindow.x2 - procWindow.x1;
+	const std::ptrdiff_t height = procWindow.y2 - procWindow.y1;
+	if( width <= 0 || height <= 0 )
+		return;
+
+	connectedComponents::component_labelling<Allocator> labelling;
+	labelling.template compute<Connexity>(
+		subimage_view( srcView, procWindow.x1 - srcRod.x1, procWindow.y1 - srcRod.y1, width, height ),
+		softTest, strongTest, executor );
+
+	fill_seeded_components<DView, Allocator> fill( labelling,
+		subimage_view( dstView, procWindow.x1 - dstRod.x1, procWindow.y1 - dstRod.y1, width, height ),
+		get_white<DPixel>() );
+	algorithm::for_each_band( height, width, fill, executor );
 }
 
+template<class Connexity, class StrongTest, class SoftTest, class SView, class DView, template<class> class Allocator>
+void flood_fill_parallel( const SView& srcView, const Rect<std::ssize_t>& srcRod,
+                          DView& dstView, const Rect<std::ssize_t>& dstRod,
+                          const Rect<std::ssize_t>& procWindow,
+                          const StrongTest& strongTest, const SoftTest& softTest )
+{
+	flood_fill_parallel<Connexity, StrongTest, SoftTest, SView, DView, Allocator>(
+		srcView, srcRod, dstView, dstRod, procWindow, strongTest, softTest,
+		algorithm::thread_group_executor() );
+}
 
-template<template<class> class Allocator, class SView, class DView>
+}
+
+
+template<template<class> class Allocator, class SView, class DView, class Executor>
 void applyFloodFill(
 	const SView& srcView,
 	      DView& dstView,
-	const double lowerThres, const double upperThres )
+	const double lowerThres, const double upperThres,
+	const Executor& executor )
 {
 	using namespace boost::gil;
 	using namespace terry::numeric;
@@ -610,15 +692,25 @@ void applyFloodFill(
 	if( isConstantImage )
 		return;
 	
-	floodFill::flood_fill<floodFill::Connexity4, floodFill::IsUpper<Scalar>, floodFill::IsUpper<Scalar>, SView, DView, Allocator>(
+	floodFill::flood_fill_parallel<floodFill::Connexity4, floodFill::IsUpper<Scalar>, floodFill::IsUpper<Scalar>, SView, DView, Allocator>(
 				srcView, getBounds<std::ptrdiff_t>(srcView),
 				dstView, getBounds<std::ptrdiff_t>(dstView),
 				rectangleReduce( getBounds<std::ptrdiff_t>(dstView), 1 ),
 				floodFill::IsUpper<Scalar>(upperThresR),
-				floodFill::IsUpper<Scalar>(lowerThresR)
+				floodFill::IsUpper<Scalar>(lowerThresR),
+				executor
 				);
 }
 
+template<template<class> class Allocator, class SView, class DView>
+void applyFloodFill(
+	const SView& srcView,
+	      DView& dstView,
+	const double lowerThres, const double upperThres )
+{
+	applyFloodFill<Allocator>( srcView, dstView, lowerThres, upperThres, algorithm::thread_group_executor() );
+}
+
 
 }
 }
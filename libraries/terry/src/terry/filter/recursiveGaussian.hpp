@@ -0,0 +1,332 @@
+#ifndef _TERRY_FILTER_RECURSIVEGAUSSIAN_HPP_
+#define _TERRY_FILTER_RECURSIVEGAUSSIAN_HPP_
+
+#include "convolve.hpp"
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/image.hpp>
+#include <boost/gil/image_view_factory.hpp>
+#include <boost/gil/algorithm.hpp>
+#include <boost/gil/metafunctions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace filter {
+
+/// @brief Relative error accepted on the initial values of the recursive gaussian, defines its margin.
+static const double kRecursiveGaussianTolerance = 1e-3;
+/// @brief Under this sigma, the recursive gaussian is less accurate, the sigma is clamped.
+static const double kRecursiveGaussianMinSigma = 0.5;
+/// @brief Number of box filters of the extended box approximation.
+static const std::size_t kExtendedBoxPasses = 3;
+
+/**
+ * @brief Third order recursive gaussian filter (Young, van Vliet).
+ *
+ * A causal and an anticausal pass with the poles of van Vliet, Young and
+ * Verbeek (1998). The poles are scaled so that the variance of the filter is
+ * exactly sigma^2. The cost per pixel doesn't depend on sigma, the difference
+ * with a gaussian is around 1% of its peak.
+ *
+ * The lines are filtered with a margin, the initial values of the passes are
+ * the steady state of the first and last values of the margin.
+ */
+struct recursive_gaussian
+{
+	double _sigma;
+	double _b; ///< gain of each pass
+	double _a[3]; ///< w[n] = b * x[n] - ( a0 * w[n-1] + a1 * w[n-2] + a2 * w[n-3] )
+	std::ptrdiff_t _margin;
+
+	/// @param sigma standard deviation in pixels, 0 for no filtering
+	explicit recursive_gaussian( const double sigma = 0 )
+	: _sigma( sigma )
+	, _b( 1.0 )
+	, _margin( 0 )
+	{
+		_a[0] = _a[1] = _a[2] = 0.0;
+		if( is_identity() )
+			return;
+		const double s = std::max( _sigma, kRecursiveGaussianMinSigma );
+
+		// the variance grows with the scale of the poles: bisection of the scale
+		double low = 0.0;
+		double high = s;
+		while( variance( high ) < s * s )
+			high *= 2.0;
+		for( int i = 0; i < 64; ++i )
+		{
+			const double mid = 0.5 * ( low + high );
+			if( variance( mid ) < s * s )
+				low = mid;
+			else
+				high = mid;
+		}
+		const double scale = 0.5 * ( low + high );
+
+		const std::complex<double> d1 = std::pow( pole1(), 1.0 / scale );
+		const double d3 = std::pow( pole3(), 1.0 / scale );
+		const double n1 = std::norm( d1 );
+		// ( 1 - z^-1 / d1 ) ( 1 - z^-1 / conj(d1) ) ( 1 - z^-1 / d3 )
+		_a[0] = - 2.0 * d1.real() / n1 - 1.0 / d3;
+		_a[1] = 1.0 / n1 + 2.0 * d1.real() / ( n1 * d3 );
+		_a[2] = - 1.0 / ( n1 * d3 );
+		_b = 1.0 + _a[0] + _a[1] + _a[2];
+
+		// the slowest pole gives the length of the influence of the initial values
+		const double slowest = std::min( std::abs( d1 ), d3 );
+		_margin = static_cast<std::ptrdiff_t>( std::ceil( scale * std::log( 1.0 / kRecursiveGaussianTolerance ) / std::log( slowest ) ) );
+	}
+
+	bool is_identity() const { return _sigma <= 0; }
+	std::ptrdiff_t margin() const { return _margin; }
+
+	/**
+	 * @brief Filter a line of interleaved channels in place.
+	 * @param line size * nbChannels values
+	 */
+	void operator()( std::vector<double>& line, std::vector<double>& /*tmp*/, const std::ptrdiff_t size, const std::ptrdiff_t nbChannels ) const
+	{
+		if( size == 0 )
+			return;
+		for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+		{
+			double* const first = &line[c];
+			const std::ptrdiff_t last = ( size - 1 ) * nbChannels;
+			// causal
+			double w1 = first[0], w2 = w1, w3 = w1;
+			for( std::ptrdiff_t i = 0; i <= last; i += nbChannels )
+			{
+				const double w = _b * first[i] - ( _a[0] * w1 + _a[1] * w2 + _a[2] * w3 );
+				first[i] = w;
+				w3 = w2; w2 = w1; w1 = w;
+			}
+			// anticausal
+			w1 = w2 = w3 = first[last];
+			for( std::ptrdiff_t i = last; i >= 0; i -= nbChannels )
+			{
+				const double w = _b * first[i] - ( _a[0] * w1 + _a[1] * w2 + _a[2] * w3 );
+				first[i] = w;
+				w3 = w2; w2 = w1; w1 = w;
+			}
+		}
+	}
+
+private:
+	/// @brief Poles for a sigma of 2
+	static std::complex<double> pole1() { return std::complex<double>( 1.41650, 1.00829 ); }
+	static double pole3() { return 1.86543; }
+
+	/// @brief Variance of the causal and anticausal passes, with the poles scaled by 1/scale
+	static double variance( const double scale )
+	{
+		const std::complex<double> d1 = std::pow( pole1(), 1.0 / scale );
+		const double d3 = std::pow( pole3(), 1.0 / scale );
+		const std::complex<double> v1 = 2.0 * d1 / ( ( d1 - 1.0 ) * ( d1 - 1.0 ) );
+		return 2.0 * v1.real() + 2.0 * d3 / ( ( d3 - 1.0 ) * ( d3 - 1.0 ) );
+	}
+};
+
+/**
+ * @brief Gaussian approximated by successive extended box filters (Gwosdek et al. 2011).
+ *
+ * An extended box is a box of radius r with a weight alpha < 1 on the 2
+ * next values, so the variance is continuous with sigma. Each pass is a
+ * running sum, the cost per pixel doesn't depend on sigma. After 3 passes
+ * the response is a piecewise quadratic, with exactly the variance sigma^2.
+ */
+struct extended_box_gaussian
+{
+	double _sigma;
+	std::ptrdiff_t _radius;
+	double _alpha;
+	double _norm; ///< 1 / ( 2r + 1 + 2alpha )
+
+	/// @param sigma standard deviation in pixels, 0 for no filtering
+	explicit extended_box_gaussian( const double sigma = 0 )
+	: _sigma( sigma )
+	, _radius( 0 )
+	, _alpha( 0.0 )
+	, _norm( 1.0 )
+	{
+		if( is_identity() )
+			return;
+		// variance of each pass
+		const double v = _sigma * _sigma / kExtendedBoxPasses;
+		// biggest box with a variance r(r+1)/3 lower than v
+		_radius = static_cast<std::ptrdiff_t>( std::floor( 0.5 * std::sqrt( 12.0 * v + 1.0 ) - 0.5 ) );
+		const double r = static_cast<double>( _radius );
+		_alpha = ( 2.0 * r + 1.0 ) * ( r * ( r + 1.0 ) / 3.0 - v ) / ( 2.0 * ( v - ( r + 1.0 ) * ( r + 1.0 ) ) );
+		_norm = 1.0 / ( 2.0 * r + 1.0 + 2.0 * _alpha );
+	}
+
+	bool is_identity() const { return _sigma <= 0; }
+	std::ptrdiff_t margin() const { return is_identity() ? 0 : kExtendedBoxPasses * ( _radius + 1 ); }
+
+	/**
+	 * @brief Filter a line of interleaved channels in place.
+	 * Only the values at more than margin() of the borders are valid.
+	 * @param line size * nbChannels values
+	 */
+	void operator()( std::vector<double>& line, std::vector<double>& tmp, const std::ptrdiff_t size, const std::ptrdiff_t nbChannels ) const
+	{
+		tmp.resize( line.size() );
+		const std::ptrdiff_t reach = _radius + 1;
+		for( std::size_t pass = 0; pass < kExtendedBoxPasses; ++pass )
+		{
+			// the valid values shrink of reach at each pass
+			const std::ptrdiff_t begin = ( pass + 1 ) * reach;
+			const std::ptrdiff_t end = size - begin;
+			for( std::ptrdiff_t c = 0; c < nbChannels; ++c )
+			{
+				const double* const src = &line[c];
+				double* const dst = &tmp[c];
+				if( begin >= end )
+					continue;
+				double sum = 0.0;
+				for( std::ptrdiff_t i = begin - _radius; i <= begin + _radius; ++i )
+					sum += src[i * nbChannels];
+				for( std::ptrdiff_t i = begin; i < end; ++i )
+				{
+					dst[i * nbChannels] = _norm * ( sum + _alpha * ( src[( i - reach ) * nbChannels] + src[( i + reach ) * nbChannels] ) );
+					sum += src[( i + reach ) * nbChannels] - src[( i - _radius ) * nbChannels];
+				}
+			}
+			line.swap( tmp );
+		}
+	}
+};
+
+namespace detail {
+
+/**
+ * @brief Filter a line of pixels with a recursive filter.
+ * @param src source line, with srcSize pixels
+ * @param dstBegin position of the first destination pixel in the source line
+ * @param dst destination line, with dstSize pixels
+ */
+template<typename DstChannel, typename Filter, typename SrcIt, typename DstIt>
+void recursive_filter_line( const Filter& filter,
+                            const SrcIt src, const std::ptrdiff_t srcSize,
+                            const DstIt dst, const std::ptrdiff_t dstBegin, const std::ptrdiff_t dstSize,
+                            const std::ptrdiff_t nbChannels, const convolve_boundary_option option,
+                            std::vector<double>& line, std::vector<double>& tmp )
+{
+	const std::ptrdiff_t margin = filter.margin();
+	const std::ptrdiff_t size = dstSize + 2 * margin;
+	line.resize( size * nbChannels );
+
+	std::vector<double>::iterator it = line.begin();
+	for( std::ptrdiff_t i = dstBegin - margin; i < dstBegin + dstSize + margin; ++i )
+	{
+		const std::ptrdiff_t index = boundary_index( i, srcSize, option );
+		for( std::ptrdiff_t c = 0; c < nbChannels; ++c, ++it )
+			*it = index < 0 ? 0.0 : static_cast<double>( src[index][c] );
+	}
+
+	filter( line, tmp, size, nbChannels );
+
+	it = line.begin() + margin * nbChannels;
+	for( std::ptrdiff_t i = 0; i < dstSize; ++i )
+	{
+		for( std::ptrdiff_t c = 0; c < nbChannels; ++c, ++it )
+			dst[i][c] = channel_from_double<DstChannel>( *it );
+	}
+}
+
+template<typename Filter, typename SrcView, typename DstView>
+void recursive_filter_rows( const Filter& filter, const SrcView& src, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                            const convolve_boundary_option option )
+{
+	typedef typename channel_type<DstView>::type DstChannel;
+	std::vector<double> line;
+	std::vector<double> tmp;
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+	{
+		recursive_filter_line<DstChannel>( filter, src.row_begin( y + dst_tl.y ), src.width(),
+		                                   dst.row_begin( y ), dst_tl.x, dst.width(),
+		                                   num_channels<DstView>::value, option, line, tmp );
+	}
+}
+
+template<typename Filter, typename SrcView, typename DstView>
+void recursive_filter_cols( const Filter& filter, const SrcView& src, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                            const convolve_boundary_option option )
+{
+	typedef typename channel_type<DstView>::type DstChannel;
+	std::vector<double> line;
+	std::vector<double> tmp;
+	for( std::ptrdiff_t x = 0; x < dst.width(); ++x )
+	{
+		recursive_filter_line<DstChannel>( filter, src.col_begin( x + dst_tl.x ), src.height(),
+		                                   dst.col_begin( x ), dst_tl.y, dst.height(),
+		                                   num_channels<DstView>::value, option, line, tmp );
+	}
+}
+
+}
+
+/**
+ * @brief Separable gaussian with a recursive filter on the rows and on the columns.
+ * @ingroup ImageAlgorithms
+ *
+ * Filter is recursive_gaussian or extended_box_gaussian. Like
+ * correlate_rows_cols, dst can be a tile of the image and the source is
+ * read at filter.margin() around dst. The values outside of the source
+ * depend on the boundary option (output_ignore and output_zero are
+ * considered as extend_zero).
+ *
+ * @param dst_tl topleft point of dst in src coordinates
+ */
+template <typename PixelAccum, template<typename> class Alloc, typename Filter, typename SrcView, typename DstView>
+void recursive_filter_rows_cols( const SrcView& src,
+                                 const Filter& filterX,
+                                 const Filter& filterY,
+                                 const DstView& dst,
+                                 const typename SrcView::point_t& dst_tl,
+                                 const convolve_boundary_option option = convolve_option_extend_zero )
+{
+	typedef typename DstView::point_t Point;
+	typedef typename DstView::coord_t Coord;
+	typedef image<PixelAccum, is_planar<DstView>::value, Alloc<unsigned char> > ImageAccum;
+
+	if( dst.width() == 0 || dst.height() == 0 )
+		return;
+
+	if( filterX.is_identity() && filterY.is_identity() )
+	{
+		copy_pixels( subimage_view( src, dst_tl, dst.dimensions() ), dst );
+	}
+	else if( filterY.is_identity() )
+	{
+		detail::recursive_filter_rows( filterX, src, dst, dst_tl, option );
+	}
+	else if( filterX.is_identity() )
+	{
+		detail::recursive_filter_cols( filterY, src, dst, dst_tl, option );
+	}
+	else
+	{
+		// rows of the source used by the columns pass
+		const Coord top_in = std::min( Coord( filterY.margin() ), dst_tl.y );
+		const Coord bottom_in = std::min( Coord( filterY.margin() ), src.height() - ( dst_tl.y + dst.height() ) );
+		const Point image_tmp_size( dst.width(), dst.height() + top_in + bottom_in );
+		const Point image_tmp_tl( dst_tl.x, dst_tl.y - top_in );
+
+		ImageAccum image_tmp( image_tmp_size );
+		typename ImageAccum::view_t view_tmp = view( image_tmp );
+
+		detail::recursive_filter_rows( filterX, src, view_tmp, image_tmp_tl, option );
+		detail::recursive_filter_cols( filterY, view_tmp, dst, Point( 0, top_in ), option );
+	}
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef _TERRY_MATH_FFT_HPP_
+#define _TERRY_MATH_FFT_HPP_
+
+#include <boost/assert.hpp>
+#include <boost/math/constants/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace math {
+
+inline bool is_power_of_2( const std::size_t n )
+{
+	return n != 0 && ( n & ( n - 1 ) ) == 0;
+}
+
+inline std::size_t next_power_of_2( const std::size_t n )
+{
+	std::size_t p = 1;
+	while( p < n )
+		p <<= 1;
+	return p;
+}
+
+inline std::size_t log2_of_power_of_2( std::size_t n )
+{
+	std::size_t l = 0;
+	while( n > 1 )
+	{
+		n >>= 1;
+		++l;
+	}
+	return l;
+}
+
+/**
+ * @brief Precomputed radix-2 FFT of a given size (power of 2).
+ *
+ * The twiddle factors and the bit reversal permutation are computed once,
+ * the transforms are in place and don't allocate, so a plan can be shared
+ * by multiple threads.
+ */
+template<typename T>
+class fft_plan
+{
+public:
+	typedef std::complex<T> Complex;
+
+public:
+	explicit fft_plan( const std::size_t size = 0 )
+	{
+		reset( size );
+	}
+
+	void reset( const std::size_t size )
+	{
+		BOOST_ASSERT( size == 0 || is_power_of_2( size ) );
+		_size = size;
+		_swaps.clear();
+		_twiddles.resize( size / 2 );
+		for( std::size_t k = 0; k < size / 2; ++k )
+		{
+			const double angle = -2.0 * boost::math::constants::pi<double>() * k / size;
+			_twiddles[k] = Complex( static_cast<T>( std::cos( angle ) ), static_cast<T>( std::sin( angle ) ) );
+		}
+		const std::size_t bits = log2_of_power_of_2( size );
+		for( std::size_t i = 0; i < size; ++i )
+		{
+			std::size_t r = 0;
+			for( std::size_t b = 0; b < bits; ++b )
+				r |= ( ( i >> b ) & 1 ) << ( bits - 1 - b );
+			if( i < r )
+			{
+				_swaps.push_back( i );
+				_swaps.push_back( r );
+			}
+		}
+	}
+
+	std::size_t size() const { return _size; }
+
+	/// @brief X[k] = sum( x[n] * exp( -2i.pi.k.n / size ) )
+	void forward( Complex* data ) const
+	{
+		transform( data, false );
+	}
+
+	/// @brief Inverse of forward (scaled by 1 / size)
+	void inverse( Complex* data ) const
+	{
+		transform( data, true );
+		const T scale = T( 1 ) / _size;
+		for( std::size_t i = 0; i < _size; ++i )
+			data[i] *= scale;
+	}
+
+private:
+	void transform( Complex* data, const bool inverse ) const
+	{
+		for( std::size_t i = 0; i < _swaps.size(); i += 2 )
+			std::swap( data[_swaps[i]], data[_swaps[i + 1]] );
+
+		for( std::size_t half = 1, step = _size / 2; half < _size; half *= 2, step /= 2 )
+		{
+			for( std::size_t block = 0; block < _size; block += 2 * half )
+			{
+				Complex* const a = data + block;
+				Complex* const b = a + half;
+				for( std::size_t k = 0; k < half; ++k )
+				{
+					// explicit complex product, std::complex checks for NaN and infinity
+					const Complex& w = _twiddles[k * step];
+					const T wi = inverse ? -w.imag() : w.imag();
+					const T re = b[k].real() * w.real() - b[k].imag() * wi;
+					const T im = b[k].real() * wi + b[k].imag() * w.real();
+					b[k] = Complex( a[k].real() - re, a[k].imag() - im );
+					a[k] = Complex( a[k].real() + re, a[k].imag() + im );
+				}
+			}
+		}
+	}
+
+private:
+	std::size_t _size;
+	std::vector<Complex> _twiddles; ///< exp( -2i.pi.k / size ) for k < size / 2
+	std::vector<std::size_t> _swaps; ///< pairs of indices of the bit reversal permutation
+};
+
+/**
+ * @brief 2D FFT of a row major buffer of width * height values.
+ * @param column scratch buffer, resized to height
+ */
+template<typename T>
+void fft_2d( std::complex<T>* data, const fft_plan<T>& planX, const fft_plan<T>& planY, const bool inverse,
+             std::vector<std::complex<T> >& column )
+{
+	const std::size_t width = planX.size();
+	const std::size_t height = planY.size();
+	for( std::size_t y = 0; y < height; ++y )
+	{
+		if( inverse )
+			planX.inverse( data + y * width );
+		else
+			planX.forward( data + y * width );
+	}
+	column.resize( height );
+	for( std::size_t x = 0; x < width; ++x )
+	{
+		for( std::size_t y = 0; y < height; ++y )
+			column[y] = data[y * width + x];
+		if( inverse )
+			planY.inverse( &column[0] );
+		else
+			planY.forward( &column[0] );
+		for( std::size_t y = 0; y < height; ++y )
+			data[y * width + x] = column[y];
+	}
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef _TERRY_SAMPLER_COORDINATE_MAP_HPP_
+#define	_TERRY_SAMPLER_COORDINATE_MAP_HPP_
+
+#include <terry/math/Rect.hpp>
+#include <terry/globals.hpp>
+
+#include <boost/gil/color_convert.hpp>
+#include <boost/gil/typedefs.hpp>
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace terry {
+namespace sampler {
+
+/**
+ * @brief Source position of each pixel of a destination region (STMap).
+ *
+ * Evaluating a geometric transformation (lens distortion, TPS, ...) for each pixel
+ * is often more expensive than the sampling itself. The map is computed once with
+ * fill_coordinate_map(), then used as the transformation of resample_pixels_progress()
+ * for all the images sharing the same transformation.
+ *
+ * The coordinates are stored in float: the precision is better than 1/1000 pixel
+ * for images up to 16K.
+ */
+template<typename F>
+class coordinate_map
+{
+public:
+	typedef F value_type;
+	typedef point2<F> point_t;
+
+public:
+	coordinate_map()
+		: _width( 0 )
+	{}
+
+	/**
+	 * @param region destination coordinates covered by the map
+	 */
+	explicit coordinate_map( const Rect<std::ssize_t>& region )
+		: _region( region )
+		, _width( region.x2 - region.x1 )
+		, _points( _width * ( region.y2 - region.y1 ) )
+	{}
+
+	const Rect<std::ssize_t>& region() const { return _region; }
+
+	bool contains( const Rect<std::ssize_t>& window ) const
+	{
+		return window.x1 >= _region.x1 && window.y1 >= _region.y1 &&
+		       window.x2 <= _region.x2 && window.y2 <= _region.y2;
+	}
+
+	/// @brief Memory used by the coordinates in bytes.
+	std::size_t memory_size() const { return _points.size() * sizeof( point_t ); }
+
+	/// @brief Source position of the destination pixel (x, y).
+	const point_t& operator()( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		BOOST_ASSERT( x >= _region.x1 && x < _region.x2 && y >= _region.y1 && y < _region.y2 );
+		return _points[ ( y - _region.y1 ) * _width + ( x - _region.x1 ) ];
+	}
+	point_t& operator()( const std::ptrdiff_t x, const std::ptrdiff_t y )
+	{
+		BOOST_ASSERT( x >= _region.x1 && x < _region.x2 && y >= _region.y1 && y < _region.y2 );
+		return _points[ ( y - _region.y1 ) * _width + ( x - _region.x1 ) ];
+	}
+
+private:
+	Rect<std::ssize_t> _region;
+	std::ptrdiff_t _width;
+	std::vector<point_t> _points;
+};
+
+/**
+ * @brief The map used as a transformation functor, the destination point must be inside the map region.
+ */
+template <typename F, typename F2>
+inline point2<F> transform( const coordinate_map<F>& map, const point2<F2>& dst )
+{
+	return map( dst.x, dst.y );
+}
+
+namespace details {
+
+template<typename F, typename F2>
+inline void assign_point( const point2<F2>& src, point2<F>& dst )
+{
+	dst.x = src.x;
+	dst.y = src.y;
+}
+
+}
+
+/**
+ * @brief Compute the source position of the destination pixels of @p window.
+ * Different windows of the same map could be filled in parallel.
+ */
+template<typename F, typename MapFn>
+void fill_coordinate_map( coordinate_map<F>& map, const MapFn& dst_to_src, const Rect<std::ssize_t>& window )
+{
+	BOOST_ASSERT( map.contains( window ) );
+	point2<std::ptrdiff_t> dst_p;
+	for( dst_p.y = window.y1; dst_p.y < window.y2; ++dst_p.y )
+	{
+		for( dst_p.x = window.x1; dst_p.x < window.x2; ++dst_p.x )
+		{
+			details::assign_point( transform( dst_to_src, dst_p ), map( dst_p.x, dst_p.y ) );
+		}
+	}
+}
+
+namespace details {
+
+/**
+ * @brief Fill a coordinate map by bilinear interpolation of the exact positions on an adaptive grid.
+ * The cells are subdivided where the interpolation differs from the transformation (high curvature).
+ */
+template<typename F, typename MapFn>
+class adaptive_grid_filler
+{
+public:
+	typedef point2<F> Point;
+
+	adaptive_grid_filler( coordinate_map<F>& map, const MapFn& dst_to_src, const double max_error )
+		: _map( map )
+		, _dst_to_src( dst_to_src )
+		, _max_error2( max_error * max_error )
+	{}
+
+	Point eval( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		Point p;
+		assign_point( transform( _dst_to_src, point2<std::ptrdiff_t>( x, y ) ), p );
+		return p;
+	}
+
+	/**
+	 * @brief Fill the pixels [x1, x2] x [y1, y2] (included).
+	 * @param p00, p10, p01, p11 exact positions of the corners (x1,y1) (x2,y1) (x1,y2) (x2,y2)
+	 */
+	void fill( const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+	           const Point& p00, const Point& p10, const Point& p01, const Point& p11 )
+	{
+		const std::ptrdiff_t w = x2 - x1;
+		const std::ptrdiff_t h = y2 - y1;
+		if( w <= 1 && h <= 1 )
+		{
+			// only corners
+			_map( x1, y1 ) = p00;
+			_map( x2, y1 ) = p10;
+			_map( x1, y2 ) = p01;
+			_map( x2, y2 ) = p11;
+			return;
+		}
+		const std::ptrdiff_t xm = x1 + w / 2;
+		const std::ptrdiff_t ym = y1 + h / 2;
+		const double fx = w ? double( xm - x1 ) / w : 0.0;
+		const double fy = h ? double( ym - y1 ) / h : 0.0;
+
+		// exact positions at the middle of the edges and at the center
+		const Point pm0 = eval( xm, y1 );
+		const Point pm1 = eval( xm, y2 );
+		const Point p0m = eval( x1, ym );
+		const Point p1m = eval( x2, ym );
+		const Point pmm = eval( xm, ym );
+
+		if( distance2( pm0, lerp( p00, p10, fx ) ) <= _max_error2 &&
+		    distance2( pm1, lerp( p01, p11, fx ) ) <= _max_error2 &&
+		    distance2( p0m, lerp( p00, p01, fy ) ) <= _max_error2 &&
+		    distance2( p1m, lerp( p10, p11, fy ) ) <= _max_error2 &&
+		    distance2( pmm, lerp( lerp( p00, p10, fx ), lerp( p01, p11, fx ), fy ) ) <= _max_error2 )
+		{
+			interpolate( x1, y1, x2, y2, p00, p10, p01, p11 );
+			return;
+		}
+
+		if( w > 1 && h > 1 )
+		{
+			fill( x1, y1, xm, ym, p00, pm0, p0m, pmm );
+			fill( xm, y1, x2, ym, pm0, p10, pmm, p1m );
+			fill( x1, ym, xm, y2, p0m, pmm, p01, pm1 );
+			fill( xm, ym, x2, y2, pmm, p1m, pm1, p11 );
+		}
+		else if( w > 1 )
+		{
+			fill( x1, y1, xm, y2, p00, pm0, p01, pm1 );
+			fill( xm, y1, x2, y2, pm0, p10, pm1, p11 );
+		}
+		else
+		{
+			fill( x1, y1, x2, ym, p00, p10, p0m, p1m );
+			fill( x1, ym, x2, y2, p0m, p1m, p01, p11 );
+		}
+	}
+
+private:
+	static Point lerp( const Point& a, const Point& b, const double t )
+	{
+		return Point( a.x + ( b.x - a.x ) * t, a.y + ( b.y - a.y ) * t );
+	}
+
+	static double distance2( const Point& a, const Point& b )
+	{
+		const double dx = a.x - b.x;
+		const double dy = a.y - b.y;
+		return dx * dx + dy * dy;
+	}
+
+	void interpolate( const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+	                  const Point& p00, const Point& p10, const Point& p01, const Point& p11 )
+	{
+		const double w = x2 - x1;
+		const double h = y2 - y1;
+		for( std::ptrdiff_t y = y1; y <= y2; ++y )
+		{
+			const double fy = h ? ( y - y1 ) / h : 0.0;
+			const Point left = lerp( p00, p01, fy );
+			const Point right = lerp( p10, p11, fy );
+			for( std::ptrdiff_t x = x1; x <= x2; ++x )
+			{
+				_map( x, y ) = lerp( left, right, w ? ( x - x1 ) / w : 0.0 );
+			}
+		}
+	}
+
+private:
+	coordinate_map<F>& _map;
+	const MapFn& _dst_to_src;
+	const double _max_error2;
+};
+
+}
+
+/**
+ * @brief Approximate the source position of the destination pixels of @p window
+ * for smooth transformations (TPS, lens distortions...).
+ *
+ * The transformation is evaluated on a grid of @p cell_size pixels, and the cells are
+ * subdivided until the bilinear interpolation of their corners differs by less than
+ * @p max_error pixels from the transformation at the middle of the edges and at the center.
+ * Different windows of the same map could be filled in parallel.
+ *
+ * @param max_error maximum distance in pixels between the interpolated and the exact positions
+ * @param cell_size size of the initial cells
+ */
+template<typename F, typename MapFn>
+void fill_coordinate_map_adaptive( coordinate_map<F>& map, const MapFn& dst_to_src, const Rect<std::ssize_t>& window, const double max_error, const std::ptrdiff_t cell_size = 32 )
+{
+	BOOST_ASSERT( map.contains( window ) );
+	BOOST_ASSERT( cell_size > 0 );
+	if( window.x2 <= window.x1 || window.y2 <= window.y1 )
+		return;
+
+	typedef typename details::adaptive_grid_filler<F, MapFn>::Point Point;
+	details::adaptive_grid_filler<F, MapFn> filler( map, dst_to_src, max_error );
+	const std::ptrdiff_t xLast = window.x2 - 1;
+	const std::ptrdiff_t yLast = window.y2 - 1;
+	// the cells share their borders
+	for( std::ptrdiff_t y1 = window.y1; ; y1 += cell_size )
+	{
+		const std::ptrdiff_t y2 = std::min( y1 + cell_size, yLast );
+		Point p00 = filler.eval( window.x1, y1 );
+		Point p01 = filler.eval( window.x1, y2 );
+		for( std::ptrdiff_t x1 = window.x1; ; x1 += cell_size )
+		{
+			const std::ptrdiff_t x2 = std::min( x1 + cell_size, xLast );
+			const Point p10 = filler.eval( x2, y1 );
+			const Point p11 = filler.eval( x2, y2 );
+			filler.fill( x1, y1, x2, y2, p00, p10, p01, p11 );
+			if( x2 == xLast )
+				break;
+			p00 = p10;
+			p01 = p11;
+		}
+		if( y2 == yLast )
+			break;
+	}
+}
+
+/**
+ * @brief Export the map as an image, with the usual STMap convention:
+ * red and green contain the source position normalized by the source size
+ * (0 and 1 on the source borders), blue is 0 and alpha is 1.
+ * Only float views keep the precision of the coordinates.
+ *
+ * @param dst_view view in the destination coordinates of the map
+ * @param window pixels to export, inside the map region
+ * @param src_size size of the source image (in pixels)
+ */
+template<typename F, typename DstView>
+void coordinate_map_to_view( const coordinate_map<F>& map, const DstView& dst_view, const Rect<std::ssize_t>& window, const point2<double>& src_size )
+{
+	BOOST_ASSERT( map.contains( window ) );
+	for( std::ptrdiff_t y = window.y1; y < window.y2; ++y )
+	{
+		typename DstView::x_iterator it = dst_view.row_begin( y ) + window.x1;
+		for( std::ptrdiff_t x = window.x1; x < window.x2; ++x, ++it )
+		{
+			// integer coordinates are the pixel centers
+			const point2<F>& p = map( x, y );
+			const rgba32f_pixel_t st( ( p.x + 0.5 ) / src_size.x, ( p.y + 0.5 ) / src_size.y, 0.0f, 1.0f );
+			color_convert( st, *it );
+		}
+	}
+}
+
+/**
+ * @brief Import a map from an STMap image, the inverse of coordinate_map_to_view().
+ *
+ * @param src_view STMap image in the destination coordinates of the map, covering the map region
+ * @param src_size size of the image which will be resampled with the map (in pixels)
+ */
+template<typename F, typename SrcView>
+void view_to_coordinate_map( const SrcView& src_view, coordinate_map<F>& map, const point2<double>& src_size )
+{
+	const Rect<std::ssize_t>& region = map.region();
+	BOOST_ASSERT( src_view.width() >= region.x2 && src_view.height() >= region.y2 );
+	rgba32f_pixel_t st;
+	for( std::ptrdiff_t y = region.y1; y < region.y2; ++y )
+	{
+		typename SrcView::x_iterator it = src_view.row_begin( y ) + region.x1;
+		for( std::ptrdiff_t x = region.x1; x < region.x2; ++x, ++it )
+		{
+			color_convert( *it, st );
+			map( x, y ) = point2<F>( get_color( st, red_t() ) * src_size.x - 0.5, get_color( st, green_t() ) * src_size.y - 0.5 );
+		}
+	}
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+#define	_TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+
+#include <terry/math/Rect.hpp>
+#include <terry/geometry/affine.hpp>
+#include <terry/basic_colors.hpp>
+#include <terry/globals.hpp>
+
+#include <terry/sampler/details.hpp>
+#include <terry/sampler/sampler.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace terry {
+namespace sampler {
+
+/**
+ * @brief The separable resampling supports only scales and translations,
+ * and doesn't implement the mirror mode.
+ */
+template<typename T>
+inline bool is_separable_transform( const matrix3x2<T>& dst_to_src, const EParamFilterOutOfImage outOfImageProcess )
+{
+	return dst_to_src.b == 0 && dst_to_src.c == 0 && outOfImageProcess != eParamFilterOutMirror;
+}
+
+/// @brief Maximum number of source rows filtered horizontally and kept for the vertical pass.
+static const std::size_t kSeparableScratchRows = 1024;
+
+namespace details {
+
+/**
+ * @brief Filter taps along one axis, for each destination coordinate.
+ * The same weights as sample(), computed once per row and per column.
+ */
+template<typename Weight>
+struct axis_filter
+{
+	static const std::ptrdiff_t outside = -1; ///< tap outside of the source image
+
+	std::size_t _windowSize;
+	std::vector<std::ptrdiff_t> _indices; ///< source coordinate of each tap
+	std::vector<Weight> _weights; ///< weight of each tap
+
+	/**
+	 * @param scale, translate source coordinate of the destination coordinate x: scale * x + translate
+	 * @param dstBegin, dstEnd destination coordinates
+	 * @param srcSize size of the source along this axis
+	 */
+	template<typename Sampler>
+	void compute( Sampler& sampler, const double scale, const double translate,
+	              const std::ptrdiff_t dstBegin, const std::ptrdiff_t dstEnd,
+	              const std::ptrdiff_t srcSize, const EParamFilterOutOfImage outOfImageProcess )
+	{
+		_windowSize = sampler._windowSize;
+		const std::size_t nbTaps = _windowSize * std::max( dstEnd - dstBegin, std::ptrdiff_t(0) );
+		_indices.resize( nbTaps );
+		_weights.resize( nbTaps );
+
+		const std::ptrdiff_t middlePosition = std::floor( ( _windowSize - 1.0 ) * 0.5 );
+		std::size_t tap = 0;
+		for( std::ptrdiff_t dst = dstBegin; dst < dstEnd; ++dst )
+		{
+			const double src = scale * dst + translate;
+			const std::ptrdiff_t srcTL = std::floor( src );
+			const RESAMPLING_CORE_TYPE frac = src - srcTL;
+			for( std::size_t i = 0; i < _windowSize; ++i, ++tap )
+			{
+				const RESAMPLING_CORE_TYPE distance = - frac - middlePosition + i;
+				sampler( distance, _weights[tap] );
+
+				std::ptrdiff_t index = srcTL - middlePosition + i;
+				if( index < 0 || index >= srcSize )
+				{
+					if( outOfImageProcess == eParamFilterOutCopy )
+						index = std::min( std::max( index, std::ptrdiff_t(0) ), srcSize - 1 );
+					else
+						index = outside;
+				}
+				_indices[tap] = index;
+			}
+		}
+	}
+};
+
+template<typename Weight>
+const std::ptrdiff_t axis_filter<Weight>::outside;
+
+}
+
+/**
+ * @brief Resample with a scale and a translation as two separable passes.
+ * @ingroup ImageAlgorithms
+ *
+ * Gives the same result as resample_pixels_progress, but the filter weights
+ * are computed once per row and per column, the source rows are filtered
+ * horizontally into a scratch buffer, and then filtered vertically.
+ * There is no allocation per pixel.
+ *
+ * @pre is_separable_transform( dst_to_src, outOfImageProcess )
+ */
+template<
+	typename Sampler, // Models SamplerConcept
+	typename SrcView, // Models RandomAccess2DImageViewConcept
+	typename DstView, // Models MutableRandomAccess2DImageViewConcept
+	typename Progress>
+void resample_pixels_separable_progress(
+	const SrcView& src_view, const DstView& dst_view,
+	const matrix3x2<double>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler() )
+{
+	typedef typename SrcView::value_type                     SrcP;
+	typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+	typedef typename boost::gil::bits64f                     Weight;
+	typedef details::axis_filter<Weight>                     AxisFilter;
+
+	BOOST_ASSERT( is_separable_transform( dst_to_src, outOfImageProcess ) );
+
+	const terry::point2<std::ssize_t> procWindowSize = procWindow.size();
+	if( procWindowSize.x <= 0 || procWindowSize.y <= 0 )
+		return;
+	const std::ptrdiff_t srcWidth = src_view.width();
+	const std::ptrdiff_t srcHeight = src_view.height();
+
+	AxisFilter xFilter;
+	AxisFilter yFilter;
+	xFilter.compute( sampler, dst_to_src.a, dst_to_src.e, procWindow.x1, procWindow.x2, srcWidth, outOfImageProcess );
+	yFilter.compute( sampler, dst_to_src.d, dst_to_src.f, procWindow.y1, procWindow.y2, srcHeight, outOfImageProcess );
+
+	SrcC outsideValue( 0 );
+	if( outOfImageProcess == eParamFilterOutBlack )
+		outsideValue = get_black<SrcC>();
+
+	// The destination rows are processed by bands, only the source rows used
+	// by a band are filtered horizontally, into the scratch buffer.
+	const std::ptrdiff_t bandHeight = std::max( std::ptrdiff_t( kSeparableScratchRows / yFilter._windowSize ), std::ptrdiff_t(1) );
+	std::vector<std::ptrdiff_t> rowSlots( srcHeight, AxisFilter::outside ); ///< row of the scratch buffer for each source row
+	std::vector<std::ptrdiff_t> bandRows; ///< source rows used by the band
+	std::vector<SrcC> scratch;
+
+	for( std::ptrdiff_t bandBegin = 0; bandBegin < procWindowSize.y; bandBegin += bandHeight )
+	{
+		const std::ptrdiff_t bandEnd = std::min( bandBegin + bandHeight, std::ptrdiff_t( procWindowSize.y ) );
+
+		BOOST_FOREACH( const std::ptrdiff_t y, bandRows )
+		{
+			rowSlots[y] = AxisFilter::outside;
+		}
+		bandRows.clear();
+		for( std::size_t tap = bandBegin * yFilter._windowSize; tap < bandEnd * yFilter._windowSize; ++tap )
+		{
+			const std::ptrdiff_t y = yFilter._indices[tap];
+			if( y != AxisFilter::outside && rowSlots[y] == AxisFilter::outside )
+			{
+				rowSlots[y] = bandRows.size();
+				bandRows.push_back( y );
+			}
+		}
+		// only grows, the buffer is reused by the next bands
+		if( scratch.size() < bandRows.size() * procWindowSize.x )
+			scratch.resize( bandRows.size() * procWindowSize.x );
+
+		// horizontal pass
+		BOOST_FOREACH( const std::ptrdiff_t y, bandRows )
+		{
+			const typename SrcView::x_iterator srcIt = src_view.row_begin( y );
+			typename std::vector<SrcC>::iterator rowIt = scratch.begin() + rowSlots[y] * procWindowSize.x;
+			std::size_t tap = 0;
+			for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x, ++rowIt )
+			{
+				SrcC mp( 0 );
+				for( std::size_t i = 0; i < xFilter._windowSize; ++i, ++tap )
+				{
+					const std::ptrdiff_t index = xFilter._indices[tap];
+					if( index == AxisFilter::outside )
+						details::add_dst_mul_src<SrcC, Weight, SrcC>()( outsideValue, xFilter._weights[tap], mp );
+					else
+						details::add_dst_mul_src<SrcP, Weight, SrcC>()( srcIt[index], xFilter._weights[tap], mp );
+				}
+				*rowIt = mp;
+			}
+		}
+
+		// vertical pass
+		for( std::ptrdiff_t y = bandBegin; y < bandEnd; ++y )
+		{
+			const std::size_t tapBegin = y * yFilter._windowSize;
+			typename DstView::x_iterator dstIt = dst_view.row_begin( procWindow.y1 + y ) + procWindow.x1;
+			for( std::ptrdiff_t x = 0; x < procWindowSize.x; ++x, ++dstIt )
+			{
+				SrcC mp( 0 );
+				std::size_t tap = tapBegin;
+				for( std::size_t i = 0; i < yFilter._windowSize; ++i, ++tap )
+				{
+					const std::ptrdiff_t index = yFilter._indices[tap];
+					if( index == AxisFilter::outside )
+						details::add_dst_mul_src<SrcC, Weight, SrcC>()( outsideValue, yFilter._weights[tap], mp );
+					else
+						details::add_dst_mul_src<SrcC, Weight, SrcC>()( scratch[rowSlots[index] * procWindowSize.x + x], yFilter._weights[tap], mp );
+				}
+				color_convert( mp, *dstIt );
+			}
+			if( p.progressForward( procWindowSize.x ) )
+				return;
+		}
+	}
+}
+
+}
+}
+
+#endif
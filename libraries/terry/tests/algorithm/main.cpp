@@ -0,0 +1,186 @@
+#include <terry/algorithm/reduce.hpp>
+#include <terry/algorithm/statistics.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_algorithm_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+/// @brief Moments of the values of a row, the test image.
+struct RowMoments
+{
+	const std::vector<double>* _values;
+	std::ptrdiff_t _width;
+	terry::algorithm::channel_moments_t _moments;
+	std::vector<std::ptrdiff_t> _rows; ///< rows in the order of the reduction
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		for( std::ptrdiff_t x = 0; x < _width; ++x )
+			_moments( ( *_values )[y * _width + x] );
+		_rows.push_back( y );
+	}
+
+	void merge( const RowMoments& other )
+	{
+		_moments.merge( other._moments );
+		_rows.insert( _rows.end(), other._rows.begin(), other._rows.end() );
+	}
+};
+
+/// @brief Count the processing of each row, stop or throw at a row.
+struct CountRows
+{
+	std::vector<int> _counts;
+	std::ptrdiff_t _stopRow;
+	std::ptrdiff_t _throwRow;
+	boost::mutex _mutex;
+
+	CountRows( const std::ptrdiff_t height )
+	: _counts( height, 0 )
+	, _stopRow( -1 )
+	, _throwRow( -1 )
+	{}
+
+	bool operator()( const std::size_t, const std::ptrdiff_t y1, const std::ptrdiff_t y2 )
+	{
+		for( std::ptrdiff_t y = y1; y < y2; ++y )
+		{
+			if( y == _throwRow )
+				throw std::runtime_error( "row error" );
+			{
+				boost::mutex::scoped_lock lock( _mutex );
+				++_counts[y];
+			}
+			if( y == _stopRow )
+				return true;
+		}
+		return false;
+	}
+};
+
+std::vector<double> makeValues( const std::size_t size )
+{
+	// large offset to check the numerical stability
+	std::vector<double> values( size );
+	for( std::size_t i = 0; i < size; ++i )
+		values[i] = 1e6 + std::exp( 2.0 * std::sin( i * 0.37 ) );
+	return values;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_algorithm_reduce_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( moments_two_pass_reference )
+{
+	const std::vector<double> values = makeValues( 10000 );
+
+	terry::algorithm::channel_moments_t moments;
+	double mean = 0;
+	for( std::size_t i = 0; i < values.size(); ++i )
+	{
+		moments( values[i] );
+		mean += values[i];
+	}
+	mean /= values.size();
+
+	double m2 = 0, m3 = 0, m4 = 0;
+	for( std::size_t i = 0; i < values.size(); ++i )
+	{
+		const double d = values[i] - mean;
+		m2 += d * d;
+		m3 += d * d * d;
+		m4 += d * d * d * d;
+	}
+	const double n = values.size();
+
+	BOOST_CHECK_EQUAL( moments.count(), values.size() );
+	BOOST_CHECK_CLOSE( moments.mean(), mean, 1e-9 );
+	BOOST_CHECK_CLOSE( moments.variance(), m2 / n, 1e-6 );
+	BOOST_CHECK_CLOSE( moments.skewness(), std::sqrt( n ) * m3 / std::pow( m2, 1.5 ), 1e-4 );
+	BOOST_CHECK_CLOSE( moments.kurtosis(), n * m4 / ( m2 * m2 ) - 3.0, 1e-4 );
+}
+
+BOOST_AUTO_TEST_CASE( moments_constant )
+{
+	terry::algorithm::channel_moments_t moments;
+	for( int i = 0; i < 100; ++i )
+		moments( 0.25 );
+	BOOST_CHECK_EQUAL( moments.mean(), 0.25 );
+	BOOST_CHECK_EQUAL( moments.variance(), 0.0 );
+	BOOST_CHECK_EQUAL( moments.skewness(), 0.0 );
+	BOOST_CHECK_EQUAL( moments.kurtosis(), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( reduce_rows_independent_of_threads )
+{
+	const std::ptrdiff_t width = 300;
+	const std::ptrdiff_t height = 437;
+	const std::vector<double> values = makeValues( width * height );
+
+	RowMoments init;
+	init._values = &values;
+	init._width = width;
+
+	RowMoments serial = init;
+	for( std::ptrdiff_t y = 0; y < height; ++y )
+		serial( y );
+
+	RowMoments single = init;
+	terry::algorithm::reduce_rows_parallel( height, 0, single, terry::algorithm::thread_group_executor( 1 ) );
+	RowMoments parallel = init;
+	terry::algorithm::reduce_rows_parallel( height, 0, parallel, terry::algorithm::thread_group_executor( 8 ) );
+
+	// all the rows, merged in order
+	BOOST_CHECK( single._rows == serial._rows );
+	BOOST_CHECK( parallel._rows == serial._rows );
+
+	// same bands, same result
+	BOOST_CHECK_EQUAL( single._moments.mean(), parallel._moments.mean() );
+	BOOST_CHECK_EQUAL( single._moments.kurtosis(), parallel._moments.kurtosis() );
+
+	BOOST_CHECK_CLOSE( parallel._moments.mean(), serial._moments.mean(), 1e-9 );
+	BOOST_CHECK_CLOSE( parallel._moments.variance(), serial._moments.variance(), 1e-6 );
+	BOOST_CHECK_CLOSE( parallel._moments.skewness(), serial._moments.skewness(), 1e-4 );
+	BOOST_CHECK_CLOSE( parallel._moments.kurtosis(), serial._moments.kurtosis(), 1e-4 );
+}
+
+BOOST_AUTO_TEST_CASE( reduce_rows_empty )
+{
+	const std::vector<double> values;
+	RowMoments reducer;
+	reducer._values = &values;
+	reducer._width = 0;
+	terry::algorithm::reduce_rows_parallel( 0, 0, reducer );
+	BOOST_CHECK_EQUAL( reducer._moments.count(), 0u );
+	BOOST_CHECK( reducer._rows.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( for_each_band_rows )
+{
+	const std::ptrdiff_t height = 1000;
+	CountRows all( height );
+	BOOST_CHECK( terry::algorithm::for_each_band( height, 0, all, terry::algorithm::thread_group_executor( 4 ) ) );
+	for( std::ptrdiff_t y = 0; y < height; ++y )
+		BOOST_REQUIRE_EQUAL( all._counts[y], 1 );
+
+	CountRows stopped( height );
+	stopped._stopRow = 0;
+	BOOST_CHECK( ! terry::algorithm::for_each_band( height, 0, stopped, terry::algorithm::thread_group_executor( 1 ) ) );
+	BOOST_CHECK_EQUAL( stopped._counts[0], 1 );
+	BOOST_CHECK_EQUAL( stopped._counts[1], 0 );
+
+	CountRows failed( height );
+	failed._throwRow = height / 2;
+	BOOST_CHECK_THROW( terry::algorithm::for_each_band( height, 0, failed, terry::algorithm::thread_group_executor( 4 ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+#include <terry/globals.hpp>
+#include <terry/filter/floodFill.hpp>
+#include <terry/filter/connectedComponents.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE( terry_filter_connectedComponents_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( connectedComponents_bands )
+{
+	using namespace terry::filter;
+	typedef connectedComponents::component_labelling<> Labelling;
+
+	// higher than the number of bands, so the components cross the borders of the bands
+	const std::ptrdiff_t width = 600;
+	const std::ptrdiff_t height = 500;
+	terry::gray32f_image_t img( width, height );
+	terry::gray32f_view_t view = terry::view( img );
+	terry::draw::fill_pixels( view, terry::gray32f_pixel_t( 0.0f ) );
+
+	// a "U" crossing all the bands, seeded at the bottom of the left branch
+	for( std::ptrdiff_t y = 0; y < height; ++y )
+	{
+		view( 10, y )[0] = 0.5f;
+		view( 20, y )[0] = 0.5f;
+	}
+	for( std::ptrdiff_t x = 10; x <= 20; ++x )
+		view( x, height - 1 )[0] = 0.5f;
+	view( 10, height - 1 )[0] = 1.0f;
+
+	// a diagonal, only connected with 8 neighbours
+	for( std::ptrdiff_t i = 0; i < 300; ++i )
+		view( 100 + i, i )[0] = 0.5f;
+	view( 399, 299 )[0] = 1.0f;
+
+	Labelling labelling4;
+	labelling4.compute<floodFill::Connexity4>( view, floodFill::IsUpper<float>( 0.4f ), floodFill::IsUpper<float>( 0.9f ), terry::algorithm::thread_group_executor( 1 ) );
+
+	BOOST_CHECK_EQUAL( labelling4.getLabel( 20, 0 ), labelling4.getLabel( 10, 0 ) );
+	BOOST_CHECK_EQUAL( labelling4.getLabel( 10, 0 ), Labelling::Label( 10 ) );
+	BOOST_CHECK( labelling4.isSeeded( 20, 0 ) );
+	BOOST_CHECK( ! labelling4.isForeground( 15, 0 ) );
+	BOOST_CHECK_EQUAL( labelling4.getLabel( 15, 0 ), Labelling::kNoLabel );
+	BOOST_CHECK( labelling4.getLabel( 100, 0 ) != labelling4.getLabel( 101, 1 ) );
+	BOOST_CHECK( ! labelling4.isSeeded( 100, 0 ) );
+
+	Labelling labelling8;
+	labelling8.compute<floodFill::Connexity8>( view, floodFill::IsUpper<float>( 0.4f ), floodFill::IsUpper<float>( 0.9f ), terry::algorithm::thread_group_executor( 1 ) );
+	BOOST_CHECK_EQUAL( labelling8.getLabel( 100, 0 ), labelling8.getLabel( 399, 299 ) );
+	BOOST_CHECK( labelling8.isSeeded( 100, 0 ) );
+
+	// the labels don't depend on the number of threads
+	Labelling labelling8Parallel;
+	labelling8Parallel.compute<floodFill::Connexity8>( view, floodFill::IsUpper<float>( 0.4f ), floodFill::IsUpper<float>( 0.9f ), terry::algorithm::thread_group_executor( 4 ) );
+	for( std::ptrdiff_t y = 0; y < height; ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < width; ++x )
+		{
+			BOOST_REQUIRE_EQUAL( labelling8.getLabel( x, y ), labelling8Parallel.getLabel( x, y ) );
+			BOOST_REQUIRE_EQUAL( labelling8.isSeeded( x, y ), labelling8Parallel.isSeeded( x, y ) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( connectedComponents_floodFill )
+{
+	using namespace terry::filter;
+
+	terry::gray32f_image_t srcImg( 8, 3 );
+	terry::gray32f_view_t src = terry::view( srcImg );
+	terry::gray32f_image_t dstImg( 8, 3 );
+	terry::gray32f_view_t dst = terry::view( dstImg );
+	terry::draw::fill_pixels( dst, terry::gray32f_pixel_t( 0.0f ) );
+
+	const float values[] = { 0.5f, 1.0f, 0.5f, 0.0f, 0.5f, 0.5f, 0.0f, 1.0f };
+	for( std::ptrdiff_t y = 0; y < 3; ++y )
+		for( std::ptrdiff_t x = 0; x < 8; ++x )
+			src( x, y )[0] = values[x];
+
+	floodFill::flood_fill_parallel<floodFill::Connexity4, floodFill::IsUpper<float>, floodFill::IsUpper<float>, terry::gray32f_view_t, terry::gray32f_view_t, std::allocator>(
+		src, terry::getBounds<std::ssize_t>( src ),
+		dst, terry::getBounds<std::ssize_t>( dst ),
+		terry::getBounds<std::ssize_t>( dst ),
+		floodFill::IsUpper<float>( 0.9f ), floodFill::IsUpper<float>( 0.4f ) );
+
+	const float expected[] = { 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+	for( std::ptrdiff_t x = 0; x < 8; ++x )
+		BOOST_CHECK_EQUAL( float( dst( x, 1 )[0] ), expected[x] );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+#include <terry/globals.hpp>
+#include <terry/filter/correlate2d.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+void fillImage( const boost::gil::rgba32f_view_t& v )
+{
+	std::srand( 42 );
+	for( std::ptrdiff_t y = 0; y < v.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < v.width(); ++x )
+			for( int c = 0; c < 4; ++c )
+				v( x, y )[c] = std::rand() / float( RAND_MAX );
+}
+
+terry::filter::kernel_2d<double> randomKernel( const std::size_t width, const std::size_t height )
+{
+	terry::filter::kernel_2d<double> kernel( width, height );
+	for( std::size_t y = 0; y < height; ++y )
+		for( std::size_t x = 0; x < width; ++x )
+			kernel( x, y ) = std::rand() / double( RAND_MAX ) - 0.3;
+	kernel.normalize();
+	return kernel;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_filter_correlate2d_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( fft_inverse )
+{
+	const terry::math::fft_plan<double> plan( 64 );
+	std::vector<std::complex<double> > data( 64 );
+	std::vector<std::complex<double> > ref( 64 );
+	for( std::size_t i = 0; i < data.size(); ++i )
+		ref[i] = data[i] = std::complex<double>( std::rand() / double( RAND_MAX ), std::rand() / double( RAND_MAX ) );
+
+	plan.forward( &data[0] );
+	// DC
+	std::complex<double> sum( 0 );
+	for( std::size_t i = 0; i < ref.size(); ++i )
+		sum += ref[i];
+	BOOST_CHECK_CLOSE( data[0].real(), sum.real(), 1e-9 );
+	BOOST_CHECK_CLOSE( data[0].imag(), sum.imag(), 1e-9 );
+
+	plan.inverse( &data[0] );
+	for( std::size_t i = 0; i < data.size(); ++i )
+	{
+		BOOST_CHECK_SMALL( data[i].real() - ref[i].real(), 1e-12 );
+		BOOST_CHECK_SMALL( data[i].imag() - ref[i].imag(), 1e-12 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( fft_same_as_direct )
+{
+	using namespace boost::gil;
+	const terry::filter::convolve_boundary_option options[] = {
+		terry::filter::convolve_option_extend_zero,
+		terry::filter::convolve_option_extend_constant,
+		terry::filter::convolve_option_extend_mirror };
+
+	rgba32f_image_t src( 90, 70 );
+	fillImage( view( src ) );
+
+	terry::filter::kernel_2d<double> kernel = randomKernel( 21, 14 );
+	kernel.set_center( point2<std::ptrdiff_t>( 5, 9 ) );
+	const terry::filter::fft_correlation_kernel<float> fftKernel( kernel );
+
+	for( std::size_t o = 0; o < sizeof( options ) / sizeof( options[0] ); ++o )
+	{
+		// a tile of the image
+		const point2<std::ptrdiff_t> tile_tl( 7, 20 );
+		rgba32f_image_t direct( 75, 40 );
+		rgba32f_image_t fft( 75, 40 );
+		terry::filter::correlate_2d_direct( const_view( src ), kernel, view( direct ), tile_tl, options[o] );
+		terry::filter::correlate_2d_fft( const_view( src ), fftKernel, view( fft ), tile_tl, options[o], terry::algorithm::thread_group_executor( 3 ) );
+
+		for( std::ptrdiff_t y = 0; y < direct.height(); ++y )
+			for( std::ptrdiff_t x = 0; x < direct.width(); ++x )
+				for( int c = 0; c < 4; ++c )
+					BOOST_CHECK_SMALL( view( fft )( x, y )[c] - view( direct )( x, y )[c], 1e-4f );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( direct_identity )
+{
+	using namespace boost::gil;
+	rgba32f_image_t src( 20, 10 );
+	rgba32f_image_t dst( 20, 10 );
+	fillImage( view( src ) );
+
+	// a kernel with only its center gives the source
+	terry::filter::kernel_2d<double> kernel( 5, 3 );
+	kernel( 2, 1 ) = 1.0;
+	terry::filter::correlate_2d_direct( const_view( src ), kernel, view( dst ), point2<std::ptrdiff_t>( 0, 0 ),
+	                                    terry::filter::convolve_option_extend_mirror );
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < dst.width(); ++x )
+			for( int c = 0; c < 4; ++c )
+				BOOST_CHECK_EQUAL( view( dst )( x, y )[c], view( src )( x, y )[c] );
+}
+
+BOOST_AUTO_TEST_CASE( fft_cost_model )
+{
+	// small kernels stay direct, the big ones use the FFT
+	BOOST_CHECK( ! terry::filter::is_correlate_2d_fft_faster( 3, 3 ) );
+	BOOST_CHECK( terry::filter::is_correlate_2d_fft_faster( 63, 63 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
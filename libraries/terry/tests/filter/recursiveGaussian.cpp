@@ -0,0 +1,131 @@
+#include <terry/globals.hpp>
+#include <terry/filter/recursiveGaussian.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <boost/math/constants/constants.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+/// @brief Response of a filter to an impulse in the middle of an image with one row.
+template<class Filter>
+std::vector<double> impulseResponse( const Filter& filter, const std::ptrdiff_t width )
+{
+	using namespace boost::gil;
+	gray32f_image_t src( width, 1 );
+	gray32f_image_t dst( width, 1 );
+	fill_pixels( view( src ), gray32f_pixel_t( 0.0f ) );
+	view( src )( width / 2, 0 ) = gray32f_pixel_t( 1.0f );
+
+	terry::filter::recursive_filter_rows_cols<gray32f_pixel_t, std::allocator>(
+		view( src ), filter, Filter( 0 ), view( dst ), point2<std::ptrdiff_t>( 0, 0 ),
+		terry::filter::convolve_option_extend_zero );
+
+	std::vector<double> response( width );
+	for( std::ptrdiff_t x = 0; x < width; ++x )
+		response[x] = view( dst )( x, 0 )[0];
+	return response;
+}
+
+template<class Filter>
+void checkMoments( const double sigma, const double tolerance )
+{
+	const std::ptrdiff_t width = static_cast<std::ptrdiff_t>( 20 * sigma ) + 1;
+	const std::vector<double> response = impulseResponse( Filter( sigma ), width );
+	double sum = 0.0;
+	double variance = 0.0;
+	for( std::ptrdiff_t x = 0; x < width; ++x )
+	{
+		sum += response[x];
+		variance += response[x] * ( x - width / 2 ) * ( x - width / 2 );
+	}
+	BOOST_CHECK_CLOSE( sum, 1.0, 0.01 );
+	BOOST_CHECK_CLOSE( std::sqrt( variance / sum ), sigma, tolerance );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_filter_recursiveGaussian_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( recursive_gaussian_moments )
+{
+	checkMoments<terry::filter::recursive_gaussian>( 3.0, 0.1 );
+	checkMoments<terry::filter::recursive_gaussian>( 40.0, 0.1 );
+}
+
+BOOST_AUTO_TEST_CASE( extended_box_gaussian_moments )
+{
+	checkMoments<terry::filter::extended_box_gaussian>( 3.0, 0.01 );
+	checkMoments<terry::filter::extended_box_gaussian>( 40.0, 0.01 );
+}
+
+BOOST_AUTO_TEST_CASE( recursive_gaussian_shape )
+{
+	const double sigma = 25.0;
+	const std::ptrdiff_t width = 501;
+	const std::vector<double> response = impulseResponse( terry::filter::recursive_gaussian( sigma ), width );
+	const double peak = 1.0 / ( std::sqrt( 2.0 * boost::math::constants::pi<double>() ) * sigma );
+	for( std::ptrdiff_t x = 0; x < width; ++x )
+	{
+		const double d = x - width / 2;
+		BOOST_CHECK_SMALL( response[x] - peak * std::exp( - d * d / ( 2.0 * sigma * sigma ) ), 0.02 * peak );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( recursive_gaussian_tiles )
+{
+	using namespace boost::gil;
+	// a tile gives the same result as the full image, with each boundary option
+	const terry::filter::convolve_boundary_option options[] = {
+		terry::filter::convolve_option_extend_zero,
+		terry::filter::convolve_option_extend_constant,
+		terry::filter::convolve_option_extend_mirror };
+	const terry::filter::recursive_gaussian filter( 4.0 );
+
+	rgba32f_image_t src( 64, 48 );
+	for( std::ptrdiff_t y = 0; y < 48; ++y )
+		for( std::ptrdiff_t x = 0; x < 64; ++x )
+			view( src )( x, y ) = rgba32f_pixel_t( x * 0.1f, y * 0.2f, ( x * y ) % 7, 1.0f );
+
+	for( std::size_t o = 0; o < sizeof( options ) / sizeof( options[0] ); ++o )
+	{
+		rgba32f_image_t full( 64, 48 );
+		rgba32f_image_t tile( 20, 16 );
+		const point2<std::ptrdiff_t> tile_tl( 30, 5 );
+		terry::filter::recursive_filter_rows_cols<rgba32f_pixel_t, std::allocator>(
+			const_view( src ), filter, filter, view( full ), point2<std::ptrdiff_t>( 0, 0 ), options[o] );
+		terry::filter::recursive_filter_rows_cols<rgba32f_pixel_t, std::allocator>(
+			const_view( src ), filter, filter, view( tile ), tile_tl, options[o] );
+
+		for( std::ptrdiff_t y = 0; y < tile.height(); ++y )
+			for( std::ptrdiff_t x = 0; x < tile.width(); ++x )
+				for( int c = 0; c < 4; ++c )
+					BOOST_CHECK_SMALL( view( tile )( x, y )[c] - view( full )( x + tile_tl.x, y + tile_tl.y )[c], 0.01f );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( extended_box_gaussian_constant )
+{
+	using namespace boost::gil;
+	// a constant image stays constant with the constant and mirror borders
+	gray32f_image_t src( 40, 30 );
+	gray32f_image_t dst( 40, 30 );
+	fill_pixels( view( src ), gray32f_pixel_t( 0.5f ) );
+	const terry::filter::extended_box_gaussian filter( 12.0 );
+
+	terry::filter::recursive_filter_rows_cols<gray32f_pixel_t, std::allocator>(
+		const_view( src ), filter, filter, view( dst ), point2<std::ptrdiff_t>( 0, 0 ),
+		terry::filter::convolve_option_extend_mirror );
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < dst.width(); ++x )
+			BOOST_CHECK_CLOSE( float( view( dst )( x, y )[0] ), 0.5f, 0.001f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,208 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/all.hpp>
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
+#include <terry/sampler/coordinate_map.hpp>
+
+#include <iostream>
+#include <cmath>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+struct NoProgress
+{
+	bool progressForward( const int ) { return false; }
+};
+
+/// @brief Smooth non linear transformation.
+struct Swirl
+{
+	double _cx, _cy, _strength;
+};
+
+template <typename F2>
+inline terry::point2<double> transform( const Swirl& t, const terry::point2<F2>& p )
+{
+	const double dx = p.x - t._cx;
+	const double dy = p.y - t._cy;
+	const double angle = t._strength * std::exp( - ( dx * dx + dy * dy ) / 400.0 );
+	return terry::point2<double>( t._cx + dx * std::cos( angle ) - dy * std::sin( angle ),
+	                              t._cy + dx * std::sin( angle ) + dy * std::cos( angle ) );
+}
+
+/// @brief Resample a test pattern with the generic and the separable resampling.
+template<class Sampler>
+void checkSeparable( const Sampler& sampler, const std::ptrdiff_t dstWidth, const std::ptrdiff_t dstHeight, const terry::sampler::EParamFilterOutOfImage outOfImage )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+
+	gray32f_image_t src( 13, 9 );
+	gray32f_view_t srcView = view( src );
+	for( std::ptrdiff_t y = 0; y < srcView.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < srcView.width(); ++x )
+			srcView( x, y ) = gray32f_pixel_t( ( ( x * 7 + y * 3 ) % 11 ) / 10.0f );
+
+	gray32f_image_t generic( dstWidth, dstHeight );
+	gray32f_image_t separable( dstWidth, dstHeight );
+
+	const double src_width  = srcView.width() - 1;
+	const double src_height = srcView.height() - 1;
+	const double dst_width  = dstWidth - 1;
+	const double dst_height = dstHeight - 1;
+	const matrix3x2<double> mat =
+		matrix3x2<double>::get_translate( - dst_width * 0.5, - dst_height * 0.5 ) *
+		matrix3x2<double>::get_scale    ( (src_width + 1) / (dst_width + 1 ), (src_height + 1) / (dst_height + 1) ) *
+		matrix3x2<double>::get_translate( src_width * 0.5 , src_height * 0.5 );
+	const terry::Rect<std::ssize_t> procWindow( 0, 0, dstWidth, dstHeight );
+
+	BOOST_REQUIRE( is_separable_transform( mat, outOfImage ) );
+
+	NoProgress progress;
+	resample_pixels_progress( srcView, view( generic ), mat, procWindow, outOfImage, progress, sampler );
+	resample_pixels_separable_progress( srcView, view( separable ), mat, procWindow, outOfImage, progress, sampler );
+
+	for( std::ptrdiff_t y = 0; y < dstHeight; ++y )
+		for( std::ptrdiff_t x = 0; x < dstWidth; ++x )
+			BOOST_CHECK_SMALL( get_color( view( generic )( x, y ), gray_color_t() ) - get_color( view( separable )( x, y ), gray_color_t() ), 1e-5f );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_sampler_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( separable_upscale )
+{
+	using namespace terry::sampler;
+	checkSeparable( bicubic_sampler(), 31, 20, eParamFilterOutCopy );
+	checkSeparable( lanczos3_sampler(), 31, 20, eParamFilterOutCopy );
+	checkSeparable( gaussian_sampler(), 31, 20, eParamFilterOutBlack );
+	checkSeparable( mitchell_sampler(), 31, 20, eParamFilterOutTransparency );
+}
+
+BOOST_AUTO_TEST_CASE( separable_downscale )
+{
+	using namespace terry::sampler;
+	checkSeparable( bilinear_sampler(), 5, 4, eParamFilterOutCopy );
+	checkSeparable( lanczos_sampler( 4, 1.0 ), 5, 4, eParamFilterOutCopy );
+	checkSeparable( catrom_sampler(), 6, 3, eParamFilterOutBlack );
+}
+
+BOOST_AUTO_TEST_CASE( separable_transform )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+	BOOST_CHECK( is_separable_transform( matrix3x2<double>::get_scale( 2.0, 0.5 ), eParamFilterOutBlack ) );
+	BOOST_CHECK( ! is_separable_transform( matrix3x2<double>::get_scale( 2.0, 0.5 ), eParamFilterOutMirror ) );
+	BOOST_CHECK( ! is_separable_transform( matrix3x2<double>::get_rotate( 0.5 ), eParamFilterOutBlack ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( coordinate_map_resample )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+
+	gray32f_image_t src( 13, 9 );
+	gray32f_view_t srcView = view( src );
+	for( std::ptrdiff_t y = 0; y < srcView.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < srcView.width(); ++x )
+			srcView( x, y ) = gray32f_pixel_t( ( ( x * 7 + y * 3 ) % 11 ) / 10.0f );
+
+	const matrix3x2<double> mat =
+		matrix3x2<double>::get_translate( -8.0, -5.0 ) *
+		matrix3x2<double>::get_rotate( 0.3 ) *
+		matrix3x2<double>::get_translate( 6.0, 4.0 );
+	const terry::Rect<std::ssize_t> procWindow( 0, 0, 17, 11 );
+
+	coordinate_map<float> map( procWindow );
+	// filled in two parts, as by two threads
+	fill_coordinate_map( map, mat, terry::Rect<std::ssize_t>( 0, 0, 17, 5 ) );
+	fill_coordinate_map( map, mat, terry::Rect<std::ssize_t>( 0, 5, 17, 11 ) );
+
+	gray32f_image_t direct( 17, 11 );
+	gray32f_image_t mapped( 17, 11 );
+	NoProgress progress;
+	resample_pixels_progress( srcView, view( direct ), mat, procWindow, eParamFilterOutBlack, progress, bicubic_sampler() );
+	resample_pixels_progress( srcView, view( mapped ), map, procWindow, eParamFilterOutBlack, progress, bicubic_sampler() );
+
+	for( std::ptrdiff_t y = 0; y < 11; ++y )
+		for( std::ptrdiff_t x = 0; x < 17; ++x )
+			BOOST_CHECK_SMALL( get_color( view( direct )( x, y ), gray_color_t() ) - get_color( view( mapped )( x, y ), gray_color_t() ), 1e-4f );
+}
+
+BOOST_AUTO_TEST_CASE( coordinate_map_stmap )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+
+	const terry::Rect<std::ssize_t> region( 0, 0, 7, 5 );
+	const point2<double> srcSize( 20, 10 );
+	coordinate_map<float> map( region );
+	fill_coordinate_map( map, matrix3x2<double>::get_scale( 3.0, 2.0 ), region );
+
+	rgba32f_image_t stmap( 7, 5 );
+	coordinate_map_to_view( map, view( stmap ), region, srcSize );
+	// the source borders are at 0 and 1
+	BOOST_CHECK_CLOSE( get_color( view( stmap )( 0, 0 ), red_t() ), 0.025f, 1e-3f );
+	BOOST_CHECK_CLOSE( get_color( view( stmap )( 0, 0 ), green_t() ), 0.05f, 1e-3f );
+
+	coordinate_map<float> imported( region );
+	view_to_coordinate_map( const_view( stmap ), imported, srcSize );
+	for( std::ptrdiff_t y = 0; y < 5; ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < 7; ++x )
+		{
+			BOOST_CHECK_SMALL( imported( x, y ).x - map( x, y ).x, 1e-4f );
+			BOOST_CHECK_SMALL( imported( x, y ).y - map( x, y ).y, 1e-4f );
+		}
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( coordinate_map_adaptive )
+{
+	using namespace terry;
+	using namespace terry::sampler;
+
+	const terry::Rect<std::ssize_t> region( 0, 0, 101, 77 );
+	const Swirl swirl = { 50.0, 40.0, 1.5 };
+
+	coordinate_map<float> exact( region );
+	fill_coordinate_map( exact, swirl, region );
+
+	const double maxError = 0.05;
+	coordinate_map<float> adaptive( region );
+	// filled in two parts, as by two threads
+	fill_coordinate_map_adaptive( adaptive, swirl, terry::Rect<std::ssize_t>( 0, 0, 101, 40 ), maxError, 16 );
+	fill_coordinate_map_adaptive( adaptive, swirl, terry::Rect<std::ssize_t>( 0, 40, 101, 77 ), maxError, 16 );
+
+	// the error is only checked on some points of each cell
+	for( std::ptrdiff_t y = 0; y < 77; ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < 101; ++x )
+		{
+			BOOST_CHECK_SMALL( adaptive( x, y ).x - exact( x, y ).x, float( 4 * maxError ) );
+			BOOST_CHECK_SMALL( adaptive( x, y ).y - exact( x, y ).y, float( 4 * maxError ) );
+		}
+	}
+
+	// affine transformations are interpolated without subdivision
+	const matrix3x2<double> mat = matrix3x2<double>::get_rotate( 0.3 ) * matrix3x2<double>::get_translate( 6.0, 4.0 );
+	fill_coordinate_map( exact, mat, region );
+	fill_coordinate_map_adaptive( adaptive, mat, region, 1e-3 );
+	for( std::ptrdiff_t y = 0; y < 77; ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < 101; ++x )
+		{
+			BOOST_CHECK_SMALL( adaptive( x, y ).x - exact( x, y ).x, 1e-3f );
+			BOOST_CHECK_SMALL( adaptive( x, y ).y - exact( x, y ).y, 1e-3f );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,51 @@
+# scons: pluginCheckerboard pluginBlur
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def testBlurMethods():
+
+	for method in ["auto", "convolution", "recursive", "box"]:
+		for border in ["Mirror", "Constant", "Black", "Padded"]:
+			g = tuttle.Graph()
+			read = g.createNode( "tuttle.checkerboard", size=[200,100] )
+			blur = g.createNode( "tuttle.blur", size=[150.0, 60.0], border=border, method=method )
+
+			g.connect( [read, blur] )
+			g.compute( blur )
+
+
+def computeBlur( method ):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.checkerboard", size=[200,100], explicitConversion="32f" )
+	# the output keeps the size of the source, whatever the margin of the method
+	blur = g.createNode( "tuttle.blur", size=[16.0, 16.0], border="No", method=method )
+	g.connect( [read, blur] )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, blur )
+	return outputCache.get(0).getNumpyArray()
+
+
+def testBlurRecursiveMatchesConvolution():
+	"""
+	The recursive gaussian gives the same image as the convolution by the gaussian kernel.
+	"""
+	convolution = computeBlur( "convolution" )
+	recursive = computeBlur( "recursive" )
+	assert_equals( recursive.shape, convolution.shape )
+
+	# far from the borders, which are handled differently by the 2 methods (sigma is 4 pixels)
+	margin = 20
+	convolution = convolution[margin:-margin, margin:-margin, 0:3]
+	recursive = recursive[margin:-margin, margin:-margin, 0:3]
+	# the blurred checkerboard is not constant
+	assert( convolution.max() - convolution.min() > 0.1 )
+	assert( numpy.allclose( recursive, convolution, atol=0.02 ) )
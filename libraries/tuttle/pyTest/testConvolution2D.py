@@ -0,0 +1,32 @@
+# scons: pluginCheckerboard pluginConvolution
+
+from pyTuttle import tuttle
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def testConvolution2D():
+
+	for size in [[3,3], [9,5]]:
+		for border in ["Mirror", "Constant", "Black", "Padded"]:
+			g = tuttle.Graph()
+			read = g.createNode( "tuttle.checkerboard", size=[200,100] )
+			conv = g.createNode( "tuttle.convolution", type="2D", size=size, border=border, coef_0_0=1.0, coef_1_1=2.0 )
+
+			g.connect( [read, conv] )
+			g.compute( conv )
+
+
+def testConvolutionKernelClip():
+
+	# a big kernel from an image, computed in the frequency domain
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.checkerboard", size=[200,100] )
+	kernel = g.createNode( "tuttle.checkerboard", size=[31,21] )
+	conv = g.createNode( "tuttle.convolution" )
+
+	g.connect( read, conv )
+	g.connect( kernel, conv.getAttribute("Kernel") )
+	g.compute( conv )
@@ -0,0 +1,84 @@
+# scons: pluginMemoryBuffer pluginLensDistort pluginPinning
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeDistortion( array, pluginName, **params ):
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.setNumpyArray( array )
+	distort = g.createNode( pluginName, **params )
+	g.connect( ib.getNode(), distort )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, distort )
+	return outputCache.get(0).getNumpyArray()
+
+
+def computeNode( g, node ):
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, node )
+	return outputCache.get(0).getNumpyArray()
+
+
+def testLensDistortCachedCoordinates():
+	"""
+	The cached coordinates give the same image as the direct evaluation,
+	the next renders of the node reuse the map while the parameters are
+	unchanged, and a parameter change computes a new map.
+	"""
+	array = numpy.random.rand( 60, 80, 4 ).astype( numpy.float32 )
+
+	direct = computeDistortion( array, "tuttle.lensdistort", coef1=0.2, cacheCoordinates=False )
+	directOther = computeDistortion( array, "tuttle.lensdistort", coef1=0.3, cacheCoordinates=False )
+	assert( not numpy.allclose( directOther, direct, atol=1e-3 ) )
+
+	# all the renders on the same node, which keeps its map between the computes
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.setNumpyArray( array )
+	distort = g.createNode( "tuttle.lensdistort", coef1=0.2, cacheCoordinates=True )
+	g.connect( ib.getNode(), distort )
+
+	first = computeNode( g, distort )
+	second = computeNode( g, distort )
+	assert( numpy.allclose( first, direct, atol=1e-3 ) )
+	assert( numpy.array_equal( second, first ) )
+
+	# a new coefficient invalidates the cached map
+	distort.getParam( "coef1" ).setValue( 0.3 )
+	other = computeNode( g, distort )
+	assert( numpy.allclose( other, directOther, atol=1e-3 ) )
+
+	# and the previous map is not used back by mistake
+	distort.getParam( "coef1" ).setValue( 0.2 )
+	assert( numpy.allclose( computeNode( g, distort ), direct, atol=1e-3 ) )
+
+
+def testLensDistortSTMap():
+	"""
+	The STMap contains the normalized source position of each pixel.
+	"""
+	array = numpy.zeros( ( 60, 80, 4 ), numpy.float32 )
+
+	stmap = computeDistortion( array, "tuttle.lensdistort", coef1=0.2, output="stmap" )
+	assert_equals( stmap.shape, array.shape )
+	# the lens center is not moved
+	assert_almost_equals( stmap[30, 40, 0], 40.5 / 80, places=1 )
+	assert_almost_equals( stmap[30, 40, 1], 30.5 / 60, places=1 )
+	assert( numpy.all( stmap[:,:,3] == 1.0 ) )
+
+
+def testPinningCachedCoordinates():
+	array = numpy.random.rand( 40, 50, 4 ).astype( numpy.float32 )
+
+	direct = computeDistortion( array, "tuttle.pinning", perpMatrix0=[1.1, 0.0, 0.02], cacheCoordinates=False )
+	cached = computeDistortion( array, "tuttle.pinning", perpMatrix0=[1.1, 0.0, 0.02], cacheCoordinates=True )
+	assert( numpy.allclose( cached, direct, atol=1e-3 ) )
@@ -0,0 +1,59 @@
+# scons: pluginCheckerboard pluginInvert pluginMerge
+
+from pyTuttle import tuttle
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeRod( g, node, options=tuttle.ComputeOptions() ):
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, node, options )
+	rod = outputCache.get(0).getROD()
+	return [rod.x2 - rod.x1, rod.y2 - rod.y1]
+
+
+def testModifiedParamsOnReusedGraph():
+
+	g = tuttle.Graph()
+	read1 = g.createNode( "tuttle.checkerboard", size=[20,30] )
+	read2 = g.createNode( "tuttle.checkerboard", size=[40,50] )
+	merge = g.createNode( "tuttle.merge", rod="union" )
+	invert = g.createNode( "tuttle.invert" )
+
+	g.connect( read1, merge.getAttribute("A") )
+	g.connect( read2, merge.getAttribute("B") )
+	g.connect( merge, invert )
+
+	assert_equals( computeRod( g, invert ), [40, 50] )
+
+	# the compiled graph is reused, only read1 and the nodes using it are setup again
+	read1.getParam("size").setValue( [60, 10] )
+	assert_equals( computeRod( g, invert ), [60, 50] )
+
+	# the graph is compiled again after a change of the topology
+	g.connect( read1, merge.getAttribute("B") )
+	assert_equals( computeRod( g, invert ), [60, 10] )
+
+
+def testModifiedParamsOnFrameLanes():
+
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.checkerboard", size=[20,30] )
+	invert = g.createNode( "tuttle.invert" )
+	g.connect( read, invert )
+
+	options = tuttle.ComputeOptions(0, 3)
+	options.setNbParallelFrames( 2 )
+	assert_equals( computeRod( g, invert, options ), [20, 30] )
+
+	# the cloned nodes of the frame lanes are synchronized
+	read.getParam("size").setValue( [70, 80] )
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, invert, options )
+	for i in range(outputCache.size()):
+		rod = outputCache.get(i).getROD()
+		assert_equals( [rod.x2 - rod.x1, rod.y2 - rod.y1], [70, 80] )
@@ -0,0 +1,126 @@
+# scons: pluginCheckerboard pluginInvert pluginGamma pluginConstant pluginPng
+
+from pyTuttle import tuttle
+import numpy
+import os
+import threading
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+class FrameOrderHandle(tuttle.IProgressHandle):
+	"""
+	Record the times of the images delivered to the output cache, at the end of each frame.
+	"""
+	def __init__(self, outputCache):
+		super(FrameOrderHandle, self).__init__()
+		self.outputCache = outputCache
+		self.times = []
+
+	def endFrame(self):
+		times = set( self.outputCache.getTime( self.outputCache.get(i) ) for i in range( self.outputCache.size() ) )
+		self.times.extend( sorted( times - set( self.times ) ) )
+
+
+def computeFrames( g, node, options ):
+	outputCache = tuttle.MemoryCache()
+	handle = FrameOrderHandle( outputCache )
+	options.setProgressHandle( handle )
+	g.compute( outputCache, node, options )
+
+	images = {}
+	for i in range( outputCache.size() ):
+		image = outputCache.get( i )
+		images[ outputCache.getTime( image ) ] = image.getNumpyArray()
+	return images, handle.times
+
+
+def testParallelFrames():
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	invert = g.createNode( "tuttle.invert" )
+	# each frame is different
+	gamma = g.createNode( "tuttle.gamma" )
+	gamma.getParam( "master" ).setValue( {0.0: 0.5, 9.0: 2.0} )
+	g.connect( [checker, invert, gamma] )
+
+	sequential, sequentialOrder = computeFrames( g, gamma, tuttle.ComputeOptions(0, 9) )
+
+	options = tuttle.ComputeOptions(0, 9)
+	options.setNbParallelFrames( 3 )
+	parallel, parallelOrder = computeFrames( g, gamma, options )
+
+	assert_equals( len( sequential ), 10 )
+	assert( not numpy.array_equal( sequential[0], sequential[9] ) )
+	assert_equals( sorted( parallel.keys() ), sorted( sequential.keys() ) )
+	for time, image in sequential.items():
+		assert( numpy.array_equal( parallel[time], image ) )
+
+	# the images are delivered in the order of the frames
+	assert_equals( sequentialOrder, list( range( 10 ) ) )
+	assert_equals( parallelOrder, sequentialOrder )
+
+
+class CountingHandle(tuttle.IProgressHandle):
+	"""
+	Count the calls of each progress handle per frame, and the calls outside of the main thread.
+	"""
+	def __init__(self):
+		super(CountingHandle, self).__init__()
+		self.threadIdent = threading.current_thread().ident
+		self.frames = []
+		self.otherThreadCalls = 0
+
+	def count(self, name):
+		if threading.current_thread().ident != self.threadIdent:
+			self.otherThreadCalls += 1
+		frame = self.frames[-1]
+		frame[name] = frame.get( name, 0 ) + 1
+
+	def beginFrame(self):
+		self.frames.append( {} )
+		self.count( "beginFrame" )
+
+	def setupAtTime(self):
+		self.count( "setupAtTime" )
+
+	def processAtTime(self):
+		self.count( "processAtTime" )
+
+	def endFrame(self):
+		self.count( "endFrame" )
+
+
+def testParallelFramesContinueOnError():
+	"""
+	A frame in error doesn't change the progress handles of the next frames.
+	"""
+	directory = ".tests/parallelFrames"
+	g = tuttle.Graph()
+	constant = g.createNode( "tuttle.constant", size=[32,24] )
+	write = g.createNode( "tuttle.pngwriter", filename=directory+"/frame-####.png" )
+	g.connect( constant, write )
+	g.compute( write, tuttle.ComputeOptions(0, 9) )
+	# the reading of this frame fails
+	os.remove( directory+"/frame-0004.png" )
+
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=directory+"/frame-####.png" )
+	outputCache = tuttle.MemoryCache()
+	handle = CountingHandle()
+	options = tuttle.ComputeOptions(0, 9)
+	options.setNbParallelFrames( 3 )
+	options.setContinueOnError( True )
+	options.setProgressHandle( handle )
+	g.compute( outputCache, read, options )
+
+	assert_equals( outputCache.size(), 9 )
+	assert_equals( len( handle.frames ), 10 )
+	for frame in handle.frames:
+		assert_equals( frame, {"beginFrame": 1, "setupAtTime": 1, "processAtTime": 1, "endFrame": 1} )
+	assert_equals( handle.otherThreadCalls, 0 )
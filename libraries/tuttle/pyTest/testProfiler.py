@@ -0,0 +1,69 @@
+# scons: pluginCheckerboard pluginInvert pluginGamma pluginPng
+
+from pyTuttle import tuttle
+import json
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def testProfiler():
+
+	tuttle.core().getRenderCache().clear()
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	invert = g.createNode( "tuttle.invert" )
+	gamma = g.createNode( "tuttle.gamma", master=2.2 )
+	write = g.createNode( "tuttle.pngwriter", filename=".tests/output_profiler_####.png" )
+	g.connect( [checker, invert, gamma, write] )
+
+	profiler = tuttle.Profiler()
+	options = tuttle.ComputeOptions(0, 2)
+	options.setUseRenderCache( True )
+	options.setProfiler( profiler )
+	g.compute( write, options )
+
+	assert_equals( list(profiler.getNodeNames()), sorted([checker.getName(), invert.getName(), gamma.getName(), write.getName()]) )
+
+	invertStats = profiler.getNodeStats( invert.getName() )
+	assert( invertStats.getWallTime() > 0 )
+	assert( invertStats._bytes > 0 )
+	assert_equals( invertStats._cacheMisses, 3 )
+	assert_equals( profiler.getNodeStatsAtTime( invert.getName(), 1 )._cacheMisses, 1 )
+
+	# the render of the writer is profiled as I/O
+	assert( profiler.getPhaseStats( tuttle.eProfilePhaseIO )._nbEvents >= 3 )
+
+	# same computation: the outputs are taken from the render cache
+	profiler.clear()
+	g.compute( gamma, options )
+	assert_equals( profiler.getNodeStats( gamma.getName() )._cacheHits, 3 )
+
+	trace = json.loads( profiler.getChromeTrace() )
+	assert_equals( len(trace["traceEvents"]), profiler.getNbEvents() )
+	for event in trace["traceEvents"]:
+		assert_equals( event["ph"], "X" )
+	profiler.exportChromeTrace( ".tests/profiler_trace.json" )
+
+
+def testDisabledProfiler():
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL" )
+	invert = g.createNode( "tuttle.invert" )
+	g.connect( checker, invert )
+
+	profiler = tuttle.Profiler()
+	profiler.setEnabled( False )
+	options = tuttle.ComputeOptions(0)
+	options.setProfiler( profiler )
+	g.compute( invert, options )
+	assert_equals( profiler.getNbEvents(), 0 )
+
+	profiler.setEnabled()
+	g.compute( invert, options )
+	assert( profiler.getNbEvents() > 0 )
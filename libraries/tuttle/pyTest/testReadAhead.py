@@ -0,0 +1,38 @@
+# scons: pluginCheckerboard pluginInvert pluginPng
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+	tuttle.compute( [
+		tuttle.NodeInit( "tuttle.checkerboard", size=[64,48] ),
+		tuttle.NodeInit( "tuttle.invert" ),
+		tuttle.NodeInit( "tuttle.pngwriter", filename=".tests/readAhead/frame-####.png" ),
+		], tuttle.ComputeOptions( 0, 9 ) )
+
+
+def readSequence( readAhead ):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=".tests/readAhead/frame-####.png", readAhead=readAhead )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, read, tuttle.ComputeOptions( 0, 9 ) )
+	images = {}
+	for i in range( outputCache.size() ):
+		image = outputCache.get( i )
+		images[ outputCache.getTime( image ) ] = image.getNumpyImage()
+	return images
+
+
+def testReadAhead():
+	reference = readSequence( 0 )
+	withReadAhead = readSequence( 4 )
+
+	assert_equals( len( reference ), 10 )
+	assert_equals( sorted( withReadAhead.keys() ), sorted( reference.keys() ) )
+	for time, referenceImage in reference.items():
+		assert( numpy.array_equal( withReadAhead[time], referenceImage ) )
@@ -0,0 +1,83 @@
+# scons: pluginCheckerboard pluginInvert pluginGamma
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def testRenderCache():
+
+	renderCache = tuttle.core().getRenderCache()
+	renderCache.clear()
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	invert = g.createNode( "tuttle.invert" )
+	gamma = g.createNode( "tuttle.gamma", master=2.2 )
+	g.connect( [checker, invert, gamma] )
+
+	options = tuttle.ComputeOptions(0)
+	options.setUseRenderCache( True )
+
+	firstCache = tuttle.MemoryCache()
+	g.compute( firstCache, gamma, options )
+	assert_equals( renderCache.size(), 3 )
+
+	# same graph: the output is taken from the render cache
+	secondCache = tuttle.MemoryCache()
+	g.compute( secondCache, gamma, options )
+	assert_equals( renderCache.size(), 3 )
+	assert( numpy.array_equal( secondCache.get(0).getNumpyImage(), firstCache.get(0).getNumpyImage() ) )
+
+	# only the last node changes
+	gamma.getParam("master").setValue( 1.5 )
+	g.compute( gamma, options )
+	assert_equals( renderCache.size(), 4 )
+
+	renderCache.clear()
+	assert( renderCache.empty() )
+
+
+def computeFrames( g, node, options ):
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, node, options )
+	images = {}
+	for i in range( outputCache.size() ):
+		image = outputCache.get( i )
+		images[ outputCache.getTime( image ) ] = image.getNumpyArray()
+	return images
+
+
+def testRenderCacheParallelFrames():
+
+	renderCache = tuttle.core().getRenderCache()
+	renderCache.clear()
+
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	invert = g.createNode( "tuttle.invert" )
+	gamma = g.createNode( "tuttle.gamma" )
+	gamma.getParam("master").setValue( {0.0:0.5, 9.0:2.0} )
+	g.connect( [checker, invert, gamma] )
+
+	reference = computeFrames( g, gamma, tuttle.ComputeOptions(0, 9) )
+	assert_equals( len( reference ), 10 )
+
+	options = tuttle.ComputeOptions(0, 9)
+	options.setUseRenderCache( True )
+	options.setNbParallelFrames( 3 )
+
+	# the checkerboard and the invert are constant in time: all the frame
+	# lanes share their cached outputs
+	for i in range( 2 ):
+		images = computeFrames( g, gamma, options )
+		assert_equals( sorted( images.keys() ), sorted( reference.keys() ) )
+		for time, referenceImage in reference.items():
+			assert( numpy.array_equal( images[time], referenceImage ) )
+
+	renderCache.clear()
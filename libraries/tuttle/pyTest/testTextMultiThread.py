@@ -0,0 +1,43 @@
+# scons: pluginText
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def renderText( nbThreads, verticalFlip ):
+	preferences = tuttle.core().getPreferences()
+	previousNbThreads = preferences.getNbThreads()
+	preferences.setNbThreads( nbThreads )
+	try:
+		g = tuttle.Graph()
+		text = g.createNode( "tuttle.text", mode="size", size=[200, 81], text="TuttleOFX gjpqy", textSize=30, verticalFlip=verticalFlip )
+		outputCache = tuttle.MemoryCache()
+		g.compute( outputCache, text )
+		return outputCache.get(0).getNumpyArray()
+	finally:
+		preferences.setNbThreads( previousNbThreads )
+
+
+def testTextMultiThread():
+	"""
+	Each render thread draws the slices of the glyphs in its rows:
+	the same image as a render on one thread, with and without vertical flip.
+	"""
+	single = renderText( 1, False )
+	singleFlipped = renderText( 1, True )
+	multi = renderText( 8, False )
+	multiFlipped = renderText( 8, True )
+
+	# the text is drawn
+	assert( single[:,:,3].max() > 0 )
+
+	assert( numpy.array_equal( multi, single ) )
+	assert( numpy.array_equal( multiFlipped, singleFlipped ) )
+	# the flip only mirrors the rows
+	assert( numpy.array_equal( multiFlipped, numpy.flipud( multi ) ) )
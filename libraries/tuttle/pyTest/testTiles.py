@@ -0,0 +1,34 @@
+# scons: pluginCheckerboard pluginInvert pluginGamma
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeGraph( options ):
+	g = tuttle.Graph()
+	checker = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	invert = g.createNode( "tuttle.invert" )
+	gamma = g.createNode( "tuttle.gamma", master=2.2 )
+	g.connect( [checker, invert, gamma] )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, gamma, options )
+	return outputCache.get(0).getNumpyImage()
+
+
+def testTiles():
+
+	fullFrame = computeGraph( tuttle.ComputeOptions(0) )
+
+	options = tuttle.ComputeOptions(0)
+	options.setTileSize( 100 )
+	tiled = computeGraph( options )
+
+	assert_equals( tiled.shape, fullFrame.shape )
+	assert( numpy.array_equal( tiled, fullFrame ) )
@@ -0,0 +1,49 @@
+# scons: pluginConstant pluginPng
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def writeSequence( directory, writeBehind ):
+	g = tuttle.Graph()
+	# the content of each frame is different, to detect the frames written
+	# at the wrong time or in the wrong file
+	constant = g.createNode( "tuttle.constant", size=[64,48] )
+	color = constant.getParam( "color" )
+	color.setValueAtTime( 0., 0. )
+	color.setValueAtTime( 9., .9 )
+	write = g.createNode( "tuttle.pngwriter", filename=directory+"/frame-####.png", writeBehind=writeBehind )
+	g.connect( constant, write )
+	g.compute( write, tuttle.ComputeOptions( 0, 9 ) )
+
+
+def readSequence( directory ):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=directory+"/frame-####.png", bitDepth="8i" )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, read, tuttle.ComputeOptions( 0, 9 ) )
+	images = {}
+	for i in range( outputCache.size() ):
+		image = outputCache.get( i )
+		images[ outputCache.getTime( image ) ] = image.getNumpyArray()
+	return images
+
+
+def testWriteBehind():
+	writeSequence( ".tests/writeBehind/sync", 0 )
+	writeSequence( ".tests/writeBehind/async", 3 )
+
+	reference = readSequence( ".tests/writeBehind/sync" )
+	withWriteBehind = readSequence( ".tests/writeBehind/async" )
+
+	assert_equals( len( reference ), 10 )
+	assert_equals( sorted( withWriteBehind.keys() ), sorted( reference.keys() ) )
+	for time, referenceImage in reference.items():
+		# each file contains the frame of its time
+		expected = 255 * time / 10.
+		assert_almost_equal( float( referenceImage[0,0,0] ), expected, delta=1.5 )
+		assert_almost_equal( float( withWriteBehind[time][0,0,0] ), expected, delta=1.5 )
+		assert( numpy.array_equal( withWriteBehind[time], referenceImage ) )
@@ -0,0 +1,58 @@
+# scons: pluginMemoryBuffer pluginInvert
+
+from pyTuttle import tuttle
+import numpy
+
+from nose.tools import *
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def bufferAddress( array ):
+	return array.__array_interface__['data'][0]
+
+
+def testBorrowedInputAndSharedOutput():
+	"""
+	The numpy array flows from the input buffer to the output buffer without copy.
+	"""
+	array = numpy.random.rand( 48, 64, 4 ).astype( numpy.float32 )
+
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.setBorrowedNumpyArray( array )
+	ob = g.createOutputBuffer()
+	ob.setShareSourceBuffer()
+	g.connect( ib.getNode(), ob.getNode() )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, ob.getNode() )
+
+	view = outputCache.get(0).getNumpyArrayView()
+	assert_equals( view.shape, array.shape )
+	assert( numpy.array_equal( view, array ) )
+	assert_equals( bufferAddress( view ), bufferAddress( array ) )
+
+
+def testBorrowedInputWithProcessing():
+	"""
+	The borrowed buffer is used as the input image of the next node.
+	"""
+	array = numpy.random.rand( 32, 16, 4 ).astype( numpy.float32 )
+
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.setBorrowedNumpyArray( array )
+	invert = g.createNode( "tuttle.invert" )
+	g.connect( ib.getNode(), invert )
+
+	outputCache = tuttle.MemoryCache()
+	g.compute( outputCache, invert )
+
+	# the view keeps the output buffer after the release of the cache
+	view = outputCache.get(0).getNumpyArrayView()
+	outputCache.clearAll()
+	assert_not_equals( bufferAddress( view ), bufferAddress( array ) )
+	assert( numpy.allclose( view[:,:,0:3], 1.0 - array[:,:,0:3] ) )
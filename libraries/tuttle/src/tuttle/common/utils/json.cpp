@@ -0,0 +1,30 @@
+#include "json.hpp"
+
+#include <boost/foreach.hpp>
+
+namespace tuttle {
+namespace common {
+
+void writeJsonString( std::ostream& os, const std::string& s )
+{
+	os << '"';
+	BOOST_FOREACH( const char c, s )
+	{
+		switch( c )
+		{
+			case '"': os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\n': os << "\\n"; break;
+			case '\t': os << "\\t"; break;
+			default:
+				if( static_cast<unsigned char>( c ) < 0x20 )
+					os << ' ';
+				else
+					os << c;
+		}
+	}
+	os << '"';
+}
+
+}
+}
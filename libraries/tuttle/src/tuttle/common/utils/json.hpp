@@ -0,0 +1,19 @@
+#ifndef _TUTTLE_COMMON_JSON_HPP_
+#define _TUTTLE_COMMON_JSON_HPP_
+
+#include <ostream>
+#include <string>
+
+namespace tuttle {
+namespace common {
+
+/**
+ * @brief Write @p s as a quoted JSON string, with the quotes and backslashes escaped.
+ * The other control characters are replaced by spaces.
+ */
+void writeJsonString( std::ostream& os, const std::string& s );
+
+}
+}
+
+#endif
@@ -7,6 +7,8 @@
 
 #include <tuttle/common/utils/Formatter.hpp>
 
+#include "Profiler.hpp"
+
 #include <tuttle/common/atomic.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -115,6 +117,10 @@ public:
 		_forceIdentityNodesProcess = other._forceIdentityNodesProcess;
 		_returnBuffers = other._returnBuffers;
 		_isInteractive = other._isInteractive;
+		_nbParallelFrames = other._nbParallelFrames;
+		_tileSize = other._tileSize;
+		_useRenderCache = other._useRenderCache;
+		_profiler = other._profiler;
 
 		// don't modify the abort status?
 		//_abort.store( false, boost::memory_order_relaxed );
@@ -133,6 +139,9 @@ private:
 		setColorEnable              ( false );
 		setIsInteractive            ( false );
 		setForceIdentityNodesProcess( false );
+		setNbParallelFrames         ( 1     );
+		setTileSize                 ( 0     );
+		setUseRenderCache           ( false );
 	}
 	
 public:
@@ -260,6 +269,45 @@ public:
 	}
 	bool getForceIdentityNodesProcess() const { return _forceIdentityNodesProcess; }
 	
+	/**
+	 * @brief Number of frames rendered at the same time.
+	 * Each frame in flight uses its own copy of the graph nodes,
+	 * so the memory used grows with this value.
+	 * Frames are still returned (and progress handles called) in time order.
+	 * 0 means one frame per thread of the host thread pool, 1 disables frame-parallel rendering.
+	 */
+	This& setNbParallelFrames( const std::size_t v )
+	{
+		_nbParallelFrames = v;
+		return *this;
+	}
+	std::size_t getNbParallelFrames() const { return _nbParallelFrames; }
+	
+	/**
+	 * @brief Size in pixels of the tiles used to render the nodes supporting tiles.
+	 * A chain of nodes supporting tiles is rendered tile by tile, so the intermediate
+	 * nodes only allocate tile buffers. Nodes without tiles support still use full frames.
+	 * 0 disables tiled rendering.
+	 */
+	This& setTileSize( const std::size_t v )
+	{
+		_tileSize = v;
+		return *this;
+	}
+	std::size_t getTileSize() const { return _tileSize; }
+	
+	/**
+	 * @brief Keep the output of the nodes in the core render cache, indexed by their global hash.
+	 * A node already in the cache is not computed again, nor all its input nodes.
+	 * Useful for interactive computations, where only a few parameters change between two computations.
+	 */
+	This& setUseRenderCache( const bool v = true )
+	{
+		_useRenderCache = v;
+		return *this;
+	}
+	bool getUseRenderCache() const { return _useRenderCache; }
+	
 	/**
 	 * @brief The application would like to abort the process (from another thread).
 	 */
@@ -272,6 +320,26 @@ public:
 	 */
 	bool getAbort() const { return _abort.load( boost::memory_order_relaxed ); }
 
+	/**
+	 * @brief Record the cost of each node, for each frame and each phase of the computation.
+	 * The same profiler could be used by several computations, the events are accumulated.
+	 */
+	This& setProfiler( boost::shared_ptr<Profiler> profiler )
+	{
+		_profiler = profiler;
+		return *this;
+	}
+	boost::shared_ptr<Profiler> getProfiler() const { return _profiler; }
+	/**
+	 * @brief The profiler to use during the computation, NULL if there is no profiler or if it is disabled.
+	 */
+	Profiler* getActiveProfiler() const
+	{
+		if( _profiler.get() == NULL || ! _profiler->isEnabled() )
+			return NULL;
+		return _profiler.get();
+	}
+
 	/**
 	* @brief A handle to follow the progress (start, end...) of the compute
 	*/
@@ -327,10 +395,14 @@ private:
 	bool _forceIdentityNodesProcess;
 	bool _returnBuffers;
 	bool _isInteractive;
+	std::size_t _nbParallelFrames;
+	std::size_t _tileSize;
+	bool _useRenderCache;
 	
 	boost::atomic_bool _abort;
 
 	boost::shared_ptr<IProgressHandle> _progressHandle;
+	boost::shared_ptr<Profiler> _profiler;
 };
 
 }
@@ -1,4 +1,5 @@
 %include <tuttle/host/global.i>
+%include <tuttle/host/Profiler.i>
 
 %include <boost_shared_ptr.i>
 %include <std_list.i>
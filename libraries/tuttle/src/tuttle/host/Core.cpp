@@ -58,6 +58,7 @@ Core::Core()
 	_pluginCache.registerAPICache( _imageEffectPluginCache );
 
 	_memoryPool.updateMemoryAuthorizedWithRAM();
+	_renderCache.setMaxMemorySize( _memoryPool.getMaxMemorySize() / 4 );
 	//	preload();
 }
 
@@ -3,8 +3,10 @@
 
 #include "version.hpp"
 #include "Preferences.hpp"
+#include "ThreadPool.hpp"
 
 #include <tuttle/host/memory/IMemoryCache.hpp>
+#include <tuttle/host/memory/RenderCache.hpp>
 #include <tuttle/host/HostDescriptor.hpp>
 #include <tuttle/host/ofx/OfxhPluginCache.hpp>
 #include <tuttle/host/ofx/OfxhImageEffectPluginCache.hpp>
@@ -34,10 +36,12 @@ private:
 	ofx::OfxhPluginCache _pluginCache;
 	memory::IMemoryPool& _memoryPool;
 	memory::IMemoryCache& _memoryCache;
+	memory::RenderCache _renderCache;
 	bool _isPreloaded;
 	boost::shared_ptr<tuttle::common::Formatter> _formatter;
 	
 	Preferences _preferences;
+	ThreadPool _threadPool;
 
 public:
 	      ofx::OfxhPluginCache& getPluginCache()       { return _pluginCache; }
@@ -52,6 +56,15 @@ public:
 	      Preferences& getPreferences()       { return _preferences; }
 	const Preferences& getPreferences() const { return _preferences; }
 
+	/**
+	 * @brief Host-wide thread pool, sized with Preferences::getNbThreads().
+	 */
+	ThreadPool& getThreadPool()
+	{
+		_threadPool.setNbThreads( _preferences.getNbThreads() );
+		return _threadPool;
+	}
+
 public:
 	const ofx::imageEffect::OfxhImageEffectPluginCache& getImageEffectPluginCache() const { return _imageEffectPluginCache; }
 
@@ -60,6 +73,12 @@ public:
 	memory::IMemoryCache&       getMemoryCache()       { return _memoryCache; }
 	const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
 
+	/**
+	 * @brief Output images of the nodes kept across computations (see ComputeOptions::setUseRenderCache).
+	 */
+	memory::RenderCache&        getRenderCache()       { return _renderCache; }
+	const memory::RenderCache&  getRenderCache() const { return _renderCache; }
+
 public:
 	ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById( const std::string& id, int vermaj = -1, int vermin = -1 )
 	{
@@ -3,6 +3,7 @@
 %include <tuttle/host/HostDescriptor.i>
 %include <tuttle/host/memory/MemoryCache.i>
 %include <tuttle/host/memory/MemoryPool.i>
+%include <tuttle/host/memory/RenderCache.i>
 %include <tuttle/host/ofx/OfxhPlugin.i>
 %include <tuttle/host/ofx/OfxhPluginCache.i>
 %include <tuttle/host/ofx/OfxhImageEffectPluginCache.i>
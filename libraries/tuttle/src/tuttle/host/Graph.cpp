@@ -123,6 +123,7 @@ void Graph::renameNode( Graph::Node& node, const std::string& newUniqueName )
 void Graph::addToInternalGraph( Node& node )
 {
 	//TUTTLE_TLOG( TUTTLE_INFO, "Graph::addToInternalGraph: " << node.getName() );
+	invalidateProcessGraph();
 	Vertex v( node.getName(), node );
 	_graph.addVertex( v );
 }
@@ -130,6 +131,7 @@ void Graph::addToInternalGraph( Node& node )
 void Graph::removeFromInternalGraph( Node& node )
 {
 	//TUTTLE_TLOG( TUTTLE_INFO, "Graph::removeFromInternalGraph: " << node.getName() );
+	invalidateProcessGraph();
 	const unsigned int id = _graph.getVertexDescriptor( node.getName() );
 	_graph.removeVertex( id );
 }
@@ -156,8 +158,14 @@ std::size_t Graph::deleteUnconnectedNodes( const Node& node )
 	return toRemove.size();
 }
 
+void Graph::invalidateProcessGraph()
+{
+	_processGraph.reset();
+}
+
 void Graph::clear()
 {
+	invalidateProcessGraph();
 	_graph.clear();
 	_nodesMap.clear();
 	_instanceCount.clear();
@@ -232,16 +240,19 @@ void Graph::connect( const std::vector<Node*>& nodes )
 
 void Graph::connect( const Node& outNode, const Attribute& inAttr )
 {
+	invalidateProcessGraph();
 	_graph.connect( outNode.getName(), inAttr.getNode().getName(), inAttr.getName() );
 }
 
 void Graph::connect( const Attribute& outAttr, const Attribute& inAttr )
 {
+	invalidateProcessGraph();
 	_graph.connect( outAttr.getNode().getName(), inAttr.getNode().getName(), inAttr.getName() );
 }
 
 void Graph::unconnect( const Attribute& outAttr, const Attribute& inAttr )
 {
+	invalidateProcessGraph();
 	_graph.unconnect( outAttr.getNode().getName(), inAttr.getNode().getName(), inAttr.getName() );
 }
 
@@ -275,6 +286,7 @@ void Graph::init()
 
 void Graph::unconnect( const Node& node )
 {
+	invalidateProcessGraph();
 	_graph.clearVertex( _graph.getVertexDescriptor(node.getName()) );
 }
 
@@ -372,8 +384,27 @@ bool Graph::compute( memory::IMemoryCache& memoryCache, const NodeListArg& nodes
 	graph::exportAsDOT( "graph.dot", _graph );
 #endif
 	
-	graph::ProcessGraph procGraph( options, *this, nodes.getNodes(), internMemoryCache );
-	return procGraph.process( memoryCache );
+	const std::list<std::string> outputNodes = nodes.getNodes();
+	if( _processGraph && _processGraph->isCompiledFor( outputNodes, internMemoryCache ) )
+	{
+		TUTTLE_TLOG( TUTTLE_INFO, "[Graph] reuse the compiled graph" );
+		_processGraph->setOptions( options );
+	}
+	else
+	{
+		_processGraph.reset( new graph::ProcessGraph( options, *this, outputNodes, internMemoryCache ) );
+	}
+
+	try
+	{
+		return _processGraph->process( memoryCache );
+	}
+	catch(...)
+	{
+		// don't reuse a graph in an unknown state
+		invalidateProcessGraph();
+		throw;
+	}
 }
 
 std::vector<const Graph::Node*> Graph::getNodes() const
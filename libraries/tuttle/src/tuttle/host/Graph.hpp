@@ -19,6 +19,7 @@
 #include <tuttle/common/utils/global.hpp>
 
 #include <boost/ptr_container/ptr_map.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <stdexcept>
 #include <string>
@@ -30,6 +31,9 @@ namespace tuttle {
 namespace host {
 
 class NodeInit;
+namespace graph {
+class ProcessGraph;
+}
 
 /**
  * @brief A user graph to manipulate OpenFX nodes.
@@ -217,10 +221,14 @@ private:
 	InternalGraphImpl _graph;
 	NodeMap _nodesMap;
 	InstanceCountMap _instanceCount; ///< used to assign a unique name to each node
+	/// Graph compiled by the last compute, reused by the next computes
+	/// while the topology doesn't change. Only the modified nodes need a new setup.
+	boost::scoped_ptr<graph::ProcessGraph> _processGraph;
 
 private:
 	void addToInternalGraph( Node& node );
 	void removeFromInternalGraph( Node& node );
+	void invalidateProcessGraph();
 };
 
 }
@@ -65,10 +65,12 @@ public:
 	INode()
 		: _data(NULL)
 		, _beforeRenderCallback(0)
+		, _revision(0)
 	{}
 	INode( const INode& e )
 		: _data(NULL)
 		, _beforeRenderCallback(0)
+		, _revision(0)
 	{}
 	
 	virtual ~INode();
@@ -117,6 +119,12 @@ public:
 
 	virtual std::size_t getLocalHashAtTime( const OfxTime time ) const = 0;
 
+	/**
+	 * @brief Revision of the node, incremented at each modification of its parameters.
+	 * The compiled ProcessGraph only setup again the nodes modified since the last compute.
+	 */
+	std::size_t getRevision() const { return _revision; }
+	void incrementRevision() { ++_revision; }
 
 
 #ifndef SWIG
@@ -225,6 +233,7 @@ public:
 protected:
 	Data* _data; ///< link to external datas
 	DataAtTimeMap _dataAtTime; ///< link to external datas at each time
+	std::size_t _revision; ///< see getRevision()
 
 public:
 	void setProcessData( Data* data );
@@ -4,6 +4,7 @@
 // ofx host
 #include <tuttle/host/Core.hpp> // for core().getMemoryCache()
 #include <tuttle/host/attribute/ClipImage.hpp>
+#include <tuttle/host/attribute/Image.hpp>
 #include <tuttle/host/attribute/allParams.hpp>
 #include <tuttle/host/graph/ProcessEdgeAtTime.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
@@ -34,6 +35,7 @@
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
@@ -42,12 +44,25 @@
 namespace tuttle {
 namespace host {
 
+namespace {
+
+template<class Rect>
+bool sameRect( const Rect& a, const Rect& b )
+{
+	return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2;
+}
+
+}
+
 ImageEffectNode::ImageEffectNode(
 		tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin& plugin,
 		tuttle::host::ofx::imageEffect::OfxhImageEffectNodeDescriptor& desc,
 		const std::string& context )
 	: tuttle::host::ofx::imageEffect::OfxhImageEffectNode( plugin, desc, context, false )
 	, _defaultOutputFielding( kOfxImageFieldNone )
+	, _borrowedOutputRowDistanceBytes( 0 )
+	, _borrowedOutputOrientation( attribute::Image::eImageOrientationFromBottomToTop )
+	, _outputSharesSourceData( false )
 {
 	populate();
 	//	createInstanceAction();
@@ -57,6 +72,10 @@ ImageEffectNode::ImageEffectNode( const ImageEffectNode& other )
 	: INode( other )
 	, tuttle::host::ofx::imageEffect::OfxhImageEffectNode( other )
 	, _defaultOutputFielding( other._defaultOutputFielding )
+	, _borrowedOutputData( other._borrowedOutputData )
+	, _borrowedOutputRowDistanceBytes( other._borrowedOutputRowDistanceBytes )
+	, _borrowedOutputOrientation( other._borrowedOutputOrientation )
+	, _outputSharesSourceData( other._outputSharesSourceData )
 {
 	populate();
 	copyAttributesValues( other ); // values need to be setted before the createInstanceAction !
@@ -90,6 +109,34 @@ void ImageEffectNode::connect( const INode& sourceEffect, attribute::Attribute&
 	inputClip.setConnectedClip( outputClip );
 }
 
+void ImageEffectNode::paramChanged( const ofx::attribute::OfxhParam& param, const ofx::attribute::EChange change )
+{
+	if( change != ofx::attribute::eChangeTime )
+	{
+		incrementRevision();
+		_paramsRevision[param.getName()] = getRevision();
+	}
+	ofx::imageEffect::OfxhImageEffectNode::paramChanged( param, change );
+}
+
+void ImageEffectNode::synchronizeParams( const ImageEffectNode& other, const std::size_t sinceRevision )
+{
+	typedef std::map<std::string, std::size_t> RevisionMap;
+	BOOST_FOREACH( const RevisionMap::value_type& p, other._paramsRevision )
+	{
+		if( p.second <= sinceRevision )
+			continue;
+		ofx::attribute::OfxhParam& param = getParam( p.first );
+		param.copy( other.getParam( p.first ) );
+		paramChanged( param, ofx::attribute::eChangePluginEdited );
+	}
+	// the external buffer goes with the parameters describing it
+	_borrowedOutputData = other._borrowedOutputData;
+	_borrowedOutputRowDistanceBytes = other._borrowedOutputRowDistanceBytes;
+	_borrowedOutputOrientation = other._borrowedOutputOrientation;
+	_outputSharesSourceData = other._outputSharesSourceData;
+}
+
 attribute::Attribute& ImageEffectNode::getSingleInputAttribute()
 {
 	ofx::attribute::OfxhClipImageSet::ClipImageVector& clips = getClipsByOrder();
@@ -800,7 +847,17 @@ void ImageEffectNode::preProcess1( graph::ProcessVertexAtTimeData& vData )
 //	TUTTLE_TLOG_VAR( TUTTLE_INFO, &getData(vData._time) );
 //	TUTTLE_TLOG_VAR( TUTTLE_INFO, &vData );
 	vData._apiImageEffect._renderRoD = rod;
-	vData._apiImageEffect._renderRoI = rod; ///< @todo tuttle: tile supports
+	// A final node renders its whole RoD, the RoI of the other nodes
+	// is the union of the RoIs requested by the nodes using them (see preProcess2).
+	if( vData._isFinalNode )
+	{
+		vData._apiImageEffect._renderRoI = rod;
+	}
+	else
+	{
+		const OfxRectD emptyRoI = { 0, 0, 0, 0 };
+		vData._apiImageEffect._renderRoI = emptyRoI;
+	}
 
 	TUTTLE_TLOG( TUTTLE_INFO, "[Pre Process 1] rod: x1:" << rod.x1 << " y1:" << rod.y1 << " x2:" << rod.x2 << " y2:" << rod.y2 );
 }
@@ -809,6 +866,15 @@ void ImageEffectNode::preProcess2_reverse( graph::ProcessVertexAtTimeData& vData
 {
 //	TUTTLE_TLOG( TUTTLE_INFO, "preProcess2_finish: " << getName() << " at time: " << vData._time );
 
+	// The RoI has been accumulated from the requests of the nodes using this one.
+	// Without tiles support, the plugin expects to render its whole RoD.
+	if( ofx::isEmpty( vData._apiImageEffect._renderRoI ) || ! supportsTileRender() )
+		vData._apiImageEffect._renderRoI = vData._apiImageEffect._renderRoD;
+	else
+		vData._apiImageEffect._renderRoI = ofx::clamp( vData._apiImageEffect._renderRoI, vData._apiImageEffect._renderRoD );
+
+	TUTTLE_TLOG( TUTTLE_INFO, "[Pre Process 2] " << getName() << " roi: " << vData._apiImageEffect._renderRoI );
+
 	getRegionOfInterestAction( vData._time,
 				   vData._nodeData->_renderScale,
 				   vData._apiImageEffect._renderRoI,
@@ -836,14 +902,138 @@ bool ImageEffectNode::isIdentity( const graph::ProcessVertexAtTimeData& vData, s
 void ImageEffectNode::preProcess_infos( const graph::ProcessVertexAtTimeData& vData, const OfxTime time, graph::ProcessVertexAtTimeInfo& nodeInfos ) const
 {
 //	TUTTLE_TLOG( TUTTLE_INFO, "preProcess_infos: " << getName() );
-	const OfxRectD rod             = vData._apiImageEffect._renderRoD;
+	const OfxRectD roi             = vData._apiImageEffect._renderRoI;
 	const std::size_t bitDepth     = this->getOutputClip().getBitDepth(); // value in bytes
 	const std::size_t nbComponents = getOutputClip().getNbComponents();
-	nodeInfos._memory = std::ceil( ( rod.x2 - rod.x1 ) * ( rod.y2 - rod.y1 ) * nbComponents * bitDepth );
+	nodeInfos._memory = std::ceil( ( roi.x2 - roi.x1 ) * ( roi.y2 - roi.y1 ) * nbComponents * bitDepth );
 }
 
 
+bool ImageEffectNode::supportsTileRender() const
+{
+	return supportsTiles() && getOutputClip().supportsTiles();
+}
+
 void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
+{
+	allocateOutputImages( vData, vData._apiImageEffect._renderRoI );
+	render( vData, vData._apiImageEffect._renderRoI );
+	releaseInputImages( vData );
+	declareOutputUsages( vData );
+}
+
+/**
+ * @brief Create the output images with @p bounds and put them in the memory cache.
+ * Replace the images of a previous call, so a node rendered tile by tile reuses the same tile buffer.
+ */
+void ImageEffectNode::allocateOutputImages( graph::ProcessVertexAtTimeData& vData, const OfxRectD& bounds )
+{
+	try
+	{
+		memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
+
+		TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Acquire needed output clip images" );
+		BOOST_FOREACH( ClipImageMap::value_type& i, _clipImages )
+		{
+			attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>( *( i.second ) );
+			if( clip.isOutput() )
+			{
+				TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] " << bounds );
+				{
+					// release the previous buffer before allocating the new one
+					const memory::CACHE_ELEMENT previousImage( memoryCache.get( clip.getClipIdentifier(), vData._time ) );
+					if( previousImage.get() != NULL )
+						memoryCache.remove( previousImage );
+				}
+				memory::CACHE_ELEMENT imageCache( createSharedOutputImage( clip, vData, bounds ) );
+				if( imageCache.get() == NULL )
+				{
+					imageCache.reset( new attribute::Image(
+							clip,
+							vData._time,
+							bounds,
+							attribute::Image::eImageOrientationFromBottomToTop,
+							0 )
+						);
+					imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+				}
+				memoryCache.put( clip.getClipIdentifier(), vData._time, imageCache );
+			}
+		}
+	}
+	catch(boost::exception& e)
+	{
+		e << exception::time(vData._time)
+		  << exception::pluginIdentifier(this->getPlugin().getIdentifier())
+		  << exception::nodeName(this->getName());
+		throw;
+	}
+}
+
+void ImageEffectNode::setBorrowedOutputData( const memory::IPoolDataPtr& data, const int rowDistanceBytes, const attribute::Image::EImageOrientation orientation )
+{
+	_borrowedOutputData = data;
+	_borrowedOutputRowDistanceBytes = rowDistanceBytes;
+	_borrowedOutputOrientation = orientation;
+}
+
+void ImageEffectNode::clearBorrowedOutputData()
+{
+	_borrowedOutputData.reset();
+}
+
+/**
+ * @brief Create an output image without buffer copy, using the borrowed buffer
+ * or the buffer of the source image (see setBorrowedOutputData and setOutputSharesSourceData).
+ * @return an empty element if the output image needs its own buffer.
+ */
+memory::CACHE_ELEMENT ImageEffectNode::createSharedOutputImage( attribute::ClipImage& clip, graph::ProcessVertexAtTimeData& vData, const OfxRectD& bounds )
+{
+	if( _borrowedOutputData.get() != NULL && sameRect( bounds, vData._apiImageEffect._renderRoD ) )
+	{
+		memory::CACHE_ELEMENT image( new attribute::Image( clip, vData._time, bounds, _borrowedOutputOrientation, _borrowedOutputRowDistanceBytes ) );
+		const OfxRectI pixelBounds = image->getBounds();
+		const std::size_t height = pixelBounds.y2 - pixelBounds.y1;
+		if( image->getMemorySize() / std::max( height, std::size_t( 1 ) ) <= std::size_t( image->getRowAbsDistanceBytes() ) &&
+		    height * image->getRowAbsDistanceBytes() <= _borrowedOutputData->size() )
+		{
+			TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] " << getName() << " uses a borrowed output buffer" );
+			image->setPoolData( _borrowedOutputData );
+			return image;
+		}
+		TUTTLE_LOG_WARNING( "[Node Process] The borrowed buffer of " << quotes( getName() ) << " is too small, use a copy." );
+	}
+	if( _outputSharesSourceData )
+	{
+		memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
+		BOOST_FOREACH( const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair, vData._inEdges )
+		{
+			const graph::ProcessEdgeAtTime* inEdge = inEdgePair.second;
+			if( inEdge->getInAttrName() != kOfxSimpleSourceAttributeName || inEdge->isTiled() )
+				continue;
+			const memory::CACHE_ELEMENT source( memoryCache.get( getClip( inEdge->getInAttrName() ).getClipIdentifier(), inEdge->getOutTime() ) );
+			if( source.get() == NULL )
+				break;
+			memory::CACHE_ELEMENT image( new attribute::Image( clip, vData._time, bounds, source->getOrientation(), source->getRowAbsDistanceBytes() ) );
+			if( sameRect( image->getBounds(), source->getBounds() ) &&
+			    image->getBitDepth() == source->getBitDepth() &&
+			    image->getComponentsType() == source->getComponentsType() )
+			{
+				TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] " << getName() << " shares the buffer of its source image" );
+				image->setPoolData( source->getPoolData() );
+				return image;
+			}
+			break;
+		}
+	}
+	return memory::CACHE_ELEMENT();
+}
+
+/**
+ * @brief Call the plugin render action on the @p roi region.
+ * All input and output images needs to be in the memory cache.
+ */
+void ImageEffectNode::render( graph::ProcessVertexAtTimeData& vData, const OfxRectD& roi )
 {
 	try
 	{
@@ -855,10 +1045,10 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 		if( par == 0.0 )
 			par = 1.0;
 		const OfxRectI renderWindow = {
-			boost::numeric_cast<int>( std::floor( vData._apiImageEffect._renderRoI.x1 / par ) ),
-			boost::numeric_cast<int>( std::floor( vData._apiImageEffect._renderRoI.y1 ) ),
-			boost::numeric_cast<int>( std::ceil( vData._apiImageEffect._renderRoI.x2 / par ) ),
-			boost::numeric_cast<int>( std::ceil( vData._apiImageEffect._renderRoI.y2 ) )
+			boost::numeric_cast<int>( std::floor( roi.x1 / par ) ),
+			boost::numeric_cast<int>( std::floor( roi.y1 ) ),
+			boost::numeric_cast<int>( std::ceil( roi.x2 / par ) ),
+			boost::numeric_cast<int>( std::ceil( roi.y2 ) )
 		};
 //		TUTTLE_TLOG_VAR( TUTTLE_INFO, roi );
 
@@ -902,23 +1092,17 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 			allNeededDatas.push_back( imageCache );
 		}
 
-		TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Acquire needed output clip images" );
 		BOOST_FOREACH( ClipImageMap::value_type& i, _clipImages )
 		{
 			attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>( *( i.second ) );
 			if( clip.isOutput() )
 			{
-				TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] " << vData._apiImageEffect._renderRoI );
-				memory::CACHE_ELEMENT imageCache( new attribute::Image(
-						clip,
-						vData._time,
-						vData._apiImageEffect._renderRoI,
-						attribute::Image::eImageOrientationFromBottomToTop,
-						0 )
-					);
-				imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
-				memoryCache.put( clip.getClipIdentifier(), vData._time, imageCache );
-
+				memory::CACHE_ELEMENT imageCache( memoryCache.get( clip.getClipIdentifier(), vData._time ) );
+				if( imageCache.get() == NULL )
+				{
+					BOOST_THROW_EXCEPTION( exception::Memory()
+						<< exception::dev() + "Output clip " + quotes( clip.getFullName() ) + " at time " + vData._time + " not in memory cache (identifier:" + quotes( clip.getClipIdentifier() ) + ")." );
+				}
 				allNeededDatas.push_back( imageCache );
 			}
 		}
@@ -933,11 +1117,34 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 		TUTTLE_LOG_TRACE( "[Node Process] Plugin Render Action - End" );
 
 		debugOutputImage( vData._time );
+	}
+	catch(boost::exception& e)
+	{
+		e << exception::time(vData._time)
+		  << exception::pluginIdentifier(this->getPlugin().getIdentifier())
+		  << exception::nodeName(this->getName());
+		throw;
+	}
+}
+
+/**
+ * @brief Release the references of this node on its input images.
+ * A node rendered by tiles releases its tiled inputs after each tile,
+ * and its full frame inputs once at the end.
+ */
+void ImageEffectNode::releaseInputImages( graph::ProcessVertexAtTimeData& vData, const EInputImages inputs )
+{
+	try
+	{
+		memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
 
-		// release input images
 		BOOST_FOREACH( const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair, vData._inEdges )
 		{
 			const graph::ProcessEdgeAtTime* inEdge = inEdgePair.second;
+			if( ( inputs == eInputImagesTiled && ! inEdge->isTiled() ) ||
+			    ( inputs == eInputImagesFullFrame && inEdge->isTiled() ) )
+				continue;
+
 			attribute::ClipImage& clip = getClip( inEdge->getInAttrName() );
 			const OfxTime outTime = inEdge->getOutTime();
 
@@ -955,6 +1162,24 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 			// TODO: use RAII technique for add/releaseReference...
 			imageCache->releaseReference( ofx::imageEffect::OfxhImage::eReferenceOwnerHost );
 		}
+	}
+	catch(boost::exception& e)
+	{
+		e << exception::time(vData._time)
+		  << exception::pluginIdentifier(this->getPlugin().getIdentifier())
+		  << exception::nodeName(this->getName());
+		throw;
+	}
+}
+
+/**
+ * @brief Add a reference on the output images for each node using them.
+ */
+void ImageEffectNode::declareOutputUsages( graph::ProcessVertexAtTimeData& vData )
+{
+	try
+	{
+		memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
 
 		// declare future usages of the output
 		BOOST_FOREACH( ClipImageMap::value_type& item, _clipImages )
@@ -992,7 +1217,6 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 		  << exception::nodeName(this->getName());
 		throw;
 	}
-
 }
 
 void ImageEffectNode::postProcess( graph::ProcessVertexAtTimeData& vData )
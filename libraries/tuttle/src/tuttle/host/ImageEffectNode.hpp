@@ -5,6 +5,8 @@
 
 #include <tuttle/host/attribute/Param.hpp>
 #include <tuttle/host/attribute/ClipImage.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/memory/IMemoryCache.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
 #include <tuttle/host/graph/ProcessVertexAtTimeData.hpp>
 
@@ -67,6 +69,15 @@ public:
 
 	void connect( const INode& sourceEffect, attribute::Attribute& attr );
 
+	/// @brief Increment the node revision and call the plugin instance changed action.
+	void paramChanged( const ofx::attribute::OfxhParam& param, const ofx::attribute::EChange change );
+
+	/**
+	 * @brief Copy the parameters of @p other modified after its revision @p sinceRevision.
+	 * The plugin is notified of each copied parameter, like if it was set.
+	 */
+	void synchronizeParams( const ImageEffectNode& other, const std::size_t sinceRevision );
+
 	attribute::ClipImage&       getClip( const std::string& name, const bool acceptPartialName = false )       { return dynamic_cast<attribute::ClipImage&>( ofx::attribute::OfxhClipImageSet::getClip( name, acceptPartialName ) ); }
 	const attribute::ClipImage& getClip( const std::string& name, const bool acceptPartialName = false ) const { return dynamic_cast<const attribute::ClipImage&>( ofx::attribute::OfxhClipImageSet::getClip( name, acceptPartialName ) ); }
 
@@ -123,6 +134,49 @@ public:
 	void endSequence( graph::ProcessVertexData& vData );
 	/// @}
 
+	/// @group Tiled process
+	/// process() is split in these steps, so the process graph can
+	/// render a node tile by tile (see ProcessGraph::processTiles).
+	/// @{
+	enum EInputImages
+	{
+		eInputImagesAll,
+		eInputImagesTiled, ///< inputs rendered tile by tile for this node
+		eInputImagesFullFrame ///< inputs rendered once for all tiles
+	};
+
+	/**
+	 * @brief The node supports tiles on its effect and its output clip,
+	 * so its output can be rendered tile by tile.
+	 */
+	bool supportsTileRender() const;
+
+	void allocateOutputImages( graph::ProcessVertexAtTimeData& vData, const OfxRectD& bounds );
+	void render( graph::ProcessVertexAtTimeData& vData, const OfxRectD& roi );
+	void releaseInputImages( graph::ProcessVertexAtTimeData& vData, const EInputImages inputs = eInputImagesAll );
+	void declareOutputUsages( graph::ProcessVertexAtTimeData& vData );
+	/// @}
+
+	/// @group Zero-copy output images
+	/// @{
+	/**
+	 * @brief Use an external buffer as the output image of the node, instead of a buffer of the MemoryPool.
+	 * The buffer is only used if the whole region of definition is rendered,
+	 * the plugin sees it as its output image and doesn't need to fill it.
+	 * The node keeps a reference on @p data until another buffer is set (see memory::LinkData).
+	 */
+	void setBorrowedOutputData( const memory::IPoolDataPtr& data, const int rowDistanceBytes, const attribute::Image::EImageOrientation orientation );
+	void clearBorrowedOutputData();
+
+	/**
+	 * @brief The output image shares the buffer of the source image, if they have the same layout.
+	 * Only for the nodes copying their source to their output, the plugin sees its
+	 * output image at the same address as its source image.
+	 */
+	void setOutputSharesSourceData( const bool share = true ) { _outputSharesSourceData = share; }
+	bool getOutputSharesSourceData() const { return _outputSharesSourceData; }
+	/// @}
+
 	std::ostream& print( std::ostream& os ) const;
 
 	friend std::ostream& operator<<( std::ostream& os, const This& v );
@@ -264,6 +318,8 @@ public:
 private:
 	void checkClipsConnected() const;
 
+	memory::CACHE_ELEMENT createSharedOutputImage( attribute::ClipImage& clip, graph::ProcessVertexAtTimeData& vData, const OfxRectD& bounds );
+
 	void initComponents();
 	void initInputClipsPixelAspectRatio();
 	void initPixelAspectRatio();
@@ -278,6 +334,13 @@ private:
 	/// our clip is pretending to be progressive PAL SD, so return kOfxImageFieldNone
 	std::string _defaultOutputFielding;
 
+	std::map<std::string, std::size_t> _paramsRevision; ///< node revision of the last change of each parameter
+
+	memory::IPoolDataPtr _borrowedOutputData; ///< external buffer used as output image
+	int _borrowedOutputRowDistanceBytes;
+	attribute::Image::EImageOrientation _borrowedOutputOrientation;
+	bool _outputSharesSourceData;
+
 };
 
 }
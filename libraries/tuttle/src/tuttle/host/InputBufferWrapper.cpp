@@ -1,5 +1,6 @@
 #include "InputBufferWrapper.hpp"
 #include "Core.hpp"
+#include "ImageEffectNode.hpp"
 #include "exceptions.hpp"
 #include "memory/LinkData.hpp"
 
@@ -16,6 +17,37 @@ namespace host {
 
 using namespace boost::assign;
 
+namespace {
+
+std::size_t pixelMemorySize( const InputBufferWrapper::EPixelComponent components, const InputBufferWrapper::EBitDepth bitDepth )
+{
+	std::size_t nbComponents = 0;
+	switch( components )
+	{
+		case InputBufferWrapper::ePixelComponentRGBA:
+			nbComponents = 4;
+			break;
+		case InputBufferWrapper::ePixelComponentRGB:
+			nbComponents = 3;
+			break;
+		case InputBufferWrapper::ePixelComponentAlpha:
+			nbComponents = 1;
+			break;
+	}
+	switch( bitDepth )
+	{
+		case InputBufferWrapper::eBitDepthUByte:
+			return nbComponents;
+		case InputBufferWrapper::eBitDepthUShort:
+			return nbComponents * 2;
+		case InputBufferWrapper::eBitDepthFloat:
+			return nbComponents * 4;
+	}
+	return 0;
+}
+
+}
+
 void InputBufferWrapper::setMode( const EMode mode )
 {
 	static std::map<EMode, const char*> toString = map_list_of
@@ -27,6 +59,8 @@ void InputBufferWrapper::setMode( const EMode mode )
 
 void InputBufferWrapper::setBuffer( void* rawBuffer )
 {
+	// the plugin copies the new buffer
+	getNode().asImageEffectNode().clearBorrowedOutputData();
 	getNode().getParam( "bufferPointer" ).setValue(
 			boost::lexical_cast<std::string>( reinterpret_cast<std::ptrdiff_t>(rawBuffer) )
 		);
@@ -117,17 +151,29 @@ void InputBufferWrapper::setRawImageBuffer(
 	setBitDepth( bitDepth );
 	setRowDistanceSize( rowDistanceBytes );
 	setOrientation( orientation );
-	
-//	_outputClip.setComponents( components );
-//	_outputClip.setBitDepth( bitDepth );
-//	_imageCache.reset( new attribute::Image(
-//			_outputClip,
-//			0, // no time information
-//			rod,
-//			orientation,
-//			rowDistanceBytes
-//		) );
-//	_imageCache->setPoolData( new memory::LinkData( rawBuffer ) );
+}
+
+void InputBufferWrapper::setBorrowedRawImageBuffer(
+		void* rawBuffer,
+		const int width, const int height,
+		const EPixelComponent components,
+		const EBitDepth bitDepth,
+		const int rowDistanceBytes,
+		const EImageOrientation orientation,
+		CallbackReleaseBufferPtr release,
+		CustomDataPtr customData )
+{
+	const std::size_t rowBytes = rowDistanceBytes != 0 ? rowDistanceBytes : width * pixelMemorySize( components, bitDepth );
+	// owns the buffer from now, so the release callback is called even on error
+	memory::IPoolDataPtr data( new memory::LinkData( static_cast<char*>( rawBuffer ), rowBytes * height, release, customData ) );
+
+	setRawImageBuffer( rawBuffer, width, height, components, bitDepth, rowDistanceBytes, orientation );
+
+	// The plugin sees the buffer as its output image, and doesn't need to copy it.
+	getNode().asImageEffectNode().setBorrowedOutputData( data, rowBytes,
+		orientation == eImageOrientationFromTopToBottom ?
+			attribute::Image::eImageOrientationFromTopToBottom :
+			attribute::Image::eImageOrientationFromBottomToTop );
 }
 
 
@@ -143,6 +189,7 @@ void InputBufferWrapper::setRawImageBuffer(
 
 void InputBufferWrapper::setCallback( CallbackInputImagePtr callback, CustomDataPtr customData, CallbackDestroyCustomDataPtr destroyCustomData )
 {
+	getNode().asImageEffectNode().clearBorrowedOutputData();
 	getNode().getParam( "callbackPointer" ).setValue(
 			boost::lexical_cast<std::string>( reinterpret_cast<std::ptrdiff_t>( callback ) )
 		);
@@ -47,6 +47,7 @@ public:
 	typedef void* CustomDataPtr;
 	typedef void (*CallbackInputImagePtr)( OfxTime time, CustomDataPtr outputCustomData, void** rawdata, int* width, int* height, int* rowSizeBytes );
 	typedef void (*CallbackDestroyCustomDataPtr)( CustomDataPtr outputCustomData );
+	typedef void (*CallbackReleaseBufferPtr)( CustomDataPtr customData );
 
 private:
 	INode* _node;
@@ -162,6 +163,23 @@ public:
 			orientation );
 	}
 	
+	/**
+	 * @brief Use @p rawBuffer as the output image of the node, without copy.
+	 * The buffer is borrowed: the application must not modify or free it
+	 * until @p release is called with @p customData, when the node and
+	 * all the images using the buffer are released (or if this function fails).
+	 * If the node is not rendered on its whole region of definition, the buffer is copied.
+	 */
+	void setBorrowedRawImageBuffer(
+			void* rawBuffer,
+			const int width, const int height,
+			const EPixelComponent components,
+			const EBitDepth bitDepth,
+			const int rowDistanceBytes,
+			const EImageOrientation orientation,
+			CallbackReleaseBufferPtr release,
+			CustomDataPtr customData = NULL );
+	
 	void setCallback( CallbackInputImagePtr callback, CustomDataPtr customData = NULL, CallbackDestroyCustomDataPtr destroyCustomData = NULL );
 	
 };
@@ -99,6 +99,13 @@ import_array();
 		delete (Inputbuffer_python_customData*)object;
 	}
 	
+	void inputbuffer_release_array_callback( void* object )
+	{
+		SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+		Py_XDECREF( (PyObject*)object );
+		SWIG_PYTHON_THREAD_END_BLOCK;
+	}
+	
 	typedef void *PyFunc;
 %}
 
@@ -127,9 +134,78 @@ import_array();
 		SWIG_PYTHON_THREAD_END_BLOCK;
 	}
 	
+	/**
+	 * @brief Use the buffer of a numpy array as image, without copy.
+	 * The array is referenced until the node and all the images using it are released,
+	 * so it should not be modified in the meantime.
+	 */
+	void setBorrowedNumpyArray( PyObject* object, const tuttle::host::InputBufferWrapper::EImageOrientation orientation = tuttle::host::InputBufferWrapper::eImageOrientationFromTopToBottom )
+	{
+		SWIG_PYTHON_THREAD_BEGIN_BLOCK;
+		if( ! PyArray_Check( object ) )
+		{
+			PyErr_SetString( PyExc_TypeError, "Expected a numpy array" );
+			SWIG_PYTHON_THREAD_END_BLOCK;
+			return;
+		}
+		PyArrayObject* array = (PyArrayObject*)object;
+		const int nbDims = PyArray_NDIM( array );
+		const int nbComponents = nbDims == 3 ? static_cast<int>( PyArray_DIM( array, 2 ) ) : 1;
+		if( ( nbDims != 2 && nbDims != 3 ) || ! PyArray_IS_C_CONTIGUOUS( array ) || ! PyArray_ISALIGNED( array ) )
+		{
+			PyErr_SetString( PyExc_ValueError, "Expected a contiguous numpy array of shape (height, width) or (height, width, components)" );
+			SWIG_PYTHON_THREAD_END_BLOCK;
+			return;
+		}
+		tuttle::host::InputBufferWrapper::EPixelComponent components = tuttle::host::InputBufferWrapper::ePixelComponentAlpha;
+		switch( nbComponents )
+		{
+			case 1:
+				break;
+			case 3:
+				components = tuttle::host::InputBufferWrapper::ePixelComponentRGB;
+				break;
+			case 4:
+				components = tuttle::host::InputBufferWrapper::ePixelComponentRGBA;
+				break;
+			default:
+				PyErr_SetString( PyExc_ValueError, "Unsupported number of components, expected 1, 3 or 4" );
+				SWIG_PYTHON_THREAD_END_BLOCK;
+				return;
+		}
+		tuttle::host::InputBufferWrapper::EBitDepth bitDepth = tuttle::host::InputBufferWrapper::eBitDepthUByte;
+		switch( PyArray_TYPE( array ) )
+		{
+			case NPY_UBYTE:
+				break;
+			case NPY_USHORT:
+				bitDepth = tuttle::host::InputBufferWrapper::eBitDepthUShort;
+				break;
+			case NPY_FLOAT:
+				bitDepth = tuttle::host::InputBufferWrapper::eBitDepthFloat;
+				break;
+			default:
+				PyErr_SetString( PyExc_TypeError, "Unsupported array type, expected uint8, uint16 or float32" );
+				SWIG_PYTHON_THREAD_END_BLOCK;
+				return;
+		}
+		// released by inputbuffer_release_array_callback
+		Py_INCREF( object );
+		$self->setBorrowedRawImageBuffer(
+			PyArray_DATA( array ),
+			static_cast<int>( PyArray_DIM( array, 1 ) ),
+			static_cast<int>( PyArray_DIM( array, 0 ) ),
+			components, bitDepth,
+			static_cast<int>( PyArray_STRIDE( array, 0 ) ),
+			orientation,
+			inputbuffer_release_array_callback, object );
+		SWIG_PYTHON_THREAD_END_BLOCK;
+	}
+	
 }
 
 %ignore setCallback;
+%ignore setBorrowedRawImageBuffer;
 
 %apply (unsigned char* INPLACE_ARRAY2, int DIM1, int DIM2) {(unsigned char* rawBuffer, int height, int width)};
 %apply (unsigned short* INPLACE_ARRAY2, int DIM1, int DIM2) {(unsigned short* rawBuffer, int height, int width)};
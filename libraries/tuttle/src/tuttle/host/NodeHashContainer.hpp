@@ -24,6 +24,10 @@ public:
 	{
 		return _hashes.begin()->second;
 	}
+	bool hasHash( const NodeAtTimeKey& k ) const
+	{
+		return _hashes.find(k) != _hashes.end();
+	}
 	std::size_t getHash( const NodeAtTimeKey& k ) const
 	{
 		Map::const_iterator it = _hashes.find(k);
@@ -47,6 +51,10 @@ public:
 	{
 		_hashes[k] = hash;
 	}
+	void clear()
+	{
+		_hashes.clear();
+	}
 
 public:
 	friend std::ostream& operator<<( std::ostream& os, const NodeHashContainer& c );
@@ -1,5 +1,6 @@
 #include "OutputBufferWrapper.hpp"
 #include "Core.hpp"
+#include "ImageEffectNode.hpp"
 #include <tuttle/host/ofx/attribute/OfxhClipImageDescriptor.hpp>
 
 namespace tuttle {
@@ -18,5 +19,10 @@ void OutputBufferWrapper::setCallback( CallbackOutputImagePtr callback, CustomDa
 		);
 }
 
+void OutputBufferWrapper::setShareSourceBuffer( const bool share )
+{
+	getNode().asImageEffectNode().setOutputSharesSourceData( share );
+}
+
 }
 }
@@ -60,6 +60,15 @@ public:
 	INode& getNode() { return *_node; }
 
 	void setCallback( CallbackOutputImagePtr callback, CustomDataPtr customData = NULL, CallbackDestroyCustomDataPtr destroyCustomData = NULL );
+
+	/**
+	 * @brief The output image of the node shares the buffer of its source image, instead of a copy.
+	 * The callback receives the buffer of the node computing the source image.
+	 * To keep the buffer after the callback without copy, return the output buffers of the
+	 * computation (ComputeOptions::setReturnBuffers): each image holds a reference on its
+	 * MemoryPool buffer until the application releases it.
+	 */
+	void setShareSourceBuffer( const bool share = true );
 };
 
 }
@@ -20,6 +20,7 @@ namespace host {
 Preferences::Preferences()
 : _home( buildTuttleHome() )
 , _temp( buildTuttleTemp() )
+, _nbThreads( 0 )
 {}
 
 boost::filesystem::path Preferences::buildTuttleHome() const
@@ -4,6 +4,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include <string>
+#include <cstddef>
 
 namespace tuttle {
 namespace host {
@@ -13,6 +14,7 @@ class Preferences
 private:
 	boost::filesystem::path _home;
 	boost::filesystem::path _temp;
+	std::size_t _nbThreads;
 	
 public:
 	Preferences();
@@ -25,6 +27,13 @@ public:
 	
 	boost::filesystem::path buildTuttleTestPath() const;
 	
+	/**
+	 * @brief Number of threads of the host thread pool, used by the OFX multithread suite.
+	 * 0 means one thread per hardware thread.
+	 */
+	void setNbThreads( const std::size_t nbThreads ) { _nbThreads = nbThreads; }
+	std::size_t getNbThreads() const { return _nbThreads; }
+	
 private:
 	boost::filesystem::path buildTuttleHome() const;
 	boost::filesystem::path buildTuttleTemp() const;
@@ -0,0 +1,311 @@
+#include "Profiler.hpp"
+
+#include "exceptions.hpp"
+
+#include <tuttle/common/utils/json.hpp>
+
+#include <boost/thread/tss.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <set>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+void noCleanup( ProfileScope* ) {}
+
+/// @brief Innermost action profiled in each thread (not owned).
+boost::thread_specific_ptr<ProfileScope> currentScope( &noCleanup );
+
+}
+
+std::string mapProfilePhaseEnumToString( const EProfilePhase e )
+{
+	switch( e )
+	{
+		case eProfilePhaseSetup:
+			return "setup";
+		case eProfilePhasePreProcess:
+			return "preprocess";
+		case eProfilePhaseCache:
+			return "cache";
+		case eProfilePhaseRender:
+			return "render";
+		case eProfilePhaseIO:
+			return "io";
+		case eProfilePhasePostProcess:
+			return "postprocess";
+	}
+	BOOST_THROW_EXCEPTION( exception::Value()
+		<< exception::dev() + "Unrecognized profile phase: " + static_cast<int>( e ) );
+}
+
+void ProfileStats::add( const ProfileEvent& event )
+{
+	++_nbEvents;
+	_wallTime += event._wallTime;
+	_cpuTime += event._cpuTime;
+	_bytes += event._bytes;
+	_cacheHits += event._cacheHits;
+	_cacheMisses += event._cacheMisses;
+}
+
+void ProfileStats::add( const ProfileStats& stats )
+{
+	_nbEvents += stats._nbEvents;
+	_wallTime += stats._wallTime;
+	_cpuTime += stats._cpuTime;
+	_bytes += stats._bytes;
+	_cacheHits += stats._cacheHits;
+	_cacheMisses += stats._cacheMisses;
+}
+
+std::ostream& operator<<( std::ostream& os, const ProfileStats& stats )
+{
+	os << "wall: " << stats.getWallTime() << "s"
+	   << ", cpu: " << stats.getCpuTime() << "s"
+	   << ", memory: " << stats._bytes << " bytes"
+	   << ", cache hits: " << stats._cacheHits
+	   << ", cache misses: " << stats._cacheMisses
+	   << " (" << stats._nbEvents << " events)";
+	return os;
+}
+
+Profiler::Profiler( const bool enabled )
+	: _enabled( enabled )
+	, _origin( getClockTime() )
+{}
+
+void Profiler::setEnabled( const bool enabled )
+{
+	_enabled.store( enabled, boost::memory_order_relaxed );
+}
+
+void Profiler::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_events.clear();
+	_threadIndexes.clear();
+	_origin.store( getClockTime(), boost::memory_order_relaxed );
+}
+
+boost::int64_t Profiler::getClockTime()
+{
+	return boost::chrono::duration_cast<boost::chrono::microseconds>( boost::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+boost::int64_t Profiler::getTraceTime() const
+{
+	return getClockTime() - _origin.load( boost::memory_order_relaxed );
+}
+
+std::size_t Profiler::getThreadIndex( const boost::thread::id& id )
+{
+	std::map<boost::thread::id, std::size_t>::const_iterator it = _threadIndexes.find( id );
+	if( it != _threadIndexes.end() )
+		return it->second;
+	const std::size_t index = _threadIndexes.size();
+	_threadIndexes[id] = index;
+	return index;
+}
+
+void Profiler::addEvent( const ProfileEvent& event )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_events.push_back( event );
+	_events.back()._threadIndex = getThreadIndex( boost::this_thread::get_id() );
+}
+
+std::size_t Profiler::getNbEvents() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _events.size();
+}
+
+std::vector<ProfileEvent> Profiler::getEvents() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _events;
+}
+
+std::vector<std::string> Profiler::getNodeNames() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	std::set<std::string> names;
+	BOOST_FOREACH( const ProfileEvent& event, _events )
+	{
+		names.insert( event._nodeName );
+	}
+	return std::vector<std::string>( names.begin(), names.end() );
+}
+
+ProfileStats Profiler::getStats() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	ProfileStats stats;
+	BOOST_FOREACH( const ProfileEvent& event, _events )
+	{
+		stats.add( event );
+	}
+	return stats;
+}
+
+ProfileStats Profiler::getNodeStats( const std::string& nodeName ) const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	ProfileStats stats;
+	BOOST_FOREACH( const ProfileEvent& event, _events )
+	{
+		if( event._nodeName == nodeName )
+			stats.add( event );
+	}
+	return stats;
+}
+
+ProfileStats Profiler::getNodeStatsAtTime( const std::string& nodeName, const OfxTime time ) const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	ProfileStats stats;
+	BOOST_FOREACH( const ProfileEvent& event, _events )
+	{
+		if( event._atTime && event._time == time && event._nodeName == nodeName )
+			stats.add( event );
+	}
+	return stats;
+}
+
+ProfileStats Profiler::getPhaseStats( const EProfilePhase phase ) const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	ProfileStats stats;
+	BOOST_FOREACH( const ProfileEvent& event, _events )
+	{
+		if( event._phase == phase )
+			stats.add( event );
+	}
+	return stats;
+}
+
+std::string Profiler::getChromeTrace() const
+{
+	const std::vector<ProfileEvent> events = getEvents();
+
+	std::ostringstream os;
+	os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	BOOST_FOREACH( const ProfileEvent& event, events )
+	{
+		if( ! first )
+			os << ",";
+		first = false;
+		os << "\n{\"name\":";
+		common::writeJsonString( os, event._nodeName );
+		os << ",\"cat\":\"" << mapProfilePhaseEnumToString( event._phase ) << "\""
+		   << ",\"ph\":\"X\""
+		   << ",\"ts\":" << event._start
+		   << ",\"dur\":" << event._wallTime
+		   << ",\"pid\":1"
+		   << ",\"tid\":" << event._threadIndex
+		   << ",\"args\":{";
+		if( event._atTime )
+			os << "\"frame\":" << event._time << ",";
+		os << "\"cpu\":" << event._cpuTime
+		   << ",\"bytes\":" << event._bytes
+		   << ",\"cacheHits\":" << event._cacheHits
+		   << ",\"cacheMisses\":" << event._cacheMisses
+		   << "}}";
+	}
+	os << "\n]}\n";
+	return os.str();
+}
+
+void Profiler::exportChromeTrace( const std::string& filename ) const
+{
+	std::ofstream file( filename.c_str() );
+	if( ! file )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user() + "Unable to write the profiling trace."
+			<< exception::filename( filename ) );
+	}
+	file << getChromeTrace();
+}
+
+void Profiler::countAllocation( const std::size_t size )
+{
+	ProfileScope* scope = currentScope.get();
+	if( scope != NULL )
+		scope->addBytes( size );
+}
+
+std::ostream& operator<<( std::ostream& os, const Profiler& v )
+{
+	os << "Profiler " << ( v.isEnabled() ? "enabled" : "disabled" ) << std::endl;
+	BOOST_FOREACH( const std::string& nodeName, v.getNodeNames() )
+	{
+		os << "  " << nodeName << ": " << v.getNodeStats( nodeName ) << std::endl;
+	}
+	for( std::size_t i = 0; i < kNbProfilePhases; ++i )
+	{
+		const EProfilePhase phase = static_cast<EProfilePhase>( i );
+		os << "  [" << mapProfilePhaseEnumToString( phase ) << "] " << v.getPhaseStats( phase ) << std::endl;
+	}
+	os << "  total: " << v.getStats() << std::endl;
+	return os;
+}
+
+ProfileScope::ProfileScope( Profiler* profiler, const std::string& nodeName, const EProfilePhase phase )
+	: _profiler( NULL )
+	, _parent( NULL )
+{
+	if( profiler == NULL || ! profiler->isEnabled() )
+		return;
+	_event._nodeName = nodeName;
+	_event._phase = phase;
+	start( profiler );
+}
+
+ProfileScope::ProfileScope( Profiler* profiler, const std::string& nodeName, const OfxTime time, const EProfilePhase phase )
+	: _profiler( NULL )
+	, _parent( NULL )
+{
+	if( profiler == NULL || ! profiler->isEnabled() )
+		return;
+	_event._nodeName = nodeName;
+	_event._time = time;
+	_event._atTime = true;
+	_event._phase = phase;
+	start( profiler );
+}
+
+void ProfileScope::start( Profiler* profiler )
+{
+	_profiler = profiler;
+	_parent = currentScope.get();
+	currentScope.reset( this );
+	_event._start = profiler->getTraceTime();
+	_wallStart = boost::chrono::steady_clock::now();
+#ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+	_cpuStart = boost::chrono::thread_clock::now();
+#endif
+}
+
+ProfileScope::~ProfileScope()
+{
+	if( _profiler == NULL )
+		return;
+	_event._wallTime = boost::chrono::duration_cast<boost::chrono::microseconds>( boost::chrono::steady_clock::now() - _wallStart ).count();
+#ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+	_event._cpuTime = boost::chrono::duration_cast<boost::chrono::microseconds>( boost::chrono::thread_clock::now() - _cpuStart ).count();
+#endif
+	currentScope.reset( _parent );
+	_profiler->addEvent( _event );
+}
+
+}
+}
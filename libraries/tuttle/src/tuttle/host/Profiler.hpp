@@ -0,0 +1,207 @@
+#ifndef _TUTTLE_HOST_CORE_PROFILER_HPP_
+#define _TUTTLE_HOST_CORE_PROFILER_HPP_
+
+#include <tuttle/common/atomic.hpp>
+
+#include <ofxCore.h>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/chrono.hpp>
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+namespace tuttle {
+namespace host {
+
+enum EProfilePhase
+{
+	eProfilePhaseSetup = 0,  ///< time domain, setup actions (once per compute)
+	eProfilePhasePreProcess, ///< preprocess actions, regions of interest (per frame)
+	eProfilePhaseCache,      ///< lookup in the render cache (per frame)
+	eProfilePhaseRender,     ///< render action of the image effects
+	eProfilePhaseIO,         ///< render action of the readers and writers
+	eProfilePhasePostProcess ///< postprocess actions (per frame)
+};
+static const std::size_t kNbProfilePhases = eProfilePhasePostProcess + 1;
+
+std::string mapProfilePhaseEnumToString( const EProfilePhase e );
+
+/**
+ * @brief One measure of a node action.
+ */
+struct ProfileEvent
+{
+	ProfileEvent()
+		: _time( 0 )
+		, _atTime( false )
+		, _phase( eProfilePhaseRender )
+		, _threadIndex( 0 )
+		, _start( 0 )
+		, _wallTime( 0 )
+		, _cpuTime( 0 )
+		, _bytes( 0 )
+		, _cacheHits( 0 )
+		, _cacheMisses( 0 )
+	{}
+
+	std::string _nodeName;
+	OfxTime _time;
+	bool _atTime; ///< false for the actions called once for all frames (setup)
+	EProfilePhase _phase;
+	std::size_t _threadIndex; ///< index of the thread, in order of first use
+	boost::int64_t _start; ///< in microseconds since the profiler creation (or the last clear)
+	boost::int64_t _wallTime; ///< in microseconds
+	boost::int64_t _cpuTime; ///< in microseconds, 0 if the system doesn't provide a per thread clock
+	std::size_t _bytes; ///< bytes requested to the MemoryPool
+	std::size_t _cacheHits;
+	std::size_t _cacheMisses;
+};
+
+/**
+ * @brief Accumulation of events.
+ */
+struct ProfileStats
+{
+	ProfileStats()
+		: _nbEvents( 0 )
+		, _wallTime( 0 )
+		, _cpuTime( 0 )
+		, _bytes( 0 )
+		, _cacheHits( 0 )
+		, _cacheMisses( 0 )
+	{}
+
+	void add( const ProfileEvent& event );
+	void add( const ProfileStats& stats );
+
+	/// @brief Wall time in seconds
+	double getWallTime() const { return _wallTime * 1e-6; }
+	/// @brief CPU time in seconds
+	double getCpuTime() const { return _cpuTime * 1e-6; }
+
+	std::size_t _nbEvents;
+	boost::int64_t _wallTime; ///< in microseconds
+	boost::int64_t _cpuTime; ///< in microseconds
+	std::size_t _bytes;
+	std::size_t _cacheHits;
+	std::size_t _cacheMisses;
+};
+
+std::ostream& operator<<( std::ostream& os, const ProfileStats& stats );
+
+/**
+ * @brief Record the cost of each node, for each frame and each phase of the computation.
+ *
+ * Attach a profiler to the computation with ComputeOptions::setProfiler.
+ * A profiler can be shared by several computations, the events are accumulated until clear().
+ * All the functions are thread safe.
+ */
+class Profiler : private boost::noncopyable
+{
+public:
+	typedef Profiler This;
+
+	Profiler( const bool enabled = true );
+
+	/**
+	 * @brief Switch the recording at runtime.
+	 * A disabled profiler costs a test per node action.
+	 */
+	void setEnabled( const bool enabled = true );
+	bool isEnabled() const { return _enabled.load( boost::memory_order_relaxed ); }
+
+	/**
+	 * @brief Remove all the events and restart the trace clock.
+	 */
+	void clear();
+
+	void addEvent( const ProfileEvent& event );
+
+	std::size_t getNbEvents() const;
+	std::vector<ProfileEvent> getEvents() const;
+
+	/// @brief Names of the profiled nodes, sorted.
+	std::vector<std::string> getNodeNames() const;
+
+	/// @brief Accumulation of all the events.
+	ProfileStats getStats() const;
+	/// @brief Accumulation of the events of a node (all frames and phases).
+	ProfileStats getNodeStats( const std::string& nodeName ) const;
+	/// @brief Accumulation of the events of a node at a frame (all phases).
+	ProfileStats getNodeStatsAtTime( const std::string& nodeName, const OfxTime time ) const;
+	/// @brief Accumulation of the events of all nodes for a phase.
+	ProfileStats getPhaseStats( const EProfilePhase phase ) const;
+
+	/**
+	 * @brief Events in the Chrome trace event format (JSON),
+	 * readable by chrome://tracing or https://ui.perfetto.dev
+	 */
+	std::string getChromeTrace() const;
+	void exportChromeTrace( const std::string& filename ) const;
+
+	/**
+	 * @brief Count an allocation in the action currently profiled in this thread, if any.
+	 * Called by the MemoryPool.
+	 */
+	static void countAllocation( const std::size_t size );
+
+	/// @brief Microseconds since the profiler creation (or the last clear).
+	boost::int64_t getTraceTime() const;
+
+	friend std::ostream& operator<<( std::ostream& os, const This& v );
+
+private:
+	std::size_t getThreadIndex( const boost::thread::id& id );
+
+	/// @brief Microseconds of the steady clock since its epoch.
+	static boost::int64_t getClockTime();
+
+private:
+	boost::atomic_bool _enabled;
+	boost::atomic<boost::int64_t> _origin; ///< clock time of the creation (or the last clear), read without the lock by the actions
+	std::vector<ProfileEvent> _events;
+	std::map<boost::thread::id, std::size_t> _threadIndexes;
+	mutable boost::mutex _mutex;
+};
+
+/**
+ * @brief Measure a node action, from the construction to the destruction.
+ * Does nothing if the profiler is NULL or disabled.
+ */
+class ProfileScope : private boost::noncopyable
+{
+public:
+	ProfileScope( Profiler* profiler, const std::string& nodeName, const EProfilePhase phase );
+	ProfileScope( Profiler* profiler, const std::string& nodeName, const OfxTime time, const EProfilePhase phase );
+	~ProfileScope();
+
+	bool isActive() const { return _profiler != NULL; }
+
+	void addCacheHit() { ++_event._cacheHits; }
+	void addCacheMiss() { ++_event._cacheMisses; }
+	void addBytes( const std::size_t size ) { _event._bytes += size; }
+
+private:
+	void start( Profiler* profiler );
+
+private:
+	Profiler* _profiler;
+	ProfileScope* _parent; ///< scope of the calling action in the same thread
+	ProfileEvent _event;
+	boost::chrono::steady_clock::time_point _wallStart;
+#ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+	boost::chrono::thread_clock::time_point _cpuStart;
+#endif
+};
+
+}
+}
+
+#endif
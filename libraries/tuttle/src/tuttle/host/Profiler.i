@@ -0,0 +1,47 @@
+%include <tuttle/host/global.i>
+%include <tuttle/host/NodeListArg.i>
+
+%include <boost_shared_ptr.i>
+%include <std_vector.i>
+%include <std_string.i>
+%include <stdint.i>
+
+%{
+#include <tuttle/host/Profiler.hpp>
+%}
+
+namespace boost {
+typedef ::int64_t int64_t;
+}
+
+%shared_ptr(tuttle::host::Profiler)
+
+// The scopes are only used in C++, around the node actions.
+%ignore tuttle::host::ProfileScope;
+%ignore tuttle::host::Profiler::countAllocation;
+
+namespace std {
+%template(ProfileEventVector) vector<tuttle::host::ProfileEvent>;
+}
+
+%include <tuttle/host/Profiler.hpp>
+
+%extend tuttle::host::ProfileStats
+{
+	std::string __str__() const
+	{
+		std::stringstream s;
+		s << *self;
+		return s.str();
+	}
+}
+
+%extend tuttle::host::Profiler
+{
+	std::string __str__() const
+	{
+		std::stringstream s;
+		s << *self;
+		return s.str();
+	}
+}
@@ -0,0 +1,372 @@
+#include "ThreadPool.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/thread/tss.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace tuttle {
+namespace host {
+
+namespace {
+
+static const std::size_t kNoWorker = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Informations about the current thread, relative to the thread pool.
+ */
+struct ThreadContext
+{
+	ThreadContext()
+		: _pool( NULL )
+		, _workerIndex( kNoWorker )
+		, _inTask( false )
+		, _threadIndex( 0 )
+	{}
+
+	const ThreadPool* _pool; ///< pool owning the current thread (NULL for external threads)
+	std::size_t _workerIndex;
+	bool _inTask; ///< is the thread executing a task
+	unsigned int _threadIndex; ///< index of the task executed by the thread
+};
+
+boost::thread_specific_ptr<ThreadContext> gThreadContext;
+
+ThreadContext& threadContext()
+{
+	if( gThreadContext.get() == NULL )
+		gThreadContext.reset( new ThreadContext() );
+	return *gThreadContext;
+}
+
+std::size_t resolveNbThreads( const std::size_t nbThreads )
+{
+	if( nbThreads != 0 )
+		return nbThreads;
+	return std::max( 1u, boost::thread::hardware_concurrency() );
+}
+
+}
+
+struct ThreadPool::Batch
+{
+	Batch( TaskFunction function, const unsigned int nbTasks, void* customArg )
+		: _function( function )
+		, _nbTasks( nbTasks )
+		, _customArg( customArg )
+		, _nbRemaining( nbTasks )
+		, _failed( false )
+	{}
+
+	TaskFunction _function;
+	const unsigned int _nbTasks;
+	void* _customArg;
+
+	boost::mutex _mutex;
+	boost::condition_variable _done;
+	unsigned int _nbRemaining; ///< protected by _mutex
+	bool _failed; ///< protected by _mutex
+};
+
+struct ThreadPool::Task
+{
+	Task()
+		: _batch( NULL )
+		, _index( 0 )
+	{}
+	Task( Batch& batch, const unsigned int index )
+		: _batch( &batch )
+		, _index( index )
+	{}
+
+	Batch* _batch;
+	unsigned int _index;
+};
+
+struct ThreadPool::Worker
+{
+	boost::mutex _mutex;
+	std::deque<Task> _tasks; ///< the owner uses the back, thieves use the front
+};
+
+ThreadPool::ThreadPool( const std::size_t nbThreads )
+	: _nbThreads( 0 )
+	, _requestedNbThreads( resolveNbThreads( nbThreads ) )
+	, _nbQueuedTasks( 0 )
+	, _nextWorker( 0 )
+	, _stop( false )
+{
+	// threads are started on the first use
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+void ThreadPool::setNbThreads( const std::size_t nbThreads )
+{
+	boost::mutex::scoped_lock lock( _sizeMutex );
+	_requestedNbThreads = resolveNbThreads( nbThreads );
+}
+
+std::size_t ThreadPool::getNbThreads() const
+{
+	boost::mutex::scoped_lock lock( _sizeMutex );
+	return _requestedNbThreads;
+}
+
+bool ThreadPool::isSpawnedThread()
+{
+	return threadContext()._inTask;
+}
+
+bool ThreadPool::getThreadIndex( unsigned int& threadIndex )
+{
+	const ThreadContext& context = threadContext();
+	threadIndex = context._threadIndex;
+	return context._inTask;
+}
+
+void ThreadPool::start()
+{
+	_stop = false;
+	_nextWorker = 0;
+	// the thread calling run() is used as an executor
+	for( std::size_t i = 1; i < _nbThreads; ++i )
+	{
+		_workers.push_back( new Worker() );
+	}
+	for( std::size_t i = 0; i < _workers.size(); ++i )
+	{
+		_threads.push_back( new boost::thread( boost::bind( &ThreadPool::workerLoop, this, i ) ) );
+	}
+	TUTTLE_TLOG( TUTTLE_INFO, "[Thread pool] started with " << _nbThreads << " threads" );
+}
+
+void ThreadPool::stop()
+{
+	{
+		boost::mutex::scoped_lock lock( _queueMutex );
+		_stop = true;
+	}
+	_taskAvailable.notify_all();
+	BOOST_FOREACH( boost::thread& t, _threads )
+	{
+		t.join();
+	}
+	_threads.clear();
+	_workers.clear();
+}
+
+/**
+ * @brief Restart the workers if the number of threads has changed.
+ * @remark Wait until all external runs are finished.
+ */
+void ThreadPool::applyNbThreads()
+{
+	std::size_t nbThreads;
+	{
+		boost::mutex::scoped_lock lock( _sizeMutex );
+		if( _requestedNbThreads == _nbThreads )
+			return;
+		nbThreads = _requestedNbThreads;
+	}
+	boost::unique_lock<boost::shared_mutex> lock( _runMutex );
+	if( nbThreads == _nbThreads )
+		return;
+	stop();
+	_nbThreads = nbThreads;
+	start();
+}
+
+bool ThreadPool::run( TaskFunction function, const unsigned int nbTasks, void* customArg )
+{
+	if( nbTasks == 0 )
+		return true;
+
+	Batch batch( function, nbTasks, customArg );
+
+	// A nested call is done from a task, so the pool is already locked by the external caller.
+	boost::shared_lock<boost::shared_mutex> lock( _runMutex, boost::defer_lock );
+	if( ! threadContext()._inTask )
+	{
+		applyNbThreads();
+		lock.lock();
+	}
+
+	if( _workers.empty() || nbTasks == 1 )
+	{
+		// single threaded pool or single task
+		for( unsigned int i = 0; i < nbTasks; ++i )
+		{
+			executeTask( Task( batch, i ) );
+		}
+	}
+	else
+	{
+		// Nested calls only queue more tasks, idle workers will steal them.
+		pushTasks( batch );
+		helpUntilDone( batch );
+	}
+	return ! batch._failed;
+}
+
+void ThreadPool::pushTasks( Batch& batch )
+{
+	const ThreadContext& context = threadContext();
+	{
+		boost::mutex::scoped_lock lock( _queueMutex );
+		if( context._pool == this && context._workerIndex != kNoWorker )
+		{
+			// tasks created by a worker stay on its own queue
+			Worker& worker = _workers[context._workerIndex];
+			boost::mutex::scoped_lock workerLock( worker._mutex );
+			for( unsigned int i = batch._nbTasks; i > 0; --i )
+			{
+				worker._tasks.push_back( Task( batch, i - 1 ) );
+			}
+		}
+		else
+		{
+			for( unsigned int i = 0; i < batch._nbTasks; ++i )
+			{
+				Worker& worker = _workers[_nextWorker];
+				_nextWorker = ( _nextWorker + 1 ) % _workers.size();
+				boost::mutex::scoped_lock workerLock( worker._mutex );
+				worker._tasks.push_back( Task( batch, i ) );
+			}
+		}
+		_nbQueuedTasks += batch._nbTasks;
+	}
+	_taskAvailable.notify_all();
+}
+
+/**
+ * @brief Get the next task to execute: the newest task of our own queue,
+ * or the oldest task of another worker.
+ */
+bool ThreadPool::popTask( Task& task, const std::size_t workerIndex )
+{
+	const std::size_t nbWorkers = _workers.size();
+	bool found = false;
+
+	if( workerIndex < nbWorkers )
+	{
+		Worker& worker = _workers[workerIndex];
+		boost::mutex::scoped_lock workerLock( worker._mutex );
+		if( ! worker._tasks.empty() )
+		{
+			task = worker._tasks.back();
+			worker._tasks.pop_back();
+			found = true;
+		}
+	}
+	const std::size_t first = ( workerIndex < nbWorkers ) ? workerIndex + 1 : 0;
+	for( std::size_t i = 0; ! found && i < nbWorkers; ++i )
+	{
+		Worker& victim = _workers[( first + i ) % nbWorkers];
+		boost::mutex::scoped_lock victimLock( victim._mutex );
+		if( ! victim._tasks.empty() )
+		{
+			task = victim._tasks.front();
+			victim._tasks.pop_front();
+			found = true;
+		}
+	}
+	if( ! found )
+		return false;
+
+	boost::mutex::scoped_lock lock( _queueMutex );
+	--_nbQueuedTasks;
+	return true;
+}
+
+void ThreadPool::executeTask( const Task& task )
+{
+	Batch& batch = *task._batch;
+	ThreadContext& context = threadContext();
+	const bool previousInTask = context._inTask;
+	const unsigned int previousThreadIndex = context._threadIndex;
+	context._inTask = true;
+	context._threadIndex = task._index;
+
+	bool failed = false;
+	try
+	{
+		batch._function( task._index, batch._nbTasks, batch._customArg );
+	}
+	catch(...)
+	{
+		failed = true;
+		TUTTLE_LOG_ERROR( "[Thread pool] Error in task " << task._index << "." << std::endl
+			<< boost::current_exception_diagnostic_information() );
+	}
+
+	context._inTask = previousInTask;
+	context._threadIndex = previousThreadIndex;
+
+	boost::mutex::scoped_lock lock( batch._mutex );
+	if( failed )
+		batch._failed = true;
+	if( --batch._nbRemaining == 0 )
+		batch._done.notify_all();
+}
+
+/**
+ * @brief Execute tasks until all tasks of @p batch are done.
+ */
+void ThreadPool::helpUntilDone( Batch& batch )
+{
+	const ThreadContext& context = threadContext();
+	const std::size_t workerIndex = ( context._pool == this ) ? context._workerIndex : kNoWorker;
+
+	Task task;
+	while( true )
+	{
+		{
+			boost::mutex::scoped_lock lock( batch._mutex );
+			if( batch._nbRemaining == 0 )
+				return;
+		}
+		if( ! popTask( task, workerIndex ) )
+			break;
+		executeTask( task );
+	}
+
+	// All tasks of the batch are queued before we start to help,
+	// so the remaining ones are already executed by other threads.
+	boost::mutex::scoped_lock lock( batch._mutex );
+	while( batch._nbRemaining != 0 )
+		batch._done.wait( lock );
+}
+
+void ThreadPool::workerLoop( const std::size_t workerIndex )
+{
+	ThreadContext& context = threadContext();
+	context._pool = this;
+	context._workerIndex = workerIndex;
+
+	Task task;
+	while( true )
+	{
+		{
+			boost::mutex::scoped_lock lock( _queueMutex );
+			while( _nbQueuedTasks == 0 && ! _stop )
+				_taskAvailable.wait( lock );
+			if( _stop )
+				return;
+		}
+		if( popTask( task, workerIndex ) )
+			executeTask( task );
+	}
+}
+
+}
+}
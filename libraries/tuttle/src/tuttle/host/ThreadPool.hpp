@@ -0,0 +1,98 @@
+#ifndef _TUTTLE_HOST_THREADPOOL_HPP_
+#define _TUTTLE_HOST_THREADPOOL_HPP_
+
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <cstddef>
+#include <deque>
+
+namespace tuttle {
+namespace host {
+
+/**
+ * @brief Host-wide pool of persistent worker threads with work stealing.
+ *
+ * Each worker owns a queue of tasks: it pops its own tasks in LIFO order
+ * and steals the oldest tasks of other workers when its queue is empty.
+ * The thread calling run() also executes tasks until its batch is done.
+ *
+ * Calls from a task (nested parallelism, like a node multithreaded process
+ * inside a frame rendered in parallel) don't create new threads,
+ * they only queue more tasks for the existing workers.
+ */
+class ThreadPool : private boost::noncopyable
+{
+public:
+	typedef void (*TaskFunction)( unsigned int threadIndex, unsigned int threadMax, void* customArg );
+
+	/**
+	 * @param nbThreads number of threads executing tasks (including the calling thread),
+	 *                  0 means one thread per hardware thread.
+	 */
+	explicit ThreadPool( const std::size_t nbThreads = 0 );
+	~ThreadPool();
+
+	/**
+	 * @brief Set the number of threads of the pool.
+	 * The pool is resized before the next run() from a thread outside of the pool.
+	 */
+	void setNbThreads( const std::size_t nbThreads );
+	std::size_t getNbThreads() const;
+
+	/**
+	 * @brief Execute @p function @p nbTasks times in parallel and wait until all calls are done.
+	 * @return false if one of the calls has thrown an exception
+	 */
+	bool run( TaskFunction function, const unsigned int nbTasks, void* customArg );
+
+	/**
+	 * @brief Is the current thread executing a task of the pool?
+	 */
+	static bool isSpawnedThread();
+
+	/**
+	 * @brief Index of the task executed by the current thread.
+	 * @return false if the current thread is not executing a task
+	 */
+	static bool getThreadIndex( unsigned int& threadIndex );
+
+private:
+	struct Batch;
+	struct Task;
+	struct Worker;
+
+	void start();
+	void stop();
+	void applyNbThreads();
+
+	void workerLoop( const std::size_t workerIndex );
+	void pushTasks( Batch& batch );
+	bool popTask( Task& task, const std::size_t workerIndex );
+	void executeTask( const Task& task );
+	void helpUntilDone( Batch& batch );
+
+private:
+	boost::ptr_vector<Worker> _workers;
+	boost::ptr_vector<boost::thread> _threads;
+
+	std::size_t _nbThreads; ///< number of threads of the running pool
+	std::size_t _requestedNbThreads;
+	mutable boost::mutex _sizeMutex;
+	boost::shared_mutex _runMutex; ///< external runs share it, resize owns it
+
+	boost::mutex _queueMutex;
+	boost::condition_variable _taskAvailable;
+	std::size_t _nbQueuedTasks; ///< protected by _queueMutex
+	std::size_t _nextWorker; ///< round-robin distribution of external tasks, protected by _queueMutex
+	bool _stop;
+};
+
+}
+}
+
+#endif
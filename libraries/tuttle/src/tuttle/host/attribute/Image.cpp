@@ -41,7 +41,31 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 	// make some memory according to the bit depth
 	const std::size_t automaticRowSize = dimensions.x * _pixelBytes;
 	_memorySize = automaticRowSize * dimensions.y;
+	_rowAbsDistanceBytes = rowDistanceBytes != 0 ? rowDistanceBytes : automaticRowSize;
+
+	setImageProperties();
+}
+
+Image::Image( ClipImage& clip, const OfxTime time, const Image& other )
+	: ofx::imageEffect::OfxhImage( clip, time )
+	, _memorySize( other._memorySize )
+	, _pixelBytes( other._pixelBytes )
+	, _rowAbsDistanceBytes( other._rowAbsDistanceBytes )
+	, _bounds( other._bounds )
+	, _orientation( other._orientation )
+	, _fullname( clip.getFullName() )
+{
+	setImageProperties();
+	setPoolData( other._data );
+}
 
+Image::~Image()
+{
+	//TUTTLE_TLOG_VAR( TUTTLE_TRACE, getFullName() );
+}
+
+void Image::setImageProperties()
+{
 	// render scale x and y of 1.0
 	setDoubleProperty( kOfxImageEffectPropRenderScale, 1.0, 0 );
 	setDoubleProperty( kOfxImageEffectPropRenderScale, 1.0, 1 );
@@ -59,15 +83,9 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 	setIntProperty( kOfxImagePropRegionOfDefinition, _bounds.y2, 3 );
 
 	// row bytes
-	_rowAbsDistanceBytes = rowDistanceBytes != 0 ? rowDistanceBytes : automaticRowSize;
 	setIntProperty( kOfxImagePropRowBytes, getOrientedRowDistanceBytes( eImageOrientationFromBottomToTop ) );
 }
 
-Image::~Image()
-{
-	//TUTTLE_TLOG_VAR( TUTTLE_TRACE, getFullName() );
-}
-
 boost::uint8_t* Image::getPixelData()
 {
 	return reinterpret_cast<boost::uint8_t*>( _data->data() );
@@ -42,6 +42,11 @@ protected:
 
 public:
 	Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const EImageOrientation orientation, const int rowDistanceBytes );
+	/**
+	 * @brief Image of @p clip at @p time, sharing the pixels of @p other.
+	 * Each user of the pixels has its own image, with its own time and references.
+	 */
+	Image( ClipImage& clip, const OfxTime time, const Image& other );
 	virtual ~Image();
 
 #ifndef SWIG
@@ -113,6 +118,9 @@ public:
 	#endif
 
 private:
+	/// @brief Set the bounds and row bytes properties from the members.
+	void setImageProperties();
+
 	template < class S_VIEW >
 	static void copy( Image* dst, S_VIEW& src, const OfxPointI& dstCorner,
 	                  const OfxPointI& srcCorner, const OfxPointI& count );
@@ -43,19 +43,22 @@ namespace attribute {
 
 #ifndef WITHOUT_NUMPY
 
-		def getNumpyArray(self):
+		def getNumpyBitDepth(self):
 			import numpy
-			(data, width, height, rowSizeBytes, bitDepth, components) = self.getImage()
-			
-			numpyBitDepth = None
+			bitDepth = self.getBitDepth()
 			if bitDepth == eBitDepthUByte:
-				numpyBitDepth = numpy.uint8
+				return numpy.uint8
 			elif bitDepth == eBitDepthUShort:
-				numpyBitDepth = numpy.uint16
+				return numpy.uint16
 			elif bitDepth == eBitDepthFloat:
-				numpyBitDepth = numpy.float32
-			else:
-				raise TypeError('Unrecognized bit depth')
+				return numpy.float32
+			raise TypeError('Unrecognized bit depth')
+
+		def getNumpyArray(self):
+			import numpy
+			(data, width, height, rowSizeBytes, bitDepth, components) = self.getImage()
+			
+			numpyBitDepth = self.getNumpyBitDepth()
 			
 			bufferSize = rowSizeBytes * height
 			d = cbytearray(data, bufferSize)
@@ -72,6 +75,31 @@ namespace attribute {
 			nArray = numpy.array( numpy.flipud( numpy.reshape( flatarray, ( height, width, self.getNbComponents() ) ) ) )
 			return nArray
 
+		def getNumpyArrayView(self):
+			"""
+			Array of shape (height, width, components) using the image buffer without copy.
+			The array holds a reference on the image, so the buffer is kept
+			until the array is released.
+			"""
+			import numpy
+			bounds = self.getBounds()
+			itemSize = numpy.dtype(self.getNumpyBitDepth()).itemsize
+			nbComponents = self.getNbComponents()
+
+			class ImageBufferView(object):
+				def __init__(self, image, interface):
+					self.image = image
+					self.__array_interface__ = interface
+
+			interface = {
+				'version': 3,
+				'shape': (bounds.y2 - bounds.y1, bounds.x2 - bounds.x1, nbComponents),
+				'typestr': numpy.dtype(self.getNumpyBitDepth()).str,
+				'data': (int(self.getOrientedPixelData(Image.eImageOrientationFromTopToBottom)), False),
+				'strides': (self.getOrientedRowDistanceBytes(Image.eImageOrientationFromTopToBottom), nbComponents * itemSize, itemSize),
+			}
+			return numpy.asarray(ImageBufferView(self, interface))
+
 		def getNumpyImage(self):
 			from PIL import Image
 			return Image.fromarray(self.getNumpyArray())
@@ -8,6 +8,7 @@ namespace graph {
 ProcessEdgeAtTime::ProcessEdgeAtTime()
 : _inTime( 0.0 )
 , _outTime( 0.0 )
+, _isTiled( false )
 {
 }
 
@@ -15,6 +16,7 @@ ProcessEdgeAtTime::ProcessEdgeAtTime( const ProcessVertexAtTime::Key& out, const
 : IEdge( out.getName(), in.getName(), inAttrName )
 , _inTime( in.getTime() )
 , _outTime( out.getTime() )
+, _isTiled( false )
 {
 }
 
@@ -22,6 +24,7 @@ ProcessEdgeAtTime::ProcessEdgeAtTime( const ProcessEdge& e )
 : IEdge( e )
 , _inTime( 0.0 )
 , _outTime( 0.0 )
+, _isTiled( false )
 {
 }
 
@@ -29,6 +32,7 @@ ProcessEdgeAtTime::ProcessEdgeAtTime( const ProcessEdgeAtTime& other )
 : IEdge( other )
 , _inTime( other._inTime )
 , _outTime( other._outTime )
+, _isTiled( other._isTiled )
 {
 }
 
@@ -46,6 +50,8 @@ std::ostream& ProcessEdgeAtTime::exportDotDebug( std::ostream& os ) const
 	std::ostringstream times;
 	times << "(in:" << _inTime << ", out:" << _outTime << ")";
 	s << subDotEntry( "times", times.str() );
+	if( _isTiled )
+		s << subDotEntry( "tiled", "true" );
 
 	os << "[" << std::endl;
 	os << dotEntry( "type", "Edge" ) << ", " << std::endl;
@@ -29,9 +29,16 @@ public:
 	inline OfxTime getOutTime() const { return _outTime; }
 	inline OfxTime getInTime() const { return _inTime; }
 	
+	/**
+	 * @brief The output node is rendered tile by tile, on demand of the input node.
+	 */
+	inline bool isTiled() const { return _isTiled; }
+	inline void setTiled( const bool tiled ) { _isTiled = tiled; }
+	
 private:
 	OfxTime _inTime;
 	OfxTime _outTime;
+	bool _isTiled;
 };
 
 }
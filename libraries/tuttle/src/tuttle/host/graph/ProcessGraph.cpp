@@ -2,8 +2,11 @@
 #include "ProcessVisitors.hpp"
 #include <tuttle/common/utils/color.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
+#include <tuttle/host/Core.hpp>
 
 #include <boost/foreach.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/functional/hash.hpp>
 
 
 #ifndef TUTTLE_PRODUCTION
@@ -24,19 +27,53 @@ namespace graph {
 
 const std::string ProcessGraph::_outputId( "TUTTLE_FAKE_OUTPUT" );
 
+/**
+ * @brief A frame rendered by a frame lane.
+ */
+struct ProcessGraph::FrameJob
+{
+	FrameJob()
+		: _time( 0 )
+		, _rendered( false )
+	{}
+
+	OfxTime _time;
+	bool _rendered;
+	boost::exception_ptr _error; ///< exception catched during the render of this frame
+	memory::MemoryCache _outCache; ///< output buffers of this frame, moved into the user cache in frame order
+};
+
 ProcessGraph::ProcessGraph( const ComputeOptions& options, Graph& userGraph, const std::list<std::string>& outputNodes, memory::IMemoryCache& internMemoryCache )
 	: _instanceCount( userGraph.getInstanceCount() )
-	, _options(options)
+	, _options( &options )
 	, _internMemoryCache(internMemoryCache)
 	, _procOptions(&_internMemoryCache)
+	, _isSetup( false )
+	, _isFrameLane( false )
+	, _deferProgressHandles( false )
 {
-	_procOptions._interactive = _options.getIsInteractive();
+	_procOptions._interactive = _options->getIsInteractive();
 	// imageEffect specific...
-	_procOptions._renderScale = _options.getRenderScale();
+	_procOptions._renderScale = _options->getRenderScale();
 	
 	updateGraph( userGraph, outputNodes );
 }
 
+ProcessGraph::ProcessGraph( const ProcessGraph& master, const std::size_t laneIndex )
+	: _renderGraph( master._renderGraph )
+	, _instanceCount( master._instanceCount )
+	, _options( master._options )
+	, _internMemoryCache( _laneMemoryCache )
+	, _procOptions( master._procOptions )
+	, _isSetup( false )
+	, _isFrameLane( true )
+	, _deferProgressHandles( true )
+{
+	TUTTLE_TLOG( TUTTLE_INFO, "[Process render] create frame lane " << laneIndex );
+	_procOptions._internMemoryCache = &_internMemoryCache;
+	cloneNodes();
+}
+
 ProcessGraph::~ProcessGraph()
 {}
 
@@ -94,6 +131,87 @@ void ProcessGraph::relink()
 	}
 }
 
+/**
+ * @brief Replace the nodes of the copied graph by our own copies,
+ * so the frame lane could be processed in parallel of the master graph.
+ */
+void ProcessGraph::cloneNodes()
+{
+	_nodes.clear();
+	BOOST_FOREACH( InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices() )
+	{
+		Vertex& v = _renderGraph.instance( vd );
+
+		// fake node has no ProcessNode
+		if( v.isFake() )
+			continue;
+
+		const tuttle::host::INode& origNode = v.getProcessNode(); // node of the master graph
+		std::string key( origNode.getName() );
+		NodeMap::iterator it = _nodes.find( key );
+		tuttle::host::INode* newNode;
+		if( it != _nodes.end() )
+		{
+			newNode = it->second;
+		}
+		else
+		{
+			newNode = origNode.clone();
+			newNode->setBeforeRenderCallback( origNode._beforeRenderCallback );
+			_laneNodesRevision[key] = origNode.getRevision();
+#ifdef PROCESSGRAPH_USE_LINK
+			_laneNodes.push_back( newNode ); // owns the new pointer
+			_nodes[key] = newNode;
+#else
+			_nodes.insert( key, newNode ); // owns the new pointer
+#endif
+		}
+		v.setProcessNode( newNode );
+	}
+}
+
+/**
+ * @brief Copy into the nodes of a frame lane the parameters modified
+ * in the nodes of the master graph since the last synchronization.
+ */
+void ProcessGraph::synchronizeLaneNodes( const ProcessGraph& master )
+{
+	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
+	{
+		const INode& masterNode = *master._nodes.find( p.first )->second;
+		std::size_t& revision = _laneNodesRevision[p.first];
+		if( masterNode.getRevision() == revision )
+			continue;
+		TUTTLE_TLOG( TUTTLE_INFO, "[Process render] synchronize frame lane node " << p.first );
+		p.second->asImageEffectNode().synchronizeParams( masterNode.asImageEffectNode(), revision );
+		revision = masterNode.getRevision();
+	}
+}
+
+bool ProcessGraph::isCompiledFor( const std::list<std::string>& outputNodes, const memory::IMemoryCache& internMemoryCache ) const
+{
+	return outputNodes == _outputNodes && &internMemoryCache == &_internMemoryCache;
+}
+
+void ProcessGraph::setOptions( const ComputeOptions& options )
+{
+	_options = &options;
+	if( _procOptions._interactive != options.getIsInteractive() ||
+	    _procOptions._renderScale.x != options.getRenderScale().x ||
+	    _procOptions._renderScale.y != options.getRenderScale().y )
+	{
+		// these options are copied into the datas of all the vertices
+		_procOptions._interactive = options.getIsInteractive();
+		_procOptions._renderScale = options.getRenderScale();
+		_isSetup = false;
+		_frameLanes.clear();
+	}
+	BOOST_FOREACH( ProcessGraph& lane, _frameLanes )
+	{
+		lane._options = _options;
+	}
+}
+
 /*
    void removeVertexAndReconnectTo( const VertexDescriptor& v, const VertexDescriptor& other )
    {
@@ -187,7 +305,8 @@ void ProcessGraph::bakeGraphInformationToNodes( InternalGraphAtTimeImpl& _render
 
 void ProcessGraph::beginSequence( const TimeRange& timeRange )
 {
-	_options.beginSequenceHandle();
+	if( ! _isFrameLane )
+		_options->beginSequenceHandle();
 	_procOptions._renderTimeRange.min = timeRange._begin;
 	_procOptions._renderTimeRange.max = timeRange._end;
 	_procOptions._step                = timeRange._step;
@@ -201,21 +320,34 @@ void ProcessGraph::beginSequence( const TimeRange& timeRange )
 		NodeMap::value_type& p = *it;
 		p.second->beginSequence( _procOptions );
 	}
+	BOOST_FOREACH( ProcessGraph& lane, _frameLanes )
+	{
+		lane.beginSequence( timeRange );
+	}
 }
 
 void ProcessGraph::endSequence()
 {
-	_options.endSequenceHandle();
+	if( ! _isFrameLane )
+		_options->endSequenceHandle();
 	TUTTLE_TLOG( TUTTLE_INFO, "[Process render] process end sequence" );
 	//--- END sequence render
 	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
 	{
 		p.second->endSequence( _procOptions ); // node option... or no option here ?
 	}
+	BOOST_FOREACH( ProcessGraph& lane, _frameLanes )
+	{
+		lane.endSequence();
+		lane._renderGraphAtTime.clear();
+		lane._internMemoryCache.clearUnused();
+	}
 }
 
 void ProcessGraph::updateGraph( Graph& userGraph, const std::list<std::string>& outputNodes )
 {
+	_outputNodes = outputNodes;
+	_isSetup = false;
 	_renderGraph.copyTransposed( userGraph.getGraph() );
 
 	Vertex outputVertex( _procOptions, _outputId );
@@ -273,38 +405,56 @@ void ProcessGraph::setup()
 //			<< userMsg );
 //	}
 
+	// When the graph is reused, only the nodes modified since the last setup
+	// (and the nodes using them) need a new setup.
+	graph::visitor::CheckUpToDate<InternalGraphImpl> checkUpToDateVisitor( _renderGraph, _isSetup );
+	_renderGraph.depthFirstVisit( checkUpToDateVisitor, _renderGraph.getVertexDescriptor( _outputId ) );
+
+	std::size_t nbOutdated = 0;
 	BOOST_FOREACH( InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices() )
 	{
 		Vertex& v = _renderGraph.instance(vd);
 		if( ! v.isFake() )
 		{
-			v.setProcessData( _procOptions );
+			if( ! v._data._isUpToDate )
+			{
+				v.setProcessData( _procOptions );
+				v._data._nodeRevision = v.getProcessNode().getRevision();
+				++nbOutdated;
+			}
+			// always relink, the node may have been used by another graph
 			v.getProcessNode().setProcessData( &v._data );
 		}
 	}
+	TUTTLE_TLOG( TUTTLE_INFO, "[Process render] setup " << nbOutdated << " nodes" );
 	
 	connectClips<InternalGraphImpl>( _renderGraph );
 	
 	{
 		TUTTLE_TLOG( TUTTLE_INFO, "[Process render] Time domain propagation" );
 		graph::visitor::TimeDomain<InternalGraphImpl> timeDomainPropagationVisitor( _renderGraph );
+		timeDomainPropagationVisitor.setProfiler( _options->getActiveProfiler() );
 		_renderGraph.depthFirstVisit( timeDomainPropagationVisitor, _renderGraph.getVertexDescriptor( _outputId ) );
 	}
 
 	{	
 		TUTTLE_TLOG( TUTTLE_INFO, "[Process render] setup visitors" );
 		graph::visitor::Setup1<InternalGraphImpl> setup1Visitor( _renderGraph );
+		setup1Visitor.setProfiler( _options->getActiveProfiler() );
 		_renderGraph.depthFirstVisit( setup1Visitor, _renderGraph.getVertexDescriptor( _outputId ) );
+		// The bit depths are propagated in the whole graph,
+		// only the actions of the plugins are avoided on the nodes up to date.
 		graph::visitor::Setup2<InternalGraphImpl> setup2Visitor( _renderGraph );
 		_renderGraph.depthFirstVisit( setup2Visitor, _renderGraph.getVertexDescriptor( _outputId ) );
 		graph::visitor::Setup3<InternalGraphImpl> setup3Visitor( _renderGraph );
 		_renderGraph.depthFirstVisit( setup3Visitor, _renderGraph.getVertexDescriptor( _outputId ) );
 	}
+	_isSetup = true;
 }
 
 std::list<TimeRange> ProcessGraph::computeTimeRange()
 {
-	std::list<TimeRange> timeRanges = _options.getTimeRanges();
+	std::list<TimeRange> timeRanges = _options->getTimeRanges();
 
 	TUTTLE_TLOG_INFOS;
 	if( timeRanges.empty() )
@@ -318,10 +468,10 @@ std::list<TimeRange> ProcessGraph::computeTimeRange()
 			OfxRangeD timeDomain = v.getProcessData()._timeDomain;
 			TUTTLE_TLOG_VAR2( TUTTLE_TRACE, timeDomain.min, timeDomain.max );
 			
-			if( _options.getBegin() != std::numeric_limits<int>::min() && timeDomain.min < _options.getBegin() )
-				timeDomain.min = _options.getBegin();
-			if( _options.getEnd() != std::numeric_limits<int>::max() && timeDomain.max > _options.getEnd() )
-				timeDomain.max = _options.getEnd();
+			if( _options->getBegin() != std::numeric_limits<int>::min() && timeDomain.min < _options->getBegin() )
+				timeDomain.min = _options->getBegin();
+			if( _options->getEnd() != std::numeric_limits<int>::max() && timeDomain.max > _options->getEnd() )
+				timeDomain.max = _options->getEnd();
 			
 			TUTTLE_TLOG_VAR2( TUTTLE_TRACE, timeDomain.min, timeDomain.max );
 			// special case for infinite time domain (eg. a still image)
@@ -341,7 +491,8 @@ std::list<TimeRange> ProcessGraph::computeTimeRange()
 
 void ProcessGraph::setupAtTime( const OfxTime time )
 {
-	_options.setupAtTimeHandle();
+	if( ! _deferProgressHandles )
+		_options->setupAtTimeHandle();
 #ifdef TUTTLE_EXPORT_WITH_TIMER
 	boost::timer::cpu_timer timer;
 #endif
@@ -428,7 +579,7 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 	graph::exportDebugAsDOT( "graphProcessAtTime_a.dot", _renderGraphAtTime );
 #endif
 
-	if( ! _options.getForceIdentityNodesProcess() )
+	if( ! _options->getForceIdentityNodesProcess() )
 	{
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] remove identity nodes" );
 		// The "Remove identity nodes" step need to be done after preprocess steps, because the RoI need to be computed.
@@ -453,13 +604,19 @@ void ProcessGraph::setupAtTime( const OfxTime time )
 	{
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] preprocess 1" );
 		graph::visitor::PreProcess1<InternalGraphAtTimeImpl> preProcess1Visitor( _renderGraphAtTime );
+		preProcess1Visitor.setProfiler( _options->getActiveProfiler() );
 		_renderGraphAtTime.depthFirstVisit( preProcess1Visitor, outputAtTime );
 	}
 
 	{
 		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] preprocess 2" );
-		graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor( _renderGraphAtTime );
-		_renderGraphAtTime.depthFirstVisit( preProcess2Visitor, outputAtTime );
+		graph::visitor::preProcess2( _renderGraphAtTime, outputAtTime, _options->getActiveProfiler() );
+	}
+
+	if( _options->getUseRenderCache() )
+	{
+		TUTTLE_LOG_TRACE( "[Setup at time " << time << "] use render cache" );
+		useRenderCache( outputAtTime );
 	}
 
 #ifdef TUTTLE_EXPORT_PROCESSGRAPH_DOT
@@ -537,7 +694,8 @@ void ProcessGraph::computeHashAtTime( NodeHashContainer& outNodesHash, const Ofx
 
 void ProcessGraph::processAtTime( memory::IMemoryCache& outCache, const OfxTime time )
 {
-	_options.processAtTimeHandle();
+	if( ! _deferProgressHandles )
+		_options->processAtTimeHandle();
 #ifdef TUTTLE_EXPORT_WITH_TIMER
 	boost::timer::cpu_timer timer;
 #endif
@@ -552,16 +710,30 @@ void ProcessGraph::processAtTime( memory::IMemoryCache& outCache, const OfxTime
 
 	// do the process
 	graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor( _renderGraphAtTime, _internMemoryCache );
-	if( _options.getReturnBuffers() )
+	processVisitor.setProfiler( _options->getActiveProfiler() );
+	if( _options->getReturnBuffers() )
 	{
 		// accumulate output nodes buffers into the @p outCache MemoryCache
 		processVisitor.setOutputMemoryCache( outCache );
 	}
+	if( _options->getTileSize() )
+	{
+		// render chains of nodes supporting tiles with tile buffers
+		graph::visitor::markTiledEdges( _renderGraphAtTime );
+		processVisitor.setTileSize( _options->getTileSize() );
+	}
 
 	_renderGraphAtTime.depthFirstVisit( processVisitor, outputAtTime );
 
+	if( _options->getUseRenderCache() )
+	{
+		TUTTLE_LOG_TRACE( "[Process at time " << time << "] Fill render cache" );
+		fillRenderCache();
+	}
+
 	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Post process" );
 	graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor( _renderGraphAtTime );
+	postProcessVisitor.setProfiler( _options->getActiveProfiler() );
 	_renderGraphAtTime.depthFirstVisit( postProcessVisitor, outputAtTime );
 
 	///@todo clean datas...
@@ -584,6 +756,302 @@ void ProcessGraph::processAtTime( memory::IMemoryCache& outCache, const OfxTime
 	TUTTLE_LOG_TRACE( "[Process at time " << time << "] Out cache size: " << outCache.size() );
 }
 
+std::size_t ProcessGraph::getRenderCacheKey( const VertexAtTime& v ) const
+{
+	std::size_t key = _nodesHash.getHash( v.getKey() );
+	boost::hash_combine( key, _procOptions._renderScale.x );
+	boost::hash_combine( key, _procOptions._renderScale.y );
+	return key;
+}
+
+/**
+ * @brief Take the output of the nodes already computed from the render cache.
+ * The inputs of these nodes are disconnected, so all the upstream nodes
+ * only used by them are not computed.
+ */
+void ProcessGraph::useRenderCache( const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime )
+{
+	memory::RenderCache& renderCache = core().getRenderCache();
+
+	_nodesHash.clear();
+	graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashAtTimeVisitor( _renderGraphAtTime, _nodesHash, _renderGraphAtTime.instance( outputAtTime )._data._time );
+	_renderGraphAtTime.depthFirstVisit( computeHashAtTimeVisitor, outputAtTime );
+
+	bool cacheHit = false;
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices() )
+	{
+		VertexAtTime& v = _renderGraphAtTime.instance( vd );
+		if( v.isFake() || ! _nodesHash.hasHash( v.getKey() ) ||
+		    v.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect )
+			continue;
+
+		ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		ProfileScope profile( _options->getActiveProfiler(), v.getName(), vData._time, eProfilePhaseCache );
+		const memory::CACHE_ELEMENT cachedImage = renderCache.get( getRenderCacheKey( v ), vData._apiImageEffect._renderRoI );
+		if( ! cachedImage.get() )
+		{
+			profile.addCacheMiss();
+			continue;
+		}
+		profile.addCacheHit();
+
+		TUTTLE_TLOG( TUTTLE_INFO, "[Render cache] use cached output of " << v.getName() << " at time " << vData._time );
+		vData._isCached = true;
+		// A node constant in time has the same hash at all the frames, so the
+		// frame lanes get the same cached image: each lane uses its own image
+		// at its own time, sharing only the pixels.
+		attribute::ClipImage& outputClip = v.getProcessNode().asImageEffectNode().getOutputClip();
+		const memory::CACHE_ELEMENT image( new attribute::Image( outputClip, vData._time, *cachedImage ) );
+		_internMemoryCache.put( outputClip.getClipIdentifier(), vData._time, image );
+		_renderGraphAtTime.clearVertexOutputs( vd );
+		cacheHit = true;
+	}
+
+	if( cacheHit )
+	{
+		// Bake graph information again as the connections have changed.
+		bakeGraphInformationToNodes( _renderGraphAtTime );
+	}
+}
+
+/**
+ * @brief Put the outputs computed at the current time into the render cache.
+ */
+void ProcessGraph::fillRenderCache()
+{
+	memory::RenderCache& renderCache = core().getRenderCache();
+
+	BOOST_FOREACH( const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices() )
+	{
+		VertexAtTime& v = _renderGraphAtTime.instance( vd );
+		if( v.isFake() || ! _nodesHash.hasHash( v.getKey() ) ||
+		    v.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect )
+			continue;
+
+		const ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+		// a tiled output only contains the last tile
+		if( vData._isCached || graph::visitor::hasTiledOutput( vData ) )
+			continue;
+
+		memory::CACHE_ELEMENT image = _internMemoryCache.get( v.getProcessNode().asImageEffectNode().getOutputClip().getClipIdentifier(), vData._time );
+		if( image.get() )
+			renderCache.put( getRenderCacheKey( v ), vData._apiImageEffect._renderRoI, image );
+	}
+}
+
+/**
+ * @brief Decide what to do with the exception currently handled, raised during the render of a frame.
+ * Returns if the process should continue, else it finalizes the sequence and rethrows the exception.
+ * @remark Must be called from a catch block.
+ */
+void ProcessGraph::handleFrameError( const OfxTime time )
+{
+	try
+	{
+		throw;
+	}
+	catch( tuttle::exception::FileInSequenceNotExist& e ) // @todo tuttle: change that.
+	{
+		e << tuttle::exception::time(time);
+		if( _options->getContinueOnError() || _options->getContinueOnMissingFile() )
+		{
+			TUTTLE_LOG_WARNING( "[Process render] Missing input file at frame " << time << "." << std::endl
+					<< tuttle::exception::format_exception_message(e) << std::endl
+					<< tuttle::exception::format_exception_info(e)
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Missing input file at frame " << time << "." << std::endl );
+			_options->endFrameHandle();
+			endSequence();
+			_renderGraphAtTime.clear();
+			_internMemoryCache.clearUnused();
+			throw;
+		}
+	}
+	catch( ::boost::exception& e )
+	{
+		e << tuttle::exception::time(time);
+		if( _options->getContinueOnError() )
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
+					<< tuttle::exception::format_exception_message(e) << std::endl
+					<< tuttle::exception::format_exception_info(e)
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Stopped at frame " << time << "." << std::endl );
+			_options->endFrameHandle();
+			endSequence();
+			_renderGraphAtTime.clear();
+			_internMemoryCache.clearUnused();
+			throw;
+		}
+	}
+	catch(...)
+	{
+		if( _options->getContinueOnError() )
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
+					<< tuttle::exception::format_current_exception()
+				);
+		}
+		else
+		{
+			TUTTLE_LOG_ERROR( "[Process render] Error at frame " << time << "." << std::endl );
+			_options->endFrameHandle();
+			endSequence();
+			_renderGraphAtTime.clear();
+			_internMemoryCache.clearUnused();
+			throw;
+		}
+	}
+}
+
+/**
+ * @brief Create the frame lanes needed to render @p nbParallelFrames frames at the same time.
+ * The master graph is used as the first lane.
+ * The lanes kept from a previous compute are synchronized with the master nodes.
+ */
+void ProcessGraph::createFrameLanes( const std::size_t nbParallelFrames )
+{
+	if( _frameLanes.size() >= nbParallelFrames )
+		_frameLanes.erase( _frameLanes.begin() + ( nbParallelFrames - 1 ), _frameLanes.end() );
+	BOOST_FOREACH( ProcessGraph& lane, _frameLanes )
+	{
+		lane.synchronizeLaneNodes( *this );
+		lane.setup();
+	}
+	for( std::size_t i = _frameLanes.size() + 1; i < nbParallelFrames; ++i )
+	{
+		_frameLanes.push_back( new ProcessGraph( *this, i ) );
+		_frameLanes.back().setup();
+	}
+}
+
+/**
+ * @brief Render one frame of a frame lane.
+ * @remark Called from a render thread, errors are stored into the job to be handled by the master in frame order.
+ */
+void ProcessGraph::processFrameJob( FrameJob& job )
+{
+	if( _options->getAbort() )
+		return;
+	try
+	{
+		setupAtTime( job._time );
+		processAtTime( job._outCache, job._time );
+		job._rendered = true;
+	}
+	catch(...)
+	{
+		job._error = boost::current_exception();
+		_renderGraphAtTime.clear();
+		_internMemoryCache.clearUnused();
+	}
+}
+
+/**
+ * @brief Argument of the thread pool task rendering the frames in parallel.
+ */
+struct ProcessGraph::FrameJobs
+{
+	FrameJobs( ProcessGraph& master, boost::ptr_vector<FrameJob>& jobs )
+		: _master( master )
+		, _jobs( jobs )
+	{}
+
+	ProcessGraph& _master;
+	boost::ptr_vector<FrameJob>& _jobs;
+};
+
+void ProcessGraph::processFrameJobTask( unsigned int threadIndex, unsigned int threadMax, void* customArg )
+{
+	FrameJobs& frameJobs = *static_cast<FrameJobs*>( customArg );
+	ProcessGraph& lane = ( threadIndex == 0 ) ? frameJobs._master : frameJobs._master._frameLanes[threadIndex - 1];
+	lane.processFrameJob( frameJobs._jobs[threadIndex] );
+}
+
+/**
+ * @brief Render the frames of @p timeRange by groups of nbParallelFrames frames,
+ * each frame of a group is rendered by its own lane.
+ * Results, progress handles and errors are processed in frame order.
+ * @return false if the process has been aborted
+ */
+bool ProcessGraph::processFramesInParallel( memory::IMemoryCache& outCache, const TimeRange& timeRange )
+{
+	const std::size_t nbLanes = _frameLanes.size() + 1;
+	boost::ptr_vector<FrameJob> jobs;
+	jobs.reserve( nbLanes );
+
+	_deferProgressHandles = true;
+
+	for( int firstTime = timeRange._begin; firstTime <= timeRange._end; firstTime += timeRange._step * nbLanes )
+	{
+		jobs.clear();
+		for( int time = firstTime; time <= timeRange._end && jobs.size() < nbLanes; time += timeRange._step )
+		{
+			jobs.push_back( new FrameJob() );
+			jobs.back()._time = time;
+		}
+
+		// each lane renders one frame, inside the host thread pool
+		// so the multithreaded nodes share the same threads
+		FrameJobs frameJobs( *this, jobs );
+		core().getThreadPool().run( &ProcessGraph::processFrameJobTask, static_cast<unsigned int>( jobs.size() ), &frameJobs );
+
+		BOOST_FOREACH( FrameJob& job, jobs )
+		{
+			const OfxTime time = job._time;
+			_options->beginFrameHandle();
+			if( job._rendered || job._error )
+			{
+				_options->setupAtTimeHandle();
+				_options->processAtTimeHandle();
+			}
+
+			if( job._error )
+			{
+				try
+				{
+					boost::rethrow_exception( job._error );
+				}
+				catch(...)
+				{
+					// with continue-on-error, the next frames are still rendered by the lanes:
+					// the progress handles stay deferred to this thread
+					handleFrameError( time );
+				}
+			}
+			else if( job._rendered )
+			{
+				for( std::size_t i = 0; i < job._outCache.size(); ++i )
+				{
+					const memory::CACHE_ELEMENT image = job._outCache.get( i );
+					outCache.put( job._outCache.getPluginName( image ), job._outCache.getTime( image ), image );
+				}
+				job._outCache.clearAll();
+			}
+
+			if( _options->getAbort() )
+			{
+				TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED at time " << time << "." );
+				_options->endFrameHandle();
+				endSequence();
+				_renderGraphAtTime.clear();
+				_internMemoryCache.clearUnused();
+				_deferProgressHandles = false;
+				return false;
+			}
+			_options->endFrameHandle();
+		}
+	}
+	_deferProgressHandles = false;
+	return true;
+}
+
 bool ProcessGraph::process( memory::IMemoryCache& outCache )
 {
 #ifdef TUTTLE_EXPORT_WITH_TIMER
@@ -602,6 +1070,19 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 	graph::exportDebugAsDOT( "graphProcess_b.dot", _renderGraph );
 #endif
 
+	std::size_t nbParallelFrames = _options->getNbParallelFrames();
+	if( nbParallelFrames == 0 )
+		nbParallelFrames = core().getThreadPool().getNbThreads();
+	if( nbParallelFrames > 1 )
+	{
+		TUTTLE_LOG_INFO( "[Process render] render " << nbParallelFrames << " frames in parallel" );
+		createFrameLanes( nbParallelFrames );
+	}
+	else
+	{
+		_frameLanes.clear();
+	}
+
 	/// @todo Bug: need to use a map 'OutputNode': 'timeRanges'
 	/// And check if all Output nodes share a common timeRange
 
@@ -615,7 +1096,7 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 
 		beginSequence( timeRange );
 
-		if( _options.getAbort() )
+		if( _options->getAbort() )
 		{
 			TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED before first frame." );
 			endSequence();
@@ -623,9 +1104,17 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 			return false;
 		}
 
+		if( ! _frameLanes.empty() )
+		{
+			if( ! processFramesInParallel( outCache, timeRange ) )
+				return false;
+			endSequence();
+			continue;
+		}
+
 		for( int time = timeRange._begin; time <= timeRange._end; time += timeRange._step )
 		{
-			_options.beginFrameHandle();
+			_options->beginFrameHandle();
 
 			try
 			{
@@ -645,75 +1134,21 @@ bool ProcessGraph::process( memory::IMemoryCache& outCache )
 				TUTTLE_LOG_INFO( "[process timer] took " << boost::timer::format(processAtTime_timer.elapsed()) );
 #endif
 			}
-			catch( tuttle::exception::FileInSequenceNotExist& e ) // @todo tuttle: change that.
-			{
-				e << tuttle::exception::time(time);
-				if( _options.getContinueOnError() || _options.getContinueOnMissingFile() )
-				{
-					TUTTLE_LOG_WARNING( "[Process render] Missing input file at frame " << time << "." << std::endl
-							<< tuttle::exception::format_exception_message(e) << std::endl
-							<< tuttle::exception::format_exception_info(e)
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Missing input file at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
-				}
-			}
-			catch( ::boost::exception& e )
-			{
-				e << tuttle::exception::time(time);
-				if( _options.getContinueOnError() )
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
-							<< tuttle::exception::format_exception_message(e) << std::endl
-							<< tuttle::exception::format_exception_info(e)
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Stopped at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
-				}
-			}
 			catch(...)
 			{
-				if( _options.getContinueOnError() )
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Skip frame " << time << "." << std::endl
-							<< tuttle::exception::format_current_exception()
-						);
-				}
-				else
-				{
-					TUTTLE_LOG_ERROR( "[Process render] Error at frame " << time << "." << std::endl );
-					_options.endFrameHandle();
-					endSequence();
-					_renderGraphAtTime.clear();
-					_internMemoryCache.clearUnused();
-					throw;
-				}
+				handleFrameError( time );
 			}
 
-			if( _options.getAbort() )
+			if( _options->getAbort() )
 			{
 				TUTTLE_LOG_ERROR( "[Process render] PROCESS ABORTED at time " << time << "." );
-				_options.endFrameHandle();
+				_options->endFrameHandle();
 				endSequence();
 				_renderGraphAtTime.clear();
 				_internMemoryCache.clearUnused();
 				return false;
 			}
-			_options.endFrameHandle();
+			_options->endFrameHandle();
 		}
 
 		endSequence();
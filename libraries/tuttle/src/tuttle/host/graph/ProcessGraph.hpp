@@ -10,6 +10,9 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/NodeHashContainer.hpp>
+#include <tuttle/host/memory/MemoryCache.hpp>
+
+#include <boost/ptr_container/ptr_vector.hpp>
 
 #include <string>
 
@@ -54,15 +57,45 @@ public:
 	~ProcessGraph();
 
 private:
+	/**
+	 * @brief Create a frame lane: a copy of the @p master graph with cloned nodes,
+	 * used to render a frame in parallel of the master.
+	 */
+	ProcessGraph( const ProcessGraph& master, const std::size_t laneIndex );
+
+	struct FrameJob;
+	struct FrameJobs;
+
 	VertexAtTime::Key getOutputKeyAtTime( const OfxTime time );
 	InternalGraphAtTimeImpl::vertex_descriptor getOutputVertexAtTime( const OfxTime time );
 	
 	void relink();
+	void cloneNodes();
+	void synchronizeLaneNodes( const ProcessGraph& master );
 	void bakeGraphInformationToNodes( InternalGraphAtTimeImpl& renderGraphAtTime );
 
+	void createFrameLanes( const std::size_t nbParallelFrames );
+	void processFrameJob( FrameJob& job );
+	static void processFrameJobTask( unsigned int threadIndex, unsigned int threadMax, void* customArg );
+	bool processFramesInParallel( memory::IMemoryCache& outCache, const TimeRange& timeRange );
+	void handleFrameError( const OfxTime time );
+
+	std::size_t getRenderCacheKey( const VertexAtTime& v ) const;
+	void useRenderCache( const InternalGraphAtTimeImpl::vertex_descriptor outputAtTime );
+	void fillRenderCache();
+
 public:
 	void updateGraph( Graph& userGraph, const std::list<std::string>& outputNodes );
 
+	/**
+	 * @brief The graph could be computed again while the topology of the user graph doesn't change.
+	 * @return true if this graph renders @p outputNodes using @p internMemoryCache
+	 */
+	bool isCompiledFor( const std::list<std::string>& outputNodes, const memory::IMemoryCache& internMemoryCache ) const;
+
+	/// @brief Options of the next compute, a new render scale needs a new setup of all nodes.
+	void setOptions( const ComputeOptions& options );
+
 	void setup();
 	std::list<TimeRange> computeTimeRange();
 	void computeHashAtTime( NodeHashContainer& outNodesHash, const OfxTime time );
@@ -82,9 +115,22 @@ private:
 
 	static const std::string _outputId;
 	
-	const ComputeOptions& _options;
+	const ComputeOptions* _options; ///< options of the current compute
+	std::list<std::string> _outputNodes;
+	memory::MemoryCache _laneMemoryCache; ///< intern memory cache of a frame lane
 	memory::IMemoryCache& _internMemoryCache;
 	ProcessVertexData _procOptions;
+	NodeHashContainer _nodesHash; ///< global hash of the nodes at the current time, used by the render cache
+	bool _isSetup; ///< a previous setup could be partially reused
+
+	/// @brief Frame-parallel rendering
+	/// @{
+	boost::ptr_vector<ProcessGraph> _frameLanes; ///< graphs used to render other frames in parallel (owned by the master)
+	boost::ptr_vector<INode> _laneNodes; ///< nodes cloned by a frame lane
+	std::map<std::string, std::size_t> _laneNodesRevision; ///< revision of the master nodes copied into the cloned nodes
+	bool _isFrameLane;
+	bool _deferProgressHandles; ///< progress handles are called by the master in frame order
+	/// @}
 };
 
 }
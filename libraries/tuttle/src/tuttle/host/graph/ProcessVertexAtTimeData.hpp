@@ -47,6 +47,7 @@ public:
 		: _nodeData( NULL )
 		, _time( 0 )
 		, _isFinalNode( false )
+		, _isCached( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
 	{
@@ -57,6 +58,7 @@ public:
 		: _nodeData( &nodeData )
 		, _time( time )
 		, _isFinalNode( false )
+		, _isCached( false )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
 	{
@@ -76,6 +78,7 @@ public:
 		
 		_time = v._time;
 		_isFinalNode = v._isFinalNode;
+		_isCached = v._isCached;
 		_outDegree = v._outDegree;
 		_inDegree = v._inDegree;
 		_localInfos = v._localInfos;
@@ -105,6 +108,7 @@ public:
 
 	OfxTime _time;
 	bool _isFinalNode;
+	bool _isCached; ///< the output is taken from the render cache, so the node (and its inputs) is not computed
 
 	typedef std::pair<std::string, OfxTime> Key;
 	typedef std::map<Key, const ProcessEdgeAtTime*> ProcessEdgeAtTimeByClipName;
@@ -24,6 +24,8 @@ public:
 		, _interactive( 0 )
 		, _outDegree( 0 )
 		, _inDegree( 0 )
+		, _nodeRevision( 0 )
+		, _isUpToDate( false )
 	{
 		_timeDomain.min = kOfxFlagInfiniteMin;
 		_timeDomain.max = kOfxFlagInfiniteMax;
@@ -65,6 +67,9 @@ public:
 	std::size_t _outDegree; ///< number of connected input clips
 	std::size_t _inDegree; ///< number of nodes using the output of this node
 
+	std::size_t _nodeRevision; ///< revision of the node at its last setup
+	bool _isUpToDate; ///< the setup of a previous compute is still valid
+
 	///@brief All time dependant datas.
 	///@{
 	typedef std::set<OfxTime> TimesSet;
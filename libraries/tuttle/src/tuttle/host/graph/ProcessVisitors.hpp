@@ -2,6 +2,11 @@
 #define _TUTTLE_HOST_PROCESSVISITORS_HPP_
 
 #include "ProcessVertexData.hpp"
+#include "ProcessVertexAtTimeData.hpp"
+
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/Profiler.hpp>
+#include <tuttle/host/ofx/OfxhUtilities.hpp>
 
 #include <tuttle/host/memory/MemoryCache.hpp>
 
@@ -16,6 +21,7 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 
 namespace tuttle {
 namespace host {
@@ -48,6 +54,47 @@ namespace visitor {
 
 
 
+/**
+ * @brief Find the vertices with a valid setup from a previous compute:
+ * the node is not modified since its last setup and all its inputs are up to date.
+ */
+template<class TGraph>
+class CheckUpToDate : public boost::default_dfs_visitor
+{
+public:
+	typedef typename TGraph::GraphContainer GraphContainer;
+	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+
+	CheckUpToDate( TGraph& graph, const bool isSetup )
+		: _graph( graph )
+		, _isSetup( isSetup )
+	{}
+
+	template<class VertexDescriptor, class Graph>
+	void finish_vertex( VertexDescriptor v, Graph& g )
+	{
+		Vertex& vertex = _graph.instance( v );
+		if( vertex.isFake() )
+			return;
+
+		bool upToDate = _isSetup && vertex.getProcessData()._nodeRevision == vertex.getProcessNode().getRevision();
+		// the inputs are already finished
+		BOOST_FOREACH( const edge_descriptor ed, boost::out_edges( v, g ) )
+		{
+			const Vertex& input = _graph.instance( boost::target( ed, g ) );
+			if( ! input.isFake() && ! input.getProcessData()._isUpToDate )
+				upToDate = false;
+		}
+		vertex.getProcessData()._isUpToDate = upToDate;
+		TUTTLE_TLOG( TUTTLE_TRACE, "[Check up to date] finish vertex " << vertex << ": " << upToDate );
+	}
+
+private:
+	TGraph& _graph;
+	const bool _isSetup; ///< false for the first setup of the graph
+};
+
 template<class TGraph>
 class Setup1 : public boost::default_dfs_visitor
 {
@@ -57,22 +104,30 @@ public:
 
 	Setup1( TGraph& graph )
 		: _graph( graph )
+		, _profiler( NULL )
 	{}
 
+	void setProfiler( Profiler* profiler )
+	{
+		_profiler = profiler;
+	}
+
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor v, Graph& g )
 	{
 		Vertex& vertex = _graph.instance( v );
 
 		TUTTLE_TLOG( TUTTLE_TRACE, "[Setup 1] finish vertex " << vertex );
-		if( vertex.isFake() )
+		if( vertex.isFake() || vertex.getProcessData()._isUpToDate )
 			return;
 
+		ProfileScope profile( _profiler, vertex.getName(), eProfilePhaseSetup );
 		vertex.getProcessNode().setup1();
 	}
 
 private:
 	TGraph& _graph;
+	Profiler* _profiler;
 };
 
 template<class TGraph>
@@ -138,23 +193,33 @@ public:
 
 	TimeDomain( TGraph& graph )
 		: _graph( graph )
+		, _profiler( NULL )
 	{}
 
+	void setProfiler( Profiler* profiler )
+	{
+		_profiler = profiler;
+	}
+
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor vd, Graph& g )
 	{
 		Vertex& vertex = _graph.instance( vd );
 
 		TUTTLE_TLOG( TUTTLE_TRACE, "[Time Domain] finish vertex " << vertex );
-		if( vertex.isFake() )
+		if( vertex.isFake() || vertex.getProcessData()._isUpToDate )
 			return;
 
-		vertex.getProcessData()._timeDomain = vertex.getProcessNode().computeTimeDomain();
+		{
+			ProfileScope profile( _profiler, vertex.getName(), eProfilePhaseSetup );
+			vertex.getProcessData()._timeDomain = vertex.getProcessNode().computeTimeDomain();
+		}
 		TUTTLE_TLOG( TUTTLE_TRACE, "[Time Domain] min: " << vertex.getProcessData()._timeDomain.min << ", max: " << vertex.getProcessData()._timeDomain.max );
 	}
 
 private:
 	TGraph& _graph;
+	Profiler* _profiler;
 };
 
 template<class TGraph>
@@ -185,7 +250,8 @@ public:
 		if( vertex.isFake() )
 			return;
 
-		const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(_time);
+		// with temporal access, the input nodes are not at the time of the output node
+		const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime( vertex.getProcessDataAtTime()._time );
 
 		typedef std::map<VertexKey, std::size_t> InputsHash;
 		InputsHash inputsGlobalHash;
@@ -593,8 +659,14 @@ public:
 
 	PreProcess1( TGraph& graph )
 		: _graph( graph )
+		, _profiler( NULL )
 	{}
 
+	void setProfiler( Profiler* profiler )
+	{
+		_profiler = profiler;
+	}
+
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor v, Graph& g )
 	{
@@ -605,40 +677,101 @@ public:
 			return;
 
 		//TUTTLE_TLOG( TUTTLE_TRACE, vertex.getProcessDataAtTime()._time );
+		ProfileScope profile( _profiler, vertex.getName(), vertex.getProcessDataAtTime()._time, eProfilePhasePreProcess );
 		vertex.getProcessNode().preProcess1( vertex.getProcessDataAtTime() );
 	}
 
 private:
 	TGraph& _graph;
+	Profiler* _profiler;
 };
 
+/**
+ * @brief Collect the vertices in depth first search finish order,
+ * so each node comes after all its input nodes.
+ * @remark The discover order is not enough to visit a node after all the nodes
+ * using it, as a node used twice is discovered from its first user.
+ */
 template<class TGraph>
 class PreProcess2 : public boost::default_dfs_visitor
 {
 public:
 	typedef typename TGraph::GraphContainer GraphContainer;
 	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::vertex_descriptor vertex_descriptor;
 
-	PreProcess2( TGraph& graph )
+	PreProcess2( TGraph& graph, std::vector<vertex_descriptor>& finishOrder )
 		: _graph( graph )
+		, _finishOrder( finishOrder )
 	{}
 
 	template<class VertexDescriptor, class Graph>
-	void discover_vertex( VertexDescriptor v, Graph& g )
+	void finish_vertex( VertexDescriptor v, Graph& g )
 	{
-		Vertex& vertex = _graph.instance( v );
-
-		TUTTLE_TLOG( TUTTLE_TRACE, "[Preprocess 2] discover vertex " << vertex );
-		if( vertex.isFake() )
-			return;
-
-		vertex.getProcessNode().preProcess2_reverse( vertex.getProcessDataAtTime() );
+		TUTTLE_TLOG( TUTTLE_TRACE, "[Preprocess 2] finish vertex " << _graph.instance( v ) );
+		_finishOrder.push_back( v );
 	}
 
 private:
 	TGraph& _graph;
+	std::vector<vertex_descriptor>& _finishOrder;
 };
 
+/**
+ * @brief Call preProcess2_reverse on each node after all the nodes using it,
+ * and propagate the regions of interest from the outputs to the inputs.
+ * The RoI of a node is the union of the RoIs requested by all the nodes using it.
+ */
+template<class TGraph>
+void preProcess2( TGraph& graph, const typename TGraph::vertex_descriptor& output, Profiler* profiler = NULL )
+{
+	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::Edge Edge;
+	typedef typename TGraph::vertex_descriptor vertex_descriptor;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+	typedef ProcessVertexAtTimeData::ImageEffect::MapClipImageRod MapClipImageRod;
+
+	std::vector<vertex_descriptor> finishOrder;
+	PreProcess2<TGraph> preProcess2Visitor( graph, finishOrder );
+	graph.depthFirstVisit( preProcess2Visitor, output );
+
+	BOOST_REVERSE_FOREACH( const vertex_descriptor& vd, finishOrder )
+	{
+		Vertex& vertex = graph.instance( vd );
+		if( vertex.isFake() )
+			continue;
+
+		ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+		{
+			ProfileScope profile( profiler, vertex.getName(), vData._time, eProfilePhasePreProcess );
+			vertex.getProcessNode().preProcess2_reverse( vData );
+		}
+
+		BOOST_FOREACH( const edge_descriptor& ed, graph.getOutEdges( vd ) )
+		{
+			const Edge& edge = graph.instance( ed );
+			ProcessVertexAtTimeData::ImageEffect& input = graph.targetInstance( ed ).getProcessDataAtTime()._apiImageEffect;
+
+			// by default, the whole input is needed
+			OfxRectD requestedRoI = input._renderRoD;
+			BOOST_FOREACH( const typename MapClipImageRod::value_type& clipRoI, vData._apiImageEffect._inputsRoI )
+			{
+				if( clipRoI.first->getName() == edge.getInAttrName() )
+				{
+					requestedRoI = clipRoI.second;
+					break;
+				}
+			}
+			if( ofx::isEmpty( requestedRoI ) )
+				continue;
+			if( ofx::isEmpty( input._renderRoI ) )
+				input._renderRoI = requestedRoI;
+			else
+				input._renderRoI = ofx::rectUnion( input._renderRoI, requestedRoI );
+		}
+	}
+}
+
 template<class TGraph>
 class OptimizeGraph : public boost::default_dfs_visitor
 {
@@ -696,6 +829,183 @@ private:
 	TGraph& _graph;
 };
 
+/**
+ * @brief The node of @p vertex can render its output tile by tile.
+ */
+template<class Vertex>
+inline bool supportsTileRender( Vertex& vertex )
+{
+	if( vertex.isFake() || vertex.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect )
+		return false;
+	return vertex.getProcessNode().asImageEffectNode().supportsTileRender();
+}
+
+/**
+ * @brief The output of the node is rendered tile by tile on demand of the node using it.
+ */
+inline bool hasTiledOutput( const ProcessVertexAtTimeData& vData )
+{
+	return vData._outEdges.size() == 1 && vData._outEdges.front()->isTiled();
+}
+
+inline bool hasTiledInputs( const ProcessVertexAtTimeData& vData )
+{
+	BOOST_FOREACH( const ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdge, vData._inEdges )
+	{
+		if( inEdge.second->isTiled() )
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Declare the connections rendered tile by tile.
+ * A node supporting tiles and used only by one node also supporting tiles,
+ * is rendered tile by tile on demand of this node, so it only needs a tile buffer.
+ * Others nodes render their whole RoI in one buffer.
+ */
+template<class TGraph>
+void markTiledEdges( TGraph& graph )
+{
+	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::vertex_descriptor vertex_descriptor;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+
+	BOOST_FOREACH( const vertex_descriptor vd, graph.getVertices() )
+	{
+		Vertex& vertex = graph.instance( vd );
+		if( ! supportsTileRender( vertex ) )
+			continue;
+		const ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+		if( vData._isFinalNode || vData._isCached || vData._outDegree != 1 )
+			continue;
+		BOOST_FOREACH( const edge_descriptor& ed, graph.getInEdges( vd ) )
+		{
+			const bool tiled = supportsTileRender( graph.sourceInstance( ed ) );
+			graph.instance( ed ).setTiled( tiled );
+			TUTTLE_TLOG( TUTTLE_TRACE, "[Tiles] " << vertex << " rendered by tiles: " << tiled );
+		}
+	}
+}
+
+/**
+ * @brief Render the region @p roi of a node, after the needed tiles of its tiled inputs.
+ */
+template<class TGraph>
+void processTile( TGraph& graph, const typename TGraph::vertex_descriptor& vd, const OfxRectD& roi )
+{
+	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::Edge Edge;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+	typedef ProcessVertexAtTimeData::ImageEffect::MapClipImageRod MapClipImageRod;
+
+	Vertex& vertex = graph.instance( vd );
+	ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+	ImageEffectNode& node = vertex.getProcessNode().asImageEffectNode();
+
+	MapClipImageRod inputsRoI;
+	node.getRegionOfInterestAction( vData._time, vData._nodeData->_renderScale, roi, inputsRoI );
+	BOOST_FOREACH( const edge_descriptor& ed, graph.getOutEdges( vd ) )
+	{
+		const Edge& edge = graph.instance( ed );
+		if( ! edge.isTiled() )
+			continue;
+		// the tile is inside the RoI computed during the preprocess
+		const OfxRectD& inputRoI = graph.targetInstance( ed ).getProcessDataAtTime()._apiImageEffect._renderRoI;
+		OfxRectD inputTile = inputRoI;
+		BOOST_FOREACH( const typename MapClipImageRod::value_type& clipRoI, inputsRoI )
+		{
+			if( clipRoI.first->getName() == edge.getInAttrName() )
+			{
+				inputTile = ofx::clamp( clipRoI.second, inputRoI );
+				break;
+			}
+		}
+		if( ofx::isEmpty( inputTile ) )
+			inputTile = inputRoI;
+		processTile( graph, graph.target( ed ), inputTile );
+	}
+
+	const bool tiledOutput = hasTiledOutput( vData );
+	if( tiledOutput )
+		node.allocateOutputImages( vData, roi );
+	node.render( vData, roi );
+	node.releaseInputImages( vData, ImageEffectNode::eInputImagesTiled );
+	if( tiledOutput )
+		node.declareOutputUsages( vData );
+}
+
+/**
+ * @brief Release the full frame inputs used by a node and its tiled inputs, once all tiles are rendered.
+ */
+template<class TGraph>
+void releaseFullFrameInputs( TGraph& graph, const typename TGraph::vertex_descriptor& vd )
+{
+	typedef typename TGraph::Vertex Vertex;
+	typedef typename TGraph::edge_descriptor edge_descriptor;
+
+	BOOST_FOREACH( const edge_descriptor& ed, graph.getOutEdges( vd ) )
+	{
+		if( graph.instance( ed ).isTiled() )
+			releaseFullFrameInputs( graph, graph.target( ed ) );
+	}
+	Vertex& vertex = graph.instance( vd );
+	vertex.getProcessNode().asImageEffectNode().releaseInputImages( vertex.getProcessDataAtTime(), ImageEffectNode::eInputImagesFullFrame );
+}
+
+/**
+ * @brief Render the whole RoI of a node tile by tile.
+ * The output buffer of the node contains the whole RoI,
+ * its tiled inputs are rendered again for each tile.
+ */
+template<class TGraph>
+void processTiles( TGraph& graph, const typename TGraph::vertex_descriptor& vd, const std::size_t tileSize )
+{
+	typedef typename TGraph::Vertex Vertex;
+
+	Vertex& vertex = graph.instance( vd );
+	ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+	ImageEffectNode& node = vertex.getProcessNode().asImageEffectNode();
+	const OfxRectD roi = vData._apiImageEffect._renderRoI;
+
+	double par = node.getOutputClip().getPixelAspectRatio();
+	if( par == 0.0 )
+		par = 1.0;
+	const double tileWidth = tileSize * par;
+	const double tileHeight = tileSize;
+
+	node.allocateOutputImages( vData, roi );
+	for( std::size_t j = 0; roi.y1 + j * tileHeight < roi.y2; ++j )
+	{
+		for( std::size_t i = 0; roi.x1 + i * tileWidth < roi.x2; ++i )
+		{
+			const OfxRectD tile = {
+				roi.x1 + i * tileWidth,
+				roi.y1 + j * tileHeight,
+				std::min( roi.x1 + ( i + 1 ) * tileWidth, roi.x2 ),
+				std::min( roi.y1 + ( j + 1 ) * tileHeight, roi.y2 )
+			};
+			TUTTLE_TLOG( TUTTLE_TRACE, "[Tiles] " << vertex << " tile: " << tile );
+			processTile( graph, vd, tile );
+		}
+	}
+	releaseFullFrameInputs( graph, vd );
+	node.declareOutputUsages( vData );
+}
+
+/**
+ * @brief The render of the readers and writers is profiled as I/O.
+ */
+inline EProfilePhase getRenderPhase( const INode& node )
+{
+	if( node.getNodeType() != INode::eNodeTypeImageEffect )
+		return eProfilePhaseRender;
+	const std::string& context = node.asImageEffectNode().getContext();
+	if( context == kOfxImageEffectContextReader || context == kOfxImageEffectContextWriter )
+		return eProfilePhaseIO;
+	return eProfilePhaseRender;
+}
+
 template<class TGraph>
 class Process : public boost::default_dfs_visitor
 {
@@ -707,6 +1017,8 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( NULL )
+		, _tileSize( 0 )
+		, _profiler( NULL )
 	{
 	}
 	
@@ -714,6 +1026,8 @@ public:
 		: _graph( graph )
 		, _cache( cache )
 		, _result( &result )
+		, _tileSize( 0 )
+		, _profiler( NULL )
 	{
 	}
 	
@@ -724,6 +1038,19 @@ public:
 	{
 		_result = &result;
 	}
+	
+	/**
+	 * Render the nodes with tiled inputs tile by tile (see markTiledEdges).
+	 */
+	void setTileSize( const std::size_t tileSize )
+	{
+		_tileSize = tileSize;
+	}
+
+	void setProfiler( Profiler* profiler )
+	{
+		_profiler = profiler;
+	}
 
 	template<class VertexDescriptor, class Graph>
 	void finish_vertex( VertexDescriptor v, Graph& g )
@@ -736,11 +1063,22 @@ public:
 		if( vertex.isFake() )
 			return;
 
+		// rendered tile by tile, by the node using it
+		if( hasTiledOutput( vertex.getProcessDataAtTime() ) )
+			return;
+
 		// check if abort ?
 
 		// launch the process
 		boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
-		vertex.getProcessNode().process( vertex.getProcessDataAtTime() );
+		ProfileScope profile( _profiler, vertex.getName(), vertex.getProcessDataAtTime()._time, getRenderPhase( vertex.getProcessNode() ) );
+		if( vertex.getProcessDataAtTime()._isCached )
+			// the output image is already in the memory cache, only declare its usages
+			vertex.getProcessNode().asImageEffectNode().declareOutputUsages( vertex.getProcessDataAtTime() );
+		else if( _tileSize && hasTiledInputs( vertex.getProcessDataAtTime() ) )
+			processTiles( _graph, v, _tileSize );
+		else
+			vertex.getProcessNode().process( vertex.getProcessDataAtTime() );
 		boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
 		_cumulativeTime += t2 - t1;
 		
@@ -765,6 +1103,8 @@ private:
 	TGraph& _graph;
 	memory::IMemoryCache& _cache;
 	memory::IMemoryCache* _result;
+	std::size_t _tileSize;
+	Profiler* _profiler;
 	boost::posix_time::time_duration _cumulativeTime;
 };
 
@@ -777,8 +1117,14 @@ public:
 
 	PostProcess( TGraph& graph )
 		: _graph( graph )
+		, _profiler( NULL )
 	{}
 
+	void setProfiler( Profiler* profiler )
+	{
+		_profiler = profiler;
+	}
+
 	template<class VertexDescriptor, class Graph>
 	void initialize_vertex( VertexDescriptor v, Graph& g )
 	{
@@ -798,11 +1144,13 @@ public:
 		if( vertex.isFake() )
 			return;
 
+		ProfileScope profile( _profiler, vertex.getName(), vertex.getProcessDataAtTime()._time, eProfilePhasePostProcess );
 		vertex.getProcessNode().postProcess( vertex.getProcessDataAtTime() );
 	}
 
 private:
 	TGraph& _graph;
+	Profiler* _profiler;
 };
 
 
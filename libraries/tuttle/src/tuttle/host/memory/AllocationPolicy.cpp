@@ -0,0 +1,244 @@
+#include "AllocationPolicy.hpp"
+
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined( __WINDOWS__ )
+ #include <malloc.h>
+#else
+ #include <stdlib.h>
+ #include <unistd.h>
+#endif
+
+#if defined( __LINUX__ )
+ #include <sys/mman.h>
+ #include <sys/syscall.h>
+ #include <fstream>
+ #include <string>
+ #include <sstream>
+#endif
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+namespace {
+
+static const std::size_t kMinAlignment = 64; ///< size of a cache line, enough for all SIMD loads
+static const std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+std::size_t roundUp( const std::size_t size, const std::size_t alignment )
+{
+	return ( ( size + alignment - 1 ) / alignment ) * alignment;
+}
+
+std::size_t pageSize()
+{
+#if defined( __WINDOWS__ )
+	return 4096;
+#else
+	static const std::size_t size = sysconf( _SC_PAGESIZE );
+	return size;
+#endif
+}
+
+char* alignedAlloc( const std::size_t alignment, const std::size_t size )
+{
+#if defined( __WINDOWS__ )
+	return static_cast<char*>( _aligned_malloc( size, alignment ) );
+#else
+	void* buffer = NULL;
+	if( posix_memalign( &buffer, alignment, size ) != 0 )
+		return NULL;
+	return static_cast<char*>( buffer );
+#endif
+}
+
+void alignedFree( char* buffer )
+{
+#if defined( __WINDOWS__ )
+	_aligned_free( buffer );
+#else
+	free( buffer );
+#endif
+}
+
+#if defined( __LINUX__ )
+
+#ifndef MPOL_INTERLEAVE
+ #define MPOL_INTERLEAVE 3
+#endif
+
+/**
+ * @brief Mask of the online NUMA nodes (limited to the 64 first nodes).
+ * @return 0 if the system is not NUMA
+ */
+unsigned long onlineNumaNodes()
+{
+	std::ifstream file( "/sys/devices/system/node/online" );
+	std::string content;
+	if( !std::getline( file, content ) )
+		return 0;
+
+	// format: "0-3,6"
+	unsigned long mask = 0;
+	std::istringstream ranges( content );
+	std::string range;
+	while( std::getline( ranges, range, ',' ) )
+	{
+		unsigned int first = 0;
+		unsigned int last = 0;
+		char sep = 0;
+		std::istringstream r( range );
+		if( !( r >> first ) )
+			continue;
+		last = first;
+		if( r >> sep >> last && sep != '-' )
+			last = first;
+		for( unsigned int node = first; node <= last && node < 64; ++node )
+			mask |= 1ul << node;
+	}
+	// a single node is not NUMA
+	if( ( mask & ( mask - 1 ) ) == 0 )
+		return 0;
+	return mask;
+}
+
+bool interleavePages( char* buffer, const std::size_t size )
+{
+	static const unsigned long nodes = onlineNumaNodes();
+	if( nodes == 0 )
+		return false;
+	const long res = syscall( SYS_mbind, buffer, size, MPOL_INTERLEAVE, &nodes, sizeof( nodes ) * 8, 0 );
+	if( res != 0 )
+	{
+		TUTTLE_LOG_DEBUG( "[Memory Pool] Can't interleave the buffer on the NUMA nodes." );
+		return false;
+	}
+	return true;
+}
+
+#endif
+
+}
+
+char* allocateBuffer( const AllocationPolicy& policy, const std::size_t size, BufferAllocation& allocation )
+{
+	const std::size_t alignment = std::max( policy._alignment, kMinAlignment );
+	const bool isBig = size >= policy._hugePagesMinSize;
+	allocation = BufferAllocation();
+	char* buffer = NULL;
+
+#if defined( __LINUX__ )
+	if( isBig )
+	{
+	#ifdef MAP_HUGETLB
+		if( policy._hugePages == eHugePagesExplicit )
+		{
+			const std::size_t mappedSize = roundUp( size, kHugePageSize );
+			void* mapped = mmap( NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+			if( mapped != MAP_FAILED )
+			{
+				buffer = static_cast<char*>( mapped );
+				allocation._alignment = kHugePageSize;
+				allocation._allocatedSize = mappedSize;
+				allocation._hugePages = eHugePagesExplicit;
+				allocation._isMapped = true;
+			}
+			else
+			{
+				TUTTLE_LOG_DEBUG( "[Memory Pool] No reserved huge page available for " << size << " bytes, use transparent huge pages." );
+			}
+		}
+	#endif
+		if( buffer == NULL && policy._hugePages != eHugePagesNone )
+		{
+			// transparent huge pages need a buffer aligned on huge pages
+			const std::size_t hugeSize = roundUp( size, kHugePageSize );
+			buffer = alignedAlloc( std::max( alignment, kHugePageSize ), hugeSize );
+			if( buffer != NULL )
+			{
+				allocation._alignment = std::max( alignment, kHugePageSize );
+				allocation._allocatedSize = hugeSize;
+			#ifdef MADV_HUGEPAGE
+				if( madvise( buffer, hugeSize, MADV_HUGEPAGE ) == 0 )
+					allocation._hugePages = eHugePagesTransparent;
+			#endif
+			}
+		}
+		if( buffer == NULL )
+		{
+			// the NUMA placement works on whole pages
+			const std::size_t pageAlignment = std::max( alignment, pageSize() );
+			const std::size_t pagesSize = roundUp( size, pageAlignment );
+			buffer = alignedAlloc( pageAlignment, pagesSize );
+			allocation._alignment = pageAlignment;
+			allocation._allocatedSize = pagesSize;
+		}
+		if( buffer != NULL && policy._numaPlacement == eNumaPlacementInterleaved )
+		{
+			// The pages are not touched yet, so the policy applies to all of them.
+			if( interleavePages( buffer, allocation._allocatedSize ) )
+				allocation._numaPlacement = eNumaPlacementInterleaved;
+		}
+		return buffer;
+	}
+#endif
+
+	buffer = alignedAlloc( alignment, size );
+	allocation._alignment = alignment;
+	allocation._allocatedSize = size;
+	return buffer;
+}
+
+void freeBuffer( char* buffer, const BufferAllocation& allocation )
+{
+	if( buffer == NULL )
+		return;
+#if defined( __LINUX__ )
+	if( allocation._isMapped )
+	{
+		munmap( buffer, allocation._allocatedSize );
+		return;
+	}
+#endif
+	alignedFree( buffer );
+}
+
+std::ostream& operator<<( std::ostream& os, const EHugePages v )
+{
+	switch( v )
+	{
+		case eHugePagesNone:
+			os << "none";
+			break;
+		case eHugePagesTransparent:
+			os << "transparent";
+			break;
+		case eHugePagesExplicit:
+			os << "explicit";
+			break;
+	}
+	return os;
+}
+
+std::ostream& operator<<( std::ostream& os, const ENumaPlacement v )
+{
+	switch( v )
+	{
+		case eNumaPlacementFirstTouch:
+			os << "first touch";
+			break;
+		case eNumaPlacementInterleaved:
+			os << "interleaved";
+			break;
+	}
+	return os;
+}
+
+}
+}
+}
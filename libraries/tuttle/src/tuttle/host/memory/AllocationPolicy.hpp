@@ -0,0 +1,87 @@
+#ifndef _TUTTLE_HOST_CORE_ALLOCATIONPOLICY_HPP_
+#define _TUTTLE_HOST_CORE_ALLOCATIONPOLICY_HPP_
+
+#include <cstddef>
+#include <iostream>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+enum EHugePages
+{
+	eHugePagesNone, ///< only use the system page size
+	eHugePagesTransparent, ///< align big buffers on huge pages and advise the kernel to use transparent huge pages
+	eHugePagesExplicit ///< map big buffers from the reserved huge pages, fallback to transparent huge pages
+};
+
+enum ENumaPlacement
+{
+	eNumaPlacementFirstTouch, ///< pages are placed on the node of the first thread writing them
+	eNumaPlacementInterleaved ///< pages of big buffers are interleaved on all the nodes
+};
+
+/**
+ * @brief How the MemoryPool allocates the memory of its buffers.
+ *
+ * The huge pages and the NUMA placement only apply to buffers bigger than
+ * _hugePagesMinSize (typically full frames). They are only available on Linux,
+ * the other systems only use the alignment.
+ */
+struct AllocationPolicy
+{
+	AllocationPolicy()
+		: _alignment( 64 )
+		, _hugePages( eHugePagesTransparent )
+		, _hugePagesMinSize( 4 * 1024 * 1024 )
+		, _numaPlacement( eNumaPlacementFirstTouch )
+	{}
+
+	std::size_t _alignment; ///< alignment of the buffers in bytes (a power of 2, at least 64)
+	EHugePages _hugePages;
+	std::size_t _hugePagesMinSize; ///< minimal size in bytes of the buffers using huge pages and NUMA placement
+	ENumaPlacement _numaPlacement;
+};
+
+/**
+ * @brief How a buffer was really allocated.
+ */
+struct BufferAllocation
+{
+	BufferAllocation()
+		: _alignment( 0 )
+		, _allocatedSize( 0 )
+		, _hugePages( eHugePagesNone )
+		, _numaPlacement( eNumaPlacementFirstTouch )
+		, _isMapped( false )
+	{}
+
+	std::size_t _alignment; ///< alignment of the buffer address
+	std::size_t _allocatedSize; ///< size asked to the system (with the huge pages rounding)
+	EHugePages _hugePages;
+	ENumaPlacement _numaPlacement;
+	bool _isMapped; ///< memory mapped from the system huge pages
+};
+
+/**
+ * @brief Allocate @p size bytes following @p policy.
+ * @param[out] allocation how the buffer was allocated, needed to free it
+ * @return the buffer or NULL if the system can't allocate it
+ */
+char* allocateBuffer( const AllocationPolicy& policy, const std::size_t size, BufferAllocation& allocation );
+
+/**
+ * @brief Free a buffer allocated by allocateBuffer.
+ */
+void freeBuffer( char* buffer, const BufferAllocation& allocation );
+
+#ifndef SWIG
+std::ostream& operator<<( std::ostream& os, const EHugePages v );
+std::ostream& operator<<( std::ostream& os, const ENumaPlacement v );
+#endif
+
+}
+}
+}
+
+#endif
@@ -45,6 +45,8 @@ public:
 	virtual size_t       getAvailableMemorySize() const  = 0;
 	virtual size_t       getWastedMemorySize() const     = 0;
 	virtual size_t       getMaxMemorySize() const        = 0;
+	virtual size_t       getPeakUsedMemorySize() const   = 0;
+	virtual void         resetPeakUsedMemorySize()       = 0;
 	virtual void         clear( size_t size )            = 0;
 	virtual void         clearOne()                      = 0;
 	virtual void         clear()                         = 0;
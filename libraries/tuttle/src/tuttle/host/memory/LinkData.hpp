@@ -1,7 +1,11 @@
 #ifndef _TUTTLE_HOST_LINKDATA_HPP_
 #define _TUTTLE_HOST_LINKDATA_HPP_
 
-#include "MemoryPool.hpp"
+#include "IMemoryPool.hpp"
+
+#include <boost/smart_ptr/detail/atomic_count.hpp>
+
+#include <cassert>
 
 namespace tuttle {
 namespace host {
@@ -9,33 +13,64 @@ namespace memory {
 
 /**
  * @brief A link to an external buffer which can't be managed by the MemoryPool.
+ *
+ * The buffer is borrowed from the application: it is used by the images
+ * without copy, and @p release is called with @p customData when the last
+ * image using it is destroyed, so the application could reuse its memory.
+ * Always allocate it with new, it deletes itself with its last reference.
  */
 class LinkData : public IPoolData
 {
+public:
+	typedef void (*CallbackReleasePtr)( void* customData );
+
+private:
 	LinkData();
 	LinkData( const LinkData& );
-	
+
 public:
-	LinkData( char* dataLink )
-	: _dataLink(dataLink)
+	LinkData( char* dataLink, const std::size_t size, CallbackReleasePtr release = NULL, void* customData = NULL )
+	: _dataLink( dataLink )
+	, _size( size )
+	, _reservedSize( size )
+	, _release( release )
+	, _customData( customData )
+	, _refCount( 0 )
 	{}
 
-	~LinkData ()
+	~LinkData()
 	{
 		// we don't own _dataLink
+		if( _release != NULL )
+			_release( _customData );
 	}
 
 	char*        data() { return _dataLink; }
 	const char*  data() const { return _dataLink; }
 
-	const size_t size() const { return 0; }
-	const size_t reservedSize() const { return 0; }
+	const std::size_t size() const { return _size; }
+	const std::size_t reservedSize() const { return _reservedSize; }
 
-	void addRef() {}
-	void release() {}
+	void setSize( const std::size_t newSize )
+	{
+		assert( newSize <= _reservedSize );
+		_size = newSize;
+	}
+
+	void addRef() { ++_refCount; }
+	void release()
+	{
+		if( --_refCount == 0 )
+			delete this;
+	}
 
 private:
 	char* const _dataLink;
+	std::size_t _size;
+	const std::size_t _reservedSize;
+	CallbackReleasePtr _release;
+	void* _customData;
+	boost::detail::atomic_count _refCount; ///< images (and nodes) using this buffer
 };
 
 }
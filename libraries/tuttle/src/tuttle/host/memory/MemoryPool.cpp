@@ -3,10 +3,16 @@
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/common/system/memoryInfo.hpp>
 #include <tuttle/host/Core.hpp>
+#include <tuttle/host/Profiler.hpp>
 
 #include <boost/throw_exception.hpp>
+#include <boost/smart_ptr/detail/atomic_count.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <new>
 
 namespace tuttle {
 namespace host {
@@ -22,18 +28,22 @@ private:
 	friend class MemoryPool;
 
 public:
-	PoolData( IPool& pool, const std::size_t size )
+	PoolData( IPool& pool, const std::size_t size, const AllocationPolicy& policy )
 		: _pool( pool )
 		, _id( _count++ )
 		, _reservedSize( size )
 		, _size( size )
-		, _pData( new char[size] )
+		, _pData( allocateBuffer( policy, size, _allocation ) )
 		, _refCount( 0 )
-	{}
+		, _nbUses( 0 )
+	{
+		if( _pData == NULL )
+			BOOST_THROW_EXCEPTION( std::bad_alloc() );
+	}
 
 	~PoolData()
 	{
-		delete [] _pData;
+		freeBuffer( _pData, _allocation );
 	}
 
 public:
@@ -62,8 +72,12 @@ private:
 	const std::size_t _id; ///< unique id to identify one memory data
 	const std::size_t _reservedSize; ///< memory allocated
 	std::size_t _size; ///< memory requested
+	BufferAllocation _allocation; ///< how the data was allocated (initialized with _pData)
 	char* const _pData; ///< own the data
-	int _refCount; ///< counter on clients currently using this data
+	boost::detail::atomic_count _refCount; ///< counter on clients currently using this data, the frame lanes share the buffers of the render cache
+	std::size_t _nbUses; ///< number of references from an unused state, protected by the pool mutex
+	std::multimap<std::size_t, PoolData*>::iterator _unusedPos; ///< position in the unused buffers, if unused
+	std::list<PoolData*>::iterator _unusedLruPos; ///< position in the unused buffers release order, if unused
 };
 
 void intrusive_ptr_add_ref( IPoolData* pData )
@@ -90,90 +104,160 @@ void PoolData::release()
 		_pool.released( this );
 }
 
-MemoryPool::MemoryPool( const std::size_t maxSize )
+MemoryPool::MemoryPool( const std::size_t maxSize, const AllocationPolicy& policy )
 	: _memoryAuthorized( maxSize )
+	, _allocationPolicy( policy )
+	, _evictionPolicy( eEvictionLeastRecentlyUsed )
+	, _softWatermark( 0.9 )
+	, _hardWatermark( 1.0 )
+	, _nbDataUsed( 0 )
+	, _nbDataUnused( 0 )
+	, _usedMemorySize( 0 )
+	, _peakUsedMemorySize( 0 )
+	, _unusedMemorySize( 0 )
+	, _wastedMemorySize( 0 )
+	, _nbAllocations( 0 )
+	, _nbReuses( 0 )
+	, _nbEvictions( 0 )
+	, _evictedMemorySize( 0 )
 {}
 
 MemoryPool::~MemoryPool()
 {
-	if( !_dataUsed.empty() )
+	if( getDataUsedSize() != 0 )
 	{
-		TUTTLE_LOG_DEBUG( "[Memory Pool] Error inside memory pool. Some data always mark used at the destruction (nb elements:" << _dataUsed.size() << ")" );
+		TUTTLE_LOG_DEBUG( "[Memory Pool] Error inside memory pool. Some data always mark used at the destruction (nb elements:" << getDataUsedSize() << ")" );
 	}
 }
 
-void MemoryPool::referenced( PoolData* pData )
+void MemoryPool::setAllocationPolicy( const AllocationPolicy& policy )
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	DataList::iterator it = _dataUnused.find( pData );
+	_allocationPolicy = policy;
+}
 
-	if( it != _dataUnused.end() )
-	{
-		_dataUnused.erase( it );
-	}
-	else // a really new data
-	{
-		_allDatas.push_back( pData );
-		_dataMap[pData->data()] = pData;
-	}
-	_dataUsed.insert( pData );
+AllocationPolicy MemoryPool::getAllocationPolicy() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _allocationPolicy;
+}
+
+void MemoryPool::setWatermarks( const double soft, const double hard )
+{
+	_softWatermark.store( soft, boost::memory_order_release );
+	_hardWatermark.store( hard, boost::memory_order_release );
+}
+
+double MemoryPool::getSoftWatermark() const
+{
+	return _softWatermark.load( boost::memory_order_acquire );
+}
+
+double MemoryPool::getHardWatermark() const
+{
+	return _hardWatermark.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getSoftLimit() const
+{
+	return static_cast<std::size_t>( getSoftWatermark() * _memoryAuthorized );
+}
+
+std::size_t MemoryPool::getHardLimit() const
+{
+	return static_cast<std::size_t>( getHardWatermark() * _memoryAuthorized );
+}
+
+void MemoryPool::setEvictionPolicy( const EEvictionPolicy policy )
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	_evictionPolicy = policy;
+}
+
+EEvictionPolicy MemoryPool::getEvictionPolicy() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	return _evictionPolicy;
+}
+
+void MemoryPool::addSize( boost::atomic<std::size_t>& counter, const std::size_t size )
+{
+	counter.store( counter.load( boost::memory_order_relaxed ) + size, boost::memory_order_release );
+}
+
+void MemoryPool::removeSize( boost::atomic<std::size_t>& counter, const std::size_t size )
+{
+	counter.store( counter.load( boost::memory_order_relaxed ) - size, boost::memory_order_release );
+}
+
+void MemoryPool::referenced( PoolData* pData )
+{
+	// The buffer is already out of the unused buffers:
+	// it is a new buffer or it was taken by getOneAvailableData.
+	boost::mutex::scoped_lock locker( _mutex );
+	++pData->_nbUses;
+	addSize( _nbDataUsed, 1 );
+	addSize( _usedMemorySize, pData->reservedSize() );
+	addSize( _wastedMemorySize, pData->reservedSize() - pData->size() );
+	const std::size_t used = _usedMemorySize.load( boost::memory_order_relaxed );
+	if( used > _peakUsedMemorySize.load( boost::memory_order_relaxed ) )
+		_peakUsedMemorySize.store( used, boost::memory_order_release );
 }
 
 void MemoryPool::released( PoolData* pData )
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUsed.erase( pData );
-	_dataUnused.insert( pData );
+	removeSize( _nbDataUsed, 1 );
+	removeSize( _usedMemorySize, pData->reservedSize() );
+	removeSize( _wastedMemorySize, pData->reservedSize() - pData->size() );
+
+	pushUnused( pData );
+}
+
+void MemoryPool::pushUnused( PoolData* pData )
+{
+	pData->_unusedPos = _dataUnused.insert( DataUnusedMap::value_type( pData->reservedSize(), pData ) );
+	pData->_unusedLruPos = _dataUnusedLru.insert( _dataUnusedLru.end(), pData );
+	addSize( _nbDataUnused, 1 );
+	addSize( _unusedMemorySize, pData->reservedSize() );
+}
+
+void MemoryPool::popUnused( PoolData* pData )
+{
+	_dataUnused.erase( pData->_unusedPos );
+	_dataUnusedLru.erase( pData->_unusedLruPos );
+	removeSize( _nbDataUnused, 1 );
+	removeSize( _unusedMemorySize, pData->reservedSize() );
 }
 
 namespace  {
 
-/// Functor to get the smallest element in pool
-struct DataFitSize : public std::unary_function<PoolData*, void>
+/// max ratio between the reserved size of a reused buffer and the size needed
+static const std::size_t kMaxBufferRatio = 2;
+
+/// Predicate to erase the owned buffers contained in a set
+struct IsInSet
 {
-	DataFitSize( std::size_t size )
-		: _sizeNeeded( size )
-		, _bestMatchDiff( ULONG_MAX )
-		, _pBestMatch( NULL )
+	explicit IsInSet( const boost::unordered_set<const PoolData*>& datas )
+		: _datas( datas )
 	{}
 
-	void operator()( PoolData* pData )
-	{
-		const std::size_t dataSize = pData->reservedSize();
-		
-		// Check minimum amount of memory
-		if( _sizeNeeded > dataSize )
-			return;
-		// Do not reuse too big buffers
-		if( dataSize > _maxBufferRatio * _sizeNeeded )
-			return;
-		const std::size_t diff = dataSize - _sizeNeeded;
-		if( diff >= _bestMatchDiff )
-			return;
-		_bestMatchDiff = diff;
-		_pBestMatch    = pData;
-	}
-
-	PoolData* bestMatch()
+	bool operator()( const PoolData& data ) const
 	{
-		return _pBestMatch;
+		return _datas.find( &data ) != _datas.end();
 	}
 
-	private:
-		static const double _maxBufferRatio;  //< max ratio between used and unused part of the buffer
-		const std::size_t _sizeNeeded;
-		std::size_t _bestMatchDiff;
-		PoolData* _pBestMatch;
+	const boost::unordered_set<const PoolData*>& _datas;
 };
 
-const double DataFitSize::_maxBufferRatio = 2.0;
-
 }
 
 IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 {
+	Profiler::countAllocation( size );
+
 	// Try to reuse a buffer available in the MemoryPool
-	IPoolData* pData = getOneAvailableData( size );
+	PoolData* pData = getOneAvailableData( size );
 	if( pData != NULL )
 	{
 		TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
@@ -206,12 +290,12 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 		TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryCache");
 		memoryCache.clearUnused();
 
-		availableSize = getAvailableMemorySize();
-		if( size > availableSize )
+		pData = getOneAvailableData( size );
+		if( pData != NULL )
 		{
-			// Release elements from the MemoryPool (make them available to the OS)
-			TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
-			clear();
+			TUTTLE_LOG_TRACE("[Memory Pool] Reuse a buffer available in the MemoryPool");
+			pData->setSize( size );
+			return pData;
 		}
 
 		availableSize = getAvailableMemorySize();
@@ -223,42 +307,57 @@ IPoolDataPtr MemoryPool::allocate( const std::size_t size )
 		}
 	}
 
+	{
+		// Release just enough unused buffers to stay under the soft watermark (make them available to the OS)
+		const std::size_t softLimit = getSoftLimit();
+		const std::size_t allocatedSize = getAllocatedMemorySize() + size;
+		if( allocatedSize > softLimit )
+		{
+			TUTTLE_LOG_TRACE("[Memory Pool] Release " << allocatedSize - softLimit << " bytes from the MemoryPool");
+			clear( allocatedSize - softLimit );
+		}
+	}
+
 	// Allocate a new buffer in MemoryPool
 	TUTTLE_TLOG( TUTTLE_TRACE, "[Memory Pool] allocate " << size << " bytes" );
-	return new PoolData( *this, size );
+	try
+	{
+		pData = new PoolData( *this, size, getAllocationPolicy() );
+	}
+	catch( std::bad_alloc& )
+	{
+		// the system has less memory than expected, give back all unused buffers and retry
+		clear();
+		pData = new PoolData( *this, size, getAllocationPolicy() );
+	}
+	{
+		boost::mutex::scoped_lock locker( _mutex );
+		_allDatas.push_back( pData );
+		addSize( _nbAllocations, 1 );
+	}
+	return pData;
 }
 
 std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
 {
 	_memoryAuthorized = /*getUsedMemorySize() +*/ getMemoryInfo()._totalRam;
 	TUTTLE_LOG_DEBUG( TUTTLE_TRACE, "[Memory Pool] update memory authorized with RAM: " << _memoryAuthorized );
-	return _memoryAuthorized;
-}
-
-namespace  {
-
-std::size_t accumulateReservedSize( const std::size_t& sum, const IPoolData* pData )
-{
-	return sum + pData->reservedSize();
-}
-
-std::size_t accumulateWastedSize( const std::size_t& sum, const IPoolData* pData )
-{
-	return sum + ( pData->reservedSize() - pData->size() );
-}
 
+	const std::size_t softLimit = getSoftLimit();
+	const std::size_t allocatedSize = getAllocatedMemorySize();
+	if( allocatedSize > softLimit )
+		clear( allocatedSize - softLimit );
+	return _memoryAuthorized;
 }
 
 std::size_t MemoryPool::getUsedMemorySize() const
 {
-	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUsed.begin(), _dataUsed.end(), 0, &accumulateReservedSize );
+	return _usedMemorySize.load( boost::memory_order_acquire );
 }
 
 std::size_t MemoryPool::getAllocatedAndUnusedMemorySize() const
 {
-	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUnused.begin(), _dataUnused.end(), 0, &accumulateReservedSize );
+	return _unusedMemorySize.load( boost::memory_order_acquire );
 }
 
 std::size_t MemoryPool::getAllocatedMemorySize() const
@@ -273,59 +372,173 @@ std::size_t MemoryPool::getMaxMemorySize() const
 
 std::size_t MemoryPool::getAvailableMemorySize() const
 {
-	return getMaxMemorySize() - getUsedMemorySize();
+	const std::size_t used = getUsedMemorySize();
+	const std::size_t hardLimit = getHardLimit();
+	if( used > hardLimit )
+		return 0;
+	return hardLimit - used;
 }
 
 std::size_t MemoryPool::getWastedMemorySize() const
+{
+	return _wastedMemorySize.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getPeakUsedMemorySize() const
+{
+	return _peakUsedMemorySize.load( boost::memory_order_acquire );
+}
+
+void MemoryPool::resetPeakUsedMemorySize()
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::accumulate( _dataUsed.begin(), _dataUsed.end(), 0, std::ptr_fun( &accumulateWastedSize ) );
+	_peakUsedMemorySize.store( _usedMemorySize.load( boost::memory_order_relaxed ), boost::memory_order_release );
 }
 
 std::size_t MemoryPool::getDataUsedSize() const
 {
-	return _dataUsed.size();
+	return _nbDataUsed.load( boost::memory_order_acquire );
 }
 
 std::size_t MemoryPool::getDataUnusedSize() const
 {
-	return _dataUnused.size();
+	return _nbDataUnused.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getNbAllocations() const
+{
+	return _nbAllocations.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getNbReuses() const
+{
+	return _nbReuses.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getNbEvictions() const
+{
+	return _nbEvictions.load( boost::memory_order_acquire );
+}
+
+std::size_t MemoryPool::getEvictedMemorySize() const
+{
+	return _evictedMemorySize.load( boost::memory_order_acquire );
 }
 
 PoolData* MemoryPool::getOneAvailableData( const size_t size )
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	return std::for_each( _dataUnused.begin(), _dataUnused.end(), DataFitSize( size ) ).bestMatch();
+	// smallest buffer with enough memory
+	DataUnusedMap::iterator it = _dataUnused.lower_bound( size );
+	if( it == _dataUnused.end() )
+		return NULL;
+	// Do not reuse too big buffers
+	if( it->first > kMaxBufferRatio * size )
+		return NULL;
+
+	PoolData* pData = it->second;
+	popUnused( pData );
+	addSize( _nbReuses, 1 );
+	return pData;
+}
+
+std::vector<PoolDataInfos> MemoryPool::getDatasInfos() const
+{
+	boost::mutex::scoped_lock locker( _mutex );
+	std::vector<PoolDataInfos> infos;
+	infos.reserve( _allDatas.size() );
+	BOOST_FOREACH( const PoolData& data, _allDatas )
+	{
+		PoolDataInfos info;
+		info._id = data._id;
+		info._size = data._size;
+		info._reservedSize = data._reservedSize;
+		info._allocation = data._allocation;
+		info._nbUses = data._nbUses;
+		info._isUsed = long( data._refCount ) > 0;
+		infos.push_back( info );
+	}
+	return infos;
+}
+
+void MemoryPool::evictUnused( const std::size_t size )
+{
+	boost::unordered_set<const PoolData*> toErase;
+	std::size_t freedSize = 0;
+	while( freedSize < size && ! _dataUnusedLru.empty() )
+	{
+		PoolData* pData = NULL;
+		switch( _evictionPolicy )
+		{
+			case eEvictionLeastRecentlyUsed:
+				pData = _dataUnusedLru.front();
+				break;
+			case eEvictionLargestFirst:
+				pData = _dataUnused.rbegin()->second;
+				break;
+		}
+		popUnused( pData );
+		toErase.insert( pData );
+		freedSize += pData->reservedSize();
+	}
+	if( toErase.empty() )
+		return;
+	TUTTLE_TLOG( TUTTLE_TRACE, "[Memory Pool] evict " << toErase.size() << " buffers, " << freedSize << " bytes" );
+	_allDatas.erase_if( IsInSet( toErase ) );
+	addSize( _nbEvictions, toErase.size() );
+	addSize( _evictedMemorySize, freedSize );
 }
 
 void MemoryPool::clear( std::size_t size )
 {
-	/// @todo tuttle
+	boost::mutex::scoped_lock locker( _mutex );
+	evictUnused( size );
 }
 
 void MemoryPool::clear()
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUnused.clear();
+	evictUnused( std::numeric_limits<std::size_t>::max() );
 }
 
 void MemoryPool::clearOne()
 {
 	boost::mutex::scoped_lock locker( _mutex );
-	_dataUnused.erase( _dataUnused.begin() );
+	// any buffer frees at least one byte
+	evictUnused( 1 );
 }
 
 std::ostream& operator<<( std::ostream& os, const MemoryPool& memoryPool )
 {
-	os << "[Memory Pool] Unused data:           " << memoryPool.getDataUnusedSize() << " bytes\n";
-	os << "[Memory Pool] All datas:             " << memoryPool.getDataUsedSize() << " bytes\n";
+	const AllocationPolicy policy = memoryPool.getAllocationPolicy();
+	std::size_t nbHugePagesDatas = 0;
+	std::size_t nbInterleavedDatas = 0;
+	BOOST_FOREACH( const PoolDataInfos& info, memoryPool.getDatasInfos() )
+	{
+		if( info._allocation._hugePages != eHugePagesNone )
+			++nbHugePagesDatas;
+		if( info._allocation._numaPlacement == eNumaPlacementInterleaved )
+			++nbInterleavedDatas;
+	}
+	os << "[Memory Pool] Unused data:           " << memoryPool.getDataUnusedSize() << " buffers\n";
+	os << "[Memory Pool] Used data:             " << memoryPool.getDataUsedSize() << " buffers\n";
 	os << "[Memory Pool] Total RAM:             " << getMemoryInfo()._totalRam << " bytes\n";
 	os << "\n";
 	os << "[Memory Pool] Used memory:           " << memoryPool.getUsedMemorySize() << " bytes\n";
+	os << "[Memory Pool] Peak used memory:      " << memoryPool.getPeakUsedMemorySize() << " bytes\n";
 	os << "[Memory Pool] Allocated memory:      " << memoryPool.getAllocatedMemorySize() << " bytes\n";
 	os << "[Memory Pool] Max memory:            " << memoryPool.getMaxMemorySize() << " bytes\n";
 	os << "[Memory Pool] Available memory size: " << memoryPool.getAvailableMemorySize() << " bytes\n";
 	os << "[Memory Pool] Wasted memory:         " << memoryPool.getWastedMemorySize() << " bytes\n";
+	os << "[Memory Pool] Watermarks:            " << memoryPool.getSoftWatermark() << " (soft), " << memoryPool.getHardWatermark() << " (hard)\n";
+	os << "\n";
+	os << "[Memory Pool] Allocations:           " << memoryPool.getNbAllocations() << " buffers\n";
+	os << "[Memory Pool] Reuses:                " << memoryPool.getNbReuses() << " buffers\n";
+	os << "[Memory Pool] Evictions:             " << memoryPool.getNbEvictions() << " buffers, " << memoryPool.getEvictedMemorySize() << " bytes\n";
+	os << "\n";
+	os << "[Memory Pool] Alignment:             " << policy._alignment << " bytes\n";
+	os << "[Memory Pool] Huge pages:            " << policy._hugePages << " (" << nbHugePagesDatas << " buffers)\n";
+	os << "[Memory Pool] NUMA placement:        " << policy._numaPlacement << " (" << nbInterleavedDatas << " interleaved buffers)\n";
 	return os;
 }
 
@@ -2,13 +2,16 @@
 #define _TUTTLE_HOST_CORE_MEMORYPOOL_HPP_
 
 #include "IMemoryPool.hpp"
+#include "AllocationPolicy.hpp"
+
+#include <tuttle/common/atomic.hpp>
 
 #include <boost/ptr_container/ptr_list.hpp>
-#include <boost/unordered_set.hpp>
 #include <boost/thread.hpp>
 
 #include <map>
 #include <list>
+#include <vector>
 #include <sstream>
 #include <numeric>
 #include <functional>
@@ -28,6 +31,37 @@ public:
 };
 
 /**
+ * @brief Statistics about one buffer of the pool.
+ */
+struct PoolDataInfos
+{
+	std::size_t _id;
+	std::size_t _size; ///< memory requested by the current user
+	std::size_t _reservedSize; ///< memory usable
+	BufferAllocation _allocation;
+	std::size_t _nbUses; ///< number of times the buffer was given by the pool
+	bool _isUsed;
+};
+
+enum EEvictionPolicy
+{
+	eEvictionLeastRecentlyUsed, ///< free the unused buffers released the longest time ago first
+	eEvictionLargestFirst ///< free the biggest unused buffers first
+};
+
+/**
+ * @brief Pool of image buffers.
+ *
+ * Unused buffers are indexed by their reserved size, so finding the best
+ * buffer to reuse is a logarithmic lookup instead of a scan of all buffers.
+ * The memory sizes are running counters updated when a buffer is referenced
+ * or released, so the getters don't lock the pool.
+ *
+ * Two watermarks, relative to the max memory size, limit the memory:
+ * - the used memory can't exceed the hard watermark (allocate throws),
+ * - unused buffers are freed, just enough to keep the allocated memory
+ *   (used and unused) under the soft watermark.
+ *
  * @todo tuttle: virtual destructor or nothing in virtual
  */
 class MemoryPool : public IMemoryPool
@@ -37,12 +71,30 @@ public:
 	typedef MemoryPool This;
 
 public:
-	MemoryPool( const std::size_t maxSize = 0 );
+	MemoryPool( const std::size_t maxSize = 0, const AllocationPolicy& policy = AllocationPolicy() );
 	~MemoryPool();
 
+	/**
+	 * @brief Set how the new buffers are allocated.
+	 * The buffers already allocated keep their allocation.
+	 */
+	void setAllocationPolicy( const AllocationPolicy& policy );
+	AllocationPolicy getAllocationPolicy() const;
+
 	IPoolDataPtr allocate( const std::size_t size );
 	std::size_t  updateMemoryAuthorizedWithRAM();
 
+	/**
+	 * @param soft ratio of the max memory size above which unused buffers are freed
+	 * @param hard ratio of the max memory size the used memory can't exceed
+	 */
+	void setWatermarks( const double soft, const double hard );
+	double getSoftWatermark() const;
+	double getHardWatermark() const;
+
+	void setEvictionPolicy( const EEvictionPolicy policy );
+	EEvictionPolicy getEvictionPolicy() const;
+
 	void referenced( PoolData* );
 	void released( PoolData* );
 
@@ -53,25 +105,86 @@ public:
 	std::size_t getAvailableMemorySize() const;
 	std::size_t getWastedMemorySize() const;
 
+	/// @brief Maximum of the used memory since the creation of the pool or the last reset.
+	std::size_t getPeakUsedMemorySize() const;
+	/// @brief Restart the peak measure from the current used memory.
+	void resetPeakUsedMemorySize();
+
 	std::size_t getDataUsedSize() const;
 	std::size_t getDataUnusedSize() const;
+
+	/// @name Statistics of the buffers creation and destruction
+	/// @{
+	std::size_t getNbAllocations() const; ///< number of buffers allocated from the system
+	std::size_t getNbReuses() const; ///< number of allocations served by an unused buffer
+	std::size_t getNbEvictions() const; ///< number of unused buffers given back to the system
+	std::size_t getEvictedMemorySize() const;
+	/// @}
+
+	/// @brief Statistics of all the buffers of the pool.
+	std::vector<PoolDataInfos> getDatasInfos() const;
 	
+	/**
+	 * @brief Take the smallest unused buffer which can contain @p size bytes.
+	 * The buffer is removed from the unused buffers, so it can't be given twice.
+	 * @return NULL if there is no buffer to reuse
+	 */
 	PoolData* getOneAvailableData( const size_t size );
 
+	/**
+	 * @brief Free unused buffers, following the eviction policy,
+	 * until at least @p size bytes are given back to the system.
+	 */
 	void clear( std::size_t size );
+	/// @brief Free all unused buffers.
 	void clear();
+	/// @brief Free one unused buffer, following the eviction policy.
 	void clearOne();
 
 	friend std::ostream& operator<<( std::ostream& os, const This& v );
 
 private:
-	typedef boost::unordered_set<PoolData*> DataList;
+	typedef std::multimap<std::size_t, PoolData*> DataUnusedMap; ///< unused buffers sorted by reserved size
+	typedef std::list<PoolData*> DataUnusedList; ///< unused buffers sorted by release order
+
+	/// @warning _mutex should be locked for all these functions
+	/// @{
+	void pushUnused( PoolData* pData );
+	void popUnused( PoolData* pData );
+	/// @brief Give unused buffers back to the system, until @p size bytes are freed.
+	void evictUnused( const std::size_t size );
+	/// @}
+
+	std::size_t getSoftLimit() const;
+	std::size_t getHardLimit() const;
+
+	static void addSize( boost::atomic<std::size_t>& counter, const std::size_t size );
+	static void removeSize( boost::atomic<std::size_t>& counter, const std::size_t size );
+
+private:
 	boost::ptr_list<PoolData> _allDatas; // the owner
-	std::map<char*, PoolData*> _dataMap;
-	DataList _dataUsed;
-	DataList _dataUnused;
+	DataUnusedMap _dataUnused;
+	DataUnusedList _dataUnusedLru;
 	std::size_t _memoryAuthorized;
-	mutable boost::mutex _mutex;
+	AllocationPolicy _allocationPolicy; ///< protected by _mutex
+	EEvictionPolicy _evictionPolicy; ///< protected by _mutex
+	boost::atomic<double> _softWatermark;
+	boost::atomic<double> _hardWatermark;
+	mutable boost::mutex _mutex; ///< protects the buffers lists and the counters updates
+
+	/// @name Running counters, updated under _mutex but read without lock
+	/// @{
+	boost::atomic<std::size_t> _nbDataUsed;
+	boost::atomic<std::size_t> _nbDataUnused;
+	boost::atomic<std::size_t> _usedMemorySize;
+	boost::atomic<std::size_t> _peakUsedMemorySize;
+	boost::atomic<std::size_t> _unusedMemorySize;
+	boost::atomic<std::size_t> _wastedMemorySize;
+	boost::atomic<std::size_t> _nbAllocations;
+	boost::atomic<std::size_t> _nbReuses;
+	boost::atomic<std::size_t> _nbEvictions;
+	boost::atomic<std::size_t> _evictedMemorySize;
+	/// @}
 };
 
 #ifndef SWIG
@@ -2,9 +2,11 @@
 %include <tuttle/host/memory/IMemoryPool.i>
 
 %{
+#include <tuttle/host/memory/AllocationPolicy.hpp>
 #include <tuttle/host/memory/MemoryPool.hpp>
 %}
 
+%include <tuttle/host/memory/AllocationPolicy.hpp>
 %include <tuttle/host/memory/MemoryPool.hpp>
 
 %extend tuttle::host::memory::MemoryPool
@@ -0,0 +1,129 @@
+#include "RenderCache.hpp"
+
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+namespace {
+
+bool contains( const OfxRectD& r, const OfxRectD& inside )
+{
+	return r.x1 <= inside.x1 && r.y1 <= inside.y1 &&
+	       r.x2 >= inside.x2 && r.y2 >= inside.y2;
+}
+
+}
+
+RenderCache::RenderCache( const std::size_t maxMemorySize )
+	: _memorySize( 0 )
+	, _maxMemorySize( maxMemorySize )
+{}
+
+RenderCache::~RenderCache()
+{}
+
+void RenderCache::setMaxMemorySize( const std::size_t maxMemorySize )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_maxMemorySize = maxMemorySize;
+	shrink();
+}
+
+std::size_t RenderCache::getMaxMemorySize() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _maxMemorySize;
+}
+
+std::size_t RenderCache::getMemorySize() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _memorySize;
+}
+
+std::size_t RenderCache::size() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _map.size();
+}
+
+bool RenderCache::empty() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _map.empty();
+}
+
+void RenderCache::put( const std::size_t hash, const OfxRectD& roi, CACHE_ELEMENT image )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	const Map::iterator it = _map.find( hash );
+	if( it != _map.end() )
+	{
+		erase( it );
+	}
+	if( image->getMemorySize() > _maxMemorySize )
+		return;
+
+	_lru.push_front( hash );
+	Entry& entry = _map[hash];
+	entry._image = image;
+	entry._roi = roi;
+	entry._lruIt = _lru.begin();
+	_memorySize += image->getMemorySize();
+
+	shrink();
+}
+
+CACHE_ELEMENT RenderCache::get( const std::size_t hash, const OfxRectD& roi )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	const Map::iterator it = _map.find( hash );
+	if( it == _map.end() || ! contains( it->second._roi, roi ) )
+		return CACHE_ELEMENT();
+
+	// move to the front of the lru list
+	_lru.splice( _lru.begin(), _lru, it->second._lruIt );
+	return it->second._image;
+}
+
+void RenderCache::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_map.clear();
+	_lru.clear();
+	_memorySize = 0;
+}
+
+void RenderCache::erase( const Map::iterator it )
+{
+	_memorySize -= it->second._image->getMemorySize();
+	_lru.erase( it->second._lruIt );
+	_map.erase( it );
+}
+
+/**
+ * @brief Remove the least recently used images until the cache fits its maximum size.
+ */
+void RenderCache::shrink()
+{
+	while( _memorySize > _maxMemorySize && ! _lru.empty() )
+	{
+		TUTTLE_TLOG( TUTTLE_INFO, "[Render cache] remove hash " << _lru.back() );
+		erase( _map.find( _lru.back() ) );
+	}
+}
+
+std::ostream& operator<<( std::ostream& os, const RenderCache& v )
+{
+	boost::mutex::scoped_lock lock( v._mutex );
+	os << "[RenderCache] size:" << v._map.size()
+	   << " memory:" << v._memorySize << "/" << v._maxMemorySize << std::endl;
+	return os;
+}
+
+}
+}
+}
@@ -0,0 +1,90 @@
+#ifndef _TUTTLE_HOST_CORE_RENDERCACHE_HPP_
+#define _TUTTLE_HOST_CORE_RENDERCACHE_HPP_
+
+#include "IMemoryCache.hpp"
+
+#include <ofxCore.h>
+
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <list>
+#include <cstddef>
+#include <ostream>
+
+namespace tuttle {
+namespace host {
+namespace memory {
+
+/**
+ * @brief Output images of the nodes, indexed by the global hash of the node at a time.
+ *
+ * The global hash covers the node parameters and all the upstream nodes,
+ * so the images are reused across computations of the same (or another) graph.
+ * The least recently used images are removed when the cache exceeds its maximum size.
+ */
+class RenderCache : private boost::noncopyable
+{
+typedef RenderCache This;
+
+public:
+	RenderCache( const std::size_t maxMemorySize = 0 );
+	~RenderCache();
+
+	void setMaxMemorySize( const std::size_t maxMemorySize );
+	std::size_t getMaxMemorySize() const;
+
+	/**
+	 * @brief Memory used by the images of the cache.
+	 */
+	std::size_t getMemorySize() const;
+	std::size_t size() const;
+	bool empty() const;
+
+	/**
+	 * @brief Add the output image of a node, rendered on the region @p roi.
+	 */
+	void put( const std::size_t hash, const OfxRectD& roi, CACHE_ELEMENT image );
+
+	/**
+	 * @brief Get the image of a node, if it contains the region @p roi.
+	 * @return an empty element if the image is not in the cache.
+	 */
+	CACHE_ELEMENT get( const std::size_t hash, const OfxRectD& roi );
+
+	void clear();
+
+	friend std::ostream& operator<<( std::ostream& os, const This& v );
+
+private:
+	typedef std::list<std::size_t> LruList; ///< most recently used first
+
+	struct Entry
+	{
+		CACHE_ELEMENT _image;
+		OfxRectD _roi;
+		LruList::iterator _lruIt;
+	};
+	typedef boost::unordered_map<std::size_t, Entry> Map;
+
+	void erase( const Map::iterator it );
+	void shrink();
+
+private:
+	Map _map;
+	LruList _lru;
+	std::size_t _memorySize;
+	std::size_t _maxMemorySize;
+	mutable boost::mutex _mutex;
+};
+
+#ifndef SWIG
+std::ostream& operator<<( std::ostream& os, const RenderCache& v );
+#endif
+
+}
+}
+}
+
+#endif
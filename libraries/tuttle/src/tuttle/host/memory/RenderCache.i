@@ -0,0 +1,19 @@
+%include <tuttle/host/global.i>
+%include <tuttle/host/memory/IMemoryCache.i>
+
+%{
+#include <tuttle/host/memory/RenderCache.hpp>
+%}
+
+%include <tuttle/host/memory/RenderCache.hpp>
+
+
+%extend tuttle::host::memory::RenderCache
+{
+	std::string __str__() const
+	{
+		std::stringstream s;
+		s << *self;
+		return s.str();
+	}
+}
@@ -1,10 +1,10 @@
 #include "OfxhMultiThreadSuite.hpp"
 #include "OfxhCore.hpp"
 
-#include <boost/thread/thread.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ThreadPool.hpp>
+
 #include <boost/thread/recursive_mutex.hpp>
-#include <boost/thread/tss.hpp>
-#include <boost/bind.hpp>
 
 struct OfxMutex
 {
@@ -17,23 +17,6 @@ namespace ofx {
 
 namespace {
 
-struct ThreadSpecificData
-{
-	ThreadSpecificData( unsigned int threadIndex ) : _index( 0 ) {}
-	unsigned int _index;
-};
-
-boost::thread_specific_ptr<ThreadSpecificData> ptr;
-
-void launchThread( OfxThreadFunctionV1 func,
-                   unsigned int        threadIndex,
-                   unsigned int        threadMax,
-                   void*               customArg )
-{
-	ptr.reset( new ThreadSpecificData( threadIndex ) );
-	func( threadIndex, threadMax, customArg );
-}
-
 OfxStatus multiThread( OfxThreadFunctionV1 func,
                        const unsigned int  nThreads,
                        void*               customArg )
@@ -42,26 +25,18 @@ OfxStatus multiThread( OfxThreadFunctionV1 func,
 	{
 		return kOfxStatErrValue;
 	}
-	else if( nThreads == 1 )
+	// the persistent host thread pool executes all the calls,
+	// even nested ones, without creating new threads
+	if( ! core().getThreadPool().run( func, nThreads, customArg ) )
 	{
-		func( 0, 1, customArg );
-	}
-	else
-	{
-		boost::thread_group group;
-		for( unsigned int i = 0; i < nThreads; ++i )
-		{
-			group.create_thread( boost::bind( launchThread, func, i, nThreads, customArg ) );
-		}
-		group.join_all();
+		return kOfxStatFailed;
 	}
 	return kOfxStatOK;
 }
 
 OfxStatus multiThreadNumCPUs( unsigned int* const nCPUs )
 {
-//	*nCPUs = 1; /// @todo tuttle: needs to have an option to disable multithreading (force only one cpu).
-	*nCPUs = boost::thread::hardware_concurrency();
+	*nCPUs = static_cast<unsigned int>( core().getThreadPool().getNbThreads() );
 	TUTTLE_TLOG( TUTTLE_INFO, "[Multi thread] CPUs used: " << *nCPUs );
 	return kOfxStatOK;
 }
@@ -69,18 +44,17 @@ OfxStatus multiThreadNumCPUs( unsigned int* const nCPUs )
 OfxStatus multiThreadIndex( unsigned int* const threadIndex )
 {
 	//	*threadIndex = boost::this_thread::get_id(); //	we don't want a global thead id, but the thead index inside a node multithread process.
-	if( ptr.get() != NULL )
+	if( ! ThreadPool::getThreadIndex( *threadIndex ) )
 	{
 		*threadIndex = 0;
 		return kOfxStatFailed;
 	}
-	*threadIndex = ptr->_index;
 	return kOfxStatOK;
 }
 
 int multiThreadIsSpawnedThread( void )
 {
-	return ptr.get() != NULL;
+	return ThreadPool::isSpawnedThread();
 }
 
 /**
@@ -10,6 +10,17 @@ namespace property {
 
 namespace {
 
+/// The plugins give the property names as C strings, find the atom without copying them.
+OfxhAtom propertyAtom( const char* property )
+{
+	const OfxhAtom atom = findPropertyAtom( property );
+	if( atom == kOfxhNoAtom )
+	{
+		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue, std::string( property ) + ". Property not found." ) );
+	}
+	return atom;
+}
+
 /// static functions for the suite
 template<class T>
 OfxStatus propSet( OfxPropertySetHandle properties,
@@ -26,7 +37,7 @@ OfxStatus propSet( OfxPropertySetHandle properties,
 		if( !thisSet->verifyMagic() )
 			return kOfxStatErrBadHandle;
 
-		OfxhPropertyTemplate<T>& prop = thisSet->fetchLocalTypedProperty<OfxhPropertyTemplate<T> >( property );
+		OfxhPropertyTemplate<T>& prop = thisSet->fetchLocalTypedProperty<OfxhPropertyTemplate<T> >( propertyAtom( property ) );
 
 		if( prop.getPluginReadOnly() )
 		{
@@ -73,7 +84,7 @@ OfxStatus propSetN( OfxPropertySetHandle properties,
 		if( !thisSet->verifyMagic() )
 			return kOfxStatErrBadHandle;
 
-		OfxhPropertyTemplate<T>& prop = thisSet->fetchLocalTypedProperty<OfxhPropertyTemplate<T> >( property );
+		OfxhPropertyTemplate<T>& prop = thisSet->fetchLocalTypedProperty<OfxhPropertyTemplate<T> >( propertyAtom( property ) );
 
 		if( prop.getPluginReadOnly() )
 		{
@@ -111,7 +122,7 @@ OfxStatus propGet( OfxPropertySetHandle          properties,
 		OfxhSet* thisSet = reinterpret_cast<OfxhSet*>( properties );
 		if( !thisSet->verifyMagic() )
 			return kOfxStatErrBadHandle;
-		*value = thisSet->fetchTypedProperty<OfxhPropertyTemplate<T> >( property ).getAPIConstlessValue( index );
+		*value = thisSet->fetchTypedProperty<OfxhPropertyTemplate<T> >( propertyAtom( property ) ).getAPIConstlessValue( index );
 		//*value = castAwayConst( castToAPIType( prop->getValue( index ) ) );
 
 		#ifdef DEBUG_PROPERTIES
@@ -169,7 +180,7 @@ OfxStatus propGetN( OfxPropertySetHandle          properties,
 		OfxhSet* thisSet = reinterpret_cast<OfxhSet*>( properties );
 		if( !thisSet->verifyMagic() )
 			return kOfxStatErrBadHandle;
-		thisSet->fetchTypedProperty<OfxhPropertyTemplate<T> >( property ).getValueN( castToConst( values ), count );
+		thisSet->fetchTypedProperty<OfxhPropertyTemplate<T> >( propertyAtom( property ) ).getValueN( castToConst( values ), count );
 	}
 	catch( OfxhException& e )
 	{
@@ -193,7 +204,7 @@ OfxStatus propReset( OfxPropertySetHandle properties, const char* property )
 		if( !thisSet->verifyMagic() )
 			return kOfxStatErrBadHandle;
 
-		OfxhProperty& prop = thisSet->fetchLocalProperty( property );
+		OfxhProperty& prop = thisSet->fetchLocalProperty( propertyAtom( property ) );
 
 		//		if( prop.getPluginReadOnly() )
 		//		{
@@ -223,7 +234,7 @@ OfxStatus propGetDimension( OfxPropertySetHandle properties, const char* propert
 	try
 	{
 		OfxhSet* thisSet = reinterpret_cast<OfxhSet*>( properties );
-		*count = thisSet->fetchProperty( property ).getDimension();
+		*count = thisSet->fetchProperty( propertyAtom( property ) ).getDimension();
 	}
 	catch( OfxhException& e )
 	{
@@ -0,0 +1,130 @@
+#include "OfxhAtom.hpp"
+
+#include <tuttle/host/ofx/OfxhException.hpp>
+#include <tuttle/host/exceptions.hpp>
+
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <deque>
+#include <cstring>
+
+namespace tuttle {
+namespace host {
+namespace ofx {
+namespace property {
+
+namespace {
+
+/// Hash a C string like boost::hash<std::string>, to find a name without copying it in a std::string.
+struct CStringHash
+{
+	std::size_t operator()( const char* s ) const
+	{
+		return boost::hash_range( s, s + std::strlen( s ) );
+	}
+};
+
+struct CStringEqual
+{
+	bool operator()( const char* a, const std::string& b ) const
+	{
+		return b.compare( a ) == 0;
+	}
+};
+
+/**
+ * @brief The atoms of all property names.
+ * Names are interned from all the threads creating properties, but the lookups are much
+ * more frequent, so the table is read under a shared lock.
+ */
+class AtomTable
+{
+public:
+	typedef boost::unordered_map<std::string, OfxhAtom> AtomMap;
+
+	OfxhAtom intern( const std::string& name )
+	{
+		{
+			boost::shared_lock<boost::shared_mutex> lock( _mutex );
+			AtomMap::const_iterator it = _atoms.find( name );
+			if( it != _atoms.end() )
+				return it->second;
+		}
+		boost::unique_lock<boost::shared_mutex> lock( _mutex );
+		// another thread may have registered it meanwhile
+		std::pair<AtomMap::iterator, bool> inserted = _atoms.insert( std::make_pair( name, _names.size() ) );
+		if( inserted.second )
+			_names.push_back( name );
+		return inserted.first->second;
+	}
+
+	OfxhAtom find( const char* name ) const
+	{
+		boost::shared_lock<boost::shared_mutex> lock( _mutex );
+		AtomMap::const_iterator it = _atoms.find( name, CStringHash(), CStringEqual() );
+		if( it == _atoms.end() )
+			return kOfxhNoAtom;
+		return it->second;
+	}
+
+	OfxhAtom find( const std::string& name ) const
+	{
+		boost::shared_lock<boost::shared_mutex> lock( _mutex );
+		AtomMap::const_iterator it = _atoms.find( name );
+		if( it == _atoms.end() )
+			return kOfxhNoAtom;
+		return it->second;
+	}
+
+	const std::string& name( const OfxhAtom atom ) const
+	{
+		boost::shared_lock<boost::shared_mutex> lock( _mutex );
+		if( atom >= _names.size() )
+		{
+			BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue )
+				<< exception::dev() + "Unknown property atom " + atom + "." );
+		}
+		return _names[atom]; // deque elements don't move when the table grows
+	}
+
+private:
+	mutable boost::shared_mutex _mutex;
+	AtomMap _atoms;
+	std::deque<std::string> _names; ///< names by atom
+};
+
+AtomTable& atomTable()
+{
+	static AtomTable table;
+	return table;
+}
+
+}
+
+OfxhAtom internPropertyName( const std::string& name )
+{
+	return atomTable().intern( name );
+}
+
+OfxhAtom findPropertyAtom( const char* name )
+{
+	return atomTable().find( name );
+}
+
+OfxhAtom findPropertyAtom( const std::string& name )
+{
+	return atomTable().find( name );
+}
+
+const std::string& getPropertyAtomName( const OfxhAtom atom )
+{
+	return atomTable().name( atom );
+}
+
+}
+}
+}
+}
@@ -0,0 +1,39 @@
+#ifndef _TUTTLE_HOST_OFX_PROPERTY_ATOM_HPP_
+#define _TUTTLE_HOST_OFX_PROPERTY_ATOM_HPP_
+
+#include <string>
+#include <cstddef>
+
+namespace tuttle {
+namespace host {
+namespace ofx {
+namespace property {
+
+/**
+ * @brief Interned property name.
+ * Each property name gets a unique integer the first time a property of that name is created,
+ * so property sets are indexed by integers instead of strings.
+ * Atoms are never released: there is a bounded number of property names.
+ */
+typedef std::size_t OfxhAtom;
+
+/// Atom of a name which was never interned, no property can have it.
+static const OfxhAtom kOfxhNoAtom = static_cast<OfxhAtom>( -1 );
+
+/// @brief Get the atom of @p name, registering it if needed.
+OfxhAtom internPropertyName( const std::string& name );
+
+/// @brief Find the atom of @p name, without registering it.
+/// @return kOfxhNoAtom if there is no property with this name.
+OfxhAtom findPropertyAtom( const char* name );
+OfxhAtom findPropertyAtom( const std::string& name );
+
+/// @brief Name of an interned property.
+const std::string& getPropertyAtomName( const OfxhAtom atom );
+
+}
+}
+}
+}
+
+#endif
@@ -56,6 +56,7 @@ OfxhProperty::OfxhProperty( const std::string& name,
                             std::size_t        dimension,
                             bool               pluginReadOnly )
 	: _name( name )
+	, _atom( internPropertyName( name ) )
 	, _type( type )
 	, _dimension( dimension )
 	, _pluginReadOnly( pluginReadOnly )
@@ -65,6 +66,7 @@ OfxhProperty::OfxhProperty( const std::string& name,
 
 OfxhProperty::OfxhProperty( const OfxhProperty& other )
 	: _name( other._name )
+	, _atom( other._atom )
 	, _type( other._type )
 	, _dimension( other._dimension )
 	, _pluginReadOnly( other._pluginReadOnly )
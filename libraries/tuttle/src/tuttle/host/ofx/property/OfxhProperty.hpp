@@ -29,6 +29,8 @@
 #ifndef _TUTTLE_HOST_OFX_PROPERTY_HPP_
 #define _TUTTLE_HOST_OFX_PROPERTY_HPP_
 
+#include "OfxhAtom.hpp"
+
 #include <tuttle/host/ofx/OfxhCore.hpp>
 #include <tuttle/host/ofx/OfxhUtilities.hpp>
 #include <tuttle/host/ofx/OfxhException.hpp>
@@ -102,6 +104,7 @@ public:
 
 protected:
 	std::string _name;                         ///< name of this property
+	OfxhAtom _atom;                            ///< interned name of this property
 	EPropType _type;                           ///< type of this property
 	std::size_t _dimension;                    ///< the fixed dimension of this property
 	bool _pluginReadOnly;                      ///< set is forbidden through suite: value may still change between getValue() calls
@@ -168,6 +171,12 @@ public:
 		return _name;
 	}
 
+	/// get the interned name of this property
+	OfxhAtom getAtom() const
+	{
+		return _atom;
+	}
+
 	/// get the type of this property
 	EPropType getType() const
 	{
@@ -221,6 +230,8 @@ private:
 	void serialize( Archive& ar, const unsigned int version )
 	{
 		ar& BOOST_SERIALIZATION_NVP( _name );
+		if( Archive::is_loading::value )
+			_atom = internPropertyName( _name );
 		ar& BOOST_SERIALIZATION_NVP( _type );
 		ar& BOOST_SERIALIZATION_NVP( _dimension );
 		ar& BOOST_SERIALIZATION_NVP( _pluginReadOnly );
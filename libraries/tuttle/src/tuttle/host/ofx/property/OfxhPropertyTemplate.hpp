@@ -95,6 +95,7 @@ public:
 	typedef typename T::ReturnType ReturnType;
 	typedef typename T::APIType APIType;
 	typedef typename T::APITypeConstless APITypeConstless;
+	static const EPropType typeCode = T::typeCode;
 
 protected:
 	/// this is the present value of the property
@@ -129,7 +130,7 @@ public:
 			//TUTTLE_TLOG( TUTTLE_INFO, "OfxhPropertyTemplate::operator== not same type : " << getType() << " != " << other.getType() );
 			return false;
 		}
-		return operator==( dynamic_cast<const This&>( other ) );
+		return operator==( static_cast<const This&>( other ) );
 	}
 
 	bool operator==( const This& other ) const
@@ -161,7 +162,7 @@ public:
 			BOOST_THROW_EXCEPTION( exception::Bug()
 			    << exception::dev( "You try to copy a property value, but it is not the same property type." ) );
 		}
-		copyValues( dynamic_cast<const This&>( other ) );
+		copyValues( static_cast<const This&>( other ) );
 	}
 
 	void copyValues( const This& other )
@@ -37,6 +37,7 @@
 #include <ofxImageEffect.h>
 
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 
 //#define DEBUG_PROPERTIES true
@@ -46,6 +47,43 @@ namespace host {
 namespace ofx {
 namespace property {
 
+namespace {
+
+struct AtomLess
+{
+	bool operator()( const PropertyIndex::value_type& a, const OfxhAtom b ) const { return a.first < b; }
+	bool operator()( const PropertyIndex::value_type& a, const PropertyIndex::value_type& b ) const { return a.first < b.first; }
+};
+
+}
+
+OfxhProperty* OfxhSet::findLocalProperty( const OfxhAtom atom ) const
+{
+	PropertyIndex::const_iterator it = std::lower_bound( _index.begin(), _index.end(), atom, AtomLess() );
+	if( it == _index.end() || it->first != atom )
+		return NULL;
+	return it->second;
+}
+
+void OfxhSet::indexProperty( OfxhProperty* prop )
+{
+	const PropertyIndex::value_type entry( prop->getAtom(), prop );
+	_index.insert( std::lower_bound( _index.begin(), _index.end(), prop->getAtom(), AtomLess() ), entry );
+}
+
+void OfxhSet::rebuildIndex()
+{
+	_index.clear();
+	_index.reserve( _props.size() );
+	for( PropertyMap::iterator it = _props.begin(), itEnd = _props.end();
+	     it != itEnd;
+	     ++it )
+	{
+		_index.push_back( std::make_pair( it->second->getAtom(), it->second ) );
+	}
+	std::sort( _index.begin(), _index.end(), AtomLess() );
+}
+
 
 OfxhProperty& OfxhSet::localAt( const int index )
 {
@@ -100,29 +138,52 @@ void OfxhSet::addNotifyHook( const std::string& s, OfxhNotifyHook* hook )
 
 OfxhProperty& OfxhSet::fetchLocalProperty( const std::string& name )
 {
-	PropertyMap::iterator i = _props.find( name );
+	const OfxhAtom atom = findPropertyAtom( name );
 
-	if( i == _props.end() )
+	if( atom == kOfxhNoAtom )
 	{
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue, "fetchLocalProperty: " + name + ". Property not found." ) ); //+ " on type:" + getStringProperty(kOfxPropType) + " name:" + getStringProperty(kOfxPropName) );// " NULL, (followChain: " << followChain << ").";
 	}
-	return *( i->second );
+	return fetchLocalProperty( atom );
+}
+
+OfxhProperty& OfxhSet::fetchLocalProperty( const OfxhAtom atom )
+{
+	OfxhProperty* prop = findLocalProperty( atom );
+
+	if( prop == NULL )
+	{
+		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue, "fetchLocalProperty: " + getPropertyAtomName( atom ) + ". Property not found." ) );
+	}
+	return *prop;
 }
 
 const OfxhProperty& OfxhSet::fetchProperty( const std::string& name ) const
 {
-	PropertyMap::const_iterator i = _props.find( name );
+	const OfxhAtom atom = findPropertyAtom( name );
 
-	if( i == _props.end() )
+	if( atom == kOfxhNoAtom )
 	{
-		if( _chainedSet )
-		{
-			return _chainedSet->fetchProperty( name );
-		}
 		BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue )
 			<< exception::dev() + "fetchProperty: " + name + " property not found." );
 	}
-	return *( i->second );
+	return fetchProperty( atom );
+}
+
+const OfxhProperty& OfxhSet::fetchProperty( const OfxhAtom atom ) const
+{
+	const OfxhSet* set = this;
+
+	do
+	{
+		if( const OfxhProperty* prop = set->findLocalProperty( atom ) )
+			return *prop;
+		set = set->_chainedSet;
+	}
+	while( set );
+
+	BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrValue )
+		<< exception::dev() + "fetchProperty: " + getPropertyAtomName( atom ) + " property not found." );
 }
 
 /**
@@ -136,24 +197,27 @@ void OfxhSet::createProperty( const OfxhPropSpec& spec )
 			<< exception::dev() + "Tried to add a duplicate property to a Property::Set (" + spec.name + ")" );
 	}
 	std::string key( spec.name ); // for constness
+	OfxhProperty* prop = NULL;
 	switch( spec.type )
 	{
 		case ePropTypeInt:
-			_props.insert( key, new Int( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atoi( spec.defaultValue ) : 0 ) );
+			prop = new Int( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atoi( spec.defaultValue ) : 0 );
 			break;
 		case ePropTypeDouble:
-			_props.insert( key, new Double( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atof( spec.defaultValue ) : 0 ) );
+			prop = new Double( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? std::atof( spec.defaultValue ) : 0 );
 			break;
 		case ePropTypeString:
-			_props.insert( key, new String( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? spec.defaultValue : "" ) );
+			prop = new String( spec.name, spec.dimension, spec.readonly, spec.defaultValue ? spec.defaultValue : "" );
 			break;
 		case ePropTypePointer:
-			_props.insert( key, new Pointer( spec.name, spec.dimension, spec.readonly, (void*) spec.defaultValue ) );
+			prop = new Pointer( spec.name, spec.dimension, spec.readonly, (void*) spec.defaultValue );
 			break;
 		case ePropTypeNone:
 			BOOST_THROW_EXCEPTION( OfxhException( kOfxStatErrUnsupported )
 				<< exception::dev() + "Tried to create a property of an unrecognized type (" + spec.name + ", " + mapTypeEnumToString( spec.type ) + ")" );
 	}
+	_props.insert( key, prop );
+	indexProperty( prop );
 }
 
 void OfxhSet::addProperties( const OfxhPropSpec spec[] )
@@ -167,21 +231,28 @@ void OfxhSet::addProperties( const OfxhPropSpec spec[] )
 
 void OfxhSet::eraseProperty( const std::string& propName )
 {
+	const OfxhAtom atom = findPropertyAtom( propName );
+	PropertyIndex::iterator it = std::lower_bound( _index.begin(), _index.end(), atom, AtomLess() );
+
+	if( it != _index.end() && it->first == atom )
+		_index.erase( it );
 	_props.erase( propName );
 }
 
 bool OfxhSet::hasProperty( const std::string& propName, bool followChain ) const
 {
-	PropertyMap::const_iterator it = _props.find( propName );
+	return hasProperty( findPropertyAtom( propName ), followChain );
+}
 
-	if( it == _props.end() )
+bool OfxhSet::hasProperty( const OfxhAtom atom, bool followChain ) const
+{
+	if( findLocalProperty( atom ) )
+		return true;
+	if( followChain && _chainedSet )
 	{
-		if( followChain && _chainedSet )
-		{
-			return _chainedSet->hasProperty( propName, true );
-		}
+		return _chainedSet->hasProperty( atom, true );
 	}
-	return it != _props.end();
+	return false;
 }
 
 bool OfxhSet::hasLocalProperty( const std::string& propName ) const
@@ -196,7 +267,8 @@ void OfxhSet::addProperty( OfxhProperty* prop )
 {
 	std::string key( prop->getName() ); // for constness
 
-	_props.insert( key, prop );
+	if( _props.insert( key, prop ).second )
+		indexProperty( prop );
 }
 
 /**
@@ -227,6 +299,7 @@ OfxhSet::~OfxhSet()
 
 void OfxhSet::clear()
 {
+	_index.clear();
 	_props.clear();
 }
 
@@ -234,6 +307,7 @@ OfxhSet& OfxhSet::operator=( const This& other )
 {
 	_props      = other._props.clone();
 	_chainedSet = other._chainedSet;
+	rebuildIndex();
 	return *this;
 }
 
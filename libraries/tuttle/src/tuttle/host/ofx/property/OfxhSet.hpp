@@ -33,6 +33,10 @@
 
 #include <boost/ptr_container/serialize_ptr_map.hpp>
 
+#include <vector>
+#include <utility>
+#include <typeinfo>
+
 namespace tuttle {
 namespace host {
 namespace ofx {
@@ -53,6 +57,9 @@ struct OfxhPropSpec
 /// A std::map of properties by name
 typedef boost::ptr_map<std::string, OfxhProperty> PropertyMap;
 
+/// The properties of a set sorted by atom, for the lookups
+typedef std::vector<std::pair<OfxhAtom, OfxhProperty*> > PropertyIndex;
+
 /**
  * Class that holds a set of properties and manipulates them
  * The 'fetch' methods return a property object.
@@ -69,6 +76,7 @@ private:
 
 protected:
 	PropertyMap _props; ///< Our properties.
+	PropertyIndex _index; ///< Our properties sorted by atom, pointing into _props.
 
 	/// chained property set, which is read only
 	/// these are searched on a get if not found
@@ -161,6 +169,7 @@ public:
 	const OfxhSet& getChainedSet() const { return *_chainedSet; }
 
 	/// grab the internal properties map
+	/// @warning don't add or remove properties through the map, it would not update the index
 	const PropertyMap& getMap() const { return _props; }
 	PropertyMap&       getMap()       { return _props; }
 
@@ -178,6 +187,12 @@ public:
 	OfxhProperty&       fetchLocalProperty( const std::string& name );
 	const OfxhProperty& fetchLocalProperty( const std::string& name ) const { return const_cast<OfxhSet*>( this )->fetchLocalProperty( name ); }
 
+	/// Same as the string versions, without the string comparisons.
+	/// @param atom interned name, from internPropertyName() or findPropertyAtom()
+	const OfxhProperty& fetchProperty( const OfxhAtom atom ) const;
+	OfxhProperty&       fetchLocalProperty( const OfxhAtom atom );
+	bool hasProperty( const OfxhAtom atom, bool followChain = true ) const;
+
 	/// get property with the particular name and type.  if the property is
 	/// missing or is of the wrong type, return an error status.  if this is a sloppy
 	/// property set and the property is missing, a new one will be created of the right
@@ -185,13 +200,25 @@ public:
 	template<class T>
 	const T& fetchTypedProperty( const std::string& name ) const
 	{
-		return dynamic_cast<const T&>( fetchProperty( name ) );
+		return castProperty<T>( fetchProperty( name ) );
 	}
 
 	template<class T>
 	T& fetchLocalTypedProperty( const std::string& name )
 	{
-		return dynamic_cast<T&>( fetchLocalProperty( name ) );
+		return castProperty<T>( fetchLocalProperty( name ) );
+	}
+
+	template<class T>
+	const T& fetchTypedProperty( const OfxhAtom atom ) const
+	{
+		return castProperty<T>( fetchProperty( atom ) );
+	}
+
+	template<class T>
+	T& fetchLocalTypedProperty( const OfxhAtom atom )
+	{
+		return castProperty<T>( fetchLocalProperty( atom ) );
 	}
 
 	template<class T>
@@ -316,11 +343,33 @@ public:
 	bool verifyMagic() { return this != NULL && _magic == kMagic; }
 
 private:
+	/// the type code identifies the property template, so we don't need a dynamic_cast
+	template<class T>
+	static T& castProperty( OfxhProperty& prop )
+	{
+		if( prop.getType() != T::typeCode )
+			BOOST_THROW_EXCEPTION( std::bad_cast() );
+		return static_cast<T&>( prop );
+	}
+
+	template<class T>
+	static const T& castProperty( const OfxhProperty& prop )
+	{
+		return castProperty<T>( const_cast<OfxhProperty&>( prop ) );
+	}
+
+	/// @return the local property or NULL
+	OfxhProperty* findLocalProperty( const OfxhAtom atom ) const;
+	void indexProperty( OfxhProperty* prop );
+	void rebuildIndex();
+
 	friend class boost::serialization::access;
 	template<class Archive>
 	void serialize( Archive& ar, const unsigned int version )
 	{
 		ar& BOOST_SERIALIZATION_NVP( _props );
+		if( Archive::is_loading::value )
+			rebuildIndex();
 	}
 
 };
@@ -0,0 +1,143 @@
+#ifndef _TUTTLE_PLUGIN_COORDINATEMAPCACHE_HPP_
+#define _TUTTLE_PLUGIN_COORDINATEMAPCACHE_HPP_
+
+#include <terry/sampler/coordinate_map.hpp>
+#include <terry/math/Rect.hpp>
+
+#include <ofxsMultiThread.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+
+namespace detail {
+
+/**
+ * @brief Fill a coordinate map with the OFX threads, each thread computes a band of rows.
+ */
+template<class MapFn>
+class CoordinateMapProcessor : public OFX::MultiThread::Processor
+{
+public:
+	CoordinateMapProcessor( terry::sampler::coordinate_map<float>& map, const MapFn& dstToSrc, const double maxError )
+		: _map( map )
+		, _dstToSrc( dstToSrc )
+		, _maxError( maxError )
+	{}
+
+	void multiThreadFunction( const unsigned int threadID, const unsigned int nThreads )
+	{
+		const terry::Rect<std::ssize_t>& region = _map.region();
+		const std::ssize_t bandHeight = ( region.y2 - region.y1 + nThreads - 1 ) / nThreads;
+		const std::ssize_t y1 = region.y1 + threadID * bandHeight;
+		const std::ssize_t y2 = std::min( y1 + bandHeight, region.y2 );
+		if( y1 >= y2 )
+			return;
+		const terry::Rect<std::ssize_t> band( region.x1, y1, region.x2, y2 );
+		if( _maxError > 0.0 )
+			terry::sampler::fill_coordinate_map_adaptive( _map, _dstToSrc, band, _maxError );
+		else
+			terry::sampler::fill_coordinate_map( _map, _dstToSrc, band );
+	}
+
+private:
+	terry::sampler::coordinate_map<float>& _map;
+	const MapFn& _dstToSrc;
+	const double _maxError;
+};
+
+}
+
+/**
+ * @brief Coordinate map (STMap) of a geometric node, shared by all its frames and render threads.
+ *
+ * The map is identified by a hash of the transformation parameters and by its region.
+ * When the parameters are constant along a shot, the transformation is evaluated once,
+ * and each frame only pays the sampling.
+ * Only the last map is kept: animated parameters compute a new map for each frame.
+ */
+class CoordinateMapCache : private boost::noncopyable
+{
+public:
+	typedef terry::sampler::coordinate_map<float> Map;
+	typedef boost::shared_ptr<const Map> ConstMapPtr;
+
+public:
+	CoordinateMapCache()
+		: _key( 0 )
+	{}
+
+	/**
+	 * @brief Map of @p region for the parameters @p key, computed in parallel with @p dstToSrc if it's not in the cache.
+	 * The other render threads asking for the same map wait for it.
+	 * @param maxError see compute()
+	 */
+	template<class MapFn>
+	ConstMapPtr get( const std::size_t key, const terry::Rect<std::ssize_t>& region, const MapFn& dstToSrc, const double maxError = 0.0 )
+	{
+		std::size_t mapKey = key;
+		boost::hash_combine( mapKey, maxError );
+
+		boost::mutex::scoped_lock lock( _mutex );
+		if( isCached( mapKey, region ) )
+			return _map;
+
+		_map = compute( region, dstToSrc, maxError );
+		_key = mapKey;
+		return _map;
+	}
+
+	/**
+	 * @brief Compute a map in parallel, without cache.
+	 * @param maxError 0 to evaluate @p dstToSrc for each pixel, else the maximum error in pixels
+	 *        of an interpolation on an adaptive grid (for smooth transformations)
+	 */
+	template<class MapFn>
+	static ConstMapPtr compute( const terry::Rect<std::ssize_t>& region, const MapFn& dstToSrc, const double maxError = 0.0 )
+	{
+		boost::shared_ptr<Map> map( new Map( region ) );
+		detail::CoordinateMapProcessor<MapFn> processor( *map, dstToSrc, maxError );
+		processor.multiThread();
+		return map;
+	}
+
+	/// @brief Remove the map, to release its memory.
+	void clear()
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_map.reset();
+	}
+
+private:
+	bool isCached( const std::size_t key, const terry::Rect<std::ssize_t>& region ) const
+	{
+		if( ! _map || _key != key )
+			return false;
+		const terry::Rect<std::ssize_t>& r = _map->region();
+		return r.x1 == region.x1 && r.y1 == region.y1 && r.x2 == region.x2 && r.y2 == region.y2;
+	}
+
+private:
+	boost::mutex _mutex; ///< maps are computed with the lock, to compute each map once
+	std::size_t _key;
+	ConstMapPtr _map;
+};
+
+/// @brief Add a point to a hash of parameters.
+template<typename T>
+inline void hashPoint( std::size_t& seed, const boost::gil::point2<T>& p )
+{
+	boost::hash_combine( seed, p.x );
+	boost::hash_combine( seed, p.y );
+}
+
+}
+}
+
+#endif
@@ -20,11 +20,35 @@ protected:
 	OfxRectI _srcPixelRod;
 	SView _srcView; ///< @brief source clip (filters have only one input)
 
+private:
+	typedef typename terry::image_from_view<SView>::type SImage;
+	boost::scoped_ptr<SImage> _srcCopy; ///< source owned by the processor, see setupDetached()
+
 public:
 	ImageGilFilterProcessor( OFX::ImageEffect& effect, const EImageOrientation imageOrientation );
 	virtual ~ImageGilFilterProcessor();
 
 	virtual void setup( const OFX::RenderArguments& args );
+
+	/**
+	 * @brief Setup the process to run it later, without the host images.
+	 * The source is copied and the host images are released, so processDetached()
+	 * can be called from another thread after the end of the render action.
+	 * It's only for processes which don't write in the destination, like writers.
+	 */
+	void setupDetached( const OFX::RenderArguments& args );
+
+	/// @brief Process the source copied by setupDetached().
+	void processDetached();
+
+	/**
+	 * @brief The process runs outside of the render action.
+	 * It can't use the host suites (progress, clips, params).
+	 */
+	bool isDetached() const { return _srcCopy.get() != NULL; }
+
+	/// @brief Memory held by the source copied by setupDetached().
+	std::size_t getDetachedMemorySize() const;
 };
 
 template<class SView, class DView>
@@ -78,6 +102,37 @@ void ImageGilFilterProcessor<SView, DView>::setup( const OFX::RenderArguments& a
 //		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch() );
 }
 
+template<class SView, class DView>
+void ImageGilFilterProcessor<SView, DView>::setupDetached( const OFX::RenderArguments& args )
+{
+	this->setRenderArgs( args );
+	setup( args );
+
+	_srcCopy.reset( new SImage( _srcView.dimensions() ) );
+	boost::gil::copy_pixels( _srcView, boost::gil::view( *_srcCopy ) );
+	_srcView = boost::gil::view( *_srcCopy );
+
+	// the host images are only valid during the render action
+	this->_dstView = DView();
+	this->_dst.reset();
+	_src.reset();
+}
+
+template<class SView, class DView>
+void ImageGilFilterProcessor<SView, DView>::processDetached()
+{
+	BOOST_ASSERT( _srcCopy.get() );
+	this->multiThreadProcessImages( this->_renderArgs.renderWindow );
+}
+
+template<class SView, class DView>
+std::size_t ImageGilFilterProcessor<SView, DView>::getDetachedMemorySize() const
+{
+	if( ! _srcCopy.get() )
+		return 0;
+	return _srcView.size() * sizeof( typename SView::value_type );
+}
+
 }
 }
 
@@ -105,9 +105,7 @@ public:
 	/** @brief fetch output and inputs clips */
 	virtual void setupAndProcess( const OFX::RenderArguments& args )
 	{
-		_renderArgs = args;
-		_renderWindowSize.x = ( _renderArgs.renderWindow.x2 - _renderArgs.renderWindow.x1 );
-		_renderWindowSize.y = ( _renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1 );
+		setRenderArgs( args );
 		try
 		{
 			setup( args );
@@ -156,6 +154,15 @@ public:
 		multiThreadProcessImages( winRoW );
 	}
 
+protected:
+	void setRenderArgs( const OFX::RenderArguments& args )
+	{
+		_renderArgs = args;
+		_renderWindowSize.x = ( _renderArgs.renderWindow.x2 - _renderArgs.renderWindow.x1 );
+		_renderWindowSize.y = ( _renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1 );
+	}
+
+public:
 	/** @brief this is called by multiThreadFunction to actually process images, override in derived classes */
 	virtual void multiThreadProcessImages( const OfxRectI& windowRoW ) = 0;
 
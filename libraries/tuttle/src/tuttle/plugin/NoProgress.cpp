@@ -26,6 +26,7 @@ void NoProgress::progressBegin( const int numSteps, const std::string& msg )
  */
 bool NoProgress::progressForward( const int nSteps )
 {
+	boost::mutex::scoped_lock lock( _mutex );
 	_counter += _stepSize * static_cast<double>( nSteps );
 	return false;
 }
@@ -3,6 +3,8 @@
 
 #include "IProgress.hpp"
 
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle {
 namespace plugin {
 
@@ -16,6 +18,7 @@ public:
 protected:
 	double _stepSize; ///< Step size of progess bar
 	double _counter; ///< Current position in [0; 1]
+	boost::mutex _mutex; ///< progressForward can be called by several threads
 };
 
 }
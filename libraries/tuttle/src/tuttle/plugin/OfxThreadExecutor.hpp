@@ -0,0 +1,65 @@
+#ifndef _TUTTLE_PLUGIN_OFXTHREADEXECUTOR_HPP_
+#define _TUTTLE_PLUGIN_OFXTHREADEXECUTOR_HPP_
+
+#include <ofxsMultiThread.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Execute the workers of the terry parallel algorithms on the host threads,
+ * with the OFX multithread suite.
+ *
+ * Use it in place of the default terry::algorithm::thread_group_executor,
+ * so the plugins don't create their own threads and respect the number of
+ * threads of the host.
+ * @code
+ * terry::algorithm::reduce_rows_parallel( height, width, reducer, OfxThreadExecutor() );
+ * @endcode
+ */
+class OfxThreadExecutor
+{
+public:
+	/// @param nbThreads 0 to use all the CPUs of the host
+	explicit OfxThreadExecutor( const std::size_t nbThreads = 0 )
+	: _nbThreads( nbThreads ? nbThreads : std::max( OFX::MultiThread::getNumCPUs(), 1u ) )
+	{}
+
+	std::size_t nbThreads() const { return _nbThreads; }
+
+	template<typename Worker>
+	void operator()( Worker& worker, const std::size_t nbWorkers ) const
+	{
+		WorkerProcessor<Worker> processor( worker );
+		processor.multiThread( static_cast<unsigned int>( nbWorkers ) );
+	}
+
+private:
+	template<typename Worker>
+	class WorkerProcessor : public OFX::MultiThread::Processor
+	{
+	public:
+		explicit WorkerProcessor( Worker& worker )
+		: _worker( worker )
+		{}
+
+		void multiThreadFunction( const unsigned int, const unsigned int )
+		{
+			_worker.run();
+		}
+
+	private:
+		Worker& _worker;
+	};
+
+private:
+	std::size_t _nbThreads;
+};
+
+}
+}
+
+#endif
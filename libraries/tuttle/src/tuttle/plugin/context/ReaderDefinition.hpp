@@ -6,6 +6,10 @@
 namespace tuttle {
 namespace plugin {
 
+static const std::string kParamReaderReadAhead      = "readAhead";
+static const std::string kParamReaderReadAheadLabel = "Read ahead";
+static const std::string kParamReaderReadAheadHint  = "Number of next files of the sequence read in background while rendering (0 to disable).";
+
 enum EParamReaderBitDepth
 {
 	eParamReaderBitDepthAuto = 0,
@@ -13,6 +13,7 @@ ReaderPlugin::ReaderPlugin( OfxImageEffectHandle handle )
 	_isSequence    = _filePattern.initFromDetection( _paramFilepath->getValue() );
 	_paramBitDepth = fetchChoiceParam( kTuttlePluginBitDepth );
 	_paramChannel  = fetchChoiceParam( kTuttlePluginChannel );
+	_paramReadAhead = fetchIntParam( kParamReaderReadAhead );
 }
 
 ReaderPlugin::~ReaderPlugin()
@@ -88,6 +89,26 @@ void ReaderPlugin::render( const OFX::RenderArguments& args )
 {
 	std::string filename =  getAbsoluteFilenameAt( args.time );
 	TUTTLE_LOG_INFO( "        >-- " << filename );
+	readAhead( args.time );
+}
+
+void ReaderPlugin::readAhead( const OfxTime time )
+{
+	const int nbFiles = _paramReadAhead->getValue();
+	if( ! _isSequence || nbFiles <= 0 )
+		return;
+
+	// the current file is read by the rendering
+	_readAhead.waitFor( getAbsoluteFilenameAt( time ) );
+
+	std::vector<std::string> filenames;
+	filenames.reserve( nbFiles );
+	const OfxTime lastTime = getLastTime();
+	for( int i = 1; i <= nbFiles && time + i <= lastTime; ++i )
+	{
+		filenames.push_back( getAbsoluteFilenameAt( time + i ) );
+	}
+	_readAhead.prefetch( filenames );
 }
 
 }
@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "ReaderDefinition.hpp"
+#include "SequenceReadAhead.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <Sequence.hpp>
@@ -104,11 +105,17 @@ public:
 	OFX::StringParam*    _paramFilepath;  ///< File path
 	OFX::ChoiceParam*    _paramBitDepth;  ///< Explicit bit depth conversion
 	OFX::ChoiceParam*    _paramChannel;   ///< Explicit component conversion
+	OFX::IntParam*       _paramReadAhead; ///< Number of files read in advance
 	/// @}
 
+private:
+	/// @brief Read the next files of the sequence in background.
+	void readAhead( const OfxTime time );
+
 private:
 	bool _isSequence;
 	sequenceParser::Sequence _filePattern;            ///< Filename pattern manager
+	SequenceReadAhead _readAhead;
 };
 
 }
@@ -50,6 +50,15 @@ void describeReaderParamsInContext( OFX::ImageEffectDescriptor& desc,
 		explicitConversion->setIsSecret( true );
 		explicitConversion->setDefault( static_cast<int>( OFX::getImageEffectHostDescription()->getDefaultPixelDepth() ) );
 	}
+
+	OFX::IntParamDescriptor* readAhead = desc.defineIntParam( kParamReaderReadAhead );
+	readAhead->setLabel( kParamReaderReadAheadLabel );
+	readAhead->setHint( kParamReaderReadAheadHint );
+	readAhead->setRange( 0, 64 );
+	readAhead->setDisplayRange( 0, 16 );
+	readAhead->setDefault( 4 );
+	readAhead->setAnimates( false );
+	readAhead->setEvaluateOnChange( false );
 }
 
 }
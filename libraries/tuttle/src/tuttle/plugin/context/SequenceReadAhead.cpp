@@ -0,0 +1,152 @@
+#include "SequenceReadAhead.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+namespace tuttle {
+namespace plugin {
+
+namespace {
+static const std::size_t kReadChunkSize = 1024 * 1024;
+}
+
+SequenceReadAhead::SequenceReadAhead( const std::size_t nbThreads, const std::size_t maxKnownFiles )
+	: _nbThreads( std::max( nbThreads, std::size_t( 1 ) ) )
+	, _maxKnownFiles( maxKnownFiles )
+	, _nbFilesRead( 0 )
+	, _started( false )
+	, _stop( false )
+{
+	// threads are started on the first prefetch
+}
+
+SequenceReadAhead::~SequenceReadAhead()
+{
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stop = true;
+		_requests.clear();
+	}
+	_fileRequested.notify_all();
+	_threads.join_all();
+}
+
+void SequenceReadAhead::start()
+{
+	for( std::size_t i = 0; i < _nbThreads; ++i )
+	{
+		_threads.create_thread( boost::bind( &SequenceReadAhead::workerLoop, this ) );
+	}
+	_started = true;
+}
+
+void SequenceReadAhead::setKnown( const std::string& filename )
+{
+	if( ! _known.insert( filename ).second )
+		return;
+	_knownOrder.push_back( filename );
+	while( _knownOrder.size() > _maxKnownFiles )
+	{
+		_known.erase( _knownOrder.front() );
+		_knownOrder.pop_front();
+	}
+}
+
+void SequenceReadAhead::prefetch( const std::vector<std::string>& filenames )
+{
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		if( _stop )
+			return;
+		if( ! _started )
+			start();
+
+		// forget the previous requests not started yet (the rendering may have jumped in time)
+		BOOST_FOREACH( const std::string& filename, _requests )
+		{
+			_known.erase( filename );
+			std::deque<std::string>::iterator it = std::find( _knownOrder.begin(), _knownOrder.end(), filename );
+			if( it != _knownOrder.end() )
+				_knownOrder.erase( it );
+		}
+		_requests.clear();
+
+		BOOST_FOREACH( const std::string& filename, filenames )
+		{
+			if( _known.find( filename ) != _known.end() )
+				continue;
+			setKnown( filename );
+			_requests.push_back( filename );
+		}
+	}
+	_fileRequested.notify_all();
+}
+
+void SequenceReadAhead::waitFor( const std::string& filename )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	std::deque<std::string>::iterator it = std::find( _requests.begin(), _requests.end(), filename );
+	if( it != _requests.end() )
+	{
+		// the caller is going to read it
+		_requests.erase( it );
+		return;
+	}
+	while( _inProgress.find( filename ) != _inProgress.end() )
+		_fileRead.wait( lock );
+}
+
+std::size_t SequenceReadAhead::getNbFilesRead() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _nbFilesRead;
+}
+
+void SequenceReadAhead::workerLoop()
+{
+	std::vector<char> buffer( kReadChunkSize );
+	while( true )
+	{
+		std::string filename;
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			while( _requests.empty() && ! _stop )
+				_fileRequested.wait( lock );
+			if( _stop )
+				return;
+			filename = _requests.front();
+			_requests.pop_front();
+			_inProgress.insert( filename );
+		}
+
+		const bool read = readFile( filename, buffer );
+
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			_inProgress.erase( filename );
+			if( read )
+				++_nbFilesRead;
+		}
+		_fileRead.notify_all();
+	}
+}
+
+bool SequenceReadAhead::readFile( const std::string& filename, std::vector<char>& buffer )
+{
+	// Missing files are not an error here, the reader reports them when it renders the frame.
+	std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+	if( ! file )
+		return false;
+	while( file.read( &buffer[0], buffer.size() ) )
+	{}
+	TUTTLE_TLOG( TUTTLE_TRACE, "[Read ahead] " << filename );
+	return true;
+}
+
+}
+}
@@ -0,0 +1,80 @@
+#ifndef _TUTTLE_PLUGIN_CONTEXT_SEQUENCEREADAHEAD_HPP_
+#define _TUTTLE_PLUGIN_CONTEXT_SEQUENCEREADAHEAD_HPP_
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Read the next files of a sequence on background threads.
+ *
+ * The files are read in advance while the current frame is decoded and
+ * processed, so their content is in the system cache when the reader opens
+ * them. On network storage, it hides the I/O latency from the rendering.
+ */
+class SequenceReadAhead : private boost::noncopyable
+{
+public:
+	/**
+	 * @param nbThreads number of background threads reading files
+	 * @param maxKnownFiles number of files already read remembered, to not read them twice
+	 */
+	explicit SequenceReadAhead( const std::size_t nbThreads = 2, const std::size_t maxKnownFiles = 64 );
+	~SequenceReadAhead();
+
+	/**
+	 * @brief Read @p filenames in background (in this order).
+	 * The files requested before and not started yet are forgotten.
+	 */
+	void prefetch( const std::vector<std::string>& filenames );
+
+	/**
+	 * @brief The caller is going to read @p filename: don't read it in background,
+	 * and wait if it is already in progress.
+	 */
+	void waitFor( const std::string& filename );
+
+	/// @brief Number of files read in background.
+	std::size_t getNbFilesRead() const;
+
+private:
+	void start();
+	void workerLoop();
+	void setKnown( const std::string& filename );
+
+	/// @brief Read all the file content.
+	/// @param buffer reused between the files read by a thread
+	/// @return false if the file can't be opened
+	static bool readFile( const std::string& filename, std::vector<char>& buffer );
+
+private:
+	const std::size_t _nbThreads;
+	const std::size_t _maxKnownFiles;
+	boost::thread_group _threads;
+
+	mutable boost::mutex _mutex;
+	boost::condition_variable _fileRequested;
+	boost::condition_variable _fileRead;
+	std::deque<std::string> _requests; ///< files to read, protected by _mutex
+	std::set<std::string> _inProgress; ///< files currently read, protected by _mutex
+	std::set<std::string> _known; ///< files already read or requested, protected by _mutex
+	std::deque<std::string> _knownOrder; ///< to forget the oldest known files, protected by _mutex
+	std::size_t _nbFilesRead; ///< protected by _mutex
+	bool _started; ///< protected by _mutex
+	bool _stop; ///< protected by _mutex
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "WriteBehindQueue.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+
+WriteBehindQueue::WriteBehindQueue( const std::size_t nbThreads )
+	: _nbThreads( std::max( nbThreads, std::size_t( 1 ) ) )
+	, _maxJobs( 0 )
+	, _maxMemorySize( 0 )
+	, _nbPendingJobs( 0 )
+	, _pendingMemorySize( 0 )
+	, _nbJobsDone( 0 )
+	, _started( false )
+	, _stop( false )
+{
+	// threads are started on the first push
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+	try
+	{
+		flush();
+	}
+	catch( ... )
+	{
+		TUTTLE_LOG_ERROR( "[Write behind] Error not reported before the end of the writer:" );
+		TUTTLE_LOG_ERROR( ::boost::current_exception_diagnostic_information() );
+	}
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_stop = true;
+	}
+	_jobPushed.notify_all();
+	_threads.join_all();
+}
+
+void WriteBehindQueue::start()
+{
+	for( std::size_t i = 0; i < _nbThreads; ++i )
+	{
+		_threads.create_thread( boost::bind( &WriteBehindQueue::workerLoop, this ) );
+	}
+	_started = true;
+}
+
+void WriteBehindQueue::setLimits( const std::size_t maxJobs, const std::size_t maxMemorySize )
+{
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		_maxJobs = maxJobs;
+		_maxMemorySize = maxMemorySize;
+	}
+	// the limits may be higher
+	_jobDone.notify_all();
+}
+
+bool WriteBehindQueue::isEnabled() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _maxJobs != 0;
+}
+
+bool WriteBehindQueue::isFull( const std::size_t memorySize ) const
+{
+	if( _nbPendingJobs == 0 )
+		return false;
+	if( _nbPendingJobs >= _maxJobs )
+		return true;
+	return _maxMemorySize != 0 && _pendingMemorySize + memorySize > _maxMemorySize;
+}
+
+void WriteBehindQueue::push( const Job& job, const std::size_t memorySize )
+{
+	{
+		boost::mutex::scoped_lock lock( _mutex );
+		if( _maxJobs != 0 && ! _stop )
+		{
+			while( isFull( memorySize ) && ! _error )
+				_jobDone.wait( lock );
+
+			// stop on the first error, don't render the next frames for nothing
+			if( _error )
+			{
+				boost::exception_ptr error = _error;
+				_error = boost::exception_ptr();
+				boost::rethrow_exception( error );
+			}
+
+			if( ! _started )
+				start();
+			QueuedJob queued;
+			queued._job = job;
+			queued._memorySize = memorySize;
+			_jobs.push_back( queued );
+			++_nbPendingJobs;
+			_pendingMemorySize += memorySize;
+			_jobPushed.notify_one();
+			return;
+		}
+	}
+	// write behind disabled
+	job();
+}
+
+void WriteBehindQueue::flush()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	while( _nbPendingJobs != 0 )
+		_jobDone.wait( lock );
+	if( _error )
+	{
+		boost::exception_ptr error = _error;
+		_error = boost::exception_ptr();
+		boost::rethrow_exception( error );
+	}
+}
+
+std::size_t WriteBehindQueue::getNbJobsDone() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _nbJobsDone;
+}
+
+void WriteBehindQueue::workerLoop()
+{
+	while( true )
+	{
+		QueuedJob queued;
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			while( _jobs.empty() && ! _stop )
+				_jobPushed.wait( lock );
+			if( _jobs.empty() )
+				return;
+			queued = _jobs.front();
+			_jobs.pop_front();
+		}
+
+		boost::exception_ptr error;
+		try
+		{
+			queued._job();
+		}
+		catch( ... )
+		{
+			TUTTLE_LOG_ERROR( "[Write behind] " << ::boost::current_exception_diagnostic_information() );
+			error = boost::current_exception();
+		}
+		// release the memory held by the job before the next push
+		queued._job.clear();
+
+		{
+			boost::mutex::scoped_lock lock( _mutex );
+			if( error && ! _error )
+				_error = error;
+			--_nbPendingJobs;
+			_pendingMemorySize -= queued._memorySize;
+			++_nbJobsDone;
+		}
+		_jobDone.notify_all();
+	}
+}
+
+}
+}
@@ -0,0 +1,93 @@
+#ifndef _TUTTLE_PLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+#define _TUTTLE_PLUGIN_CONTEXT_WRITEBEHINDQUEUE_HPP_
+
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <cstddef>
+#include <deque>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Bounded queue of write jobs encoded on background threads.
+ *
+ * The render returns as soon as the frame is queued, so the graph computes
+ * the next frames while the previous ones are encoded and written.
+ * The queue is bounded by a number of jobs and by the memory they hold:
+ * push() blocks until there is enough room (backpressure).
+ * The errors are reported by flush().
+ */
+class WriteBehindQueue : private boost::noncopyable
+{
+public:
+	typedef boost::function<void()> Job;
+
+public:
+	/**
+	 * @param nbThreads number of background threads encoding the jobs
+	 */
+	explicit WriteBehindQueue( const std::size_t nbThreads = 2 );
+	/// @brief Wait for the queued jobs, the errors are only logged.
+	~WriteBehindQueue();
+
+	/**
+	 * @param maxJobs number of jobs queued or in progress (0: jobs are executed synchronously)
+	 * @param maxMemorySize memory held by the jobs queued or in progress (0: no limit)
+	 */
+	void setLimits( const std::size_t maxJobs, const std::size_t maxMemorySize );
+	bool isEnabled() const;
+
+	/**
+	 * @brief Add a job, wait if the queue is full.
+	 * A job bigger than the memory limit is accepted when the queue is empty.
+	 * @param memorySize memory held by the job until it is done
+	 */
+	void push( const Job& job, const std::size_t memorySize );
+
+	/**
+	 * @brief Wait for all the jobs.
+	 * Rethrow the first error raised by a job since the last flush.
+	 */
+	void flush();
+
+	std::size_t getNbJobsDone() const;
+
+private:
+	struct QueuedJob
+	{
+		Job _job;
+		std::size_t _memorySize;
+	};
+
+	void start();
+	void workerLoop();
+	bool isFull( const std::size_t memorySize ) const;
+
+private:
+	const std::size_t _nbThreads;
+	boost::thread_group _threads;
+
+	mutable boost::mutex _mutex;
+	boost::condition_variable _jobPushed;
+	boost::condition_variable _jobDone;
+	std::deque<QueuedJob> _jobs; ///< protected by _mutex
+	std::size_t _maxJobs; ///< protected by _mutex
+	std::size_t _maxMemorySize; ///< protected by _mutex
+	std::size_t _nbPendingJobs; ///< jobs queued or in progress, protected by _mutex
+	std::size_t _pendingMemorySize; ///< memory of the jobs queued or in progress, protected by _mutex
+	std::size_t _nbJobsDone; ///< protected by _mutex
+	boost::exception_ptr _error; ///< first error since the last flush, protected by _mutex
+	bool _started; ///< protected by _mutex
+	bool _stop; ///< protected by _mutex
+};
+
+}
+}
+
+#endif
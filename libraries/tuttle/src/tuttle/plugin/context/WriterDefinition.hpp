@@ -26,6 +26,13 @@ static const std::string kParamWriterForceNewRender = "forceNewRender";
 
 static const std::string kParamPremultiplied      = "premultiplied";
 
+static const std::string kParamWriterWriteBehind       = "writeBehind";
+static const std::string kParamWriterWriteBehindLabel  = "Write behind";
+static const std::string kParamWriterWriteBehindHint   = "Number of frames encoded and written in background while the next frames are computed (0: write synchronously). The errors are reported at the end of the sequence.";
+static const std::string kParamWriterWriteBehindMemory      = "writeBehindMemory";
+static const std::string kParamWriterWriteBehindMemoryLabel = "Write behind memory (MB)";
+static const std::string kParamWriterWriteBehindMemoryHint  = "Maximum memory used by the frames waiting to be written (0: no limit). The rendering waits when it is reached.";
+
 }
 }
 
@@ -5,6 +5,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
 #include <cstdio>
 
 namespace tuttle {
@@ -26,6 +27,8 @@ WriterPlugin::WriterPlugin( OfxImageEffectHandle handle )
 	_paramPremult = fetchBooleanParam( kParamPremultiplied );
 	_paramExistingFile = fetchChoiceParam( kParamWriterExistingFile );
 	_paramForceNewRender = fetchIntParam( kParamWriterForceNewRender );
+	_paramWriteBehind = fetchIntParam( kParamWriterWriteBehind );
+	_paramWriteBehindMemory = fetchIntParam( kParamWriterWriteBehindMemory );
 	_isSequence = _filePattern.initFromDetection( _paramFilepath->getValue( ) );
 }
 
@@ -118,6 +121,12 @@ void WriterPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments&
 	{
 		boost::filesystem::create_directories( dir );
 	}
+
+	// a single frame doesn't need to be written in background
+	const bool oneFrame = args.frameRange.min == args.frameRange.max;
+	const std::size_t nbFrames = oneFrame ? 0 : std::max( _paramWriteBehind->getValue(), 0 );
+	const std::size_t memorySize = std::size_t( std::max( _paramWriteBehindMemory->getValue(), 0 ) ) * 1024 * 1024;
+	_writeBehind.setLimits( nbFrames, memorySize );
 }
 
 void WriterPlugin::render( const OFX::RenderArguments& args )
@@ -156,5 +165,16 @@ void WriterPlugin::render( const OFX::RenderArguments& args )
 	}
 }
 
+void WriterPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
+{
+	// wait for the frames written in background and report their errors
+	_writeBehind.flush();
+}
+
+void WriterPlugin::pushWriteJob( const WriteBehindQueue::Job& job, const std::size_t memorySize )
+{
+	_writeBehind.push( job, memorySize );
+}
+
 }
 }
@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "WriterDefinition.hpp"
+#include "WriteBehindQueue.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -12,6 +13,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -34,6 +37,14 @@ public:
 
 	virtual void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 	virtual void render( const OFX::RenderArguments& args );
+	virtual void endSequenceRender( const OFX::EndSequenceRenderArguments& args );
+
+	bool isWriteBehindEnabled() const { return _writeBehind.isEnabled(); }
+	/**
+	 * @brief Write a frame in background.
+	 * Wait if there are too many frames waiting to be written.
+	 */
+	void pushWriteJob( const WriteBehindQueue::Job& job, const std::size_t memorySize );
 
 protected:
 	inline bool varyOnTime() const { return _isSequence; }
@@ -45,6 +56,8 @@ private:
 	bool _oneRender;                            ///<
 	OfxTime _oneRenderAtTime;                         ///<
 
+	WriteBehindQueue _writeBehind; ///< frames encoded in background
+
 public:
 	std::string getAbsoluteFilenameAt( const OfxTime time ) const
 	{
@@ -105,9 +118,53 @@ public:
 	OFX::BooleanParam*    _paramPremult;
 	OFX::ChoiceParam*     _paramExistingFile;
 	OFX::IntParam*        _paramForceNewRender; ///< Hack parameter, to force a new rendering
+	OFX::IntParam*        _paramWriteBehind; ///< Number of frames written in background
+	OFX::IntParam*        _paramWriteBehindMemory; ///< Memory limit of the frames written in background (MB)
 	/// @}
 };
 
+/**
+ * @brief Run a writer process in the background queue of the writer plugin.
+ *
+ * To use in place of the writer process in the render function:
+ * @code
+ * doGilRender<WriteBehind<PngWriterProcess>::Processor>( *this, args );
+ * @endcode
+ * The process is setup during the render action (the source is copied),
+ * and the file is encoded and written by the queue.
+ * If write behind is disabled, the process is executed synchronously.
+ */
+template<template<class> class Process>
+struct WriteBehind
+{
+	template<class View>
+	class Processor
+	{
+	public:
+		template<class Plugin>
+		explicit Processor( Plugin& plugin )
+			: _writer( plugin )
+			, _process( new Process<View>( plugin ) )
+		{}
+
+		void setupAndProcess( const OFX::RenderArguments& args )
+		{
+			if( ! _writer.isWriteBehindEnabled() )
+			{
+				_process->setupAndProcess( args );
+				return;
+			}
+			_process->setupDetached( args );
+			// the job holds the process until the file is written
+			_writer.pushWriteJob( boost::bind( &Process<View>::processDetached, _process ), _process->getDetachedMemorySize() );
+		}
+
+	private:
+		WriterPlugin& _writer;
+		boost::shared_ptr<Process<View> > _process;
+	};
+};
+
 }
 }
 
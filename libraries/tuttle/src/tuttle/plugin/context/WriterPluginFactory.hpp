@@ -8,6 +8,8 @@
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
+#include <limits>
+
 namespace tuttle {
 namespace plugin {
 
@@ -63,6 +65,24 @@ void describeWriterParamsInContext( OFX::ImageEffectDescriptor& desc,
 //	renderAlways->setDefault( false );
 	renderAlways->setDefault( true ); // because tuttle is not declared as a background renderer
 
+	OFX::IntParamDescriptor* writeBehind = desc.defineIntParam( kParamWriterWriteBehind );
+	writeBehind->setLabel( kParamWriterWriteBehindLabel );
+	writeBehind->setHint( kParamWriterWriteBehindHint );
+	writeBehind->setRange( 0, 64 );
+	writeBehind->setDisplayRange( 0, 8 );
+	writeBehind->setDefault( 2 );
+	writeBehind->setAnimates( false );
+	writeBehind->setEvaluateOnChange( false );
+
+	OFX::IntParamDescriptor* writeBehindMemory = desc.defineIntParam( kParamWriterWriteBehindMemory );
+	writeBehindMemory->setLabel( kParamWriterWriteBehindMemoryLabel );
+	writeBehindMemory->setHint( kParamWriterWriteBehindMemoryHint );
+	writeBehindMemory->setRange( 0, std::numeric_limits<int>::max() );
+	writeBehindMemory->setDisplayRange( 0, 4096 );
+	writeBehindMemory->setDefault( 1024 );
+	writeBehindMemory->setAnimates( false );
+	writeBehindMemory->setEvaluateOnChange( false );
+
 	OFX::IntParamDescriptor* forceNewRender = desc.defineIntParam( kParamWriterForceNewRender );
 	forceNewRender->setLabel( "Force new render" );
 	forceNewRender->setHint( "This is only useful as a workaround for GUI applications." );
@@ -2,6 +2,8 @@
 #include <tuttle/host/memory/MemoryPool.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
 
+#include <boost/foreach.hpp>
+
 #include <iostream>
 
 #define BOOST_TEST_MODULE tuttle_memory
@@ -88,6 +90,129 @@ BOOST_AUTO_TEST_CASE( memoryPool )
 	BOOST_REQUIRE_THROW( pool.allocate( 50 ), std::exception );
 }
 
+BOOST_AUTO_TEST_CASE( memoryPoolBestFit )
+{
+	memory::MemoryPool pool( 100 );
+	{
+		const memory::IPoolDataPtr pData10 = pool.allocate( 10 );
+		const memory::IPoolDataPtr pData20 = pool.allocate( 20 );
+		const memory::IPoolDataPtr pData30 = pool.allocate( 30 );
+		BOOST_CHECK_EQUAL( 3U, pool.getDataUsedSize() );
+		BOOST_CHECK_EQUAL( 0U, pool.getDataUnusedSize() );
+		BOOST_CHECK_EQUAL( 60U, pool.getUsedMemorySize() );
+	}
+	BOOST_CHECK_EQUAL( 0U, pool.getDataUsedSize() );
+	BOOST_CHECK_EQUAL( 3U, pool.getDataUnusedSize() );
+	BOOST_CHECK_EQUAL( 0U, pool.getUsedMemorySize() );
+	BOOST_CHECK_EQUAL( 60U, pool.getAllocatedAndUnusedMemorySize() );
+	{
+		// the smallest buffer which can contain the data
+		const memory::IPoolDataPtr pData = pool.allocate( 15 );
+		BOOST_CHECK_EQUAL( 20U, pData->reservedSize() );
+		BOOST_CHECK_EQUAL( 5U, pool.getWastedMemorySize() );
+		BOOST_CHECK_EQUAL( 2U, pool.getDataUnusedSize() );
+
+		// the same buffer can't be given twice
+		const memory::IPoolDataPtr pOther = pool.allocate( 15 );
+		BOOST_CHECK_EQUAL( 30U, pOther->reservedSize() );
+		BOOST_CHECK( pData->data() != pOther->data() );
+		BOOST_CHECK_EQUAL( 50U, pool.getUsedMemorySize() );
+		BOOST_CHECK_EQUAL( 20U, pool.getWastedMemorySize() );
+	}
+	BOOST_CHECK_EQUAL( 0U, pool.getWastedMemorySize() );
+	BOOST_CHECK_EQUAL( 60U, pool.getAllocatedMemorySize() );
+
+	// the least recently released buffer is freed first
+	pool.clearOne();
+	BOOST_CHECK_EQUAL( 2U, pool.getDataUnusedSize() );
+	BOOST_CHECK_EQUAL( 50U, pool.getAllocatedMemorySize() );
+
+	pool.clear();
+	BOOST_CHECK_EQUAL( 0U, pool.getDataUnusedSize() );
+	BOOST_CHECK_EQUAL( 0U, pool.getAllocatedMemorySize() );
+}
+
+BOOST_AUTO_TEST_CASE( memoryPoolEviction )
+{
+	memory::MemoryPool pool( 100 );
+	pool.setWatermarks( 0.8, 1.0 );
+	{
+		const memory::IPoolDataPtr pData10 = pool.allocate( 10 );
+		const memory::IPoolDataPtr pData20 = pool.allocate( 20 );
+		const memory::IPoolDataPtr pData30 = pool.allocate( 30 );
+	}
+	BOOST_CHECK_EQUAL( 3U, pool.getNbAllocations() );
+	BOOST_CHECK_EQUAL( 60U, pool.getAllocatedAndUnusedMemorySize() );
+
+	// free just enough memory: the 30 bytes buffer was released first
+	pool.clear( 25 );
+	BOOST_CHECK_EQUAL( 1U, pool.getNbEvictions() );
+	BOOST_CHECK_EQUAL( 30U, pool.getEvictedMemorySize() );
+	BOOST_CHECK_EQUAL( 30U, pool.getAllocatedMemorySize() );
+
+	pool.setEvictionPolicy( memory::eEvictionLargestFirst );
+	pool.clear( 1 );
+	BOOST_CHECK_EQUAL( 2U, pool.getNbEvictions() );
+	BOOST_CHECK_EQUAL( 10U, pool.getAllocatedMemorySize() );
+
+	{
+		const memory::IPoolDataPtr pData = pool.allocate( 50 );
+		BOOST_CHECK_EQUAL( 2U, pool.getNbEvictions() );
+		// going above the soft watermark evicts the unused buffers
+		const memory::IPoolDataPtr pOther = pool.allocate( 25 );
+		BOOST_CHECK_EQUAL( 3U, pool.getNbEvictions() );
+		BOOST_CHECK_EQUAL( 75U, pool.getAllocatedMemorySize() );
+		BOOST_CHECK_EQUAL( 0U, pool.getDataUnusedSize() );
+
+		// the hard watermark limits the used memory
+		BOOST_REQUIRE_THROW( pool.allocate( 30 ), std::exception );
+	}
+	{
+		// reuse without allocation
+		const memory::IPoolDataPtr pData = pool.allocate( 40 );
+		BOOST_CHECK_EQUAL( 50U, pData->reservedSize() );
+		BOOST_CHECK_EQUAL( 5U, pool.getNbAllocations() );
+		BOOST_CHECK_EQUAL( 1U, pool.getNbReuses() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( memoryPoolAllocationPolicy )
+{
+	memory::AllocationPolicy policy;
+	policy._alignment = 128;
+	policy._hugePagesMinSize = 1024;
+	memory::MemoryPool pool( 10000, policy );
+	{
+		const memory::IPoolDataPtr pSmall = pool.allocate( 10 );
+		const memory::IPoolDataPtr pBig = pool.allocate( 2000 );
+		BOOST_CHECK_EQUAL( 0U, reinterpret_cast<std::size_t>( pSmall->data() ) % 128 );
+		BOOST_CHECK_EQUAL( 0U, reinterpret_cast<std::size_t>( pBig->data() ) % 128 );
+		// huge pages don't change the size seen by the pool
+		BOOST_CHECK_EQUAL( 2000U, pBig->reservedSize() );
+		BOOST_CHECK_EQUAL( 2010U, pool.getUsedMemorySize() );
+	}
+	{
+		const memory::IPoolDataPtr pData = pool.allocate( 10 );
+		const std::vector<memory::PoolDataInfos> infos = pool.getDatasInfos();
+		BOOST_REQUIRE_EQUAL( 2U, infos.size() );
+		BOOST_FOREACH( const memory::PoolDataInfos& info, infos )
+		{
+			BOOST_CHECK( info._allocation._alignment >= 128 );
+			BOOST_CHECK( info._allocation._allocatedSize >= info._reservedSize );
+			if( info._reservedSize == 10 )
+			{
+				BOOST_CHECK_EQUAL( true, info._isUsed );
+				BOOST_CHECK_EQUAL( 2U, info._nbUses );
+			}
+			else
+			{
+				BOOST_CHECK_EQUAL( false, info._isUsed );
+				BOOST_CHECK_EQUAL( 1U, info._nbUses );
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE( memoryCache )
 {
 	memory::MemoryPool pool;
@@ -94,5 +94,48 @@ BOOST_AUTO_TEST_CASE( properties_get_and_set )
 	//	bool sequential = descriptor.getProperties().getIntProperty( kOfxImageEffectInstancePropSequentialRender ) != 0;
 }
 
+BOOST_AUTO_TEST_CASE( properties_atoms )
+{
+	using namespace tuttle::host;
+	using namespace tuttle::host::ofx::property;
+
+	static const OfxhPropSpec testStuff[] = {
+		{ "testAtomInt", ePropTypeInt, 1, false, "3" },
+		{ "testAtomString", ePropTypeString, 1, false, "value" },
+		{ 0 }
+	};
+	static const OfxhPropSpec chainedStuff[] = {
+		{ "testAtomChained", ePropTypeDouble, 1, false, "0.5" },
+		{ 0 }
+	};
+	OfxhSet testSet( testStuff );
+	OfxhSet chainedSet( chainedStuff );
+	testSet.setChainedSet( &chainedSet );
+
+	const OfxhAtom intAtom = findPropertyAtom( "testAtomInt" );
+	BOOST_CHECK_NE( intAtom, kOfxhNoAtom );
+	BOOST_CHECK_EQUAL( intAtom, internPropertyName( "testAtomInt" ) );
+	BOOST_CHECK_EQUAL( getPropertyAtomName( intAtom ), "testAtomInt" );
+	BOOST_CHECK_EQUAL( findPropertyAtom( "testAtomNeverCreated" ), kOfxhNoAtom );
+
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<Int>( intAtom ).getValue(), 3 );
+	BOOST_CHECK_EQUAL( testSet.fetchLocalTypedProperty<String>( findPropertyAtom( "testAtomString" ) ).getValue(), "value" );
+	BOOST_CHECK_THROW( testSet.fetchTypedProperty<Double>( intAtom ), std::bad_cast );
+
+	// the chained set is searched by atom too
+	const OfxhAtom chainedAtom = findPropertyAtom( "testAtomChained" );
+	BOOST_CHECK( testSet.hasProperty( chainedAtom ) );
+	BOOST_CHECK( ! testSet.hasProperty( chainedAtom, false ) );
+	BOOST_CHECK_EQUAL( testSet.fetchTypedProperty<Double>( chainedAtom ).getValue(), 0.5 );
+	BOOST_CHECK_THROW( testSet.fetchLocalProperty( chainedAtom ), ofx::OfxhException );
+
+	// copies and erased properties keep the index up to date
+	OfxhSet copySet( testSet );
+	testSet.eraseProperty( "testAtomInt" );
+	BOOST_CHECK( ! testSet.hasProperty( intAtom ) );
+	BOOST_CHECK_THROW( testSet.getIntProperty( "testAtomInt" ), ofx::OfxhException );
+	BOOST_CHECK_EQUAL( copySet.getIntProperty( "testAtomInt" ), 3 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,76 @@
+// custom host
+#include <tuttle/host/ThreadPool.hpp>
+
+#include <tuttle/common/atomic.hpp>
+
+#include <iostream>
+
+#define BOOST_TEST_MODULE tuttle_threadPool
+#include <tuttle/test/unit_test.hpp>
+
+using namespace boost::unit_test;
+using namespace std;
+using namespace tuttle::host;
+
+namespace {
+
+ThreadPool* gPool = NULL;
+boost::atomic<unsigned int> gNbCalls( 0 );
+
+void countCalls( unsigned int threadIndex, unsigned int threadMax, void* )
+{
+	unsigned int index = threadMax;
+	BOOST_CHECK( ThreadPool::isSpawnedThread() );
+	BOOST_CHECK( ThreadPool::getThreadIndex( index ) );
+	BOOST_CHECK_EQUAL( threadIndex, index );
+	++gNbCalls;
+}
+
+void nestedCalls( unsigned int threadIndex, unsigned int, void* )
+{
+	gPool->run( countCalls, 8, NULL );
+	// the thread index is restored after the nested call
+	unsigned int index = 0;
+	ThreadPool::getThreadIndex( index );
+	BOOST_CHECK_EQUAL( threadIndex, index );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( threadPool_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( threadPoolRun )
+{
+	ThreadPool pool( 4 );
+	BOOST_CHECK_EQUAL( 4U, pool.getNbThreads() );
+	BOOST_CHECK( ! ThreadPool::isSpawnedThread() );
+
+	gNbCalls = 0;
+	for( std::size_t i = 0; i < 100; ++i )
+	{
+		BOOST_CHECK( pool.run( countCalls, 6, NULL ) );
+	}
+	BOOST_CHECK_EQUAL( 600U, gNbCalls.load() );
+	BOOST_CHECK( ! ThreadPool::isSpawnedThread() );
+}
+
+BOOST_AUTO_TEST_CASE( threadPoolNestedRun )
+{
+	ThreadPool pool( 3 );
+	gPool = &pool;
+
+	gNbCalls = 0;
+	for( std::size_t i = 0; i < 100; ++i )
+	{
+		BOOST_CHECK( pool.run( nestedCalls, 5, NULL ) );
+	}
+	BOOST_CHECK_EQUAL( 4000U, gNbCalls.load() );
+
+	// resize between two runs
+	pool.setNbThreads( 1 );
+	gNbCalls = 0;
+	BOOST_CHECK( pool.run( nestedCalls, 5, NULL ) );
+	BOOST_CHECK_EQUAL( 40U, gNbCalls.load() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,13 +2,68 @@
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
+#include <tuttle/plugin/OfxThreadExecutor.hpp>
 
-#include <terry/algorithm/transform_pixels.hpp>
+#include <terry/algorithm/reduce.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace histogram {
 
+namespace {
+
+void addVector( const HistogramVector& src, HistogramVector& dst )
+{
+	BOOST_ASSERT( src.size() == dst.size() );
+	for( std::size_t i = 0; i < src.size(); ++i )
+		dst[i] += src[i];
+}
+
+/**
+ * @brief Add the histograms of src to dst
+ */
+void addHistogramBufferData( const HistogramBufferData& src, HistogramBufferData& dst )
+{
+	addVector( src._bufferRed, dst._bufferRed );
+	addVector( src._bufferGreen, dst._bufferGreen );
+	addVector( src._bufferBlue, dst._bufferBlue );
+	addVector( src._bufferHue, dst._bufferHue );
+	addVector( src._bufferLightness, dst._bufferLightness );
+	addVector( src._bufferSaturation, dst._bufferSaturation );
+	addVector( src._bufferAlpha, dst._bufferAlpha );
+}
+
+}
+
+Rows_compute_histograms::Rows_compute_histograms( const boost::gil::rgba32f_view_t& srcView, bool_2d& selection, const int nbStep, const bool isSelectionMode )
+: _srcView( srcView )
+, _imgBool( &selection )
+, _isSelectionMode( isSelectionMode )
+{
+	_data._step = nbStep;
+	_data._bufferRed.assign( nbStep, 0 );
+	_data._bufferGreen.assign( nbStep, 0 );
+	_data._bufferBlue.assign( nbStep, 0 );
+	_data._bufferHue.assign( nbStep, 0 );
+	_data._bufferLightness.assign( nbStep, 0 );
+	_data._bufferSaturation.assign( nbStep, 0 );
+	_data._bufferAlpha.assign( nbStep, 0 );
+}
+
+void Rows_compute_histograms::operator()( const std::ptrdiff_t y )
+{
+	Pixel_compute_histograms funct( *_imgBool, _data, _isSelectionMode );
+	funct._y = y;
+	boost::gil::rgba32f_view_t::x_iterator it = _srcView.row_begin( y );
+	for( std::ptrdiff_t x = 0; x < _srcView.width(); ++x )
+		funct( it[x] );
+}
+
+void Rows_compute_histograms::merge( const Rows_compute_histograms& other )
+{
+	addHistogramBufferData( other._data, _data );
+}
+
 /**
  * Create a new empty data structure from scratch (data is null)
  * @param size : size of the current source clip (width*height) 
@@ -36,10 +91,9 @@ void OverlayData::computeHistogramBufferData( HistogramBufferData& data, SView&
 	BOOST_ASSERT( srcView.width()  == std::size_t(_size.x) );
 	BOOST_ASSERT( srcView.height() == std::size_t(_size.y) );
 	
-	Pixel_compute_histograms funct( _imgBool, data, isSelection );			//functor declaration
-	
-	terry::algorithm::transform_pixels( srcView, funct );		//(USED functor reference)
-	//boost::gil::for_each_pixel(srcView, funct);		(NOT USED)
+	Rows_compute_histograms reducer( srcView, _imgBool, _vNbStep, isSelection );	//rows processed in parallel
+	terry::algorithm::reduce_rows_parallel( srcView.height(), srcView.width(), reducer, OfxThreadExecutor() );
+	addHistogramBufferData( reducer._data, data );
 	
 	this->correctHistogramBufferData(data);				//correct Histogram data to make up for discretization (average)
 }
@@ -156,6 +156,22 @@ struct Pixel_compute_histograms
     }
 };
 
+/*
+ * reducer to compute the histograms of bands of rows in parallel (see terry::algorithm::reduce_rows_parallel)
+ */
+struct Rows_compute_histograms
+{
+	boost::gil::rgba32f_view_t _srcView;	//source view
+	bool_2d* _imgBool;						//bool selection img (pixels)
+	bool _isSelectionMode;					//do we work on all of the pixels (normal histograms) or only on selection
+	HistogramBufferData _data;				//histograms of the rows already processed
+
+	Rows_compute_histograms( const boost::gil::rgba32f_view_t& srcView, bool_2d& selection, const int nbStep, const bool isSelectionMode );
+
+	void operator()( const std::ptrdiff_t y );
+	void merge( const Rows_compute_histograms& other );
+};
+
 class OverlayData 
 {
 public:
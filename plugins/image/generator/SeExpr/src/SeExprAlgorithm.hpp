@@ -1,6 +1,9 @@
 #ifndef _TUTTLE_PLUGIN_SEEXPR_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_SEEXPR_ALGORITHM_HPP_
 
+#include <map>
+#include <string>
+
 namespace tuttle {
 namespace plugin {
 namespace seExpr {
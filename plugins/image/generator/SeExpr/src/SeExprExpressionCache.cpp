@@ -0,0 +1,58 @@
+#include "SeExprExpressionCache.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <memory>
+
+namespace tuttle {
+namespace plugin {
+namespace seExpr {
+
+ExpressionCache& ExpressionCache::instance()
+{
+	static ExpressionCache cache;
+	return cache;
+}
+
+ImageSynthExpr* ExpressionCache::acquire( const std::string& code )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	ExpressionMap::iterator it = _expressions.find( code );
+	if( it != _expressions.end() && ! it->second.empty() )
+		return it->second.pop_back().release();
+
+	if( it == _expressions.end() && _expressions.size() >= kExpressionCacheMaxNbCodes )
+	{
+		// the codes in use are released in their own entry
+		_expressions.clear();
+	}
+
+	TUTTLE_LOG_TRACE( "[SeExpr] Compile the expression: " << code );
+
+	std::auto_ptr<ImageSynthExpr> expr( new ImageSynthExpr( code ) );
+	// the variables are bound at the parse of the expression
+	expr->vars["u"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["v"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["w"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["h"] = ImageSynthExpr::Var( 0.0 );
+	expr->vars["frame"] = ImageSynthExpr::Var( 0.0 );
+	expr->isValid();
+	return expr.release();
+}
+
+void ExpressionCache::release( ImageSynthExpr* expr )
+{
+	std::auto_ptr<ImageSynthExpr> owner( expr );
+	boost::mutex::scoped_lock lock( _mutex );
+	_expressions[expr->getExpr()].push_back( owner.release() );
+}
+
+void ExpressionCache::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_expressions.clear();
+}
+
+}
+}
+}
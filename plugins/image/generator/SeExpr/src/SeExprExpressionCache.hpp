@@ -0,0 +1,85 @@
+#ifndef _TUTTLE_PLUGIN_SEEXPR_EXPRESSIONCACHE_HPP_
+#define _TUTTLE_PLUGIN_SEEXPR_EXPRESSIONCACHE_HPP_
+
+#include <SeExpression.h>
+
+#include "SeExprAlgorithm.hpp"
+
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+namespace seExpr {
+
+/// @brief Maximum number of expression codes kept by the cache.
+static const std::size_t kExpressionCacheMaxNbCodes = 8;
+
+/**
+ * @brief Process-wide cache of the compiled expressions.
+ *
+ * An expression holds its variable values, so it can only be evaluated by
+ * one thread at a time. Each render thread acquires its own expression,
+ * and gives it back at the end of its rows. The expressions are kept across
+ * the frames and node instances, while the code is unchanged, so each code is
+ * only parsed once per thread.
+ *
+ * The expressions have the variables u, v, w, h and frame.
+ */
+class ExpressionCache : private boost::noncopyable
+{
+public:
+	static ExpressionCache& instance();
+
+	/**
+	 * @brief An expression compiled from @p code, for the use of one thread.
+	 * @warning Give it back with release().
+	 */
+	ImageSynthExpr* acquire( const std::string& code );
+
+	/// @brief Give back an expression acquired by acquire(), for the next renders.
+	void release( ImageSynthExpr* expr );
+
+	/// @brief Delete the expressions not in use.
+	void clear();
+
+private:
+	ExpressionCache() {}
+
+private:
+	typedef std::map<std::string, boost::ptr_vector<ImageSynthExpr> > ExpressionMap;
+
+	boost::mutex _mutex; ///< the expressions are parsed with the lock
+	ExpressionMap _expressions; ///< key: code, value: expressions not in use
+};
+
+/**
+ * @brief Expression acquired from the cache for the current scope.
+ */
+class ScopedExpression : private boost::noncopyable
+{
+public:
+	explicit ScopedExpression( const std::string& code )
+		: _expr( ExpressionCache::instance().acquire( code ) )
+	{}
+
+	~ScopedExpression()
+	{
+		ExpressionCache::instance().release( _expr );
+	}
+
+	ImageSynthExpr& get() { return *_expr; }
+
+private:
+	ImageSynthExpr* _expr;
+};
+
+}
+}
+}
+
+#endif
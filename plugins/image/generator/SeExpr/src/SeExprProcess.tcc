@@ -1,3 +1,7 @@
+#include "SeExprExpressionCache.hpp"
+
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace seExpr {
@@ -7,7 +11,6 @@ SeExprProcess<View>::SeExprProcess( SeExprPlugin &effect )
 	: ImageGilProcessor<View>( effect, eImageOrientationIndependant )
 	, _plugin( effect )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -22,18 +25,12 @@ void SeExprProcess<View>::setup( const OFX::RenderArguments& args )
 	
 	TUTTLE_TLOG( TUTTLE_INFO, _params._code );
 
-	ImageSynthExpr expr( _params._code );
-	expr.vars["u"] = ImageSynthExpr::Var( _params._paramTextureOffset.x );
-	expr.vars["v"] = ImageSynthExpr::Var( _params._paramTextureOffset.y );
-	expr.vars["w"] = ImageSynthExpr::Var( rod.x2 - rod.x1 );
-	expr.vars["h"] = ImageSynthExpr::Var( rod.y2 - rod.y1 );
-	expr.vars["frame"] = ImageSynthExpr::Var( _time );
-
-	bool valid = expr.isValid();
-	if( !valid )
+	// the compiled expression is given back to the cache, for the render threads
+	ScopedExpression expr( _params._code );
+	if( ! expr.get().isValid() )
 	{
 		TUTTLE_LOG( TUTTLE_ERROR, "Invalid expression" );
-		TUTTLE_LOG( TUTTLE_ERROR, expr.parseError() );
+		TUTTLE_LOG( TUTTLE_ERROR, expr.get().parseError() );
 	}
 }
 
@@ -51,34 +48,44 @@ void SeExprProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRo
 		procWindowRoW.x2 - procWindowRoW.x1,
 		procWindowRoW.y2 - procWindowRoW.y1
 	};
+	if( procWindowSize.x <= 0 || procWindowSize.y <= 0 )
+		return;
 
-	ImageSynthExpr expr( _params._code );
-	expr.vars["u"] = ImageSynthExpr::Var( _params._paramTextureOffset.x );
-	expr.vars["v"] = ImageSynthExpr::Var( _params._paramTextureOffset.y );
-	expr.vars["w"] = ImageSynthExpr::Var( rod.x2 - rod.x1 );
-	expr.vars["h"] = ImageSynthExpr::Var( rod.y2 - rod.y1 );
-	expr.vars["frame"] = ImageSynthExpr::Var( _time );
+	// each render thread evaluates its own expression
+	ScopedExpression scopedExpr( _params._code );
+	ImageSynthExpr& expr = scopedExpr.get();
+	expr.vars["w"].val = rod.x2 - rod.x1;
+	expr.vars["h"].val = rod.y2 - rod.y1;
+	expr.vars["frame"].val = _time;
 
-	double one_over_width  = 1.0 / procWindowSize.x;
-	double one_over_height = 1.0 / procWindowSize.y;
+	// u and v are normalized on the full render window, not on the rows of the thread
+	const double one_over_width  = 1.0 / this->_renderWindowSize.x;
+	const double one_over_height = 1.0 / this->_renderWindowSize.y;
 	double& u = expr.vars["u"].val;
 	double& v = expr.vars["v"].val;
 
+	// u only depends on the column
+	std::vector<double> rowU( procWindowSize.x );
+	for( int x = 0; x < procWindowSize.x; ++x )
+		rowU[x] = one_over_width * ( procWindowOutput.x1 + x + .5 - _params._paramTextureOffset.x );
+
+	// the results of a row, converted to the output in one pass
+	std::vector<rgba32f_pixel_t> rowResults( procWindowSize.x );
+	const rgba32f_view_t rowResultsView = interleaved_view( procWindowSize.x, 1, &rowResults.front(), procWindowSize.x * sizeof( rgba32f_pixel_t ) );
+
 	for( int y = procWindowOutput.y1;
 			 y < procWindowOutput.y2;
 			 ++y )
 	{
-		typename View::x_iterator dst_it = this->_dstView.x_at( procWindowOutput.x1, y );
-		for( int x = procWindowOutput.x1;
-			 x < procWindowOutput.x2;
-			 ++x, ++dst_it )
+		v = one_over_height * ( y + .5 - _params._paramTextureOffset.y );
+		for( int x = 0; x < procWindowSize.x; ++x )
 		{
-			u = one_over_width  * ( x + .5 - _params._paramTextureOffset.x );
-			v = one_over_height * ( y + .5 - _params._paramTextureOffset.y );
-			SeVec3d result = expr.evaluate();
-
-			color_convert( rgba32f_pixel_t( (float)result[0], (float)result[1], (float)result[2], 1.0 ), *dst_it );
+			u = rowU[x];
+			const SeVec3d result = expr.evaluate();
+			rowResults[x] = rgba32f_pixel_t( (float)result[0], (float)result[1], (float)result[2], 1.0 );
 		}
+		copy_and_convert_pixels( rowResultsView, subimage_view( this->_dstView, procWindowOutput.x1, y, procWindowSize.x, 1 ) );
+
 		if( this->progressForward( procWindowSize.x ) )
 			return;
 	}
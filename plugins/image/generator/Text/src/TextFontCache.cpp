@@ -0,0 +1,306 @@
+#include "TextFontCache.hpp"
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <terry/freetype/freegil.hpp>
+
+#include <boost/gil/image_view_factory.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef __WINDOWS__
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+namespace {
+
+/// @brief Character of a face, for the terry FreeType functors.
+struct FaceGlyph
+{
+	char ch;
+	FT_Face face;
+};
+
+}
+
+bool GlyphAtlas::Key::operator<( const Key& other ) const
+{
+	if( _charCode != other._charCode )
+		return _charCode < other._charCode;
+	if( _sizeX != other._sizeX )
+		return _sizeX < other._sizeX;
+	if( _sizeY != other._sizeY )
+		return _sizeY < other._sizeY;
+	return _fontFile < other._fontFile;
+}
+
+GlyphAtlas::Page::Page( const std::ptrdiff_t width, const std::ptrdiff_t height )
+	: _width( width )
+	, _height( height )
+	, _pixels( width * height, 0 )
+{}
+
+GlyphAtlas::GlyphAtlas()
+	: _shelfX( 0 )
+	, _shelfY( 0 )
+	, _shelfHeight( 0 )
+{}
+
+const AtlasGlyph* GlyphAtlas::find( const Key& key ) const
+{
+	std::map<Key, AtlasGlyph>::const_iterator it = _glyphs.find( key );
+	if( it == _glyphs.end() )
+		return NULL;
+	return &it->second;
+}
+
+const AtlasGlyph& GlyphAtlas::insert( const Key& key, const FT_GlyphSlot slot )
+{
+	AtlasGlyph glyph;
+	glyph._metrics = slot->metrics;
+	glyph._advance = slot->advance.x >> 6;
+
+	const std::ptrdiff_t width = slot->bitmap.width;
+	const std::ptrdiff_t height = slot->bitmap.rows;
+	if( width > 0 && height > 0 )
+	{
+		const terry::gray8_view_t coverage = allocate( width, height );
+		for( std::ptrdiff_t y = 0; y < height; ++y )
+		{
+			std::memcpy( &coverage( 0, y ), slot->bitmap.buffer + y * slot->bitmap.pitch, width );
+		}
+		glyph._coverage = coverage;
+	}
+	return _glyphs.insert( std::make_pair( key, glyph ) ).first->second;
+}
+
+std::size_t GlyphAtlas::getMemorySize() const
+{
+	std::size_t size = 0;
+	for( boost::ptr_vector<Page>::const_iterator it = _pages.begin(), itEnd = _pages.end(); it != itEnd; ++it )
+		size += it->_pixels.size();
+	return size;
+}
+
+terry::gray8_view_t GlyphAtlas::allocate( const std::ptrdiff_t width, const std::ptrdiff_t height )
+{
+	// a glyph bigger than a page has its own page
+	if( width > kGlyphAtlasPageSize || height > kGlyphAtlasPageSize )
+	{
+		_pages.push_back( new Page( width, height ) );
+		// the next glyphs start a new page
+		_shelfY = kGlyphAtlasPageSize;
+		return boost::gil::interleaved_view( width, height, reinterpret_cast<terry::gray8_pixel_t*>( &_pages.back()._pixels.front() ), width );
+	}
+
+	if( _shelfX + width > kGlyphAtlasPageSize )
+	{
+		// next shelf
+		_shelfY += _shelfHeight;
+		_shelfX = 0;
+		_shelfHeight = 0;
+	}
+	if( _pages.empty() || _shelfY + height > kGlyphAtlasPageSize )
+	{
+		// next page
+		_pages.push_back( new Page( kGlyphAtlasPageSize, kGlyphAtlasPageSize ) );
+		_shelfX = 0;
+		_shelfY = 0;
+		_shelfHeight = 0;
+	}
+	Page& page = _pages.back();
+	unsigned char* pixels = &page._pixels[_shelfY * page._width + _shelfX];
+	_shelfX += width;
+	_shelfHeight = std::max( _shelfHeight, height );
+	return boost::gil::interleaved_view( width, height, reinterpret_cast<terry::gray8_pixel_t*>( pixels ), page._width );
+}
+
+bool FontCache::FaceKey::operator<( const FaceKey& other ) const
+{
+	if( _sizeX != other._sizeX )
+		return _sizeX < other._sizeX;
+	if( _sizeY != other._sizeY )
+		return _sizeY < other._sizeY;
+	return _fontFile < other._fontFile;
+}
+
+FontCache& FontCache::instance()
+{
+	static FontCache cache;
+	return cache;
+}
+
+FontCache::FontCache()
+	: _library( NULL )
+	, _atlas( new GlyphAtlas() )
+{
+	if( FT_Init_FreeType( &_library ) )
+		_library = NULL;
+}
+
+FontCache::~FontCache()
+{
+	closeFacesLocked();
+	if( _library )
+		FT_Done_FreeType( _library );
+}
+
+std::string FontCache::findFontFile( const int font, const bool bold, const bool italic )
+{
+	const int key = font * 4 + ( bold ? 2 : 0 ) + ( italic ? 1 : 0 );
+
+	boost::mutex::scoped_lock lock( _mutex );
+	FontFileMap::const_iterator it = _fontFiles.find( key );
+	if( it != _fontFiles.end() )
+		return it->second;
+
+	std::string fontFile;
+#ifndef __WINDOWS__
+	FcInit();
+
+	FcConfig* config = FcInitLoadConfigAndFonts();
+	FcPattern* listPattern = FcPatternBuild(
+					   NULL,
+					   FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
+					   FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
+					   NULL );
+
+	FcObjectSet* os = FcObjectSetBuild( FC_FAMILY, NULL );
+	FcFontSet* fs = FcFontList( config, listPattern, os );
+
+	if( fs && font >= 0 && font < fs->nfont )
+	{
+		FcChar8* family = FcNameUnparse( fs->fonts[font] );
+
+		const int weight = bold ? FC_WEIGHT_BOLD : FC_WEIGHT_MEDIUM;
+		const int slant  = italic ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
+
+		FcPattern* p = FcPatternBuild( NULL,
+						 FC_FAMILY, FcTypeString, family,
+						 FC_WEIGHT, FcTypeInteger, weight,
+						 FC_SLANT, FcTypeInteger, slant,
+						 NULL );
+
+		FcResult result;
+		FcPattern* match = FcFontMatch( config, p, &result );
+		FcChar8* file = NULL;
+		if( match && FcPatternGetString( match, FC_FILE, 0, &file ) == FcResultMatch )
+			fontFile = reinterpret_cast<char*>( file );
+
+		if( match )
+			FcPatternDestroy( match );
+		FcPatternDestroy( p );
+		std::free( family );
+	}
+
+	if( fs )
+		FcFontSetDestroy( fs );
+	FcObjectSetDestroy( os );
+	FcPatternDestroy( listPattern );
+	FcConfigDestroy( config );
+#endif
+
+	if( fontFile.empty() )
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Text: No system font found." ) );
+
+	_fontFiles[key] = fontFile;
+	return fontFile;
+}
+
+FT_Face FontCache::getFaceLocked( const std::string& fontFile, const int sizeX, const int sizeY )
+{
+	FaceKey key;
+	key._fontFile = fontFile;
+	key._sizeX = sizeX;
+	key._sizeY = sizeY;
+
+	FaceMap::const_iterator it = _faces.find( key );
+	if( it != _faces.end() )
+		return it->second;
+
+	if( ! _library )
+		BOOST_THROW_EXCEPTION( exception::Failed()
+			<< exception::user( "Text: Unable to initialize FreeType." ) );
+
+	// animated sizes open a new face per frame
+	if( _faces.size() >= kFontCacheMaxNbFaces )
+		closeFacesLocked();
+
+	FT_Face face;
+	if( FT_New_Face( _library, fontFile.c_str(), 0, &face ) )
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Text: Unable to load the font." )
+			<< exception::filename( fontFile ) );
+	FT_Set_Pixel_Sizes( face, sizeX, sizeY );
+
+	_faces[key] = face;
+	return face;
+}
+
+void FontCache::closeFacesLocked()
+{
+	for( FaceMap::iterator it = _faces.begin(), itEnd = _faces.end(); it != itEnd; ++it )
+		FT_Done_Face( it->second );
+	_faces.clear();
+}
+
+void FontCache::layoutText( const std::string& text, const std::string& fontFile, const int sizeX, const int sizeY, TextLayout& layout )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+
+	// the texts in progress keep the previous atlas alive
+	if( _atlas->getMemorySize() > kGlyphAtlasMaxMemorySize )
+		_atlas.reset( new GlyphAtlas() );
+
+	layout._atlas = _atlas;
+	layout._glyphs.clear();
+	layout._kerning.clear();
+	layout._glyphs.reserve( text.size() );
+
+	GlyphAtlas::Key key;
+	key._fontFile = fontFile;
+	key._sizeX = sizeX;
+	key._sizeY = sizeY;
+
+	FT_Face face = text.empty() ? NULL : getFaceLocked( fontFile, sizeX, sizeY );
+	std::vector<FaceGlyph> faceGlyphs;
+	faceGlyphs.reserve( text.size() );
+	for( std::string::const_iterator it = text.begin(), itEnd = text.end(); it != itEnd; ++it )
+	{
+		key._charCode = static_cast<unsigned char>( *it );
+		const AtlasGlyph* glyph = _atlas->find( key );
+		if( ! glyph )
+		{
+			FT_Load_Glyph( face, FT_Get_Char_Index( face, *it ), FT_LOAD_DEFAULT );
+			FT_Render_Glyph( face->glyph, FT_RENDER_MODE_NORMAL );
+			glyph = &_atlas->insert( key, face->glyph );
+		}
+		layout._glyphs.push_back( glyph );
+
+		FaceGlyph faceGlyph;
+		faceGlyph.ch = *it;
+		faceGlyph.face = face;
+		faceGlyphs.push_back( faceGlyph );
+	}
+	std::transform( faceGlyphs.begin(), faceGlyphs.end(), std::back_inserter( layout._kerning ), terry::make_kerning() );
+}
+
+void FontCache::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	closeFacesLocked();
+	_fontFiles.clear();
+	_atlas.reset( new GlyphAtlas() );
+}
+
+}
+}
+}
@@ -0,0 +1,168 @@
+#ifndef _TUTTLE_PLUGIN_TEXT_FONTCACHE_HPP_
+#define _TUTTLE_PLUGIN_TEXT_FONTCACHE_HPP_
+
+#include <terry/globals.hpp>
+
+#include <boost/gil/typedefs.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+/// @brief Size of the pages of the glyph atlas (in pixels, on each side).
+static const std::ptrdiff_t kGlyphAtlasPageSize = 512;
+/// @brief Above this size (in bytes), a new atlas is started for the next texts.
+static const std::size_t kGlyphAtlasMaxMemorySize = 32 * 1024 * 1024;
+/// @brief Maximum number of opened faces (one per font file and size).
+static const std::size_t kFontCacheMaxNbFaces = 16;
+
+/**
+ * @brief A glyph rasterised in the atlas.
+ */
+struct AtlasGlyph
+{
+	FT_Glyph_Metrics _metrics;
+	int _advance; ///< horizontal advance, in pixels
+	terry::gray8c_view_t _coverage; ///< 8 bits coverage in a page of the atlas, empty for the glyphs without pixels (spaces)
+};
+
+/**
+ * @brief Glyphs rasterised by FreeType, packed in pages by rows (shelves).
+ *
+ * The glyphs are never modified nor moved after their insertion, so the
+ * render threads can read them without lock.
+ * The colour of the text is not part of the key: the atlas stores the
+ * coverage of the glyphs, the colour is applied when the glyphs are drawn.
+ */
+class GlyphAtlas : private boost::noncopyable
+{
+public:
+	struct Key
+	{
+		std::string _fontFile;
+		int _sizeX;
+		int _sizeY;
+		FT_ULong _charCode;
+
+		bool operator<( const Key& other ) const;
+	};
+
+public:
+	GlyphAtlas();
+
+	/// @return the glyph, NULL if it's not in the atlas
+	const AtlasGlyph* find( const Key& key ) const;
+
+	/// @brief Copy the glyph rendered in @p slot in the atlas.
+	const AtlasGlyph& insert( const Key& key, const FT_GlyphSlot slot );
+
+	std::size_t getNbGlyphs() const { return _glyphs.size(); }
+	/// @brief Size of the pages, in bytes.
+	std::size_t getMemorySize() const;
+
+private:
+	/// @brief Reserve a region of @p width x @p height pixels in the pages.
+	terry::gray8_view_t allocate( const std::ptrdiff_t width, const std::ptrdiff_t height );
+
+private:
+	struct Page
+	{
+		Page( const std::ptrdiff_t width, const std::ptrdiff_t height );
+
+		std::ptrdiff_t _width;
+		std::ptrdiff_t _height;
+		std::vector<unsigned char> _pixels;
+	};
+
+	boost::ptr_vector<Page> _pages;
+	std::ptrdiff_t _shelfX; ///< first free pixel of the current shelf, in the last page
+	std::ptrdiff_t _shelfY; ///< top of the current shelf, in the last page
+	std::ptrdiff_t _shelfHeight; ///< height of the current shelf
+	std::map<Key, AtlasGlyph> _glyphs; ///< the nodes are never moved
+};
+
+/**
+ * @brief Glyphs of a text, ready to be drawn.
+ */
+struct TextLayout
+{
+	boost::shared_ptr<const GlyphAtlas> _atlas; ///< keeps the glyphs alive
+	std::vector<const AtlasGlyph*> _glyphs; ///< one glyph per character of the text
+	std::vector<int> _kerning; ///< horizontal offset before each glyph, in pixels
+};
+
+/**
+ * @brief Process-wide cache of the FreeType faces and of the rasterised glyphs.
+ *
+ * The FreeType library is initialized once, the faces are opened once per
+ * font file and size, and each glyph is rasterised once in the atlas.
+ * A text constant along a sequence (timecode, shot name) only pays the draw
+ * of the glyphs on each frame.
+ *
+ * FreeType and fontconfig are not thread-safe, they are used with the lock.
+ */
+class FontCache : private boost::noncopyable
+{
+public:
+	static FontCache& instance();
+
+	~FontCache();
+
+	/**
+	 * @brief File of a system font, found by fontconfig.
+	 * @param font index of the font family in the list of the system fonts
+	 */
+	std::string findFontFile( const int font, const bool bold, const bool italic );
+
+	/**
+	 * @brief Rasterise the glyphs of @p text in the atlas, if they are not already there.
+	 * @exception exception::File if the font can't be loaded
+	 */
+	void layoutText( const std::string& text, const std::string& fontFile, const int sizeX, const int sizeY, TextLayout& layout );
+
+	/// @brief Close the faces and start a new atlas.
+	void clear();
+
+private:
+	FontCache();
+
+	/// @brief Face of a font file with a size. _mutex must be locked.
+	FT_Face getFaceLocked( const std::string& fontFile, const int sizeX, const int sizeY );
+	/// @brief _mutex must be locked.
+	void closeFacesLocked();
+
+private:
+	struct FaceKey
+	{
+		std::string _fontFile;
+		int _sizeX;
+		int _sizeY;
+
+		bool operator<( const FaceKey& other ) const;
+	};
+	typedef std::map<FaceKey, FT_Face> FaceMap;
+	typedef std::map<int, std::string> FontFileMap;
+
+	mutable boost::mutex _mutex; ///< FreeType and fontconfig calls, and the entries
+	FT_Library _library;
+	FaceMap _faces;
+	FontFileMap _fontFiles; ///< key: font index, bold and italic
+	boost::shared_ptr<GlyphAtlas> _atlas; ///< atlas of the next texts
+};
+
+}
+}
+}
+
+#endif
@@ -1,14 +1,17 @@
 #ifndef _TUTTLE_PLUGIN_TEXT_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_TEXT_PROCESS_HPP_
 
+#include "TextFontCache.hpp"
+
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 
 #include <terry/freetype/freegil.hpp>
 #include <boost/gil/typedefs.hpp>
 
-#include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace text {
@@ -23,30 +26,14 @@ class TextProcess : public ImageGilProcessor<View>
 public:
 	typedef typename View::value_type Pixel;
 	typedef terry::rgb8_pixel_t text_pixel_t;
-	struct glyph_t
-	{
-		char ch;
-		FT_Face face;
-	};
 
 	/**
-	 * to be used with boost::ptr_container
+	 * @brief A glyph of the text, and its region in _dstViewForGlyphs.
 	 */
-	struct make_glyph
+	struct PlacedGlyph
 	{
-		FT_Face _face;
-
-		make_glyph( FT_Face face ) : _face( face ) {}
-
-		glyph_t* operator()( char ch )
-		{
-			glyph_t* u = new glyph_t();
-
-			u->ch   = ch;
-			u->face = _face;
-			return u;
-		}
-
+		const AtlasGlyph* _glyph;
+		OfxRectI _rod;
 	};
 
 protected:
@@ -57,9 +44,8 @@ protected:
 	View                          _srcView;       ///< @brief source clip (filters have only one input)
 	
 	TextPlugin&                   _plugin;        ///< Rendering plugin
-	std::vector<FT_Glyph_Metrics> _metrics;
-	std::vector<int>              _kerning;
-	boost::ptr_vector<glyph_t>    _glyphs;
+	TextLayout                    _layout;        ///< rasterised glyphs, shared by the frames
+	std::vector<PlacedGlyph>      _placedGlyphs;
 	View                          _dstViewForGlyphs;
 	boost::gil::point2<int>       _textCorner;
 	boost::gil::point2<int>       _textSize;
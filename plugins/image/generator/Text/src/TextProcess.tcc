@@ -14,16 +14,12 @@
 #include <boost/gil/gil_all.hpp>
 
 #include <boost/filesystem.hpp>
-#include <boost/ptr_container/ptr_inserter.hpp>
+#include <boost/foreach.hpp>
 
 #include <sstream>
 #include <string>
 #include <iostream>
 
-#ifndef __WINDOWS__
-#include <fontconfig/fontconfig.h>
-#endif
-
 namespace tuttle {
 namespace plugin {
 namespace text {
@@ -35,7 +31,6 @@ TextProcess<View, Functor>::TextProcess( TextPlugin& instance )
 {
 //	Py_Initialize();
 	_clipSrc = instance.fetchClip( kOfxImageEffectSimpleSourceClipName );
-	this->setNoMultiThreading();
 }
 
 template<class View, class Functor>
@@ -72,24 +67,15 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	
 	_text = _params._text;
 	
-	//Step 1. Create terry image
-	//Step 2. Initialize freetype
-	//Step 3. Make Glyphs Array
-	//Step 4. Make Metrics Array
-	//Step 5. Make Kerning Array
-	//Step 6. Get Coordinates (x,y)
-	//Step 7. Render Glyphs on GIL View
-	//Step 8. Save GIL Image
-
-	//Step 1. Create terry image -----------
-
-	//Step 2. Initialize freetype ---------------
-	FT_Library library;
-	FT_Init_FreeType( &library );
+	//Step 1. Find the font file
+	//Step 2. Get the glyphs from the atlas (rasterised at the first use)
+	//Step 3. Make Metrics Array
+	//Step 4. Get Coordinates (x,y)
+	//Step 5. Place the glyphs
+	//Step 6. Render Glyphs on GIL View, in parallel by rows
 
-	FT_Face face;
-
-	std::string selectedFont = "";
+	//Step 1. Find the font file ---------------
+	std::string selectedFont;
 
 	if( !boost::filesystem::exists( _params._fontPath ) || boost::filesystem::is_directory( _params._fontPath ) )
 	{
@@ -98,64 +84,34 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 							<< exception::user( "Text: Error in Font Path." )
 							<< exception::filename( _params._fontPath ) );
 #else
-		FcInit();
-
-		FcChar8 *file;
-		FcResult result;
-		FcConfig *config = FcInitLoadConfigAndFonts();
-		FcPattern *p = FcPatternBuild(
-						   NULL,
-						   FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
-						   FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
-						   NULL );
-
-		FcObjectSet *os = FcObjectSetBuild( FC_FAMILY, NULL );
-		FcFontSet   *fs = FcFontList( config, p, os );
-
-		selectedFont = (char*) FcNameUnparse( fs->fonts[_params._font] );
-
-		int weight = ( _params._bold   == 1) ? FC_WEIGHT_BOLD  : FC_WEIGHT_MEDIUM;
-		int slant  = ( _params._italic == 1) ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
-
-		p  = FcPatternBuild( NULL,
-							 FC_FAMILY, FcTypeString, selectedFont.c_str(),
-							 FC_WEIGHT, FcTypeInteger, weight,
-							 FC_SLANT, FcTypeInteger, slant,
-							 NULL );
-
-		FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FAMILY, 0, &file );
-		FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FILE, 0, &file );
-		selectedFont = (char*) file;
+		selectedFont = FontCache::instance().findFontFile( _params._font, _params._bold, _params._italic );
 #endif
 	}
 	else
 	{
 		selectedFont = _params._fontPath;
 	}
-	FT_New_Face( library, selectedFont.c_str(), 0, &face );
-	
-	FT_Set_Pixel_Sizes( face, _params._fontX, _params._fontY );	
 
-	//Step 3. Make Glyphs Array ------------------
+	//Step 2. Get the glyphs from the atlas ------------------
 	rgba32f_pixel_t rgba32f_foregroundColor( _params._fontColor.r,
 											 _params._fontColor.g,
 											 _params._fontColor.b,
 											 _params._fontColor.a );
 	color_convert( rgba32f_foregroundColor, _foregroundColor );
-	std::transform( _text.begin(), _text.end(), boost::ptr_container::ptr_back_inserter( _glyphs ), make_glyph( face ) );
+	FontCache::instance().layoutText( _text, selectedFont, _params._fontX, _params._fontY, _layout );
 
-	//Step 4. Make Metrics Array --------------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _metrics ), terry::make_metric() );
+	//Step 3. Make Metrics Array --------------------
+	std::vector<FT_Glyph_Metrics> metrics;
+	metrics.reserve( _layout._glyphs.size() );
+	for( std::size_t i = 0; i < _layout._glyphs.size(); ++i )
+		metrics.push_back( _layout._glyphs[i]->_metrics );
 
-	//Step 5. Make Kerning Array ----------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _kerning ), terry::make_kerning() );
+	//Step 4. Get Coordinates (x,y) ----------------
+	_textSize.x   = std::for_each( metrics.begin(), metrics.end(), _layout._kerning.begin(), terry::make_width() );
+	_textSize.y   = std::for_each( metrics.begin(), metrics.end(), terry::make_height() );
 
-	//Step 6. Get Coordinates (x,y) ----------------
-	_textSize.x   = std::for_each( _metrics.begin(), _metrics.end(), _kerning.begin(), terry::make_width() );
-	_textSize.y   = std::for_each( _metrics.begin(), _metrics.end(), terry::make_height() );
-
-	if( _metrics.size() > 1 )
-		_textSize.x   += _params._letterSpacing * (_metrics.size() - 1);
+	if( metrics.size() > 1 )
+		_textSize.x   += _params._letterSpacing * (metrics.size() - 1);
 
 	switch( _params._vAlign )
 	{
@@ -206,6 +162,27 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 	}
 	
 	_textCorner.x += _params._position.x;
+
+	//Step 5. Place the glyphs ----------------
+	_placedGlyphs.clear();
+	_placedGlyphs.reserve( _layout._glyphs.size() );
+	int x = 0;
+	for( std::size_t i = 0; i < _layout._glyphs.size(); ++i )
+	{
+		const AtlasGlyph& glyph = *_layout._glyphs[i];
+		x += _layout._kerning[i];
+
+		PlacedGlyph placed;
+		placed._glyph = &glyph;
+		placed._rod.x1 = _textCorner.x + x;
+		placed._rod.y1 = _textCorner.y + _textSize.y - ( glyph._metrics.horiBearingY >> 6 );
+		placed._rod.x2 = placed._rod.x1 + glyph._coverage.width();
+		placed._rod.y2 = placed._rod.y1 + glyph._coverage.height();
+		_placedGlyphs.push_back( placed );
+
+		x += glyph._advance;
+		x += _params._letterSpacing;
+	}
 }
 
 /**
@@ -221,38 +198,46 @@ void TextProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& procW
 									 _params._backgroundColor.g,
 									 _params._backgroundColor.b,
 									 _params._backgroundColor.a );
-	fill_pixels( this->_dstView, backgroundColor );
-	
-	OfxRectI procWindowOutput = translateRegion( procWindowRoW, this->_dstPixelRod );
+
+	const OfxRectI procWindowOutput = translateRegion( procWindowRoW, this->_dstPixelRod );
+	const OfxPointI procWindowSize = { procWindowOutput.x2 - procWindowOutput.x1, procWindowOutput.y2 - procWindowOutput.y1 };
+	View dstProcView = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y );
+
+	fill_pixels( dstProcView, backgroundColor );
 
 	if( _clipSrc->isConnected() )
 	{
-		//merge_views( this->_dstView, _srcView, this->_dstView, FunctorMatte<Pixel>() );
-		merge_views( this->_dstView, _srcView, this->_dstView, Functor() );
+		View srcProcView = subimage_view( _srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y );
+		//merge_views( dstProcView, srcProcView, dstProcView, FunctorMatte<Pixel>() );
+		merge_views( dstProcView, srcProcView, dstProcView, Functor() );
 	}
 	
-	//Step 7. Render Glyphs ------------------------
-	// if outside dstRod
-	// ...
-	// else
+	//Step 6. Render Glyphs ------------------------
+	// rows of the processing window in _dstViewForGlyphs
+	OfxRectI procWindowGlyphs = procWindowOutput;
+	if( _params._verticalFlip )
+	{
+		procWindowGlyphs.y1 = this->_dstView.height() - procWindowOutput.y2;
+		procWindowGlyphs.y2 = this->_dstView.height() - procWindowOutput.y1;
+	}
 	const OfxRectI textRod = { _textCorner.x, _textCorner.y, _textCorner.x + _textSize.x, _textCorner.y + _textSize.y + _textSize.y / 3};
-	const OfxRectI textRoi = rectanglesIntersection( textRod, procWindowOutput );
-	const OfxRectI textLocalRoi = translateRegion( textRoi, - _textCorner );
-	
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, _textSize );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, _textCorner );
-	
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textRod );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, procWindowRoW );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textRoi );
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, textLocalRoi );
-	//TUTTLE_LOG_VAR2( TUTTLE_INFO, _dstViewForGlyphs.width(), _dstViewForGlyphs.height() );
-	
-	View tmpDstViewForGlyphs = subimage_view( _dstViewForGlyphs, _textCorner.x, _textCorner.y, _textSize.x, _textSize.y);
-	
-	std::for_each( _glyphs.begin(), _glyphs.end(), _kerning.begin(),
-	               render_glyph<View>( tmpDstViewForGlyphs, _foregroundColor, _params._letterSpacing, Rect<std::ptrdiff_t>(textLocalRoi) )
-	               );
+	const OfxRectI textRoi = rectanglesIntersection( textRod, procWindowGlyphs );
+
+	BOOST_FOREACH( const PlacedGlyph& placed, _placedGlyphs )
+	{
+		const OfxRectI glyphRoi = rectanglesIntersection( placed._rod, textRoi );
+		if( glyphRoi.x2 == glyphRoi.x1 || glyphRoi.y2 == glyphRoi.y1 )
+			continue;
+
+		const gray8c_view_t coverageRoi = subimage_view( placed._glyph->_coverage,
+			glyphRoi.x1 - placed._rod.x1, glyphRoi.y1 - placed._rod.y1,
+			glyphRoi.x2 - glyphRoi.x1, glyphRoi.y2 - glyphRoi.y1 );
+		const View dstRoi = subimage_view( _dstViewForGlyphs,
+			glyphRoi.x1, glyphRoi.y1,
+			glyphRoi.x2 - glyphRoi.x1, glyphRoi.y2 - glyphRoi.y1 );
+
+		copy_and_convert_alpha_blended_pixels( color_converted_view<gray32f_pixel_t>( coverageRoi ), _foregroundColor, dstRoi );
+	}
 }
 
 }
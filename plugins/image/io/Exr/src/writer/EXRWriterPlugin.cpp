@@ -30,6 +30,8 @@ EXRWriterProcessParams EXRWriterPlugin::getProcessParams( const OfxTime time )
 	params._componentsType = ( ETuttlePluginComponents ) _paramComponentsType->getValue();
 	params._storageType = ( EParamStorage ) _paramStorageType->getValue();
 	params._compression = (EParamCompression) _paramCompression->getValue();
+	params._srcComponents = _clipSrc->getPixelComponents();
+	params._srcPixelAspectRatio = _clipSrc->getPixelAspectRatio();
 
 	return params;
 }
@@ -42,7 +44,7 @@ void EXRWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<EXRWriterProcess>( *this, args );
+	doGilRender<WriteBehind<EXRWriterProcess>::Processor>( *this, args );
 }
 
 }
@@ -16,6 +16,8 @@ struct EXRWriterProcessParams
 	ETuttlePluginComponents _componentsType;
 	EParamStorage _storageType;
 	EParamCompression _compression;
+	OFX::EPixelComponent _srcComponents; ///< components of the source clip, read during the render action
+	double _srcPixelAspectRatio; ///< pixel aspect ratio of the source clip, read during the render action
 };
 
 /**
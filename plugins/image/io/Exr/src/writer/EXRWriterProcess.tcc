@@ -60,7 +60,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( _params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16h_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -105,7 +105,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( _params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32f_pixel_t>( src, _params._filepath, Imf::FLOAT );
@@ -150,7 +150,7 @@ void EXRWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( _params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32_pixel_t>( src, _params._filepath, Imf::HALF );
@@ -276,7 +276,7 @@ void EXRWriterProcess<View>::writeImage( View& src, std::string& filepath, Imf::
 	image_t img( src.width(), src.height() );
 	view_t  dvw( view( img ) );
 	boost::gil::copy_and_convert_pixels( src, dvw );
-	Imf::Header header( src.width(), src.height(), (float) _plugin._clipSrc->getPixelAspectRatio() );
+	Imf::Header header( src.width(), src.height(), (float) _params._srcPixelAspectRatio );
 
 	switch( _params._compression )
 	{
@@ -34,7 +34,7 @@ void JpegWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<JpegWriterProcess>( *this, args );
+	doGilRender<WriteBehind<JpegWriterProcess>::Processor>( *this, args );
 }
 
 }
@@ -129,6 +129,8 @@ void Jpeg2000ReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipP
  */
 void Jpeg2000ReaderPlugin::render( const OFX::RenderArguments &args )
 {
+	ReaderPlugin::render( args );
+
 	if( retrieveFileInfo(args.time)._failed )
 	{
 		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch()
@@ -255,10 +255,9 @@ void InputBufferPlugin::callbackMode_updateImage( const OfxTime time, const Inpu
  */
 void InputBufferPlugin::render( const OFX::RenderArguments &args )
 {
-	// @todo: add an OpenFX extension to setup the image buffer pointer
-	//        from the plugin.
-	// If the host supports this extension, we only need to set the pointer,
-	// else we need to do a buffer copy.
+	// The TuttleOFX host could use the input buffer as output image
+	// (InputBufferWrapper::setBorrowedRawImageBuffer), so there is nothing to copy.
+	// Other hosts need a buffer copy.
 
 	// User parameters
 	InputBufferProcessParams params = getProcessParams( args.time );
@@ -330,23 +329,25 @@ void InputBufferPlugin::render( const OFX::RenderArguments &args )
 //		TUTTLE_TLOG_VAR( TUTTLE_INFO, dstPixelRodSize.y );
 //		TUTTLE_TLOG_VAR( TUTTLE_INFO, rowBytesDistanceSize );
 //		TUTTLE_TLOG_VAR( TUTTLE_INFO, widthBytesSize );
-		switch( params._orientation )
+		// address of the row y of the image (from bottom to top) in the input buffer
+		unsigned char* inputRow0 = inputImageBufferPtr;
+		int inputRowDistance = rowBytesDistanceSize;
+		if( params._orientation == eParamOrientationFromTopToBottom )
 		{
-			case eParamOrientationFromBottomToTop:
-			{
-				for( int y = 0; y < dstPixelRodSize.y; ++y )
-				{
-					memcpy( dst->getPixelAddress( 0, y ), inputImageBufferPtr + y * rowBytesDistanceSize, widthBytesSize );
-				}
-				break;
-			}
-			case eParamOrientationFromTopToBottom:
+			inputRow0 = inputImageBufferPtr + ( dstPixelRodSize.y - 1 ) * rowBytesDistanceSize;
+			inputRowDistance = -rowBytesDistanceSize;
+		}
+
+		// The host may use the input buffer as output image (zero-copy import),
+		// in this case the image is already in place.
+		const bool inPlace = dstPixelRodSize.y > 0 &&
+			dst->getPixelAddress( 0, 0 ) == inputRow0 &&
+			dst->getPixelAddress( 0, dstPixelRodSize.y - 1 ) == inputRow0 + ( dstPixelRodSize.y - 1 ) * inputRowDistance;
+		if( ! inPlace )
+		{
+			for( int y = 0; y < dstPixelRodSize.y; ++y )
 			{
-				for( int y = 0; y < dstPixelRodSize.y; ++y )
-				{
-					memcpy( dst->getPixelAddress( 0, y ), inputImageBufferPtr + (dstPixelRodSize.y-y) * rowBytesDistanceSize, widthBytesSize );
-				}
-				break;
+				memcpy( dst->getPixelAddress( 0, y ), inputRow0 + y * inputRowDistance, widthBytesSize );
 			}
 		}
 		
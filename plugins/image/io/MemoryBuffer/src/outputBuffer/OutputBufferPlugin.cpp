@@ -84,7 +84,9 @@ void OutputBufferPlugin::render( const OFX::RenderArguments& args )
 		{
 			void* dataSrcPtr = src->getPixelAddress( bounds.x1, bounds.y1 );
 			void* dataDstPtr = dst->getPixelAddress( bounds.x1, bounds.y1 );
-			memcpy( dataDstPtr, dataSrcPtr, imageDataBytes );
+			// the host may share the source buffer with the output image (OutputBufferWrapper::setShareSourceBuffer)
+			if( dataDstPtr != dataSrcPtr )
+				memcpy( dataDstPtr, dataSrcPtr, imageDataBytes );
 			
 			// No image copy
 			rawImagePtrLink = (char *)dataDstPtr;
@@ -97,7 +99,8 @@ void OutputBufferPlugin::render( const OFX::RenderArguments& args )
 		{
 			void* dataSrcPtr = src->getPixelAddress( bounds.x1, y );
 			void* dataDstPtr = dst->getPixelAddress( bounds.x1, y );
-			memcpy( dataDstPtr, dataSrcPtr, rowBytesToCopy );
+			if( dataDstPtr != dataSrcPtr )
+				memcpy( dataDstPtr, dataSrcPtr, rowBytesToCopy );
 		}
 		if( params._callbackPtr != NULL )
 		{
@@ -28,6 +28,8 @@ OpenImageIOWriterProcessParams OpenImageIOWriterPlugin::getProcessParams( const
 	params._quality     = _quality->getValue();
 	params._orientation = static_cast<int>( _orientation->getValue() );
 	params._premultiply = this->_paramPremult->getValue();
+	params._srcComponents = this->_clipSrc->getPixelComponents();
+	params._srcBitDepth = this->_clipSrc->getPixelDepth();
 	return params;
 }
 
@@ -39,7 +41,7 @@ void OpenImageIOWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<OpenImageIOWriterProcess>( *this, args );
+	doGilRender<WriteBehind<OpenImageIOWriterProcess>::Processor>( *this, args );
 }
 
 }
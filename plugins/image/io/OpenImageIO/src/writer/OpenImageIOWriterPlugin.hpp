@@ -21,6 +21,8 @@ struct OpenImageIOWriterProcessParams
 	bool                    _premultiply;        ///< Output premultiply
 	int                     _quality;            ///< Output quality
 	int                     _orientation;        ///< Output orientation
+	OFX::EPixelComponent    _srcComponents;      ///< components of the source clip, read during the render action
+	OFX::EBitDepth          _srcBitDepth;        ///< bit depth of the source clip, read during the render action
 };
 
 /**
@@ -31,6 +31,14 @@ OpenImageIOWriterProcess<View>::OpenImageIOWriterProcess( OpenImageIOWriterPlugi
 	this->setNoMultiThreading();
 }
 
+template<class View>
+void OpenImageIOWriterProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilFilterProcessor<View>::setup( args );
+
+	params = _plugin.getProcessParams( args.time );
+}
+
 /**
  * Deduce the best bitdepth when it hasn't been set by the user
  */
@@ -68,7 +76,6 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 	BOOST_ASSERT( procWindowRoW == this->_srcPixelRod );
 	using namespace boost::gil;
 	using namespace terry;
-	params = _plugin.getProcessParams( this->_renderArgs.time );
 
 	ETuttlePluginBitDepth finalBitDepth = getDefaultBitDepth(params._filepath,params._bitDepth);
 
@@ -82,7 +89,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				std::string ext = p.extension().string();
 				if( ext == ".cin" )
 				{
-					switch ( _plugin._clipSrc->getPixelComponents() )
+					switch ( params._srcComponents )
 					{
 						case OFX::ePixelComponentAlpha:
 							writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth10 );
@@ -122,7 +129,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				}
 				if( ext == ".tif" || ext == ".tiff" )
 				{
-					switch ( _plugin._clipSrc->getPixelComponents() )
+					switch ( params._srcComponents )
 					{
 						case OFX::ePixelComponentAlpha:
 							writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth16 );
@@ -141,7 +148,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 					break;
 				}
 				
-				switch( _plugin._clipSrc->getPixelDepth() )
+				switch( params._srcBitDepth )
 				{
 					case OFX::eBitDepthUByte:
 					{
@@ -149,7 +156,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( params._srcComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray8_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth8 );
@@ -185,7 +192,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( params._srcComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray16_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth16 );
@@ -222,7 +229,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 						{
 							case eTuttlePluginComponentsAuto:
 							{
-								switch ( _plugin._clipSrc->getPixelComponents() )
+								switch ( params._srcComponents )
 								{
 									case OFX::ePixelComponentAlpha:
 										writeImage<gray32f_image_t>( this->_srcView, params._filepath, eTuttlePluginBitDepth32f );
@@ -266,7 +273,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray8_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -304,7 +311,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -340,7 +347,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray16h_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -376,7 +383,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -412,7 +419,7 @@ void OpenImageIOWriterProcess<View>::multiThreadProcessImages( const OfxRectI& p
 				{
 					case eTuttlePluginComponentsAuto:
 					{
-						switch ( _plugin._clipSrc->getPixelComponents() )
+						switch ( params._srcComponents )
 						{
 							case OFX::ePixelComponentAlpha:
 								writeImage<gray32f_image_t>( this->_srcView, params._filepath, params._bitDepth );
@@ -547,13 +554,17 @@ void OpenImageIOWriterProcess<View>::writeImage( View& src, const std::string& f
 
 	typedef typename boost::gil::channel_type<WImage>::type channel_t;
 
+	// the host progress suite is only available during the render action,
+	// not when the file is written in background
+	const ProgressCallback progress = this->isDetached() ? NULL : &progressCallback;
+
 	out->write_image(
 			oiioBitDepth,
 			&( ( *vw.begin() )[0] ),// get the adress of the first channel value from the first pixel
 			xstride,
 			ystride,
 			zstride,
-			&progressCallback,
+			progress,
 			this
 		);
 
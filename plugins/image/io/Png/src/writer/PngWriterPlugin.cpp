@@ -25,6 +25,7 @@ PngWriterProcessParams PngWriterPlugin::getProcessParams( const OfxTime time )
 	params._filepath   = getAbsoluteFilenameAt( time );
 	params._components = static_cast<ETuttlePluginComponents>( this->_paramOutputComponents->getValue() );
 	params._bitDepth   = static_cast<ETuttlePluginBitDepth>( this->_paramBitDepth->getValue() );
+	params._srcComponents = this->_clipSrc->getPixelComponents();
 
 	return params;
 }
@@ -37,7 +38,7 @@ void PngWriterPlugin::render( const OFX::RenderArguments& args )
 {
 	WriterPlugin::render( args );
 
-	doGilRender<PngWriterProcess>( *this, args );
+	doGilRender<WriteBehind<PngWriterProcess>::Processor>( *this, args );
 }
 
 }
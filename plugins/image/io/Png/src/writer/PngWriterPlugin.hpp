@@ -14,6 +14,7 @@ struct PngWriterProcessParams
 	std::string             _filepath;   ///< filepath
 	ETuttlePluginComponents _components; ///< output components
 	ETuttlePluginBitDepth   _bitDepth;   ///< Output bit depth
+	OFX::EPixelComponent    _srcComponents; ///< components of the source clip, read during the render action
 };
 
 /**
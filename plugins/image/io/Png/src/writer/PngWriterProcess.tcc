@@ -84,7 +84,7 @@ void PngWriterProcess<View>::writeImage( View& src )
 	{
 		case eTuttlePluginComponentsAuto:
 		{
-			switch ( _plugin._clipSrc->getPixelComponents() )
+			switch ( _params._srcComponents )
 			{
 				case OFX::ePixelComponentAlpha:
 				{
@@ -10,6 +10,17 @@ namespace lut {
 static const std::string kHelp      = "help";
 static const std::string kInputFilenameLabel = "3D Lut input filename";
 
+static const std::string kParamInterpolation             = "interpolation";
+static const std::string kParamInterpolationLabel        = "Interpolation";
+static const std::string kParamInterpolationTetrahedral  = "tetrahedral";
+static const std::string kParamInterpolationTrilinear    = "trilinear";
+
+enum EParamInterpolation
+{
+	eParamInterpolationTetrahedral = 0,
+	eParamInterpolationTrilinear
+};
+
 }
 }
 }
@@ -6,6 +6,8 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem.hpp>
 
+#include <cmath>
+
 namespace bfs = boost::filesystem;
 
 namespace tuttle {
@@ -18,6 +20,35 @@ LutPlugin::LutPlugin( OfxImageEffectHandle handle )
 	: ImageEffectGilPlugin( handle )
 {
 	_sFilename = fetchStringParam( kTuttlePluginFilename );
+	_paramInterpolation = fetchChoiceParam( kParamInterpolation );
+}
+
+void LutPlugin::resetLut()
+{
+	const LutReader::VectorDouble& steps = _lutReader.steps();
+	const std::size_t dimSize = steps.size();
+	if( dimSize < 2 || _lutReader.data().size() != dimSize * dimSize * dimSize * 3 )
+	{
+		_lut3D.clear();
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Wrong number of values in the lut file." ) );
+	}
+	_lut3D.reset( dimSize, &_lutReader.data()[0] );
+
+	// The engine considers the input steps as uniform,
+	// the non uniform steps are converted by a shaper.
+	const double last = steps.back();
+	bool uniform = steps.front() == 0;
+	for( std::size_t i = 0; i < dimSize && uniform; ++i )
+	{
+		uniform = std::abs( steps[i] - i * last / ( dimSize - 1 ) ) <= 1.0;
+	}
+	if( ! uniform )
+	{
+		// the input values are integers on a number of bits
+		const double inputMax = std::pow( 2.0, std::ceil( std::log( last + 1.0 ) / std::log( 2.0 ) ) ) - 1.0;
+		_lut3D.shaper().reset( &steps[0], dimSize, inputMax );
+	}
 }
 
 /**
@@ -40,9 +71,9 @@ void LutPlugin::render( const OFX::RenderArguments& args )
 			BOOST_THROW_EXCEPTION( exception::File()
 				<< exception::user( "Unable to read lut file." ) );
 		}
-		_lut3D.reset( new TetraInterpolator(), _lutReader );
+		resetLut();
 	}
-	if( !_lutReader.readOk() )
+	if( !_lutReader.readOk() || _lut3D.empty() )
 	{
 		BOOST_THROW_EXCEPTION( exception::Unknown() );
 	}
@@ -61,7 +92,7 @@ void LutPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::s
 			{
 				BOOST_THROW_EXCEPTION( exception::File() << exception::user( "Unable to read lut file..." ) );
 			}
-			_lut3D.reset( new TetraInterpolator(), _lutReader );
+			resetLut();
 		}
 	}
 }
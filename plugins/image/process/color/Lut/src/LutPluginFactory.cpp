@@ -59,6 +59,12 @@ void LutPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc, OFX:
 	filename->setDefault( "" );
 	filename->setLabels( kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel );
 	filename->setStringType( OFX::eStringTypeFilePath );
+
+	OFX::ChoiceParamDescriptor* interpolation = desc.defineChoiceParam( kParamInterpolation );
+	interpolation->setLabel( kParamInterpolationLabel );
+	interpolation->appendOption( kParamInterpolationTetrahedral );
+	interpolation->appendOption( kParamInterpolationTrilinear );
+	interpolation->setDefault( eParamInterpolationTetrahedral );
 }
 
 /**
@@ -2,8 +2,8 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "LutDefinitions.hpp"
+#include "lutEngine/FloatLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
@@ -25,15 +25,19 @@ template<class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
 private:
-	Lut3D* _lut3D;               ///< Lut3D
+	const FloatLut3D& _lut3D;   ///< Lut3D
 	LutPlugin&  _plugin;        ///< Rendering plugin
+	EParamInterpolation _interpolation;
 
 public:
 	LutProcess<View>( LutPlugin & instance );
 
+	void setup( const OFX::RenderArguments& args );
+
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	// Lut3D Transform
+	template<class Interpolation>
 	void applyLut( View& dst, View& src, const OfxRectI& procWindow );
 };
 
@@ -4,9 +4,7 @@
 
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
-#include "lutEngine/TetraInterpolator.hpp"
+#include "lutEngine/FloatLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -19,6 +17,9 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace lut {
@@ -28,9 +29,16 @@ using namespace boost::filesystem;
 template<class View>
 LutProcess<View>::LutProcess( LutPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationIndependant )
+	, _lut3D( instance._lut3D )
 	, _plugin( instance )
+	, _interpolation( eParamInterpolationTetrahedral )
+{}
+
+template<class View>
+void LutProcess<View>::setup( const OFX::RenderArguments& args )
 {
-	_lut3D = &_plugin._lut3D;
+	ImageGilFilterProcessor<View>::setup( args );
+	_interpolation = static_cast<EParamInterpolation>( _plugin._paramInterpolation->getValue() );
 }
 
 /**
@@ -42,33 +50,55 @@ void LutProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 
-	applyLut( this->_dstView, this->_srcView, procWindowOutput );
+	switch( _interpolation )
+	{
+		case eParamInterpolationTetrahedral:
+			applyLut<TetrahedralInterpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			break;
+		case eParamInterpolationTrilinear:
+			applyLut<TrilinearInterpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			break;
+	}
 }
 
+/**
+ * @brief Apply the LUT row by row: the pixels of a row are converted
+ * to float RGB, transformed, and converted back.
+ */
 template<class View>
+template<class Interpolation>
 void LutProcess<View>::applyLut( View& dst, View& src, const OfxRectI& procWindow )
 {
 	using namespace terry;
 	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
+	typedef typename channel_type<View>::type Channel;
 	const OfxPointI procWindowSize = {
 		procWindow.x2 - procWindow.x1,
 		procWindow.y2 - procWindow.y1 };
+	// a gray image is transformed as a gray RGB color
+	const int nbColorChannels = std::min( int( num_channels<View>::value ), 3 );
 
+	std::vector<float> row( procWindowSize.x * 3 );
 	for( int y = procWindow.y1; y < procWindow.y2; ++y )
 	{
-		vIterator sit = src.row_begin( y );
-		vIterator dit = dst.row_begin( y );
-		for( int x = procWindow.x1; x < procWindow.x2; ++x )
+		vIterator sit = src.row_begin( y ) + procWindow.x1;
+		std::vector<float>::iterator rowIt = row.begin();
+		for( int x = 0; x < procWindowSize.x; ++x, ++sit )
+		{
+			for( int c = 0; c < 3; ++c, ++rowIt )
+				*rowIt = channel_convert<bits32f>( ( *sit )[ std::min( c, nbColorChannels - 1 ) ] );
+		}
+
+		_lut3D.template transform<Interpolation>( &row[0], &row[0], procWindowSize.x );
+
+		vIterator dit = dst.row_begin( y ) + procWindow.x1;
+		rowIt = row.begin();
+		for( int x = 0; x < procWindowSize.x; ++x, ++dit, rowIt += 3 )
 		{
-			tuttle::Color col = _lut3D->getColor( ( *sit )[0], ( *sit )[1], ( *sit )[2] );
-			( *dit )[0] = static_cast<Pixel>( col.x );
-			( *dit )[1] = static_cast<Pixel>( col.y );
-			( *dit )[2] = static_cast<Pixel>( col.z );
-			if( dst.num_channels() > 3 )
-				( *dit )[3] = channel_traits< typename channel_type< View >::type >::max_value();
-			++sit;
-			++dit;
+			for( int c = 0; c < nbColorChannels; ++c )
+				( *dit )[c] = channel_convert<Channel>( bits32f( rowIt[c] ) );
+			if( num_channels<View>::value > 3 )
+				( *dit )[3] = channel_traits<Channel>::max_value();
 		}
 		if( this->progressForward( procWindowSize.x ) )
 			return;
@@ -0,0 +1,335 @@
+#ifndef _LUTENGINE_FLOATLUT3D_HPP_
+#define _LUTENGINE_FLOATLUT3D_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+ #define TUTTLE_LUT_USE_SSE
+ #include <xmmintrin.h>
+#endif
+
+namespace tuttle {
+
+namespace lutDetails {
+
+inline float clamp01( const float v )
+{
+	// NaN gives 0
+	return std::max( 0.0f, std::min( v, 1.0f ) );
+}
+
+/**
+ * @brief Position of a value in the lattice.
+ * @param[out] index first node of the cell
+ * @param[out] frac position inside the cell [0,1]
+ */
+inline void cellPosition( const float v, const std::size_t dimSize, std::size_t& index, float& frac )
+{
+	const float pos = clamp01( v ) * ( dimSize - 1 );
+	index = std::min( static_cast<std::size_t>( pos ), dimSize - 2 );
+	frac = pos - index;
+}
+
+#ifdef TUTTLE_LUT_USE_SSE
+
+/// @brief RGB of a lattice node in a vector register (the 4th value is a padding)
+struct Node
+{
+	__m128 _v;
+
+	Node() {}
+	explicit Node( const __m128 v ) : _v( v ) {}
+	explicit Node( const float* p ) : _v( _mm_loadu_ps( p ) ) {}
+
+	Node operator+( const Node& n ) const { return Node( _mm_add_ps( _v, n._v ) ); }
+	Node operator-( const Node& n ) const { return Node( _mm_sub_ps( _v, n._v ) ); }
+	Node operator*( const float s ) const { return Node( _mm_mul_ps( _v, _mm_set1_ps( s ) ) ); }
+
+	void store( float* rgb ) const
+	{
+		float tmp[4];
+		_mm_storeu_ps( tmp, _v );
+		rgb[0] = tmp[0];
+		rgb[1] = tmp[1];
+		rgb[2] = tmp[2];
+	}
+};
+
+#else
+
+struct Node
+{
+	float _v[3];
+
+	Node() {}
+	explicit Node( const float* p ) { _v[0] = p[0]; _v[1] = p[1]; _v[2] = p[2]; }
+	Node( const float r, const float g, const float b ) { _v[0] = r; _v[1] = g; _v[2] = b; }
+
+	Node operator+( const Node& n ) const { return Node( _v[0] + n._v[0], _v[1] + n._v[1], _v[2] + n._v[2] ); }
+	Node operator-( const Node& n ) const { return Node( _v[0] - n._v[0], _v[1] - n._v[1], _v[2] - n._v[2] ); }
+	Node operator*( const float s ) const { return Node( _v[0] * s, _v[1] * s, _v[2] * s ); }
+
+	void store( float* rgb ) const
+	{
+		rgb[0] = _v[0];
+		rgb[1] = _v[1];
+		rgb[2] = _v[2];
+	}
+};
+
+#endif
+
+/// @brief Cell of the lattice containing a color.
+struct Cell
+{
+	const float* _p000; ///< first node of the cell
+	std::size_t _strideX, _strideY, _strideZ; ///< offsets to the next node along each axis
+	float _dx, _dy, _dz; ///< position inside the cell
+
+	Node node( const bool x, const bool y, const bool z ) const
+	{
+		return Node( _p000 + ( x ? _strideX : 0 ) + ( y ? _strideY : 0 ) + ( z ? _strideZ : 0 ) );
+	}
+};
+
+}
+
+/**
+ * @brief Tetrahedral interpolation, the same tetrahedra as TetraInterpolator.
+ */
+struct TetrahedralInterpolation
+{
+	static lutDetails::Node interpolate( const lutDetails::Cell& cell )
+	{
+		using lutDetails::Node;
+		const float dx = cell._dx;
+		const float dy = cell._dy;
+		const float dz = cell._dz;
+		const Node p000 = cell.node( 0, 0, 0 );
+		const Node p111 = cell.node( 1, 1, 1 );
+
+		if( dx >= dy && dy >= dz ) // T1
+		{
+			const Node p100 = cell.node( 1, 0, 0 );
+			const Node p110 = cell.node( 1, 1, 0 );
+			return p000 + ( p100 - p000 ) * dx + ( p110 - p100 ) * dy + ( p111 - p110 ) * dz;
+		}
+		else if( dx >= dz && dz >= dy ) // T2
+		{
+			const Node p100 = cell.node( 1, 0, 0 );
+			const Node p101 = cell.node( 1, 0, 1 );
+			return p000 + ( p100 - p000 ) * dx + ( p111 - p101 ) * dy + ( p101 - p100 ) * dz;
+		}
+		else if( dz >= dx && dx >= dy ) // T3
+		{
+			const Node p001 = cell.node( 0, 0, 1 );
+			const Node p101 = cell.node( 1, 0, 1 );
+			return p000 + ( p101 - p001 ) * dx + ( p111 - p101 ) * dy + ( p001 - p000 ) * dz;
+		}
+		else if( dy >= dx && dx >= dz ) // T4
+		{
+			const Node p010 = cell.node( 0, 1, 0 );
+			const Node p110 = cell.node( 1, 1, 0 );
+			return p000 + ( p110 - p010 ) * dx + ( p010 - p000 ) * dy + ( p111 - p110 ) * dz;
+		}
+		else if( dy >= dz && dz >= dx ) // T5
+		{
+			const Node p010 = cell.node( 0, 1, 0 );
+			const Node p011 = cell.node( 0, 1, 1 );
+			return p000 + ( p111 - p011 ) * dx + ( p010 - p000 ) * dy + ( p011 - p010 ) * dz;
+		}
+		// T6
+		const Node p001 = cell.node( 0, 0, 1 );
+		const Node p011 = cell.node( 0, 1, 1 );
+		return p000 + ( p111 - p011 ) * dx + ( p011 - p001 ) * dy + ( p001 - p000 ) * dz;
+	}
+};
+
+/**
+ * @brief Trilinear interpolation of the 8 nodes of the cell.
+ */
+struct TrilinearInterpolation
+{
+	static lutDetails::Node interpolate( const lutDetails::Cell& cell )
+	{
+		using lutDetails::Node;
+		const Node p000 = cell.node( 0, 0, 0 );
+		const Node p001 = cell.node( 0, 0, 1 );
+		const Node p010 = cell.node( 0, 1, 0 );
+		const Node p011 = cell.node( 0, 1, 1 );
+		const Node p100 = cell.node( 1, 0, 0 );
+		const Node p101 = cell.node( 1, 0, 1 );
+		const Node p110 = cell.node( 1, 1, 0 );
+		const Node p111 = cell.node( 1, 1, 1 );
+
+		const Node c00 = p000 + ( p100 - p000 ) * cell._dx;
+		const Node c01 = p001 + ( p101 - p001 ) * cell._dx;
+		const Node c10 = p010 + ( p110 - p010 ) * cell._dx;
+		const Node c11 = p011 + ( p111 - p011 ) * cell._dx;
+		const Node c0 = c00 + ( c10 - c00 ) * cell._dy;
+		const Node c1 = c01 + ( c11 - c01 ) * cell._dy;
+		return c0 + ( c1 - c0 ) * cell._dz;
+	}
+};
+
+/**
+ * @brief 1D transform applied on each channel before the 3D lookup.
+ *
+ * Maps the input values to the lattice coordinates, for lattices with non
+ * uniform input steps. It is prebaked in a table linearly interpolated.
+ */
+class Shaper1D
+{
+public:
+	static const std::size_t kTableSize = 4096;
+
+public:
+	Shaper1D() {}
+
+	/**
+	 * @param steps input value of each node of the lattice, increasing
+	 * @param nbSteps number of nodes along an axis
+	 * @param inputMax input value corresponding to 1.0
+	 */
+	template<typename T>
+	void reset( const T* steps, const std::size_t nbSteps, const double inputMax )
+	{
+		_table.resize( kTableSize );
+		std::size_t i = 0;
+		for( std::size_t k = 0; k < kTableSize; ++k )
+		{
+			const double v = std::max( double( steps[0] ), std::min( k * inputMax / ( kTableSize - 1 ), double( steps[nbSteps - 1] ) ) );
+			while( i < nbSteps - 2 && v > steps[i + 1] )
+				++i;
+			const double stepSize = double( steps[i + 1] ) - double( steps[i] );
+			const double frac = stepSize > 0 ? ( v - steps[i] ) / stepSize : 0.0;
+			_table[k] = static_cast<float>( ( i + frac ) / ( nbSteps - 1 ) );
+		}
+	}
+
+	void clear() { _table.clear(); }
+	bool empty() const { return _table.empty(); }
+
+	float apply( const float v ) const
+	{
+		const float pos = lutDetails::clamp01( v ) * ( kTableSize - 1 );
+		const std::size_t i = std::min( static_cast<std::size_t>( pos ), kTableSize - 2 );
+		const float frac = pos - i;
+		return _table[i] + ( _table[i + 1] - _table[i] ) * frac;
+	}
+
+private:
+	std::vector<float> _table;
+};
+
+/**
+ * @brief 3D LUT applied on rows of float RGB pixels.
+ *
+ * The lattice is stored as float, with 4 values per node for vector loads,
+ * and the interpolation is a template parameter (TetrahedralInterpolation or
+ * TrilinearInterpolation), so there is no virtual call or allocation per pixel.
+ *
+ * Compared to Lut3D with TetraInterpolator or TrilinInterpolator (double
+ * lattice), the results are the same within 1e-5 for normalized lattice values
+ * and inputs in [0,1[. The inputs are clamped to [0,1] (Lut3D extrapolates
+ * outside), and 1.0 gives the last node.
+ */
+class FloatLut3D
+{
+public:
+	FloatLut3D() : _dimSize( 0 ) {}
+
+	/**
+	 * @brief Set the lattice.
+	 * @param dimSize number of nodes along an axis (at least 2)
+	 * @param data RGB of the nodes, in the Lut3D order (blue varies the fastest)
+	 * The shaper is removed.
+	 */
+	template<typename T>
+	void reset( const std::size_t dimSize, const T* data )
+	{
+		_shaper.clear();
+		if( dimSize < 2 )
+		{
+			clear();
+			return;
+		}
+		_dimSize = dimSize;
+		const std::size_t nbNodes = dimSize * dimSize * dimSize;
+		_nodes.assign( nbNodes * 4, 0.0f );
+		for( std::size_t n = 0; n < nbNodes; ++n )
+		{
+			_nodes[n * 4    ] = static_cast<float>( data[n * 3    ] );
+			_nodes[n * 4 + 1] = static_cast<float>( data[n * 3 + 1] );
+			_nodes[n * 4 + 2] = static_cast<float>( data[n * 3 + 2] );
+		}
+	}
+
+	void clear()
+	{
+		_dimSize = 0;
+		_nodes.clear();
+		_shaper.clear();
+	}
+
+	bool empty() const { return _dimSize == 0; }
+	std::size_t dimSize() const { return _dimSize; }
+
+	Shaper1D& shaper() { return _shaper; }
+	const Shaper1D& shaper() const { return _shaper; }
+
+	/**
+	 * @brief Transform a row of RGB pixels (3 floats per pixel).
+	 * @param src, dst can be the same buffer
+	 */
+	template<class Interpolation>
+	void transform( const float* src, float* dst, const std::size_t nbPixels ) const
+	{
+		if( _shaper.empty() )
+			transformRow<Interpolation, false>( src, dst, nbPixels );
+		else
+			transformRow<Interpolation, true>( src, dst, nbPixels );
+	}
+
+private:
+	template<class Interpolation, bool useShaper>
+	void transformRow( const float* src, float* dst, const std::size_t nbPixels ) const
+	{
+		lutDetails::Cell cell;
+		cell._strideZ = 4;
+		cell._strideY = _dimSize * cell._strideZ;
+		cell._strideX = _dimSize * cell._strideY;
+		const float* nodes = &_nodes[0];
+
+		for( std::size_t i = 0; i < nbPixels; ++i, src += 3, dst += 3 )
+		{
+			float r = src[0];
+			float g = src[1];
+			float b = src[2];
+			if( useShaper )
+			{
+				r = _shaper.apply( r );
+				g = _shaper.apply( g );
+				b = _shaper.apply( b );
+			}
+			std::size_t x, y, z;
+			lutDetails::cellPosition( r, _dimSize, x, cell._dx );
+			lutDetails::cellPosition( g, _dimSize, y, cell._dy );
+			lutDetails::cellPosition( b, _dimSize, z, cell._dz );
+			cell._p000 = nodes + x * cell._strideX + y * cell._strideY + z * cell._strideZ;
+
+			Interpolation::interpolate( cell ).store( dst );
+		}
+	}
+
+private:
+	std::size_t _dimSize;
+	std::vector<float> _nodes; ///< RGB and a padding for each node
+	Shaper1D _shaper;
+};
+
+}
+
+#endif
@@ -1,4 +1,9 @@
+#include "../../src/lutEngine/FloatLut3D.hpp"
+
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #define BOOST_TEST_MODULE test_plugin_lut
 #include <boost/test/unit_test.hpp>
@@ -7,10 +12,164 @@ BOOST_AUTO_TEST_SUITE( plugin_lut )
 
 using namespace boost::unit_test;
 
+namespace {
+
+/// @brief Lattice in the Lut3D order (blue varies the fastest)
+std::vector<double> createLattice( const std::size_t dimSize, const bool random )
+{
+	std::vector<double> data;
+	for( std::size_t x = 0; x < dimSize; ++x )
+		for( std::size_t y = 0; y < dimSize; ++y )
+			for( std::size_t z = 0; z < dimSize; ++z )
+			{
+				const double r = x / ( dimSize - 1.0 );
+				const double g = y / ( dimSize - 1.0 );
+				const double b = z / ( dimSize - 1.0 );
+				if( random )
+				{
+					data.push_back( std::rand() / double( RAND_MAX ) );
+					data.push_back( std::rand() / double( RAND_MAX ) );
+					data.push_back( std::rand() / double( RAND_MAX ) );
+				}
+				else
+				{
+					// affine transform, exactly interpolated
+					data.push_back( 0.5 * r + 0.25 * g + 0.1 );
+					data.push_back( 0.2 * r + 0.6 * g + 0.2 * b );
+					data.push_back( 0.9 * b + 0.05 );
+				}
+			}
+	return data;
+}
+
+/// @brief Reference: same computation as TetraInterpolator, in double.
+void tetraReference( const std::vector<double>& data, const std::size_t dimSize, const double* in, double* out )
+{
+	std::size_t i[3];
+	double d[3];
+	for( int c = 0; c < 3; ++c )
+	{
+		i[c] = (std::size_t)std::floor( in[c] * ( dimSize - 1 ) );
+		d[c] = in[c] * ( dimSize - 1.0 ) - i[c];
+	}
+	for( int c = 0; c < 3; ++c )
+	{
+#define P( X, Y, Z ) data[ ( ( ( i[0] + X ) * dimSize + ( i[1] + Y ) ) * dimSize + ( i[2] + Z ) ) * 3 + c ]
+		const double dx = d[0], dy = d[1], dz = d[2];
+		double c1, c2, c3;
+		if( dx >= dy && dy >= dz )      { c1 = P(1,0,0) - P(0,0,0); c2 = P(1,1,0) - P(1,0,0); c3 = P(1,1,1) - P(1,1,0); }
+		else if( dx >= dz && dz >= dy ) { c1 = P(1,0,0) - P(0,0,0); c2 = P(1,1,1) - P(1,0,1); c3 = P(1,0,1) - P(1,0,0); }
+		else if( dz >= dx && dx >= dy ) { c1 = P(1,0,1) - P(0,0,1); c2 = P(1,1,1) - P(1,0,1); c3 = P(0,0,1) - P(0,0,0); }
+		else if( dy >= dx && dx >= dz ) { c1 = P(1,1,0) - P(0,1,0); c2 = P(0,1,0) - P(0,0,0); c3 = P(1,1,1) - P(1,1,0); }
+		else if( dy >= dz && dz >= dx ) { c1 = P(1,1,1) - P(0,1,1); c2 = P(0,1,0) - P(0,0,0); c3 = P(0,1,1) - P(0,1,0); }
+		else                            { c1 = P(1,1,1) - P(0,1,1); c2 = P(0,1,1) - P(0,0,1); c3 = P(0,0,1) - P(0,0,0); }
+		out[c] = P(0,0,0) + c1 * dx + c2 * dy + c3 * dz;
+#undef P
+	}
+}
+
+std::vector<float> randomPixels( const std::size_t nbPixels )
+{
+	std::vector<float> pixels( nbPixels * 3 );
+	for( std::size_t i = 0; i < pixels.size(); ++i )
+		pixels[i] = 0.999f * std::rand() / float( RAND_MAX );
+	return pixels;
+}
+
+}
+
 BOOST_AUTO_TEST_CASE( plugin_lut_test_01 )
 {
 	BOOST_CHECK_EQUAL( 1.0, 1.0 );
 }
 
+BOOST_AUTO_TEST_CASE( float_lut_tetrahedral_reference )
+{
+	const std::size_t dimSize = 17;
+	const std::vector<double> data = createLattice( dimSize, true );
+	tuttle::FloatLut3D lut;
+	lut.reset( dimSize, &data[0] );
+
+	const std::size_t nbPixels = 1000;
+	const std::vector<float> src = randomPixels( nbPixels );
+	std::vector<float> dst( src.size() );
+	lut.transform<tuttle::TetrahedralInterpolation>( &src[0], &dst[0], nbPixels );
+
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		const double in[3] = { src[i * 3], src[i * 3 + 1], src[i * 3 + 2] };
+		double ref[3];
+		tetraReference( data, dimSize, in, ref );
+		for( int c = 0; c < 3; ++c )
+			BOOST_CHECK_SMALL( dst[i * 3 + c] - ref[c], 1e-5 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( float_lut_affine )
+{
+	const std::size_t dimSize = 9;
+	const std::vector<double> data = createLattice( dimSize, false );
+	tuttle::FloatLut3D lut;
+	lut.reset( dimSize, &data[0] );
+
+	std::vector<float> src = randomPixels( 500 );
+	// edges of the lattice
+	src[0] = 0.0f; src[1] = 1.0f; src[2] = 1.0f;
+	src[3] = 1.0f; src[4] = 0.0f; src[5] = 0.5f;
+
+	std::vector<float> tetra( src.size() );
+	std::vector<float> trilinear( src.size() );
+	lut.transform<tuttle::TetrahedralInterpolation>( &src[0], &tetra[0], 500 );
+	lut.transform<tuttle::TrilinearInterpolation>( &src[0], &trilinear[0], 500 );
+
+	for( std::size_t i = 0; i < src.size(); i += 3 )
+	{
+		const float r = src[i], g = src[i + 1], b = src[i + 2];
+		const float expected[3] = { 0.5f * r + 0.25f * g + 0.1f, 0.2f * r + 0.6f * g + 0.2f * b, 0.9f * b + 0.05f };
+		for( int c = 0; c < 3; ++c )
+		{
+			BOOST_CHECK_SMALL( tetra[i + c] - expected[c], 1e-5f );
+			BOOST_CHECK_SMALL( trilinear[i + c] - expected[c], 1e-5f );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( float_lut_in_place_and_clamp )
+{
+	const std::size_t dimSize = 5;
+	const std::vector<double> data = createLattice( dimSize, false );
+	tuttle::FloatLut3D lut;
+	lut.reset( dimSize, &data[0] );
+
+	float pixels[6] = { -1.0f, 2.0f, 0.5f, 0.0f, 1.0f, 0.5f };
+	lut.transform<tuttle::TetrahedralInterpolation>( pixels, pixels, 2 );
+	for( int c = 0; c < 3; ++c )
+		BOOST_CHECK_CLOSE( pixels[c], pixels[3 + c], 1e-4f );
+}
+
+BOOST_AUTO_TEST_CASE( float_lut_shaper )
+{
+	// identity lattice on non uniform input steps
+	const std::size_t dimSize = 5;
+	const double steps[dimSize] = { 0.0, 100.0, 300.0, 600.0, 1023.0 };
+	std::vector<double> data;
+	for( std::size_t x = 0; x < dimSize; ++x )
+		for( std::size_t y = 0; y < dimSize; ++y )
+			for( std::size_t z = 0; z < dimSize; ++z )
+			{
+				data.push_back( steps[x] / 1023.0 );
+				data.push_back( steps[y] / 1023.0 );
+				data.push_back( steps[z] / 1023.0 );
+			}
+	tuttle::FloatLut3D lut;
+	lut.reset( dimSize, &data[0] );
+	lut.shaper().reset( steps, dimSize, 1023.0 );
+
+	const std::vector<float> src = randomPixels( 500 );
+	std::vector<float> dst( src.size() );
+	lut.transform<tuttle::TrilinearInterpolation>( &src[0], &dst[0], 500 );
+	for( std::size_t i = 0; i < src.size(); ++i )
+		BOOST_CHECK_SMALL( dst[i] - src[i], 1e-3f );
+}
 
 BOOST_AUTO_TEST_SUITE_END()
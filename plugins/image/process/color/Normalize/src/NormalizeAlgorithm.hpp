@@ -7,7 +7,9 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/minmax.hpp>
-#include <terry/algorithm/transform_pixels_progress.hpp>
+#include <terry/algorithm/reduce.hpp>
+
+#include <tuttle/plugin/OfxThreadExecutor.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -23,10 +25,10 @@ void analyseChannel( View& src, typename View::value_type& min, typename View::v
 	typedef channel_view_type<LocalChannel,View> LocalView;
 	typename LocalView::type localView( LocalView::make(src) );
 	pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax( localView(0,0) );
-	transform_pixels_progress(
+	reduce_pixels_parallel_progress(
 		localView,
 		minmax,
-		p );
+		p, OfxThreadExecutor() );
 	static_fill( min, minmax.min[0] );
 	static_fill( max, minmax.max[0] );
 }
@@ -55,10 +57,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -69,10 +71,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef typename color_converted_view_type<View, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<typename LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -82,10 +84,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<red_t, View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -95,10 +97,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<green_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -108,10 +110,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<blue_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -121,10 +123,10 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<alpha_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -147,10 +149,10 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				progress );
+				progress, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -161,10 +163,10 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef color_converted_view_type<rgb32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				progress );
+				progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -174,10 +176,10 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<red_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -187,10 +189,10 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<green_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -200,10 +202,10 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<blue_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -232,10 +234,10 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				progress );
+				progress, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -246,10 +248,10 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef color_converted_view_type<rgb16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				progress );
+				progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -259,10 +261,10 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<red_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -272,10 +274,10 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<green_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -285,10 +287,10 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<blue_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					progress );
+					progress, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -317,10 +319,10 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -331,10 +333,10 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef color_converted_view_type<rgb8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -344,10 +346,10 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<red_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -357,10 +359,10 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<green_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -370,10 +372,10 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<blue_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 					localView,
 					minmax,
-					p );
+					p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -402,10 +404,10 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -416,10 +418,10 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 			typedef color_converted_view_type<gray32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -451,10 +453,10 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -465,10 +467,10 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 			typedef color_converted_view_type<gray16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -500,10 +502,10 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				src,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -514,10 +516,10 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 			typedef color_converted_view_type<gray8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
+			reduce_pixels_parallel_progress(
 				localView,
 				minmax,
-				p );
+				p, OfxThreadExecutor() );
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -1,5 +1,6 @@
 #include "OCIOColorSpacePlugin.hpp"
 #include "OCIOColorSpaceProcess.hpp"
+#include "../OCIOProcessorCache.hpp"
 
 #include <tuttle/common/utils/color.hpp>
 
@@ -123,8 +124,9 @@ namespace tuttle
                   exception::FileNotExist( ) << exception::filename( str ));
             }
 
-          // Get the OCIO configuration processor.
-          params._config = OCIO::Config::CreateFromFile(str.c_str());
+          // Get the OCIO configuration, only loaded once.
+          params._configFilename = str;
+          params._config = ProcessorCache::instance().getConfig(str);
 
           int index;
           _paramInputSpace->getValue(index);
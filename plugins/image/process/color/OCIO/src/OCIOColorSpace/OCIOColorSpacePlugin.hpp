@@ -17,6 +17,7 @@ namespace tuttle
         struct OCIOColorSpaceProcessParams
         {
           OCIO_NAMESPACE::ConstConfigRcPtr _config;
+          std::string _configFilename;
           std::string _inputSpace;
           std::string _outputSpace;
         };
@@ -35,7 +35,7 @@ namespace tuttle
             OCIOColorSpacePlugin& _plugin; ///< Rendering plugin
             OCIOColorSpaceProcessParams _params; ///< parameters
 
-            OCIO::ConstConfigRcPtr _config;
+            OCIO::ConstProcessorRcPtr _processor; ///< shared by all the threads
 
           public:
             OCIOColorSpaceProcess<View>(OCIOColorSpacePlugin & instance);
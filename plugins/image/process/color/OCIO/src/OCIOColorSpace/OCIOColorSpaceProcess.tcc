@@ -1,4 +1,5 @@
 #include "OCIOColorSpaceDefinitions.hpp"
+#include "../OCIOProcessorCache.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -34,11 +35,8 @@ void OCIOColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
 	
 	try
 	{
-		// Load the current config.
-		_config = _params._config;
-
-		// Try to load the processor
-		_config->getProcessor(  _params._inputSpace.c_str(),  _params._outputSpace.c_str() );
+		// The processor is built once for all the frames, threads and nodes
+		_processor = ProcessorCache::instance().getColorSpaceProcessor( _params._configFilename, _params._inputSpace, _params._outputSpace );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -79,8 +77,6 @@ void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src) {
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = _config->getProcessor( _params._inputSpace.c_str(), _params._outputSpace.c_str() );
-		
 		if (is_planar<View>::value)
 		{
 			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
@@ -96,7 +92,7 @@ void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src) {
 						dst.pixels().row_size());
 				// Apply the color transformation (in place)
 				// Need normalized values
-				processor->apply(imageDesc);
+				_processor->apply(imageDesc);
 				if (this->progressForward(dst.width()))
 					return;
 			}
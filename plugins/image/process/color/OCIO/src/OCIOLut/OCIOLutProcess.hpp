@@ -31,9 +31,7 @@ private:
 	OCIOLutPlugin&  _plugin;        ///< Rendering plugin
 	OCIOLutProcessParams _params; ///< parameters
 
-	OCIO::FileTransformRcPtr  fileTransform;
-	OCIO::GroupTransformRcPtr groupTransform;
-	OCIO::ConfigRcPtr         config;
+	OCIO::ConstProcessorRcPtr _processor; ///< shared by all the threads
 
 public:
 	OCIOLutProcess<View>( OCIOLutPlugin & instance );
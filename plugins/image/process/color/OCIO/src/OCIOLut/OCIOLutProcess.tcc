@@ -1,4 +1,5 @@
 #include "OCIOLutDefinitions.hpp"
+#include "../OCIOProcessorCache.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -32,34 +33,10 @@ void OCIOLutProcess<View>::setup(const OFX::RenderArguments& args)
 	ImageGilFilterProcessor<View>::setup(args);
 	_params = _plugin.getProcessParams(args.renderScale);
 	
-	try {
-		fileTransform = OCIO::FileTransform::Create();
-		fileTransform->setSrc( _params._filename.c_str() );
-		fileTransform->setInterpolation( _params._interpolationType );
-	
-		//Add the file transform to the group, required by the transform process
-		groupTransform = OCIO::GroupTransform::Create();
-		groupTransform->push_back( fileTransform );
-	
-		// Create the OCIO processor for the specified transform.
-		config = OCIO::Config::Create();
-	
-		OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
-		inputColorSpace->setName( kOCIOInputspace.c_str() );
-		
-		config->addColorSpace( inputColorSpace );
-		
-		OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
-		outputColorSpace->setName( kOCIOOutputspace.c_str()) ;
-	
-		outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
-	
-		TUTTLE_TLOG( TUTTLE_WARNING, "Specified Transform:" << *(groupTransform) );
-	
-		config->addColorSpace( outputColorSpace );
-		
-		// Try to load the processor
-		config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
+	try
+	{
+		// The LUT file is parsed once for all the frames, threads and nodes
+		_processor = ProcessorCache::instance().getLutProcessor( _params._filename, _params._interpolationType );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -99,8 +76,6 @@ void OCIOLutProcess<View>::applyLut(View& dst, View& src) {
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
-		
 		if (is_planar<View>::value)
 		{
 			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
@@ -116,7 +91,7 @@ void OCIOLutProcess<View>::applyLut(View& dst, View& src) {
 						dst.pixels().row_size());
 				// Apply the color transformation (in place)
 				// Need normalized values
-				processor->apply(imageDesc);
+				_processor->apply(imageDesc);
 				if (this->progressForward(dst.width()))
 					return;
 			}
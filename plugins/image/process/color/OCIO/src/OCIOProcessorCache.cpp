@@ -0,0 +1,130 @@
+#include "OCIOProcessorCache.hpp"
+#include "OCIOLut/OCIOLutDefinitions.hpp"
+
+#include <tuttle/plugin/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+namespace OCIO = OCIO_NAMESPACE;
+
+ProcessorCache& ProcessorCache::instance()
+{
+	static ProcessorCache cache;
+	return cache;
+}
+
+OCIO::ConstProcessorRcPtr ProcessorCache::getLutProcessor( const std::string& lutFilename, const OCIO::Interpolation interpolation )
+{
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time( lutFilename );
+	const std::string key = "lut\n" + lutFilename + "\n" + boost::lexical_cast<std::string>( static_cast<int>( interpolation ) );
+
+	boost::mutex::scoped_lock lock( _mutex );
+	ProcessorMap::const_iterator it = _processors.find( key );
+	if( it != _processors.end() && it->second._lastWriteTime == lastWriteTime )
+		return it->second._processor;
+
+	if( it != _processors.end() )
+	{
+		// OCIO keeps its own cache of the parsed files
+		OCIO::ClearAllCaches();
+	}
+
+	OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+	fileTransform->setSrc( lutFilename.c_str() );
+	fileTransform->setInterpolation( interpolation );
+
+	// Add the file transform to the group, required by the transform process
+	OCIO::GroupTransformRcPtr groupTransform = OCIO::GroupTransform::Create();
+	groupTransform->push_back( fileTransform );
+
+	OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+	OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
+	inputColorSpace->setName( lut::kOCIOInputspace.c_str() );
+	config->addColorSpace( inputColorSpace );
+
+	OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
+	outputColorSpace->setName( lut::kOCIOOutputspace.c_str() );
+	outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
+	config->addColorSpace( outputColorSpace );
+
+	TUTTLE_LOG_TRACE( "[OCIO] Build the processor of the transform: " << *groupTransform );
+
+	ProcessorEntry entry;
+	entry._lastWriteTime = lastWriteTime;
+	entry._config = config;
+	entry._processor = config->getProcessor( lut::kOCIOInputspace.c_str(), lut::kOCIOOutputspace.c_str() );
+	_processors[key] = entry;
+	return entry._processor;
+}
+
+OCIO::ConstConfigRcPtr ProcessorCache::getConfig( const std::string& configFilename )
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return getConfigLocked( configFilename );
+}
+
+OCIO::ConstConfigRcPtr ProcessorCache::getConfigLocked( const std::string& configFilename )
+{
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time( configFilename );
+
+	ConfigMap::const_iterator it = _configs.find( configFilename );
+	if( it != _configs.end() && it->second._lastWriteTime == lastWriteTime )
+		return it->second._config;
+
+	if( it != _configs.end() )
+		OCIO::ClearAllCaches();
+
+	TUTTLE_LOG_TRACE( "[OCIO] Load the config: " << configFilename );
+
+	ConfigEntry entry;
+	entry._lastWriteTime = lastWriteTime;
+	entry._config = OCIO::Config::CreateFromFile( configFilename.c_str() );
+	_configs[configFilename] = entry;
+	return entry._config;
+}
+
+OCIO::ConstProcessorRcPtr ProcessorCache::getColorSpaceProcessor( const std::string& configFilename, const std::string& inputSpace, const std::string& outputSpace )
+{
+	const std::string key = "colorspace\n" + configFilename + "\n" + inputSpace + "\n" + outputSpace;
+
+	boost::mutex::scoped_lock lock( _mutex );
+	const OCIO::ConstConfigRcPtr config = getConfigLocked( configFilename );
+
+	ProcessorMap::const_iterator it = _processors.find( key );
+	// the processors of a previous version of the config are outdated
+	if( it != _processors.end() && it->second._config == config )
+		return it->second._processor;
+
+	TUTTLE_LOG_TRACE( "[OCIO] Build the processor from " << inputSpace << " to " << outputSpace );
+
+	ProcessorEntry entry;
+	entry._lastWriteTime = 0;
+	entry._config = config;
+	entry._processor = config->getProcessor( inputSpace.c_str(), outputSpace.c_str() );
+	_processors[key] = entry;
+	return entry._processor;
+}
+
+void ProcessorCache::clear()
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	_processors.clear();
+	_configs.clear();
+	OCIO::ClearAllCaches();
+}
+
+std::size_t ProcessorCache::getNbProcessors() const
+{
+	boost::mutex::scoped_lock lock( _mutex );
+	return _processors.size();
+}
+
+}
+}
+}
@@ -0,0 +1,87 @@
+#ifndef _TUTTLE_PLUGIN_OCIO_PROCESSORCACHE_HPP_
+#define _TUTTLE_PLUGIN_OCIO_PROCESSORCACHE_HPP_
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <map>
+#include <string>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+/**
+ * @brief Process-wide cache of the OCIO configs and processors.
+ *
+ * The LUT files and configs are parsed and the processors built once,
+ * then shared read-only by all the render threads and node instances
+ * (OCIO processors are thread-safe for apply()).
+ * An entry is rebuilt only when its inputs change: file, modification time
+ * or transform parameters.
+ *
+ * @warning The files referenced by a config (LUTs of the color spaces)
+ * are not checked, only the config file itself.
+ */
+class ProcessorCache : private boost::noncopyable
+{
+public:
+	static ProcessorCache& instance();
+
+	/**
+	 * @brief Processor applying a LUT file.
+	 * @exception OCIO::Exception if the LUT can't be loaded
+	 */
+	OCIO_NAMESPACE::ConstProcessorRcPtr getLutProcessor( const std::string& lutFilename, const OCIO_NAMESPACE::Interpolation interpolation );
+
+	/**
+	 * @brief Config loaded from a file.
+	 * @exception OCIO::Exception if the config can't be loaded
+	 */
+	OCIO_NAMESPACE::ConstConfigRcPtr getConfig( const std::string& configFilename );
+
+	/**
+	 * @brief Processor converting between two color spaces of a config file.
+	 * @exception OCIO::Exception if the config or the color spaces can't be loaded
+	 */
+	OCIO_NAMESPACE::ConstProcessorRcPtr getColorSpaceProcessor( const std::string& configFilename, const std::string& inputSpace, const std::string& outputSpace );
+
+	/// @brief Remove all the entries, the next requests reload the files.
+	void clear();
+
+	std::size_t getNbProcessors() const;
+
+private:
+	ProcessorCache() {}
+
+	/// @brief Config of a file, reloaded if the file has changed. _mutex must be locked.
+	OCIO_NAMESPACE::ConstConfigRcPtr getConfigLocked( const std::string& configFilename );
+
+private:
+	struct ConfigEntry
+	{
+		std::time_t _lastWriteTime;
+		OCIO_NAMESPACE::ConstConfigRcPtr _config;
+	};
+	struct ProcessorEntry
+	{
+		std::time_t _lastWriteTime; ///< of the LUT file
+		OCIO_NAMESPACE::ConstConfigRcPtr _config; ///< config used to build the processor
+		OCIO_NAMESPACE::ConstProcessorRcPtr _processor;
+	};
+	typedef std::map<std::string, ConfigEntry> ConfigMap;
+	typedef std::map<std::string, ProcessorEntry> ProcessorMap;
+
+	mutable boost::mutex _mutex; ///< the entries are built with the lock, to parse each file once
+	ConfigMap _configs; ///< key: config filename
+	ProcessorMap _processors; ///< key: kind of transform, filenames and parameters
+};
+
+}
+}
+}
+
+#endif
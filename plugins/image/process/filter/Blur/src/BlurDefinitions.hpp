@@ -24,6 +24,23 @@ enum EParamBorder
 	eParamBorderPadded
 };
 
+static const std::string kParamMethod              = "method";
+static const std::string kParamMethodAuto          = "auto";
+static const std::string kParamMethodConvolution   = "convolution";
+static const std::string kParamMethodRecursive     = "recursive";
+static const std::string kParamMethodBox           = "box";
+
+enum EParamMethod
+{
+	eParamMethodAuto = 0,
+	eParamMethodConvolution,
+	eParamMethodRecursive,
+	eParamMethodBox
+};
+
+/// @brief In auto mode, the recursive gaussian is used above this number of values in the kernel.
+static const std::size_t kAutoRecursiveKernelSize = 31;
+
 static const std::string kParamGroupAdvanced = "advanced";
 static const std::string kParamNormalizedKernel = "normalizedKernel";
 static const std::string kParamKernelEpsilon = "kernelEpsilon";
@@ -6,6 +6,9 @@
 
 #include <boost/gil/gil_all.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace tuttle {
 namespace plugin {
 namespace blur {
@@ -15,6 +18,7 @@ BlurPlugin::BlurPlugin( OfxImageEffectHandle handle )
 {
 	_paramSize   = fetchDouble2DParam( kParamSize );
 	_paramBorder = fetchChoiceParam( kParamBorder );
+	_paramMethod = fetchChoiceParam( kParamMethod );
 	_paramNormalizedKernel = fetchBooleanParam( kParamNormalizedKernel );
 	_paramKernelEpsilon = fetchDoubleParam( kParamKernelEpsilon );
 }
@@ -30,8 +34,43 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams( const OfxPoi
 	const bool normalizedKernel = _paramNormalizedKernel->getValue();
 	const double kernelEpsilon = _paramKernelEpsilon->getValue();
 
-	params._gilKernelX = buildGaussian1DKernel<Scalar>( params._size.x, normalizedKernel, kernelEpsilon );
-	params._gilKernelY = buildGaussian1DKernel<Scalar>( params._size.y, normalizedKernel, kernelEpsilon );
+	params._method = static_cast<EParamMethod>( _paramMethod->getValue() );
+	if( params._method == eParamMethodAuto || params._method == eParamMethodConvolution )
+	{
+		params._gilKernelX = buildGaussian1DKernel<Scalar>( params._size.x, normalizedKernel, kernelEpsilon );
+		params._gilKernelY = buildGaussian1DKernel<Scalar>( params._size.y, normalizedKernel, kernelEpsilon );
+
+		// the convolution cost grows with the kernel size, the recursive gaussian has a constant cost.
+		// The recursive filters are always normalized.
+		if( params._method == eParamMethodAuto )
+		{
+			const bool bigKernel = std::max( params._gilKernelX.size(), params._gilKernelY.size() ) > kAutoRecursiveKernelSize;
+			params._method = ( normalizedKernel && bigKernel ) ? eParamMethodRecursive : eParamMethodConvolution;
+		}
+	}
+
+	// the kernel size is the variance of the gaussian
+	const terry::point2<double> sigma( std::sqrt( params._size.x ), std::sqrt( params._size.y ) );
+	switch( params._method )
+	{
+		case eParamMethodAuto:
+		case eParamMethodConvolution:
+			params._margin.x = params._gilKernelX.left_size();
+			params._margin.y = params._gilKernelY.left_size();
+			break;
+		case eParamMethodRecursive:
+			params._recursiveX = recursive_gaussian( sigma.x );
+			params._recursiveY = recursive_gaussian( sigma.y );
+			params._margin.x = params._recursiveX.margin();
+			params._margin.y = params._recursiveY.margin();
+			break;
+		case eParamMethodBox:
+			params._boxX = extended_box_gaussian( sigma.x );
+			params._boxY = extended_box_gaussian( sigma.y );
+			params._margin.x = params._boxX.margin();
+			params._margin.y = params._boxY.margin();
+			break;
+	}
 	
 	params._boundary_option = convolve_option_extend_mirror;
 	switch( params._border )
@@ -76,18 +115,18 @@ bool BlurPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments&
 	switch( params._border )
 	{
 		case eParamBorderPadded:
-			rod.x1 = srcRod.x1 + params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 + params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 - params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 - params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 + params._margin.x;
+			rod.y1 = srcRod.y1 + params._margin.y;
+			rod.x2 = srcRod.x2 - params._margin.x;
+			rod.y2 = srcRod.y2 - params._margin.y;
 			return true;
 		case eParamBorderBlack:
 		case eParamBorderConstant:
 		case eParamBorderMirror:
-			rod.x1 = srcRod.x1 - params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 - params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 + params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 + params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 - params._margin.x;
+			rod.y1 = srcRod.y1 - params._margin.y;
+			rod.x2 = srcRod.x2 + params._margin.x;
+			rod.y2 = srcRod.y2 + params._margin.y;
 			return true;
 		case eParamBorderNo:
 			return false; // don't modify the source image RoD
@@ -102,10 +141,10 @@ void BlurPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& ar
 	OfxRectD srcRod                  = _clipSrc->getCanonicalRod( args.time );
 
 	OfxRectD srcRoi;
-	srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
-	srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
-	srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
-	srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+	srcRoi.x1 = srcRod.x1 - params._margin.x;
+	srcRoi.y1 = srcRod.y1 - params._margin.y;
+	srcRoi.x2 = srcRod.x2 + params._margin.x;
+	srcRoi.y2 = srcRod.y2 + params._margin.y;
 	rois.setRegionOfInterest( *_clipSrc, srcRoi );
 }
 
@@ -5,6 +5,7 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/recursiveGaussian.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -19,9 +20,16 @@ struct BlurProcessParams
 	terry::point2<double> _size;
 	EParamBorder _border;
 	terry::filter::convolve_boundary_option _boundary_option;
+	EParamMethod _method; ///< never eParamMethodAuto
+	terry::point2<std::ptrdiff_t> _margin; ///< number of pixels used around each pixel
 
-	Kernel _gilKernelX;
-	Kernel _gilKernelY;
+
+	Kernel _gilKernelX; ///< only with eParamMethodConvolution
+	Kernel _gilKernelY; ///< only with eParamMethodConvolution
+	terry::filter::recursive_gaussian _recursiveX; ///< only with eParamMethodRecursive
+	terry::filter::recursive_gaussian _recursiveY;
+	terry::filter::extended_box_gaussian _boxX; ///< only with eParamMethodBox
+	terry::filter::extended_box_gaussian _boxY;
 };
 
 /**
@@ -48,6 +56,7 @@ public:
 public:
 	OFX::Double2DParam* _paramSize;
 	OFX::ChoiceParam* _paramBorder;
+	OFX::ChoiceParam* _paramMethod;
 	OFX::BooleanParam* _paramNormalizedKernel;
 	OFX::DoubleParam* _paramKernelEpsilon;
 };
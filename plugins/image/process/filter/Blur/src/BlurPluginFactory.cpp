@@ -107,6 +107,16 @@ void BlurPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	normalizedKernel->setDefault( true );
 	normalizedKernel->setParent( advanced );
 
+	OFX::ChoiceParamDescriptor* method = desc.defineChoiceParam( kParamMethod );
+	method->setLabel( "Method" );
+	method->appendOption( kParamMethodAuto, "Auto: convolution for small sizes, recursive for the big ones." );
+	method->appendOption( kParamMethodConvolution, "Convolution: exact gaussian kernel, the cost grows with the size." );
+	method->appendOption( kParamMethodRecursive, "Recursive: recursive gaussian filter, constant cost whatever the size." );
+	method->appendOption( kParamMethodBox, "Box: 3 extended box filters, constant cost whatever the size." );
+	method->setDefault( eParamMethodAuto );
+	method->setHint( "The recursive and box methods always use a normalized gaussian, and don't use the kernel epsilon." );
+	method->setParent( advanced );
+
 	OFX::DoubleParamDescriptor* kernelEpsilon = desc.defineDoubleParam( kParamKernelEpsilon );
 	kernelEpsilon->setLabel( "Kernel espilon value" );
 	kernelEpsilon->setHint( "Threshold at which we no longer consider the values of the function." );
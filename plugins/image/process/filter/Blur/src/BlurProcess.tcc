@@ -2,6 +2,7 @@
 
 #include <terry/filter/gaussianKernel.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/recursiveGaussian.hpp>
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
@@ -52,6 +53,21 @@ void BlurProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 
 	const Point proc_tl( procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1 );
 
+	switch( _params._method )
+	{
+		case eParamMethodRecursive:
+			recursive_filter_rows_cols<Pixel, OfxAllocator>(
+				this->_srcView, _params._recursiveX, _params._recursiveY, dst, proc_tl, _params._boundary_option );
+			return;
+		case eParamMethodBox:
+			recursive_filter_rows_cols<Pixel, OfxAllocator>(
+				this->_srcView, _params._boxX, _params._boxY, dst, proc_tl, _params._boundary_option );
+			return;
+		case eParamMethodAuto:
+		case eParamMethodConvolution:
+			break;
+	}
+
 	if( _params._size.x == 0 )
 	{
 		correlate_cols_auto<Pixel>( this->_srcView, _params._gilKernelY, dst, proc_tl, _params._boundary_option );
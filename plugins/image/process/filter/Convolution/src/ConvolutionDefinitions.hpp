@@ -9,6 +9,20 @@ namespace tuttle {
 namespace plugin {
 namespace convolution {
 
+static const std::string kClipKernel = "Kernel";
+
+static const std::string kParamType          = "type";
+static const std::string kParamTypeSeparable = "separable";
+static const std::string kParamType2D        = "2D";
+
+enum EParamType
+{
+	eParamTypeSeparable = 0,
+	eParamType2D
+};
+
+static const std::string kParamNormalizeKernel = "normalizeKernel";
+
 static const std::string kParamSize     = "size";
 static const unsigned int kParamSizeMax = 9;
 static const std::string kParamCoef     = "coef_";
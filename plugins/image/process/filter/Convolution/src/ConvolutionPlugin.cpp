@@ -13,6 +13,10 @@ namespace convolution {
 ConvolutionPlugin::ConvolutionPlugin( OfxImageEffectHandle handle )
 	: ImageEffectGilPlugin( handle )
 {
+	_clipKernel = fetchClip( kClipKernel );
+
+	_paramType = fetchChoiceParam( kParamType );
+	_paramNormalizeKernel = fetchBooleanParam( kParamNormalizeKernel );
 	_paramSize = fetchInt2DParam( kParamSize );
 	_paramBorder = fetchChoiceParam( kParamBorder );
 
@@ -37,6 +41,10 @@ ConvolutionProcessParams ConvolutionPlugin::getProcessParams() const
 
 	params._size.x = boost::numeric_cast<unsigned int>( size.x );
 	params._size.y = boost::numeric_cast<unsigned int>( size.y );
+
+	// the kernel clip is a 2D kernel
+	params._type = _clipKernel->isConnected() ? eParamType2D : static_cast<EParamType>( _paramType->getValue() );
+	params._normalizeKernel = _paramNormalizeKernel->getValue();
 	
 	params._boundary_option = convolve_option_extend_mirror;
 	params._border = static_cast<EParamBorder>( _paramBorder->getValue() );
@@ -56,28 +64,42 @@ ConvolutionProcessParams ConvolutionPlugin::getProcessParams() const
 			params._boundary_option = convolve_option_extend_padded;
 			break;
 	}
-	params._convX.resize( params._size.x );
-	params._convY.resize( params._size.y );
-	for( unsigned int i = 0; i < params._size.x; ++i )
-	{
-		params._convX[i] = _paramCoef[0][i]->getValue();
-	}
-	for( unsigned int i = 0; i < params._size.y; ++i )
-	{
-		params._convY[i] = _paramCoef[1][i]->getValue();
-	}
-	/*
-	params._convMatrix.resize( params._size.x, params._size.y );
-	for( unsigned int y = 0; y < params._size.y; ++y )
+	switch( params._type )
 	{
-//		unsigned int yy = y * params._size.x;
-		for( unsigned int x = 0; x < params._size.x; ++x )
+		case eParamTypeSeparable:
 		{
-			params._convMatrix(x, y) = _paramCoef[y][x]->getValue();
-			TUTTLE_LOG_INFO( "coef[" << y << "][" << x << "] = " << params._convMatrix(x, y) );
+			params._convX.resize( params._size.x );
+			params._convY.resize( params._size.y );
+			for( unsigned int i = 0; i < params._size.x; ++i )
+			{
+				params._convX[i] = _paramCoef[0][i]->getValue();
+			}
+			for( unsigned int i = 0; i < params._size.y; ++i )
+			{
+				params._convY[i] = _paramCoef[1][i]->getValue();
+			}
+			break;
+		}
+		case eParamType2D:
+		{
+			if( _clipKernel->isConnected() )
+				break; // the kernel is read from the clip at render time
+
+			// the first line of coefficients is the top of the kernel,
+			// and the images are from bottom to top
+			params._convMatrix = terry::filter::kernel_2d<ConvolutionProcessParams::Scalar>( params._size.x, params._size.y );
+			for( unsigned int y = 0; y < params._size.y; ++y )
+			{
+				for( unsigned int x = 0; x < params._size.x; ++x )
+				{
+					params._convMatrix( x, params._size.y - 1 - y ) = _paramCoef[y][x]->getValue();
+				}
+			}
+			if( params._normalizeKernel )
+				params._convMatrix.normalize();
+			break;
 		}
 	}
-	*/
 	return params;
 }
 
@@ -90,6 +112,23 @@ void ConvolutionPlugin::render( const OFX::RenderArguments& args )
 	doGilRender<ConvolutionProcess>( *this, args );
 }
 
+OfxRectD ConvolutionPlugin::getKernelMargins( const OfxTime time ) const
+{
+	OfxRectD margins;
+	if( _clipKernel->isConnected() )
+	{
+		// the kernel is centered on its image, and flipped
+		const OfxRectD kernelRod = _clipKernel->getCanonicalRod( time );
+		margins.x1 = margins.x2 = ( kernelRod.x2 - kernelRod.x1 ) * 0.5;
+		margins.y1 = margins.y2 = ( kernelRod.y2 - kernelRod.y1 ) * 0.5;
+		return margins;
+	}
+	const OfxPointI size = _paramSize->getValue();
+	margins.x1 = margins.x2 = size.x * 0.5;
+	margins.y1 = margins.y2 = size.y * 0.5;
+	return margins;
+}
+
 bool ConvolutionPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
 {
 	const ConvolutionProcessParams params = getProcessParams();
@@ -98,11 +137,22 @@ bool ConvolutionPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArgu
 	switch( params._border )
 	{
 		case eParamBorderPadded:
-			rod.x1 = srcRod.x1 + params._convX.left_size();
-			rod.y1 = srcRod.y1 + params._convY.left_size();
-			rod.x2 = srcRod.x2 - params._convX.right_size();
-			rod.y2 = srcRod.y2 - params._convY.right_size();
+		{
+			if( params._type == eParamTypeSeparable )
+			{
+				rod.x1 = srcRod.x1 + params._convX.left_size();
+				rod.y1 = srcRod.y1 + params._convY.left_size();
+				rod.x2 = srcRod.x2 - params._convX.right_size();
+				rod.y2 = srcRod.y2 - params._convY.right_size();
+				return true;
+			}
+			const OfxRectD margins = getKernelMargins( args.time );
+			rod.x1 = srcRod.x1 + margins.x1;
+			rod.y1 = srcRod.y1 + margins.y1;
+			rod.x2 = srcRod.x2 - margins.x2;
+			rod.y2 = srcRod.y2 - margins.y2;
 			return true;
+		}
 		default:
 			break;
 	}
@@ -112,16 +162,18 @@ bool ConvolutionPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArgu
 void ConvolutionPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois )
 {
 	OfxRectD srcRoi = args.regionOfInterest;
-	const OfxPointI size  = _paramSize->getValue();
-	OfxPointD halfSize;
-
-	halfSize.x = size.x * 0.5;
-	halfSize.y = size.y * 0.5;
-	srcRoi.x1 -= halfSize.x;
-	srcRoi.x2 += halfSize.x;
-	srcRoi.y1 -= halfSize.y;
-	srcRoi.y2 += halfSize.y;
+	const OfxRectD margins = getKernelMargins( args.time );
+
+	srcRoi.x1 -= margins.x1;
+	srcRoi.x2 += margins.x2;
+	srcRoi.y1 -= margins.y1;
+	srcRoi.y2 += margins.y2;
 	rois.setRegionOfInterest( *_clipSrc, srcRoi );
+
+	if( _clipKernel->isConnected() )
+	{
+		rois.setRegionOfInterest( *_clipKernel, _clipKernel->getCanonicalRod( args.time ) );
+	}
 }
 
 bool ConvolutionPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime )
@@ -145,19 +197,29 @@ void ConvolutionPlugin::changedParam( const OFX::InstanceChangedArgs& args, cons
 		oddNumber.y = v.y | 1; // odd number
 		if( oddNumber != v )
 			_paramSize->setValue( oddNumber );
-		
-		// separable convolution
-		for( unsigned int x = 0; x < kParamSizeMax; ++x )
-		{
-			_paramCoef[0][x]->setIsSecretAndDisabled( static_cast<int>(x) >= v.x );
-			_paramCoef[1][x]->setIsSecretAndDisabled( static_cast<int>(x) >= v.y );
-		}
-		// disable other matrix values
-		for( unsigned int y = 2; y < kParamSizeMax; ++y )
+	}
+	if( ( paramName == kParamSize || paramName == kParamType ) && args.reason == OFX::eChangeUserEdit )
+	{
+		const OfxPointI v = _paramSize->getValue();
+		const EParamType type = static_cast<EParamType>( _paramType->getValue() );
+		for( unsigned int y = 0; y < kParamSizeMax; ++y )
 		{
 			for( unsigned int x = 0; x < kParamSizeMax; ++x )
 			{
-				_paramCoef[y][x]->setIsSecretAndDisabled( true );
+				bool hidden = true;
+				switch( type )
+				{
+					case eParamTypeSeparable:
+						// first line: horizontal kernel, second line: vertical kernel
+						hidden = ( y == 0 && static_cast<int>(x) >= v.x ) ||
+						         ( y == 1 && static_cast<int>(x) >= v.y ) ||
+						         y > 1;
+						break;
+					case eParamType2D:
+						hidden = static_cast<int>(x) >= v.x || static_cast<int>(y) >= v.y;
+						break;
+				}
+				_paramCoef[y][x]->setIsSecretAndDisabled( hidden );
 			}
 		}
 	}
@@ -6,8 +6,7 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
 #include <terry/filter/convolve.hpp>
-
-//#include <boost/numeric/ublas/matrix.hpp>
+#include <terry/filter/correlate2d.hpp>
 
 #include <vector>
 
@@ -17,10 +16,11 @@ namespace convolution {
 
 struct ConvolutionProcessParams
 {
-//	boost::numeric::ublas::matrix<double> _convMatrix;
 	typedef float Scalar;
 	typedef terry::filter::kernel_1d<Scalar> Kernel;
 	
+	EParamType _type;
+	bool _normalizeKernel;
 	boost::gil::point2<unsigned int> _size;
 	
 	EParamBorder _border;
@@ -28,6 +28,9 @@ struct ConvolutionProcessParams
 	
 	Kernel _convX;
 	Kernel _convY;
+
+	/// 2D kernel from the coefficients, replaced by the kernel clip if connected
+	terry::filter::kernel_2d<Scalar> _convMatrix;
 };
 
 /**
@@ -49,7 +52,14 @@ public:
 
 	ConvolutionProcessParams getProcessParams() const;
 
+	/// @brief Margins of the source used around each pixel
+	OfxRectD getKernelMargins( const OfxTime time ) const;
+
 public:
+	OFX::Clip* _clipKernel;
+
+	OFX::ChoiceParam* _paramType;
+	OFX::BooleanParam* _paramNormalizeKernel;
 	OFX::Int2DParam* _paramSize;
 	OFX::ChoiceParam* _paramBorder;
 	std::vector<std::vector<OFX::DoubleParam*> > _paramCoef;
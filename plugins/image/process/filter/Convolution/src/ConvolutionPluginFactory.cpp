@@ -41,6 +41,12 @@ void ConvolutionPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 "impulse response filters in signal processing."
 "\n"
 "\n"
+"The kernel is separable (a horizontal and a vertical kernel) or 2D, from the "
+"coefficients or from an image connected to the Kernel clip. The big 2D kernels "
+"are computed in the frequency domain (FFT), with a cost growing with the log "
+"of the kernel size."
+"\n"
+"\n"
 "http://en.wikipedia.org/wiki/Convolution"
 );
 
@@ -80,6 +86,26 @@ void ConvolutionPluginFactory::describeInContext( OFX::ImageEffectDescriptor& de
 	dstClip->addSupportedComponent( OFX::ePixelComponentAlpha );
 	dstClip->setSupportsTiles( kSupportTiles );
 
+	// Optional 2D kernel image, like a bokeh shape
+	OFX::ClipDescriptor* kernelClip = desc.defineClip( kClipKernel );
+	kernelClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	kernelClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	kernelClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	kernelClip->setSupportsTiles( false );
+	kernelClip->setOptional( true );
+
+	OFX::ChoiceParamDescriptor* type = desc.defineChoiceParam( kParamType );
+	type->setLabel( "Type" );
+	type->appendOption( kParamTypeSeparable, "Separable: the first line of coefficients is the horizontal kernel, the second line is the vertical kernel." );
+	type->appendOption( kParamType2D, "2D: the matrix of coefficients, the first line is the top of the kernel." );
+	type->setDefault( eParamTypeSeparable );
+	type->setHint( "Always 2D if the Kernel clip is connected." );
+
+	OFX::BooleanParamDescriptor* normalizeKernel = desc.defineBooleanParam( kParamNormalizeKernel );
+	normalizeKernel->setLabel( "Normalize kernel" );
+	normalizeKernel->setHint( "Divide the 2D kernel by the sum of its values, to preserve the luminosity." );
+	normalizeKernel->setDefault( true );
+
 	OFX::Int2DParamDescriptor* size = desc.defineInt2DParam( kParamSize );
 	size->setLabel( "Size" );
 	size->setDefault( 3, 3 );
@@ -26,11 +26,18 @@ protected:
 	ConvolutionPlugin&    _plugin;        ///< Rendering plugin
 	ConvolutionProcessParams _params;
 
+	bool _useFft; ///< 2D kernel big enough to be faster in the frequency domain
+	terry::filter::fft_correlation_kernel<Scalar> _fftKernel; ///< spectrum of the 2D kernel, shared by all the tiles
+
 public:
 	ConvolutionProcess( ConvolutionPlugin& instance );
 
 	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	/// @brief Read the 2D kernel from the kernel clip
+	void fetchKernel( const OFX::RenderArguments& args );
 };
 
 }
@@ -2,6 +2,9 @@
 
 #include <terry/globals.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/correlate2d.hpp>
+
+#include <boost/gil/color_convert.hpp>
 
 #include <tuttle/plugin/exceptions.hpp>
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
@@ -15,6 +18,7 @@ template<class View>
 ConvolutionProcess<View>::ConvolutionProcess( ConvolutionPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromBottomToTop )
 	, _plugin( instance )
+	, _useFft( false )
 {}
 
 template <class View>
@@ -22,6 +26,55 @@ void ConvolutionProcess<View>::setup( const OFX::RenderArguments& args )
 {
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams();
+
+	if( _params._type != eParamType2D )
+		return;
+
+	if( _plugin._clipKernel->isConnected() )
+		fetchKernel( args );
+
+	// the spectrum of the kernel is computed once for all the tiles
+	_useFft = terry::filter::is_correlate_2d_fft_faster( _params._convMatrix.width(), _params._convMatrix.height() );
+	if( _useFft )
+		_fftKernel.reset( _params._convMatrix );
+}
+
+template <class View>
+void ConvolutionProcess<View>::fetchKernel( const OFX::RenderArguments& args )
+{
+	using namespace boost::gil;
+
+	boost::scoped_ptr<OFX::Image> kernelImg( _plugin._clipKernel->fetchImage( args.time ) );
+	if( !kernelImg.get() )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageNotReady() );
+	}
+	if( kernelImg->getRowDistanceBytes() == 0 )
+	{
+		BOOST_THROW_EXCEPTION( exception::WrongRowBytes() );
+	}
+	const OfxRectI kernelPixelRod = _plugin._clipKernel->getPixelRod( args.time, args.renderScale );
+	const View kernelView = this->getView( kernelImg.get(), kernelPixelRod );
+
+	// The kernel image is the response to a single point of light (like a bokeh),
+	// so it is flipped to convolve and not to correlate.
+	const std::size_t width = kernelView.width();
+	const std::size_t height = kernelView.height();
+	_params._convMatrix = terry::filter::kernel_2d<Scalar>( width, height );
+	for( std::size_t y = 0; y < height; ++y )
+	{
+		typename View::x_iterator it = kernelView.row_begin( y );
+		for( std::size_t x = 0; x < width; ++x, ++it )
+		{
+			gray32f_pixel_t value;
+			color_convert( *it, value );
+			_params._convMatrix( width - 1 - x, height - 1 - y ) = get_color( value, gray_color_t() );
+		}
+	}
+	_params._convMatrix.set_center( Point( width - 1 - width / 2, height - 1 - height / 2 ) );
+
+	if( _params._normalizeKernel )
+		_params._convMatrix.normalize();
 }
 
 /**
@@ -43,28 +96,28 @@ void ConvolutionProcess<View>::multiThreadProcessImages( const OfxRectI& procWin
 	                          procWindowSize.x, procWindowSize.y );
 
 	Point proc_tl( procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1 );
-	/*
-	switch( _params._convType )
+	switch( _params._type )
 	{
-		case eConv1D:
+		case eParamTypeSeparable:
 		{
-		*/
 			if( _params._size.x == 0 )
 				correlate_cols_auto<Pixel>( this->_srcView, _params._convY, dst, proc_tl, _params._boundary_option );
 			else if( _params._size.y == 0 )
 				correlate_rows_auto<Pixel>( this->_srcView, _params._convX, dst, proc_tl, _params._boundary_option );
 			else
 				correlate_rows_cols_auto<Pixel, OfxAllocator>( this->_srcView, _params._convX, _params._convY, dst, proc_tl, _params._boundary_option );
-		/*
 			break;
 		}
-		case eConv2D:
+		case eParamType2D:
 		{
-//			_params._convMatrix
+			// the tiles are already processed in parallel, so only one thread per tile
+			if( _useFft )
+				correlate_2d_fft( this->_srcView, _fftKernel, dst, proc_tl, _params._boundary_option );
+			else
+				correlate_2d_direct( this->_srcView, _params._convMatrix, dst, proc_tl, _params._boundary_option );
 			break;
 		}
 	}
-	*/
 }
 
 }
@@ -2,6 +2,10 @@
 #define _TUTTLE_PLUGIN_FLOODFILL_PROCESS_HPP_
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <terry/filter/connectedComponents.hpp>
+
 #include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
@@ -27,6 +31,9 @@ protected :
 	Scalar _lowerThres;
 	Scalar _upperThres;
 
+	OfxRectI _labellingWindow; ///< region of the labelling, in the src clip coordinates
+	terry::filter::connectedComponents::component_labelling<OfxAllocator> _labelling; ///< components of the render window
+
 public:
     FloodFillProcess( FloodFillPlugin& effect );
 
@@ -4,6 +4,7 @@
 #include <tuttle/plugin/ofxToGil/point.hpp>
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
+#include <tuttle/plugin/OfxThreadExecutor.hpp>
 
 #include <terry/globals.hpp>
 #include <terry/filter/floodFill.hpp>
@@ -23,7 +24,6 @@ FloodFillProcess<View>::FloodFillProcess( FloodFillPlugin &effect )
 : ImageGilFilterProcessor<View>( effect, eImageOrientationIndependant )
 , _plugin( effect )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -57,6 +57,34 @@ void FloodFillProcess<View>::setup( const OFX::RenderArguments& args )
 		_lowerThres = _params._lowerThres;
 		_upperThres = _params._upperThres;
 	}
+
+	// The components are not limited to the rows of a render thread,
+	// so they are labelled on the full render window, in parallel.
+	static const unsigned int border = 1;
+	const OfxRectI srcRodCrop = rectangleReduce( this->_srcPixelRod, border );
+	_labellingWindow = rectanglesIntersection( args.renderWindow, srcRodCrop );
+
+	if( _isConstantImage ||
+	    _params._method == eParamMethodBruteForce ||
+	    _labellingWindow.x2 <= _labellingWindow.x1 ||
+	    _labellingWindow.y2 <= _labellingWindow.y1 )
+		return;
+
+	using namespace terry::filter::floodFill;
+	const View srcLabellingView = subimage_view( this->_srcView,
+		_labellingWindow.x1 - this->_srcPixelRod.x1, _labellingWindow.y1 - this->_srcPixelRod.y1,
+		_labellingWindow.x2 - _labellingWindow.x1, _labellingWindow.y2 - _labellingWindow.y1 );
+	switch( _params._method )
+	{
+		case eParamMethod4:
+			_labelling.template compute<Connexity4>( srcLabellingView, IsUpper<Scalar>(_lowerThres), IsUpper<Scalar>(_upperThres), OfxThreadExecutor() );
+			break;
+		case eParamMethod8:
+			_labelling.template compute<Connexity8>( srcLabellingView, IsUpper<Scalar>(_lowerThres), IsUpper<Scalar>(_upperThres), OfxThreadExecutor() );
+			break;
+		case eParamMethodBruteForce:
+			break;
+	}
 }
 
 /**
@@ -69,53 +97,24 @@ void FloodFillProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 	using namespace boost::gil;
 	using namespace terry;
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
-	
-	static const unsigned int border = 1;
-	const OfxRectI srcRodCrop = rectangleReduce( this->_srcPixelRod, border );
-	const OfxRectI procWindowRoWCrop = rectanglesIntersection( procWindowRoW, srcRodCrop );
 
 	terry::draw::fill_pixels( this->_dstView, ofxToGil(procWindowOutput), get_black<Pixel>() );
 
-	if( _isConstantImage )
+	if( _isConstantImage || _params._method == eParamMethodBruteForce ) // brute force: not in production
 		return;
 
-	using namespace terry::filter::floodFill;
-	
-	switch( _params._method )
+	const OfxRectI procWindowLabelled = rectanglesIntersection( procWindowRoW, _labellingWindow );
+	static const Pixel white = get_white<Pixel>();
+	for( int y = procWindowLabelled.y1; y < procWindowLabelled.y2; ++y )
 	{
-		case eParamMethod4:
+		typename View::x_iterator dstIt = this->_dstView.x_at( procWindowLabelled.x1 - this->_dstPixelRod.x1, y - this->_dstPixelRod.y1 );
+		for( int x = procWindowLabelled.x1; x < procWindowLabelled.x2; ++x, ++dstIt )
 		{
-			flood_fill<Connexity4, IsUpper<Scalar>, IsUpper<Scalar>, View, View, OfxAllocator>(
-				this->_srcView, ofxToGil(this->_srcPixelRod),
-				this->_dstView, ofxToGil(this->_dstPixelRod),
-				ofxToGil(procWindowRoWCrop),
-				IsUpper<Scalar>(_upperThres),
-				IsUpper<Scalar>(_lowerThres)
-				);
-			break;
-		}
-		case eParamMethod8:
-		{
-			flood_fill<Connexity8, IsUpper<Scalar>, IsUpper<Scalar>, View, View, OfxAllocator>(
-				this->_srcView, ofxToGil(this->_srcPixelRod),
-				this->_dstView, ofxToGil(this->_dstPixelRod),
-				ofxToGil(procWindowRoWCrop),
-				IsUpper<Scalar>(_upperThres),
-				IsUpper<Scalar>(_lowerThres)
-				);
-			break;
-		}
-		case eParamMethodBruteForce: // not in production
-		{
-//			flood_fill_bruteForce<IsUpper<Scalar>, IsUpper<Scalar>, View, View>(
-//				this->_srcView, ofxToGil(this->_srcPixelRod),
-//				this->_dstView, ofxToGil(this->_dstPixelRod),
-//				ofxToGil(procWindowRoWCrop),
-//				IsUpper<Scalar>(_upperThres),
-//				IsUpper<Scalar>(_lowerThres)
-//				);
-			break;
+			if( _labelling.isSeeded( x - _labellingWindow.x1, y - _labellingWindow.y1 ) )
+				*dstIt = white;
 		}
+		if( this->progressForward( procWindowLabelled.x2 - procWindowLabelled.x1 ) )
+			return;
 	}
 }
 
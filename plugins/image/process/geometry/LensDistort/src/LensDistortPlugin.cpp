@@ -36,6 +36,8 @@ LensDistortPlugin::LensDistortPlugin( OfxImageEffectHandle handle )
 	_postScale            = fetchDoubleParam        ( kParamPostScale );
 	_resizeRod            = fetchChoiceParam        ( kParamResizeRod );
 	_resizeRodManualScale = fetchDoubleParam        ( kParamResizeRodManualScale );
+	_cacheCoordinates     = fetchBooleanParam       ( kParamCacheCoordinates );
+	_output               = fetchChoiceParam        ( kParamOutput );
 	_groupDisplayParams   = fetchGroupParam         ( kParamDisplayOptions );
 	_gridOverlay          = fetchBooleanParam       ( kParamGridOverlay );
 	_gridCenter           = fetchDouble2DParam      ( kParamGridCenter );
@@ -119,6 +121,11 @@ void LensDistortPlugin::changedParam( const OFX::InstanceChangedArgs& args, cons
 	{
 		redrawOverlays();
 	}
+	else if( paramName == kParamCacheCoordinates )
+	{
+		if( ! _cacheCoordinates->getValue() )
+			_coordinateMapCache.clear();
+	}
 }
 
 bool LensDistortPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime )
@@ -129,7 +136,8 @@ bool LensDistortPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*
 	{
 		isIdentity = true;
 	}
-	else if( _coef1->getValue() == 0 /*_coef1->getDefault( )*/ &&
+	else if( getOutput() == eParamOutputImage &&
+	         _coef1->getValue() == 0 /*_coef1->getDefault( )*/ &&
 	         _preScale->getValue() == _preScale->getDefault() &&
 	         _postScale->getValue() == _postScale->getDefault() &&
 	         ( !_coef2->getIsEnable() || _coef2->getValue() == _coef2->getDefault() ) &&
@@ -397,6 +405,8 @@ LensDistortParams LensDistortPlugin::getProcessParams(  ) const
 
 	lensDistortParams._lensType          = (tuttle::plugin::lens::EParamLensType)   _lensType        -> getValue();
 	lensDistortParams._centerType        = (tuttle::plugin::lens::EParamCenterType) _centerType      -> getValue();
+	lensDistortParams._cacheCoordinates  = _cacheCoordinates -> getValue();
+	lensDistortParams._output            = getOutput();
 
 	return lensDistortParams;
 }
@@ -6,6 +6,7 @@
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/context/SamplerPlugin.hpp>
+#include <tuttle/plugin/CoordinateMapCache.hpp>
 
 #include <boost/gil/utilities.hpp>
 #include <string>
@@ -18,6 +19,8 @@ struct LensDistortParams
 {
 	EParamLensType                             _lensType;
 	EParamCenterType                           _centerType;
+	bool                                       _cacheCoordinates;
+	EParamOutput                               _output;
 
 	SamplerProcessParams                       _samplerProcessParams;
 };
@@ -51,6 +54,8 @@ public:
 	OFX::DoubleParam*   _preScale;             ///< scale before applying the lens distortion
 	OFX::ChoiceParam*   _resizeRod;            ///< Choice how to resize the RoD (default 'no' resize)
 	OFX::DoubleParam*   _resizeRodManualScale; ///< scale the output RoD
+	OFX::BooleanParam*  _cacheCoordinates;     ///< reuse the source coordinates between frames
+	OFX::ChoiceParam*   _output;               ///< output the image or the coordinates (STMap)
 
 	OFX::GroupParam*    _groupDisplayParams;   ///< group of all overlay options (don't modify the output image)
 	OFX::BooleanParam*  _gridOverlay;          ///< grid overlay
@@ -70,6 +75,8 @@ public:
 	static OfxRectD     _srcRealRoi;
 	///@}
 
+	CoordinateMapCache  _coordinateMapCache;   ///< source coordinates of the last rendered parameters
+
 public:
 	LensDistortPlugin( OfxImageEffectHandle handle );
 
@@ -96,6 +103,7 @@ public:
 	const EParamLensType                 getLensType  () const     { return static_cast<EParamLensType     >( _lensType->getValue()      ); }
 	const EParamCenterType               getCenterType() const    { return static_cast<EParamCenterType   >( _centerType->getValue()    ); }
 	const EParamResizeRod                getResizeRod () const    { return static_cast<EParamResizeRod    >( _resizeRod->getValue()     ); }
+	const EParamOutput                   getOutput    () const    { return static_cast<EParamOutput       >( _output->getValue()        ); }
 
 private:
 	void initParamsProps();
@@ -206,6 +206,20 @@ void LensDistortPluginFactory::describeInContext( OFX::ImageEffectDescriptor& de
         scaleRod->setDisplayRange( 0, 2.5 );
         scaleRod->setHint( "Adjust the output RoD." );
 
+        OFX::BooleanParamDescriptor* cacheCoordinates = desc.defineBooleanParam( kParamCacheCoordinates );
+        cacheCoordinates->setLabel( "Cache coordinates" );
+        cacheCoordinates->setDefault( true );
+        cacheCoordinates->setEvaluateOnChange( false );
+        cacheCoordinates->setHint( "Compute the source position of each output pixel once, and reuse it for all the frames rendered with the same parameters.\n"
+                                   "Only the sampling remains for each frame, but it uses 8 bytes of memory per output pixel." );
+
+        OFX::ChoiceParamDescriptor* output = desc.defineChoiceParam( kParamOutput );
+        output->setLabel( "Output" );
+        output->appendOption( kParamOutputImage, "Image: the distorted source image" );
+        output->appendOption( kParamOutputSTMap, "STMap: the normalized source position of each pixel in red and green (use a float bit depth)" );
+        output->setDefault( eParamOutputImage );
+        output->setHint( "Output the image, or the coordinates to apply the same distortion in another application." );
+
         OFX::GroupParamDescriptor* displayOptions = desc.defineGroupParam( kParamDisplayOptions );
         displayOptions->setLabel( "Display options" );
         displayOptions->setHint( "Display options (change nothing on the image)" );
@@ -33,6 +33,7 @@ protected:
 	LensDistortProcessParams<Scalar> _p;
 
 	LensDistortParams                _params;
+	CoordinateMapCache::ConstMapPtr  _coordinateMap; ///< source coordinates of the output pixels, if cached
 
 public:
 	LensDistortProcess( LensDistortPlugin& instance );
@@ -42,6 +43,8 @@ public:
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 private:
+	CoordinateMapCache::ConstMapPtr getCoordinateMap();
+
 	template<class Sampler>
 	void lensDistort( View& srcView, View& dstView, const OfxRectI& procWindow, const Sampler& sampler=Sampler() );
 };
@@ -34,6 +34,45 @@ void LensDistortProcess<View>::setup( const OFX::RenderArguments& args )
 	{
 		_p = _plugin.getProcessParams( srcRod, dstRod, this->_clipDst->getPixelAspectRatio() );
 	}
+
+	if( _params._cacheCoordinates || _params._output == eParamOutputSTMap )
+		_coordinateMap = getCoordinateMap();
+}
+
+/**
+ * @brief Source coordinates of all the pixels of the output image, from the plugin cache.
+ */
+template<class View>
+CoordinateMapCache::ConstMapPtr LensDistortProcess<View>::getCoordinateMap()
+{
+	const terry::Rect<std::ssize_t> region( 0, 0, this->_dstView.width(), this->_dstView.height() );
+	std::size_t key = hash_value( _p );
+	boost::hash_combine( key, static_cast<int>( _params._lensType ) );
+
+	CoordinateMapCache& cache = _plugin._coordinateMapCache;
+	switch( _params._lensType )
+	{
+		case eParamLensTypeStandard:
+		{
+			if( _p._distort )
+				return cache.get( key, region, static_cast<const NormalLensDistortParams<double>&>( _p ) );
+			return cache.get( key, region, static_cast<const NormalLensUndistortParams<double>&>( _p ) );
+		}
+		case eParamLensTypeFisheye:
+		{
+			if( _p._distort )
+				return cache.get( key, region, static_cast<const FisheyeLensDistortParams<double>&>( _p ) );
+			return cache.get( key, region, static_cast<const FisheyeLensUndistortParams<double>&>( _p ) );
+		}
+		case eParamLensTypeAdvanced:
+		{
+			if( _p._distort )
+				return cache.get( key, region, static_cast<const AdvancedLensDistortParams<double>&>( _p ) );
+			return cache.get( key, region, static_cast<const AdvancedLensUndistortParams<double>&>( _p ) );
+		}
+	}
+	BOOST_THROW_EXCEPTION( exception::Bug()
+		<< exception::user( "Lens type not recognize." ) );
 }
 
 /**
@@ -47,6 +86,13 @@ void LensDistortProcess<View>::multiThreadProcessImages( const OfxRectI& procWin
 	using namespace terry::sampler;
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 
+	if( _params._output == eParamOutputSTMap )
+	{
+		const terry::point2<double> srcSize( this->_srcView.width(), this->_srcView.height() );
+		coordinate_map_to_view( *_coordinateMap, this->_dstView, ofxToGil( procWindowOutput ), srcSize );
+		return;
+	}
+
 	switch( _params._samplerProcessParams._filter )
 	{
 		case eParamFilterNearest:
@@ -144,6 +190,11 @@ void LensDistortProcess<View>::lensDistort( View& srcView, View& dstView, const
 	using namespace terry::sampler;
 	EParamFilterOutOfImage outOfImageProcess = _params._samplerProcessParams._outOfImageProcess;
 	terry::Rect<std::ssize_t> procWin = ofxToGil(procWindow);
+	if( _coordinateMap )
+	{
+		resample_pixels_progress( srcView, dstView, *_coordinateMap, procWin, outOfImageProcess, this->getOfxProgress(), sampler );
+		return;
+	}
 	switch( _params._lensType )
 	{
 		case eParamLensTypeStandard:
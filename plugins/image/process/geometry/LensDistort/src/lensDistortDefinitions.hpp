@@ -47,6 +47,16 @@ enum EParamResizeRod
 };
 
 static const std::string kParamResizeRodManualScale    ( "scaleRod" );
+static const std::string kParamCacheCoordinates        ( "cacheCoordinates" );
+static const std::string kParamOutput                  ( "output" );
+static const std::string kParamOutputImage             ( "image" );
+static const std::string kParamOutputSTMap             ( "stmap" );
+enum EParamOutput
+{
+	eParamOutputImage = 0,
+	eParamOutputSTMap,
+};
+
 static const std::string kParamDisplayOptions          ( "displayOptions" );
 static const std::string kParamGridOverlay             ( "gridOverlay" );
 static const std::string kParamGridCenter              ( "gridCenter" );
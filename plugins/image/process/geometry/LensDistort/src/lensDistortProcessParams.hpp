@@ -4,6 +4,8 @@
 #include <tuttle/plugin/global.hpp>
 #include <terry/globals.hpp>
 
+#include <boost/functional/hash.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace lens {
@@ -184,6 +186,30 @@ public:
 	virtual ~LensDistortProcessParams() {}
 };
 
+/**
+ * @brief Hash of all the values used by the transformations (boost::hash support).
+ */
+template<typename F>
+std::size_t hash_value( const LensDistortProcessParams<F>& p )
+{
+	std::size_t seed = 0;
+	boost::hash_combine( seed, p._distort );
+	boost::hash_combine( seed, p._coef1 );
+	boost::hash_combine( seed, p._coef2 );
+	boost::hash_combine( seed, p._squeeze );
+	boost::hash_combine( seed, p._imgHalfDiagonal );
+	boost::hash_combine( seed, p._pixelRatio );
+	const typename LensDistortProcessParams<F>::Point2* points[] = {
+		&p._asymmetric, &p._imgSizeSrc, &p._imgCenterSrc, &p._imgCenterDst,
+		&p._lensCenterDst, &p._lensCenterSrc, &p._postScale, &p._preScale };
+	for( std::size_t i = 0; i < sizeof( points ) / sizeof( points[0] ); ++i )
+	{
+		boost::hash_combine( seed, points[i]->x );
+		boost::hash_combine( seed, points[i]->y );
+	}
+	return seed;
+}
+
 }
 }
 }
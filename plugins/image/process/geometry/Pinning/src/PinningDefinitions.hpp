@@ -23,6 +23,16 @@ static const std::string kParamSetToCornersIn           = "setToCornersIn";
 static const std::string kParamSetToCornersOut          = "setToCornersOut";
 static const std::string kParamOverlay                  = "overlay";
 static const std::string kParamInverse                  = "inverse";
+static const std::string kParamCacheCoordinates         = "cacheCoordinates";
+
+static const std::string kParamOutput                   = "output";
+static const std::string kParamOutputImage              = "image";
+static const std::string kParamOutputSTMap              = "stmap";
+enum EParamOutput
+{
+	eParamOutputImage = 0,
+	eParamOutputSTMap
+};
 
 static const std::string kParamGroupCentre              = "groupCentre";
 static const std::string kParamPointCentre              = "pCentre";
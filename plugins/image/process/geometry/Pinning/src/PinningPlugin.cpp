@@ -31,6 +31,8 @@ PinningPlugin::PinningPlugin( OfxImageEffectHandle handle )
 	_paramSetToCornersOut = fetchPushButtonParam( kParamSetToCornersOut );
 	_paramOverlay       = fetchBooleanParam( kParamOverlay );
 	_paramInverse       = fetchBooleanParam( kParamInverse );
+	_paramCacheCoordinates = fetchBooleanParam( kParamCacheCoordinates );
+	_paramOutput        = fetchChoiceParam( kParamOutput );
 
 	/*
 	//TODO-vince //
@@ -101,6 +103,8 @@ PinningProcessParams<PinningPlugin::Scalar> PinningPlugin::getProcessParams( con
 	params._bilinear._height = height;
 
 	params._method        = static_cast<EParamMethod>( _paramMethod->getValue() );
+	params._cacheCoordinates = _paramCacheCoordinates->getValue();
+	params._output        = static_cast<EParamOutput>( _paramOutput->getValue() );
 
 	SamplerPlugin::fillProcessParams( params._samplerProcessParams );
 
@@ -396,6 +400,11 @@ void PinningPlugin::changedParam( const OFX::InstanceChangedArgs& args, const st
 			}
 		}
 	}
+	else if( paramName == kParamCacheCoordinates )
+	{
+		if( ! _paramCacheCoordinates->getValue() )
+			_coordinateMapCache.clear();
+	}
 }
 
 bool PinningPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime )
@@ -434,6 +443,10 @@ bool PinningPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& id
 			break;
 		}
 	}
+	if( params._output == eParamOutputSTMap )
+	{
+		identity = false;
+	}
 	identityClip = _clipSrc;
 	identityTime = args.time;
 	return identity;
@@ -6,6 +6,7 @@
 #include <tuttle/plugin/global.hpp>
 
 #include <tuttle/plugin/context/SamplerPlugin.hpp>
+#include <tuttle/plugin/CoordinateMapCache.hpp>
 
 #include <ofxsImageEffect.h>
 
@@ -28,10 +29,37 @@ struct PinningProcessParams
 	terry::geometry::PinningBilinear<Scalar>        _bilinear;
 
 	EParamMethod            _method;
+	bool                    _cacheCoordinates;
+	EParamOutput            _output;
 	
 	SamplerProcessParams    _samplerProcessParams;
 };
 
+/**
+ * @brief Hash of the values used by the transformation of the method.
+ */
+template<typename Scalar>
+std::size_t hash_value( const PinningProcessParams<Scalar>& p )
+{
+	std::size_t seed = 0;
+	boost::hash_combine( seed, static_cast<int>( p._method ) );
+	switch( p._method )
+	{
+		case eParamMethodAffine:
+		case eParamMethodPerspective:
+			boost::hash_combine( seed, p._perspective._width );
+			boost::hash_combine( seed, p._perspective._height );
+			boost::hash_range( seed, p._perspective._matrix.data().begin(), p._perspective._matrix.data().end() );
+			break;
+		case eParamMethodBilinear:
+			boost::hash_combine( seed, p._bilinear._width );
+			boost::hash_combine( seed, p._bilinear._height );
+			boost::hash_range( seed, p._bilinear._matrix.data().begin(), p._bilinear._matrix.data().end() );
+			break;
+	}
+	return seed;
+}
+
 /**
  * @brief Pinning plugin
  */
@@ -60,6 +88,8 @@ public:
 	OFX::PushButtonParam* _paramSetToCornersIn;
 	OFX::PushButtonParam* _paramSetToCornersOut;
 	OFX::BooleanParam*    _paramInverse;
+	OFX::BooleanParam*    _paramCacheCoordinates;
+	OFX::ChoiceParam*     _paramOutput;
 
 //	OFX::ChoiceParam*  _paramManipulatorMode;
 	OFX::BooleanParam*    _paramOverlay;
@@ -99,6 +129,8 @@ public:
 	OFX::Double2DParam*   _paramBilMatrixRow1;
 	OFX::Double2DParam*   _paramBilMatrixRow2;
 	OFX::Double2DParam*   _paramBilMatrixRow3;
+
+	CoordinateMapCache    _coordinateMapCache; ///< source coordinates of the last rendered parameters
 };
 
 }
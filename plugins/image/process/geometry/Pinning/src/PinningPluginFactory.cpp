@@ -95,6 +95,20 @@ void PinningPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
         inverse->setLabel( "Inverse" );
         inverse->setDefault( false );
 
+        OFX::BooleanParamDescriptor* cacheCoordinates = desc.defineBooleanParam( kParamCacheCoordinates );
+        cacheCoordinates->setLabel( "Cache coordinates" );
+        cacheCoordinates->setDefault( false );
+        cacheCoordinates->setEvaluateOnChange( false );
+        cacheCoordinates->setHint( "Compute the source position of each output pixel once, and reuse it for all the frames rendered with the same pinning.\n"
+                                   "Useless if the points are animated, and it uses 8 bytes of memory per output pixel." );
+
+        OFX::ChoiceParamDescriptor* output = desc.defineChoiceParam( kParamOutput );
+        output->setLabel( "Output" );
+        output->appendOption( kParamOutputImage, "Image: the pinned source image" );
+        output->appendOption( kParamOutputSTMap, "STMap: the normalized source position of each pixel in red and green (use a float bit depth)" );
+        output->setDefault( eParamOutputImage );
+        output->setHint( "Output the image, or the coordinates to apply the same transformation in another application." );
+
 /*
         //TODO-vince///////////
         //////////////////// Transform Centre Point ////////////////////
@@ -22,6 +22,7 @@ protected :
     PinningPlugin&    _plugin;        ///< Rendering plugin
 
 	PinningProcessParams<Scalar> _params;
+	CoordinateMapCache::ConstMapPtr _coordinateMap; ///< source coordinates of the output pixels, if cached
 	
 public:
     PinningProcess( PinningPlugin& effect );
@@ -24,6 +24,23 @@ void PinningProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 
 	_params = _plugin.getProcessParams( args.time, args.renderScale );
+
+	if( _params._cacheCoordinates || _params._output == eParamOutputSTMap )
+	{
+		// source coordinates of all the pixels of the output image
+		const terry::Rect<std::ssize_t> region( 0, 0, this->_dstView.width(), this->_dstView.height() );
+		const std::size_t key = hash_value( _params );
+		switch( _params._method )
+		{
+			case eParamMethodAffine:
+			case eParamMethodPerspective:
+				_coordinateMap = _plugin._coordinateMapCache.get( key, region, _params._perspective );
+				break;
+			case eParamMethodBilinear:
+				_coordinateMap = _plugin._coordinateMapCache.get( key, region, _params._bilinear );
+				break;
+		}
+	}
 }
 
 /**
@@ -38,6 +55,13 @@ void PinningProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowR
 
 	const terry::Rect<std::ssize_t> procWindowOutput = ofxToGil( this->translateRoWToOutputClipCoordinates( procWindowRoW ) );
 
+	if( _params._output == eParamOutputSTMap )
+	{
+		const point2<double> srcSize( this->_srcView.width(), this->_srcView.height() );
+		coordinate_map_to_view( *_coordinateMap, this->_dstView, procWindowOutput, srcSize );
+		return;
+	}
+
 	switch( _params._samplerProcessParams._filter )
 	{
 		case eParamFilterNearest:
@@ -133,6 +157,11 @@ template<class Sampler>
 void PinningProcess<View>::resample( View& srcView, View& dstView, const terry::Rect<std::ssize_t>& procWindow, const Sampler& sampler )
 {
 	using namespace boost::gil;
+	if( _coordinateMap )
+	{
+		terry::sampler::resample_pixels_progress<Sampler>( srcView, dstView, *_coordinateMap, procWindow, _params._samplerProcessParams._outOfImageProcess, this->getOfxProgress(), sampler );
+		return;
+	}
 	switch( _params._method )
 	{
 		case eParamMethodAffine:
@@ -3,6 +3,10 @@
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
+#include <terry/geometry/affine.hpp>
+#include <terry/math/Rect.hpp>
+#include <terry/sampler/sampler.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace resize {
@@ -29,6 +33,10 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class Sampler>
+	void resample( const Sampler& sampler, const terry::matrix3x2<double>& mat, const terry::Rect<std::ssize_t>& procWin, const terry::sampler::EParamFilterOutOfImage outOfImageProcess );
 };
 
 }
@@ -1,5 +1,6 @@
 #include <tuttle/plugin/ofxToGil/rect.hpp>
 #include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
 #include <terry/geometry/affine.hpp>
 
 namespace tuttle {
@@ -64,40 +65,40 @@ void ResizeProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow )
 
 	switch( _params._samplerProcessParams._filter )
 	{
-		case eParamFilterNearest	: resample_pixels_progress< ::terry::sampler::nearest_neighbor_sampler >( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterBilinear	: resample_pixels_progress< ::terry::sampler::bilinear_sampler >( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterBC :
-		{
-			bc_sampler BCsampler( _params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), BCsampler );
-			break;
-		}
-		case eParamFilterBicubic  : resample_pixels_progress< bicubic_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterCatrom   : resample_pixels_progress< catrom_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterKeys     : resample_pixels_progress< keys_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterSimon    : resample_pixels_progress< simon_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterRifman   : resample_pixels_progress< rifman_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterMitchell : resample_pixels_progress< mitchell_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterParzen   : resample_pixels_progress< parzen_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterGaussian :
-		{
-			gaussian_sampler gaussianSampler ( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSigma );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), gaussianSampler );
-			break;
-		}
-		case eParamFilterLanczos  :
-		{
-			lanczos_sampler lanczosSampler ( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSharpen );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), lanczosSampler );
-			break;
-		}
-		case eParamFilterLanczos3	: resample_pixels_progress< lanczos3_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos4	: resample_pixels_progress< lanczos4_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos6	: resample_pixels_progress< lanczos6_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos12	: resample_pixels_progress< lanczos12_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
+		case eParamFilterNearest  : resample( nearest_neighbor_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterBilinear : resample( bilinear_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterBC       : resample( bc_sampler( _params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC ), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterBicubic  : resample( bicubic_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterCatrom   : resample( catrom_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterKeys     : resample( keys_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterSimon    : resample( simon_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterRifman   : resample( rifman_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterMitchell : resample( mitchell_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterParzen   : resample( parzen_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterGaussian : resample( gaussian_sampler( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSigma ), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterLanczos  : resample( lanczos_sampler( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSharpen ), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterLanczos3 : resample( lanczos3_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterLanczos4 : resample( lanczos4_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterLanczos6 : resample( lanczos6_sampler(), mat, procWin, outOfImageProcess ); break;
+		case eParamFilterLanczos12: resample( lanczos12_sampler(), mat, procWin, outOfImageProcess ); break;
 	}
 }
 
+/**
+ * @brief Resize is a scale and a translation: use the separable resampling,
+ * unless the out of image mode is only supported by the generic resampling.
+ */
+template<class View>
+template<class Sampler>
+void ResizeProcess<View>::resample( const Sampler& sampler, const terry::matrix3x2<double>& mat, const terry::Rect<std::ssize_t>& procWin, const terry::sampler::EParamFilterOutOfImage outOfImageProcess )
+{
+	using namespace terry::sampler;
+	if( is_separable_transform( mat, outOfImageProcess ) )
+		resample_pixels_separable_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), sampler );
+	else
+		resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), sampler );
+}
+
 }
 }
 }
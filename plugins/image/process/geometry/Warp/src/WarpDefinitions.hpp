@@ -41,10 +41,29 @@ static const std::string kParamTransition = "transition";
 static const std::string kParamReset = "reset";
 static const std::string kParamNextCurve = "nextCurve";
 static const std::string kParamSetKey = "setKey";
+static const std::string kParamCacheCoordinates = "cacheCoordinates";
+
+static const std::string kParamOutput = "output";
+static const std::string kParamOutputImage = "image";
+static const std::string kParamOutputSTMap = "stmap";
+enum EParamOutput
+{
+	eParamOutputImage = 0,
+	eParamOutputSTMap
+};
 
 static const std::string kParamGroupSettings = "settings";
 static const std::string kParamNbPointsBezier = "Points Bezier";
 static const std::string kParamRigiditeTPS = "Rigidite TPS";
+static const std::string kParamTpsEvaluation = "tpsEvaluation";
+static const std::string kParamTpsEvaluationExact = "exact";
+static const std::string kParamTpsEvaluationAdaptiveGrid = "adaptiveGrid";
+enum EParamTpsEvaluation
+{
+	eParamTpsEvaluationExact = 0,
+	eParamTpsEvaluationAdaptiveGrid
+};
+static const std::string kParamTpsMaxError = "tpsMaxError";
 
 static const std::string kParamGroupIn = "groupIn";
 static const std::string kParamPointIn = "pIn";
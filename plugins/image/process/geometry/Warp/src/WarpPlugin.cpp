@@ -20,6 +20,7 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include <algorithm>
 #include <cstddef>
 
 namespace tuttle {
@@ -42,9 +43,13 @@ ImageEffect( handle )
         _paramMethod = fetchChoiceParam( kParamMethod );
 	_paramNbPoints = fetchIntParam( kParamNbPoints );
 	_transition = fetchDoubleParam( kParamTransition );
+	_paramCacheCoordinates = fetchBooleanParam( kParamCacheCoordinates );
+	_paramOutput = fetchChoiceParam( kParamOutput );
 
 	_paramRigiditeTPS = fetchDoubleParam( kParamRigiditeTPS );
 	_paramNbPointsBezier = fetchIntParam( kParamNbPointsBezier );
+	_paramTpsEvaluation = fetchChoiceParam( kParamTpsEvaluation );
+	_paramTpsMaxError = fetchDoubleParam( kParamTpsMaxError );
 
         //Multi curve
         for( std::size_t cptCBegin = 0; cptCBegin < kMaxNbPoints; ++cptCBegin )
@@ -97,6 +102,7 @@ ImageEffect( handle )
 	_instanceChangedArgs.renderScale.y = 1;
 	_instanceChangedArgs.reason = OFX::eChangePluginEdit;
 	changedParam( _instanceChangedArgs, kParamNbPoints ); // init IsSecret property for each pair of points parameter
+	changedParam( _instanceChangedArgs, kParamTpsEvaluation );
 }
 
 WarpProcessParams<WarpPlugin::Scalar> WarpPlugin::getProcessParams( const OfxPointD& renderScale ) const
@@ -109,6 +115,12 @@ WarpProcessParams<WarpPlugin::Scalar> WarpPlugin::getProcessParams( const OfxPoi
 	params._rigiditeTPS = _paramRigiditeTPS->getValue( );
 	params._transition = _transition->getValue( );
         params._method = static_cast<EParamMethod> ( _paramMethod->getValue( ) );
+	params._activateWarp = true;
+	params._cacheCoordinates = _paramCacheCoordinates->getValue( );
+	params._output = static_cast<EParamOutput>( _paramOutput->getValue( ) );
+	params._tpsEvaluation = static_cast<EParamTpsEvaluation>( _paramTpsEvaluation->getValue( ) );
+	// the error is given at full resolution
+	params._tpsMaxError = _paramTpsMaxError->getValue( ) * std::min( renderScale.x, renderScale.y );
 
 	if( nbPoints <= 1 )
 	{
@@ -262,6 +274,18 @@ void WarpPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::
                 _paramCurveBegin[(_paramNbPoints->getValue())]->setValue(true);
                 TUTTLE_LOG_DEBUG(TUTTLE_INFO, _paramCurveBegin[(_paramNbPoints->getValue())]->getValue());
         }
+	else if( paramName == kParamTpsEvaluation )
+	{
+		_paramTpsMaxError->setEnabled( _paramTpsEvaluation->getValue( ) == eParamTpsEvaluationAdaptiveGrid );
+	}
+	else if( paramName == kParamCacheCoordinates )
+	{
+		if( ! _paramCacheCoordinates->getValue( ) )
+		{
+			_coordinateMapCacheA.clear( );
+			_coordinateMapCacheB.clear( );
+		}
+	}
 	else if( paramName == kParamSetKey )
 	{
 		// @todo adrien: c'est peut-etre mieux de le faire uniquement sur les points cree ? _paramNbPoints->getValue()
@@ -282,7 +306,7 @@ void WarpPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::
 bool WarpPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime )
 {
 	WarpProcessParams<Scalar> params = getProcessParams( );
-	if( params._nbPoints == 0 )
+	if( params._nbPoints == 0 && params._output == eParamOutputImage )
 	{
 		identityClip = _clipSrc;
 		identityTime = args.time;
@@ -4,12 +4,14 @@
 #include "WarpDefinitions.hpp"
 
 #include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/CoordinateMapCache.hpp>
 
 #include <ofxsImageEffect.h>
 
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/gil/gil_all.hpp>
 #include <boost/array.hpp>
+#include <boost/foreach.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -38,8 +40,35 @@ struct WarpProcessParams
 	double _transition;
 
         EParamMethod _method;
+	bool _cacheCoordinates;
+	EParamOutput _output;
+	EParamTpsEvaluation _tpsEvaluation;
+	double _tpsMaxError; ///< in pixels, for the adaptive grid evaluation
 };
 
+/**
+ * @brief Hash of the values used by the TPS transformations.
+ */
+template<typename Scalar>
+std::size_t hash_value( const WarpProcessParams<Scalar>& p )
+{
+	std::size_t seed = 0;
+	boost::hash_combine( seed, p._activateWarp );
+	boost::hash_combine( seed, p._rigiditeTPS );
+	boost::hash_combine( seed, p._transition );
+	boost::hash_combine( seed, p._bezierIn.size() );
+	BOOST_FOREACH( const point2<Scalar>& pt, p._bezierIn )
+	{
+		hashPoint( seed, pt );
+	}
+	boost::hash_combine( seed, p._bezierOut.size() );
+	BOOST_FOREACH( const point2<Scalar>& pt, p._bezierOut )
+	{
+		hashPoint( seed, pt );
+	}
+	return seed;
+}
+
 /**
  * @brief Warp plugin
  */
@@ -77,10 +106,14 @@ public:
 
         OFX::IntParam* _paramNbPoints;
 	OFX::DoubleParam* _transition;
+	OFX::BooleanParam* _paramCacheCoordinates;
+	OFX::ChoiceParam* _paramOutput;
 
 	OFX::GroupParam* _paramGroupSettings;
 	OFX::DoubleParam* _paramRigiditeTPS;
 	OFX::IntParam* _paramNbPointsBezier;
+	OFX::ChoiceParam* _paramTpsEvaluation;
+	OFX::DoubleParam* _paramTpsMaxError;
 
 	//In
 	OFX::GroupParam* _paramGroupIn;
@@ -113,6 +146,9 @@ public:
         OFX::GroupParam* _paramGroupCurveBegin;
         boost::array<OFX::BooleanParam*, kMaxNbPoints> _paramCurveBegin;
 
+	CoordinateMapCache _coordinateMapCacheA; ///< source coordinates of the last rendered parameters
+	CoordinateMapCache _coordinateMapCacheB; ///< same for the source B
+
 private:
 	OFX::InstanceChangedArgs _instanceChangedArgs;
 };
@@ -81,6 +81,20 @@ void WarpPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	transition->setRange( 0.0, 1.0 );
 	transition->setDisplayRange( 0.0, 1.0 );
 
+	OFX::BooleanParamDescriptor* cacheCoordinates = desc.defineBooleanParam( kParamCacheCoordinates );
+	cacheCoordinates->setLabel( "Cache coordinates" );
+	cacheCoordinates->setDefault( true );
+	cacheCoordinates->setEvaluateOnChange( false );
+	cacheCoordinates->setHint( "Evaluate the TPS once for each pixel, and reuse the source positions for all the frames rendered with the same curves.\n"
+	                           "Only the sampling remains for each frame, but it uses 8 bytes of memory per pixel and per source." );
+
+	OFX::ChoiceParamDescriptor* output = desc.defineChoiceParam( kParamOutput );
+	output->setLabel( "Output" );
+	output->appendOption( kParamOutputImage, "Image: the warped source image" );
+	output->appendOption( kParamOutputSTMap, "STMap: the normalized source position of each pixel of the source A in red and green (use a float bit depth)" );
+	output->setDefault( eParamOutputImage );
+	output->setHint( "Output the image, or the coordinates to apply the same warp in another application." );
+
 	//Settings
 	{
 		OFX::GroupParamDescriptor* groupSettings = desc.defineGroupParam( kParamGroupSettings );
@@ -125,6 +139,23 @@ void WarpPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 		rigidity->setDisplayRange( 0.0, 10.0 );
 		rigidity->setParent( groupSettings );
 
+		OFX::ChoiceParamDescriptor* tpsEvaluation = desc.defineChoiceParam( kParamTpsEvaluation );
+		tpsEvaluation->setLabel( "TPS evaluation" );
+		tpsEvaluation->appendOption( kParamTpsEvaluationExact, "Exact: evaluate the TPS for each pixel" );
+		tpsEvaluation->appendOption( kParamTpsEvaluationAdaptiveGrid, "Adaptive grid: evaluate the TPS on a grid refined where the warp is curved, and interpolate in between" );
+		tpsEvaluation->setDefault( eParamTpsEvaluationExact );
+		tpsEvaluation->setHint( "The exact evaluation costs the number of curve points for each pixel, "
+		                        "the adaptive grid is much faster with many points." );
+		tpsEvaluation->setParent( groupSettings );
+
+		OFX::DoubleParamDescriptor* tpsMaxError = desc.defineDoubleParam( kParamTpsMaxError );
+		tpsMaxError->setLabel( "TPS max error" );
+		tpsMaxError->setHint( "Maximum distance in pixels between the interpolated and the exact source positions, with the adaptive grid." );
+		tpsMaxError->setDefault( 0.1 );
+		tpsMaxError->setRange( 0.001, 100.0 );
+		tpsMaxError->setDisplayRange( 0.01, 1.0 );
+		tpsMaxError->setParent( groupSettings );
+
 		OFX::IntParamDescriptor* nbPointsBezier = desc.defineIntParam( kParamNbPointsBezier );
 		nbPointsBezier->setLabel( "Bezier" );
 		nbPointsBezier->setHint( "Nombre de points dessinant la courbe de bezier" );
@@ -37,6 +37,8 @@ protected :
     WarpProcessParams<Scalar> _params; ///< parameters
     TPS_Morpher<Scalar> _tpsA;
     TPS_Morpher<Scalar> _tpsB;
+    CoordinateMapCache::ConstMapPtr _coordinateMapA; ///< source coordinates of _tpsA, if cached
+    CoordinateMapCache::ConstMapPtr _coordinateMapB; ///< source coordinates of _tpsB, if cached
 
 public:
     WarpProcess( WarpPlugin& effect );
@@ -44,6 +46,10 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
     void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class MapFn>
+	void resample( const View& srcView, const View& dstView, const MapFn& dstToSrc, const OfxRectI& procWindow );
 };
 
 }
@@ -4,6 +4,7 @@
 #include <terry/sampler/resample_progress.hpp>
 #include <terry/algorithm/transform_pixels_progress.hpp>
 #include <tuttle/plugin/exceptions.hpp>
+#include <tuttle/plugin/ofxToGil/rect.hpp>
 
 #include <terry/globals.hpp>
 
@@ -51,6 +52,39 @@ void WarpProcess<View>::setup( const OFX::RenderArguments& args )
 	_tpsA.setup( _params._bezierIn, _params._bezierOut, _params._rigiditeTPS, _params._activateWarp, this->_srcPixelRod.x2 - this->_srcPixelRod.x1, this->_srcPixelRod.y2 - this->_srcPixelRod.y1, _params._transition );
 	//TUTTLE_TCOUT_VAR( _params._rigiditeTPS );
 	//TUTTLE_TCOUT_VAR( _params._activateWarp );
+
+	// the TPS are evaluated in the source coordinates
+	const terry::Rect<std::ssize_t> regionA( 0, 0, this->_srcView.width(), this->_srcView.height() );
+	const terry::Rect<std::ssize_t> regionB( 0, 0, this->_srcBView.width(), this->_srcBView.height() );
+	const bool useSrcB = this->_clipSrcB->isConnected( ) && _params._output == eParamOutputImage;
+	const double maxError = _params._tpsEvaluation == eParamTpsEvaluationAdaptiveGrid ? _params._tpsMaxError : 0.0;
+
+	if( _params._cacheCoordinates || _params._output == eParamOutputSTMap )
+	{
+		const std::size_t key = hash_value( _params );
+		_coordinateMapA = _plugin._coordinateMapCacheA.get( key, regionA, _tpsA, maxError );
+		if( useSrcB )
+			_coordinateMapB = _plugin._coordinateMapCacheB.get( key, regionB, _tpsB, maxError );
+	}
+	else if( maxError > 0.0 )
+	{
+		// the grid needs the whole image, even without cache
+		_coordinateMapA = CoordinateMapCache::compute( regionA, _tpsA, maxError );
+		if( useSrcB )
+			_coordinateMapB = CoordinateMapCache::compute( regionB, _tpsB, maxError );
+	}
+}
+
+/**
+ * @brief Resample with the cached coordinates if any.
+ */
+template<class View>
+template<class MapFn>
+void WarpProcess<View>::resample( const View& srcView, const View& dstView, const MapFn& dstToSrc, const OfxRectI& procWindow )
+{
+	using namespace terry::sampler;
+	const EParamFilterOutOfImage outOfImageProcess = eParamFilterOutBlack; /// @todo expose as parameter
+	resample_pixels_progress<terry::sampler::bilinear_sampler>( srcView, dstView, dstToSrc, ofxToGil( procWindow ), outOfImageProcess, this->getOfxProgress() );
 }
 
 /**
@@ -70,8 +104,17 @@ void WarpProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 	OfxPointI procWindowSize = { procWindowRoW.x2 - procWindowRoW.x1,
 								procWindowRoW.y2 - procWindowRoW.y1 };
 
-	const EParamFilterOutOfImage outOfImageProcess = eParamFilterOutBlack; /// @todo expose as parameter
-	
+	if( _params._output == eParamOutputSTMap )
+	{
+		View dst = subimage_view(
+						this->_dstView,
+						this->_srcPixelRod.x1-this->_dstPixelRod.x1, this->_srcPixelRod.y1-this->_dstPixelRod.y1,
+						this->_srcView.width(), this->_srcView.height() );
+		const point2<double> srcSize( this->_srcView.width(), this->_srcView.height() );
+		coordinate_map_to_view( *_coordinateMapA, dst, ofxToGil( procWindowSrcA ), srcSize );
+		return;
+	}
+
 	if( this->_clipSrcB->isConnected( ) )
 	{
 		Image imgA( procWindowSize.x, procWindowSize.y );
@@ -85,8 +128,14 @@ void WarpProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 						this->_srcBPixelRod.x1-procWindowRoW.x1, this->_srcBPixelRod.y1-procWindowRoW.y1,
 						this->_srcBView.width(), this->_srcBView.height() );
 
-		resample_pixels_progress<terry::sampler::bilinear_sampler>( this->_srcView, viewA, _tpsA, procWindowSrcA, outOfImageProcess, this->getOfxProgress() );
-		resample_pixels_progress<terry::sampler::bilinear_sampler>( this->_srcBView, viewB, _tpsB, procWindowSrcB, outOfImageProcess, this->getOfxProgress() );
+		if( _coordinateMapA )
+			resample( this->_srcView, viewA, *_coordinateMapA, procWindowSrcA );
+		else
+			resample( this->_srcView, viewA, _tpsA, procWindowSrcA );
+		if( _coordinateMapB )
+			resample( this->_srcBView, viewB, *_coordinateMapB, procWindowSrcB );
+		else
+			resample( this->_srcBView, viewB, _tpsB, procWindowSrcB );
 
 		//fondu entre imgA et imgB = this->_dstView FAITEALAMAIN
 		View dst = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1,
@@ -104,7 +153,10 @@ void WarpProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 						this->_dstView,
 						this->_srcPixelRod.x1-this->_dstPixelRod.x1, this->_srcPixelRod.y1-this->_dstPixelRod.y1,
 						this->_srcView.width(), this->_srcView.height() );
-		resample_pixels_progress<terry::sampler::bilinear_sampler > ( this->_srcView, dst, _tpsA, procWindowSrcA, outOfImageProcess, this->getOfxProgress() );
+		if( _coordinateMapA )
+			resample( this->_srcView, dst, *_coordinateMapA, procWindowSrcA );
+		else
+			resample( this->_srcView, dst, _tpsA, procWindowSrcA );
 	}
 }
 
@@ -3,6 +3,7 @@
 #include <tuttle/plugin/global.hpp>
 #include <terry/globals.hpp>
 #include <tuttle/plugin/param/gilColor.hpp>
+#include <tuttle/plugin/OfxThreadExecutor.hpp>
 #include <terry/typedefs.hpp>
 #include <terry/channel_view.hpp>
 
@@ -14,6 +15,8 @@
 #include <terry/numeric/init.hpp>
 #include <terry/numeric/pow.hpp>
 #include <terry/numeric/sqrt.hpp>
+#include <terry/algorithm/reduce.hpp>
+#include <terry/algorithm/statistics.hpp>
 #include <boost/gil/extension/color/hsl.hpp>
 
 #include <boost/units/pow.hpp>
@@ -96,83 +99,11 @@ namespace tuttle {
 namespace plugin {
 namespace imageStatistics {
 
-template<typename T>
-T standard_deviation( const T v_sum, const T v_sum_p2, const std::size_t nb )
-{
-	using namespace boost::units;
-	return std::sqrt( v_sum_p2 / nb - pow<2>( v_sum / nb ) );
-}
-
-template<typename Pixel>
-Pixel pixel_standard_deviation( const Pixel& v_sum, const Pixel& v_sum_p2, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = standard_deviation( v_sum[i], v_sum_p2[i], nb );
-	}
-	return res;
-}
-
-/**
- * @brief In probability theory and statistics, kurtosis is a measure of the
- * "peakedness" of the probability distribution of a real-valued random variable.
- *
- * Higher kurtosis means more of the variance is the result of infrequent extreme deviations,
- * as opposed to frequent modestly sized deviations.
- */
-template<typename T>
-T kurtosis( const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3, const T v_sum_p4, const std::size_t nb )
-{
-	using namespace boost::units;
-	return ( ( v_sum_p4 - 4.0 * v_mean * v_sum_p3 + 6.0 * pow<2>( v_mean ) * v_sum_p2 ) / nb - 3.0 * pow<4>( v_mean ) ) /
-	       ( pow<4>( v_standard_deviation ) ) - 3.0;
-}
-
-template<typename Pixel>
-Pixel pixel_kurtosis( const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2, const Pixel& v_sum_p3, const Pixel& v_sum_p4, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = kurtosis( v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], v_sum_p4[i], nb );
-	}
-	return res;
-}
-
-/**
- * @brief In probability theory and statistics, skewness is a measure of the
- * asymmetry of the probability distribution of a real-valued random variable.
- *
- * A zero value indicates that the values are relatively evenly distributed
- * on both sides of the mean, typically but not necessarily implying
- * a symmetric distribution.
- */
-template<typename T>
-T skewness( const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3, const std::size_t nb )
-{
-	using namespace boost::units;
-	return ( ( v_sum_p3 - 3.0 * v_mean * v_sum_p2 ) / nb + 2.0 * pow<3>( v_mean ) ) / pow<3>( v_standard_deviation );
-}
-
-template<typename Pixel>
-Pixel pixel_skewness( const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2, const Pixel& v_sum_p3, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = skewness( v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], nb );
-	}
-	return res;
-}
-
 template<class Pixel>
 struct OutputParams
 {
 	OutputParams()
+	: _nbPixels( 0 )
 	{
 		using namespace terry::numeric;
 		pixel_zeros_t<Pixel>( )( _average );
@@ -197,145 +128,177 @@ struct OutputParams
 	std::size_t _nbPixels;
 };
 
-template<class View, class MaskView, typename CType = boost::gil::bits64f>
-struct ComputeOutputParams
+/**
+ * @brief Statistics of the pixels of one colorspace, accumulated in one pass.
+ */
+template<class Pixel>
+struct PixelStatistics
 {
-	typedef typename View::value_type Pixel;
-	typedef typename boost::gil::color_space_type<View>::type Colorspace;
-	typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::gray_t> > PixelGray; // grayscale pixel type (using the input channel_type)
-	typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> > CPixel; // the pixel type use for computation (using input colorspace)
+	typedef boost::gil::pixel<typename boost::gil::channel_type<Pixel>::type, boost::gil::gray_layout_t> PixelGray; // grayscale pixel type (using the input channel_type)
 
-	typedef OutputParams<CPixel> Output;
+	std::size_t _nbPixels;
+	Pixel _channelMin;
+	Pixel _channelMax;
+	Pixel _luminosityMin;
+	PixelGray _luminosityMinGray;
+	Pixel _luminosityMax;
+	PixelGray _luminosityMaxGray;
+	terry::algorithm::pixel_moments_t<Pixel> _moments;
 
-	static Output run( const View& image, const MaskView& maskView, const bool useMask, ImageStatisticsPlugin& plugin )
+	PixelStatistics()
+	: _nbPixels( 0 )
+	{}
+
+	void operator()( const Pixel& pix )
 	{
 		using namespace terry::numeric;
-		OutputParams<CPixel> output;
 
-		std::size_t nbProcPixels = 0;
-
-		Pixel channelMin;
-		Pixel channelMax;
-		Pixel luminosityMin;
-		PixelGray luminosityMinGray;
-		Pixel luminosityMax;
-		PixelGray luminosityMaxGray;
-
-		CPixel sum;
-		CPixel varianceSum;
-		CPixel sum_p2;
-		CPixel sum_p3;
-		CPixel sum_p4;
-		pixel_zeros_t<CPixel>( )( sum );
-		pixel_zeros_t<CPixel>( )( varianceSum );
-		pixel_zeros_t<CPixel>( )( sum_p2 );
-		pixel_zeros_t<CPixel>( )( sum_p3 );
-		pixel_zeros_t<CPixel>( )( sum_p4 );
-
-		for( int y = 0; y < image.height(); ++y )
+		PixelGray grayCurrentPixel; // current pixel in gray colorspace
+		color_convert( pix, grayCurrentPixel );
+
+		if( _nbPixels == 0 )
 		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			typename MaskView::x_iterator mask_it = maskView.x_at( 0, y );
+			// It's the first pixel we visit.
+			// So initialize statistics!
+			_channelMin = pix;
+			_channelMax = pix;
+			_luminosityMin = pix;
+			_luminosityMinGray = grayCurrentPixel;
+			_luminosityMax = pix;
+			_luminosityMaxGray = grayCurrentPixel;
+		}
+		// Count the number of pixels taken into account
+		++_nbPixels;
 
-			for( int x = 0; x < image.width(); ++x, ++src_it, ++mask_it )
-			{
-				if( useMask && get_color( *mask_it, gray_color_t() ) == 0.0 )
-					continue;
-				
-				
-				PixelGray grayCurrentPixel; // current pixel in gray colorspace
-				color_convert( * src_it, grayCurrentPixel );
-
-				if( nbProcPixels == 0 )
-				{
-					// It's the first pixel we visit.
-					// So initialize statistics!
-					channelMin = *src_it;
-					channelMax = *src_it;
-					luminosityMin = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-					luminosityMax = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
-				// Count the number of pixels taken into account
-				++nbProcPixels;
-				
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
-
-				CPixel pix_p2;
-				CPixel pix_p3;
-				CPixel pix_p4;
-
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
-
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix, sum ); // sum += pix;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, sum_p2 ); // sum_p2 += pix_p2;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, sum_p3 ); // sum_p3 += pix_p3;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, sum_p4 ); // sum_p4 += pix_p4;
-
-				// search min for each channel
-				pixel_assign_min_t<Pixel, Pixel>( )( * src_it, channelMin );
-				// search max for each channel
-				pixel_assign_max_t<Pixel, Pixel>( )( * src_it, channelMax );
-
-				// search min luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( luminosityMinGray, gray_color_t() ) )
-				{
-					luminosityMin     = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-				}
-				// search max luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( luminosityMaxGray, gray_color_t() ) )
-				{
-					luminosityMax     = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
-			}
+		_moments( pix );
+
+		// search min for each channel
+		pixel_assign_min_t<Pixel, Pixel>( )( pix, _channelMin );
+		// search max for each channel
+		pixel_assign_max_t<Pixel, Pixel>( )( pix, _channelMax );
+
+		// search min luminosity
+		if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( _luminosityMinGray, gray_color_t() ) )
+		{
+			_luminosityMin     = pix;
+			_luminosityMinGray = grayCurrentPixel;
 		}
+		// search max luminosity
+		if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( _luminosityMaxGray, gray_color_t() ) )
+		{
+			_luminosityMax     = pix;
+			_luminosityMaxGray = grayCurrentPixel;
+		}
+	}
 
-		output._nbPixels = nbProcPixels;
+	/// @brief Merge the statistics of the next pixels (the first pixel wins on equal luminosity, like in one pass).
+	void merge( const PixelStatistics& other )
+	{
+		using namespace terry::numeric;
 
-		output._channelMin    = channelMin;
-		output._channelMax    = channelMax;
-		output._luminosityMin = luminosityMin;
-		output._luminosityMax = luminosityMax;
+		if( other._nbPixels == 0 )
+			return;
+		if( _nbPixels == 0 )
+		{
+			*this = other;
+			return;
+		}
+		_nbPixels += other._nbPixels;
+		_moments.merge( other._moments );
+		pixel_assign_min_t<Pixel, Pixel>( )( other._channelMin, _channelMin );
+		pixel_assign_max_t<Pixel, Pixel>( )( other._channelMax, _channelMax );
+		if( get_color( other._luminosityMinGray, gray_color_t() ) < get_color( _luminosityMinGray, gray_color_t() ) )
+		{
+			_luminosityMin     = other._luminosityMin;
+			_luminosityMinGray = other._luminosityMinGray;
+		}
+		if( get_color( other._luminosityMaxGray, gray_color_t() ) > get_color( _luminosityMaxGray, gray_color_t() ) )
+		{
+			_luminosityMax     = other._luminosityMax;
+			_luminosityMaxGray = other._luminosityMaxGray;
+		}
+	}
 
-		CPixel stdDeriv = pixel_standard_deviation( sum, sum_p2, nbProcPixels );
-		output._average  = pixel_divides_scalar_t<CPixel, double>() ( sum, nbProcPixels );
+	template<class CPixel>
+	OutputParams<CPixel> getOutput() const
+	{
+		using terry::algorithm::channel_moments_t;
+		OutputParams<CPixel> output;
+		output._nbPixels = _nbPixels;
+		if( _nbPixels == 0 )
+			return output;
+
+		output._channelMin    = _channelMin;
+		output._channelMax    = _channelMax;
+		output._luminosityMin = _luminosityMin;
+		output._luminosityMax = _luminosityMax;
+
+		_moments.get( &channel_moments_t::mean, output._average );
+		_moments.get( &channel_moments_t::standard_deviation, output._variance );
+		_moments.get( &channel_moments_t::kurtosis, output._kurtosis );
+		_moments.get( &channel_moments_t::skewness, output._skewness );
+		return output;
+	}
+};
 
-		for( int y = 0; y < image.height(); ++y )
+/**
+ * @brief Compute the statistics of the RGBA and HSL values of a band of rows,
+ * reducer of terry::algorithm::reduce_rows_parallel_progress.
+ */
+template<class View, class MaskView, typename CType = boost::gil::bits64f>
+struct ComputeOutputParams
+{
+	typedef typename View::value_type Pixel;
+	typedef typename boost::gil::color_space_type<View>::type Colorspace;
+	typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::hsl_t> > PixelHSL;
+	typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> > CPixel; // the pixel type use for computation (using input colorspace)
+	typedef boost::gil::pixel<CType, boost::gil::layout<boost::gil::hsl_t> > CPixelHSL;
+
+	typedef OutputParams<CPixel> Output;
+	typedef OutputParams<CPixelHSL> OutputHSL;
+
+	View _image;
+	MaskView _maskView;
+	bool _useMask;
+
+	PixelStatistics<Pixel> _statistics;
+	PixelStatistics<PixelHSL> _statisticsHSL;
+
+	ComputeOutputParams( const View& image, const MaskView& maskView, const bool useMask )
+	: _image( image )
+	, _maskView( maskView )
+	, _useMask( useMask )
+	{}
+
+	void operator()( const std::ptrdiff_t y )
+	{
+		using namespace boost::gil;
+		typename View::x_iterator src_it = _image.row_begin( y );
+		typename MaskView::x_iterator mask_it = _maskView.row_begin( y );
+
+		for( int x = 0; x < _image.width(); ++x, ++src_it, ++mask_it )
 		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
+			if( _useMask && get_color( *mask_it, gray_color_t() ) == 0.0 )
+				continue;
 
-				CPixel pix_diff = pix;
-				CPixel pix_diff2;
+			_statistics( *src_it );
 
-				pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, output._average ); // pix_diff = (pix - mean)
-				pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
-				
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, varianceSum ); // varianceSum += pix_diff2;
-			}
+			PixelHSL hsl;
+			color_convert( *src_it, hsl );
+			_statisticsHSL( hsl );
 		}
+	}
 
-		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( varianceSum, nbProcPixels );
-		output._variance = pixel_sqrt_t<CPixel, Pixel>()( varianceSquare );
-		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbProcPixels );
-		output._skewness = pixel_skewness( output._average, stdDeriv, sum, sum_p2, sum_p3, nbProcPixels );
-
-		return output;
+	void merge( const ComputeOutputParams& other )
+	{
+		_statistics.merge( other._statistics );
+		_statisticsHSL.merge( other._statisticsHSL );
 	}
 
+	Output getOutput() const { return _statistics.template getOutput<CPixel>(); }
+	OutputHSL getOutputHSL() const { return _statisticsHSL.template getOutput<CPixelHSL>(); }
 };
 
-
 template <typename OutputParamsRGBA, typename OutputParamsHSL>
 void setOutputParams( const OutputParamsRGBA& outputParamsRGBA, const OutputParamsHSL& outputParamsHSL, const OfxTime time, ImageStatisticsPlugin& plugin )
 {
@@ -430,13 +393,12 @@ void ImageStatisticsProcess<View>::setup( const OFX::RenderArguments& args )
 	typedef channel_view_type<MaskColorChannel, MaskView> KthChannelView;
 	typename KthChannelView::type channelMaskView = KthChannelView::make(maskView); // gray or alpha channel
 
-	typedef ComputeOutputParams<View, typename KthChannelView::type, boost::gil::bits64f> ComputeRGBA;
-	typename ComputeRGBA::Output outputRGBA = ComputeRGBA::run( image, channelMaskView, _clipMaskConnected, this->_plugin );
-
-	typedef pixel<typename channel_type<View>::type, layout<hsl_t> > HSLPixel;
-	typedef color_converted_view_type<View, HSLPixel> HSLConverter;
-	typedef ComputeOutputParams<typename HSLConverter::type, typename KthChannelView::type, boost::gil::bits64f> ComputeHSL;
-	typename ComputeHSL::Output outputHSL = ComputeHSL::run( color_converted_view<HSLPixel>( image ), channelMaskView, _clipMaskConnected, this->_plugin );
+	// RGBA and HSL statistics in one parallel pass
+	typedef ComputeOutputParams<View, typename KthChannelView::type, boost::gil::bits64f> Compute;
+	Compute compute( image, channelMaskView, _clipMaskConnected );
+	terry::algorithm::reduce_rows_parallel( image.height(), image.width(), compute, OfxThreadExecutor() );
+	const typename Compute::Output outputRGBA = compute.getOutput();
+	const typename Compute::OutputHSL outputHSL = compute.getOutputHSL();
 
 	setOutputParams( outputRGBA, outputHSL, args.time, this->_plugin );
 